@@ -1,5 +1,6 @@
 #include "Application.hpp"
 #include "bk/Preferences.hpp"
+#include "api/fx/Events.hpp"
 #include "api/fx/IEventQueue.hpp"
 #include "api/fx/IGuiCallbackRegistrar.hpp"
 #include "ui/Manager.hpp"
@@ -28,6 +29,13 @@ Application::Application(std::shared_ptr<bk::Preferences> newPreferences,
       manager->render(editorState);
     }
   });
+
+  // F1 hides the overlay, and with it the renderer's ImGui pass
+  eventQueue->subscribe<tr::KeyEvent>([&](const auto& event) {
+    if (event->key == tr::Key::F1 && event->buttonState == tr::ButtonState::Pressed) {
+      guiCallbackRegistrar->setVisible(!guiCallbackRegistrar->isVisible());
+    }
+  });
 }
 
 Application::~Application() {
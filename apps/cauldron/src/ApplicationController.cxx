@@ -25,7 +25,7 @@ auto ApplicationController::handleAddStaticModel(const std::shared_ptr<tr::AddSt
   const auto beginBatch = tr::BeginResourceBatch{.batchId = 1};
   const auto endBatch = tr::EndResourceBatch{.batchId = 1};
 
-  eventQueue->emit(beginBatch, UIGroup);
+  eventQueue->emit(beginBatch);
   for (int i = 0; i < event->count; ++i) {
     const auto staticModelRequestId = bk::RandomUtils::uint64InRange(1, 10000);
 
@@ -42,10 +42,10 @@ auto ApplicationController::handleAddStaticModel(const std::shared_ptr<tr::AddSt
                            .modelName = event->modelName,
                            .skeleton = "",
                            .animations = {}});
-    eventQueue->emit(modelRequest, UIGroup);
+    eventQueue->emit(modelRequest);
   }
 
-  eventQueue->emit(endBatch, UIGroup);
+  eventQueue->emit(endBatch);
 }
 
 auto ApplicationController::handleStaticModelUploaded(
@@ -78,9 +78,9 @@ auto ApplicationController::handleAddStaticGeometry(
                                          .orientation = event->orientation,
                                          .skeleton = "",
                                          .animations = {}});
-  eventQueue->emit(beginBatch, UIGroup);
-  eventQueue->emit(meshRequest, UIGroup);
-  eventQueue->emit(endBatch, UIGroup);
+  eventQueue->emit(beginBatch);
+  eventQueue->emit(meshRequest);
+  eventQueue->emit(endBatch);
 }
 
 }
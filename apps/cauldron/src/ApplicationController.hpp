@@ -23,8 +23,6 @@ public:
   auto operator=(ApplicationController&&) -> ApplicationController& = delete;
 
 private:
-  static inline const std::string UIGroup = "ui_group";
-
   std::shared_ptr<tr::IEventQueue> eventQueue;
 
   tr::MapKey requestIdGenerator;
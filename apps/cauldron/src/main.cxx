@@ -40,6 +40,18 @@ auto main(int argc, char** argv) -> int {
 
   Log.info("Console is now ready for logging!");
 
+  // Value following a `--name value` style argument
+  const auto argValue = [&args](std::string_view name) -> std::optional<std::filesystem::path> {
+    const auto it = std::ranges::find(args, name);
+    if (it == args.end() || std::next(it) == args.end()) {
+      return std::nullopt;
+    }
+    return std::filesystem::path{*std::next(it)};
+  };
+  const auto argCount = [&argValue](std::string_view name) -> std::optional<uint64_t> {
+    return argValue(name).transform([](const auto& value) { return std::stoull(value.string()); });
+  };
+
   static constexpr int width = 1920;
   static constexpr int height = 1080;
 
@@ -69,8 +81,14 @@ auto main(int argc, char** argv) -> int {
 
   try {
     auto guiAdapter = std::make_shared<tr::ImGuiAdapter>();
-    auto frameworkConfig = tr::FrameworkConfig{.initialWindowSize = glm::ivec2(width, height),
-                                               .windowTitle = windowTitle.str()};
+    auto frameworkConfig = tr::FrameworkConfig{
+        .initialWindowSize = glm::ivec2(width, height),
+        .windowTitle = windowTitle.str(),
+        .headless = std::ranges::find(args, std::string_view{"--headless"}) != args.end(),
+        .recordInputPath = argValue("--record"),
+        .replayInputPath = argValue("--replay"),
+        .timingsDirectory = argValue("--timings"),
+        .frameLimit = argCount("--frames")};
     auto uiStateBuffer = std::make_shared<tr::EditorStateBuffer>();
     auto guiCallbackRegistrar = std::make_shared<tr::GuiCallBackRegistrar>();
 
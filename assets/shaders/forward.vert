@@ -28,6 +28,10 @@ struct GpuGeometryRegionData {
   uint colorOffset;
   uint texCoordOffset;
   uint normalOffset;
+
+  vec4 boundingSphere;
+  vec3 boundsMin;
+  vec3 boundsMax;
 };
 
 // Buffer references
@@ -26,6 +26,13 @@ layout(buffer_reference, scalar) buffer ResourceTable {
   uint64_t materialBufferAddress;
   uint64_t indirectCommandAddress;
   uint64_t indirectCountAddress;
+  uint64_t drawBatchAddress;
+  uint64_t drawInstanceAddress;
+  uint64_t visibleObjectAddress;
+  uint64_t depthPyramidAddress;
+  uint64_t lateIndirectCommandAddress;
+  uint64_t lateIndirectCountAddress;
+  uint64_t objectVisibilityAddress;
 };
 
 struct GpuObjectData {
@@ -27,6 +27,13 @@ layout(buffer_reference, scalar) buffer ResourceTable {
   uint64_t materialBufferAddress;
   uint64_t indirectCommandAddress;
   uint64_t indirectCountAddress;
+  uint64_t drawBatchAddress;
+  uint64_t drawInstanceAddress;
+  uint64_t visibleObjectAddress;
+  uint64_t depthPyramidAddress;
+  uint64_t lateIndirectCommandAddress;
+  uint64_t lateIndirectCountAddress;
+  uint64_t objectVisibilityAddress;
 };
 
 layout(buffer_reference, scalar) buffer FrameDataBuffer {
@@ -35,6 +42,7 @@ layout(buffer_reference, scalar) buffer FrameDataBuffer {
   vec4 cameraPosition;
   float time;
   uint maxObjects;
+  uint batchCount;
 };
 
 layout(buffer_reference, scalar) buffer IndexBuffer {
@@ -64,6 +72,9 @@ struct GpuGeometryRegionData {
   uint colorOffset;
   uint texCoordOffset;
   uint normalOffset;
+  vec4 boundingSphere;
+  vec3 boundsMin;
+  vec3 boundsMax;
 };
 
 layout(buffer_reference, scalar) buffer RegionBuffer {
@@ -83,6 +94,12 @@ layout(buffer_reference, scalar) buffer ObjectDataBuffer {
   GpuObjectData objects[];
 };
 
+// Object slot drawn by each instance that survived culling. Batches of instances share a mesh
+// and material.
+layout(buffer_reference, scalar) buffer VisibleObjectBuffer {
+  uint objects[];
+};
+
 layout(buffer_reference, scalar) buffer GpuPositionDataBuffer {
   vec3 position[];
 };
@@ -115,7 +132,9 @@ void main() {
   ObjectDataBuffer objectDataBuf = ObjectDataBuffer(resourceTable.objectDataBufferAddress);
   RegionBuffer regionBuf = RegionBuffer(resourceTable.regionBufferAddress);
 
-  GpuObjectData object = objectDataBuf.objects[gl_InstanceIndex];
+  VisibleObjectBuffer visibleBuf = VisibleObjectBuffer(resourceTable.visibleObjectAddress);
+  uint objectIndex = visibleBuf.objects[gl_InstanceIndex];
+  GpuObjectData object = objectDataBuf.objects[objectIndex];
 
   GpuPositionDataBuffer positionDataBuffer =
       GpuPositionDataBuffer(resourceTable.objectPositionsAddress);
@@ -166,5 +185,5 @@ void main() {
   v_texCoord = texCoord;
   v_normal = normal;
   v_color = color;
-  objectId = gl_InstanceIndex;
+  objectId = objectIndex;
 }
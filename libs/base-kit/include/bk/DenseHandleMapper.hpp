@@ -0,0 +1,150 @@
+#pragma once
+
+#include "bk/Handle.hpp"
+
+namespace tr {
+
+/// Translates between public and internal handles, like HandleMapper, but keeps the public to
+/// internal direction in flat arrays so `toInternal` is a page and an array load instead of a hash
+/// lookup.
+///
+/// Public ids pack an entry index in the low 32 bits and that entry's generation in the high 32,
+/// so a handle that outlives its mapping is reported as missing rather than resolving to whatever
+/// reused the entry. Generations start at 1, so a default constructed handle is never valid.
+///
+/// Entries live in fixed size pages that never move once allocated. Handles are minted on the
+/// asset thread and translated on the render thread after reaching it through the game world, so
+/// growing the table must not touch memory a reader could be looking at.
+template <typename PublicTag, typename InternalTag>
+class DenseHandleMapper {
+public:
+  using PublicHandle = Handle<PublicTag>;
+  using InternalHandle = Handle<InternalTag>;
+
+  static constexpr size_t PageSize = 4096;
+  static constexpr size_t MaxPages = 256;
+
+  DenseHandleMapper() = default;
+  ~DenseHandleMapper() = default;
+
+  DenseHandleMapper(const DenseHandleMapper&) = delete;
+  DenseHandleMapper(DenseHandleMapper&&) = delete;
+  auto operator=(const DenseHandleMapper&) -> DenseHandleMapper& = delete;
+  auto operator=(DenseHandleMapper&&) -> DenseHandleMapper& = delete;
+
+  /// Returns the existing public handle for `internal`, or maps it to a new one.
+  auto toPublic(InternalHandle internal) -> PublicHandle {
+    auto [it, inserted] = internalToPublic.try_emplace(internal);
+    if (!inserted) {
+      return it->second;
+    }
+
+    uint32_t index{};
+    if (!freeIndices.empty()) {
+      index = freeIndices.back();
+      freeIndices.pop_back();
+    } else {
+      index = entryCount.load(std::memory_order_relaxed);
+      assert(index / PageSize < MaxPages && "DenseHandleMapper is out of pages");
+      if (!pages[index / PageSize]) {
+        pages[index / PageSize] = std::make_unique<Page>();
+      }
+    }
+
+    auto& entry = entryAt(index);
+    entry.internal = internal;
+    // Only publish the entry once it's filled in.
+    if (index == entryCount.load(std::memory_order_relaxed)) {
+      entryCount.store(index + 1, std::memory_order_release);
+    }
+    it->second = makeHandle(index, entry.generation);
+    return it->second;
+  }
+
+  [[nodiscard]] auto toInternal(PublicHandle publicHandle) const -> std::optional<InternalHandle> {
+    const auto* entry = find(publicHandle);
+    return entry != nullptr ? std::optional{entry->internal} : std::nullopt;
+  }
+
+  /// Translates the public handle `projection` picks out of each of `items` into `out`, which is
+  /// resized to match. Stale handles come back as a default InternalHandle. Returns false if there
+  /// were any.
+  template <typename T, typename Projection>
+  auto toInternal(std::span<const T> items,
+                  Projection projection,
+                  std::vector<InternalHandle>& out) const -> bool {
+    out.resize(items.size());
+    auto allFound = true;
+    for (size_t i = 0; i < items.size(); ++i) {
+      const auto* entry = find(std::invoke(projection, items[i]));
+      allFound = allFound && entry != nullptr;
+      out[i] = entry != nullptr ? entry->internal : InternalHandle{};
+    }
+    return allFound;
+  }
+
+  /// Unmaps `publicHandle`. It and any copies of it go stale, and its entry is reused by a later
+  /// `toPublic`. Unlike growing the table this writes to an entry readers may still look at, so it
+  /// has to be ordered against them by the caller. Returns false if it was already stale.
+  auto erase(PublicHandle publicHandle) -> bool {
+    if (find(publicHandle) == nullptr) {
+      return false;
+    }
+    auto& entry = entryAt(indexOf(publicHandle));
+    internalToPublic.erase(entry.internal);
+    entry.internal = InternalHandle{};
+    ++entry.generation;
+    freeIndices.push_back(indexOf(publicHandle));
+    return true;
+  }
+
+  [[nodiscard]] auto size() const -> size_t {
+    return internalToPublic.size();
+  }
+
+  /// Index of the entry `handle` refers to. Live handles never share one, so it can be used to key
+  /// flat per-entry tables, as long as those also check the handle to catch an entry being reused.
+  static auto indexOf(PublicHandle handle) -> uint32_t {
+    return static_cast<uint32_t>(handle.id & 0xFFFFFFFF);
+  }
+
+private:
+  struct Entry {
+    uint32_t generation{1};
+    InternalHandle internal{};
+  };
+
+  using Page = std::array<Entry, PageSize>;
+
+  std::array<std::unique_ptr<Page>, MaxPages> pages;
+  std::atomic<uint32_t> entryCount;
+  std::vector<uint32_t> freeIndices;
+  std::unordered_map<InternalHandle, PublicHandle> internalToPublic;
+
+  [[nodiscard]] auto entryAt(uint32_t index) -> Entry& {
+    return (*pages[index / PageSize])[index % PageSize];
+  }
+
+  [[nodiscard]] auto entryAt(uint32_t index) const -> const Entry& {
+    return (*pages[index / PageSize])[index % PageSize];
+  }
+
+  [[nodiscard]] auto find(PublicHandle publicHandle) const -> const Entry* {
+    const auto index = indexOf(publicHandle);
+    if (index >= entryCount.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    const auto& entry = entryAt(index);
+    return entry.generation == generationOf(publicHandle) ? &entry : nullptr;
+  }
+
+  static auto makeHandle(uint32_t index, uint32_t generation) -> PublicHandle {
+    return PublicHandle{.id = (static_cast<size_t>(generation) << 32) | index};
+  }
+
+  static auto generationOf(PublicHandle handle) -> uint32_t {
+    return static_cast<uint32_t>(handle.id >> 32);
+  }
+};
+
+}
@@ -4,24 +4,22 @@
 
 namespace tr {
 
+/// Hands out sequential ids starting at 1, so ids never collide and 0 is never a valid id. Handles
+/// and logical handles are counted separately, which keeps each kind dense enough to index a
+/// vector with. Registries that also remove entries should use a SlotMap instead.
 template <typename T>
 struct HandleGenerator {
-
-  HandleGenerator() : gen{randomDevice()}, distribution(1, 10000) {
-  }
-
   [[nodiscard]] auto requestHandle() -> Handle<T> {
-    return Handle<T>{.id = distribution(gen)};
+    return Handle<T>{.id = ++lastHandleId};
   }
 
   [[nodiscard]] auto requestLogicalHandle() -> LogicalHandle<T> {
-    return LogicalHandle<T>{.id = distribution(gen)};
+    return LogicalHandle<T>{.id = ++lastLogicalHandleId};
   }
 
 private:
-  std::random_device randomDevice;
-  std::mt19937 gen;
-  std::uniform_int_distribution<std::size_t> distribution;
+  size_t lastHandleId{};
+  size_t lastLogicalHandleId{};
 };
 
 }
@@ -0,0 +1,158 @@
+#pragma once
+
+namespace tr {
+
+using Job = std::move_only_function<void()>;
+
+enum class JobPriority : uint8_t {
+  High = 0,
+  Normal,
+  Low,
+  Count
+};
+
+struct JobSystemConfig {
+  /// 0 uses every hardware thread not reserved below.
+  size_t workerCount = 0;
+  /// Main, game and graphics threads.
+  size_t reservedThreads = 3;
+};
+
+/// Counts a set of outstanding jobs so they can be waited on or continued from.
+class JobGroup {
+public:
+  JobGroup() = default;
+  ~JobGroup() = default;
+
+  JobGroup(const JobGroup&) = delete;
+  JobGroup(JobGroup&&) = delete;
+  auto operator=(const JobGroup&) -> JobGroup& = delete;
+  auto operator=(JobGroup&&) -> JobGroup& = delete;
+
+private:
+  friend class JobSystem;
+
+  std::atomic<size_t> pending;
+  std::mutex mutex;
+  std::vector<std::pair<Job, JobPriority>> continuations;
+};
+
+/// Shared worker pool.
+///
+/// Each worker owns a deque per priority lane. Workers push and pop their own deques at the back,
+/// and idle workers steal from the front of everyone else's, highest priority lane first. Jobs
+/// submitted from outside the pool are spread over the workers round robin.
+///
+/// Threads that wait on a JobGroup help by running queued jobs in the meantime, highest priority
+/// lane first, and sleep alongside the idle workers once there's nothing left to run.
+class JobSystem {
+public:
+  explicit JobSystem(const JobSystemConfig& config = {});
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem(JobSystem&&) = delete;
+  auto operator=(const JobSystem&) -> JobSystem& = delete;
+  auto operator=(JobSystem&&) -> JobSystem& = delete;
+
+  auto submit(Job job, JobPriority priority = JobPriority::Normal) -> void;
+  auto submit(JobGroup& group, Job job, JobPriority priority = JobPriority::Normal) -> void;
+
+  /// Submits `continuation` once every job in `group` has finished, or right away if none are
+  /// outstanding.
+  auto then(JobGroup& group, Job continuation, JobPriority priority = JobPriority::Normal) -> void;
+
+  /// Blocks until every job in `group` has finished, running queued jobs meanwhile.
+  auto wait(JobGroup& group) -> void;
+
+  /// Runs `f` on a worker, then queues `onComplete` with its result to run on whichever thread
+  /// calls `processCompleteTasks`.
+  template <typename F, typename OnComplete>
+  auto enqueue(F&& f, OnComplete&& onComplete, JobPriority priority = JobPriority::Normal)
+      -> void {
+    using ReturnType = std::invoke_result_t<F&&>;
+    submit(
+        [this, f = std::forward<F>(f), onComplete = std::forward<OnComplete>(onComplete)]() mutable {
+          if constexpr (std::is_void_v<ReturnType>) {
+            f();
+            enqueueOnCallerThread(std::move(onComplete));
+          } else {
+            enqueueOnCallerThread([onComplete = std::move(onComplete), result = f()]() mutable {
+              onComplete(result);
+            });
+          }
+        },
+        priority);
+  }
+
+  auto processCompleteTasks() -> void;
+
+  /// Calls `body(begin, end)` over [0, count) in chunks of `grainSize`, with the calling thread
+  /// working alongside the pool. Returns once every chunk is done. `body` must not throw.
+  template <typename F>
+  auto parallelFor(size_t count, size_t grainSize, F&& body) -> void {
+    if (count == 0) {
+      return;
+    }
+    grainSize = std::max<size_t>(grainSize, 1);
+    const auto chunkCount = (count + grainSize - 1) / grainSize;
+    const auto helperCount = std::min(chunkCount, workers.size() + 1) - 1;
+    if (helperCount == 0) {
+      body(size_t{0}, count);
+      return;
+    }
+
+    std::atomic<size_t> nextChunk = 0;
+    auto runChunks = [&]() {
+      for (auto chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount;
+           chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+        const auto begin = chunk * grainSize;
+        body(begin, std::min(begin + grainSize, count));
+      }
+    };
+
+    JobGroup group;
+    for (size_t i = 0; i < helperCount; ++i) {
+      submit(group, [&runChunks]() { runChunks(); }, JobPriority::High);
+    }
+    runChunks();
+    wait(group);
+  }
+
+  [[nodiscard]] auto getWorkerCount() const -> size_t {
+    return workers.size();
+  }
+
+private:
+  static constexpr auto LaneCount = static_cast<size_t>(JobPriority::Count);
+  static constexpr auto NoWorker = std::numeric_limits<size_t>::max();
+
+  struct alignas(64) WorkerQueue {
+    std::mutex mutex;
+    std::array<std::deque<Job>, LaneCount> lanes;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::jthread> workers;
+
+  std::atomic<size_t> queuedJobs;
+  std::atomic<size_t> sleepingWorkers;
+  std::atomic<size_t> nextQueue;
+
+  std::mutex sleepMutex;
+  std::condition_variable_any sleepCondition;
+
+  std::mutex completeMutex;
+  std::vector<Job> completeQueue;
+
+  auto workerLoop(size_t index, const std::stop_token& token) -> void;
+  auto push(size_t queueIndex, Job job, JobPriority priority) -> void;
+  auto tryPop(size_t queueIndex, JobPriority lowestPriority) -> std::optional<Job>;
+  auto trySteal(size_t thief, JobPriority lowestPriority) -> std::optional<Job>;
+  auto tryRunOne(size_t index, JobPriority lowestPriority) -> bool;
+  auto finish(JobGroup& group) -> void;
+  auto enqueueOnCallerThread(Job job) -> void;
+  [[nodiscard]] auto currentWorkerIndex() const -> size_t;
+};
+
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "bk/Handle.hpp"
+
+namespace tr {
+
+/// Densely stored values addressed by generational handles.
+///
+/// A handle's id packs a slot index in the low 32 bits and that slot's generation in the high 32.
+/// Erasing a value bumps its slot's generation, so handles to it go stale instead of silently
+/// resolving to whatever gets inserted into the slot next. Generations start at 1, so a default
+/// constructed handle is never valid.
+///
+/// Values live contiguously and are kept that way by moving the last value into an erased one's
+/// place, so iteration order is not insertion order and pointers to values are only stable until
+/// the next insert or erase.
+template <typename T, typename HandleTag = T>
+class SlotMap {
+public:
+  using HandleType = Handle<HandleTag>;
+
+  SlotMap() = default;
+  ~SlotMap() = default;
+
+  SlotMap(const SlotMap&) = default;
+  SlotMap(SlotMap&&) noexcept = default;
+  auto operator=(const SlotMap&) -> SlotMap& = default;
+  auto operator=(SlotMap&&) noexcept -> SlotMap& = default;
+
+  template <typename... Args>
+  auto emplace(Args&&... args) -> HandleType {
+    uint32_t slotIndex{};
+    if (freeHead != NoSlot) {
+      slotIndex = freeHead;
+      freeHead = slots[slotIndex].next;
+    } else {
+      slotIndex = static_cast<uint32_t>(slots.size());
+      slots.push_back(Slot{.generation = 1});
+    }
+
+    auto& slot = slots[slotIndex];
+    slot.next = static_cast<uint32_t>(values.size());
+    values.emplace_back(std::forward<Args>(args)...);
+    valueSlots.push_back(slotIndex);
+    return makeHandle(slotIndex, slot.generation);
+  }
+
+  auto insert(T value) -> HandleType {
+    return emplace(std::move(value));
+  }
+
+  /// Returns false if the handle was already stale.
+  auto erase(HandleType handle) -> bool {
+    if (!contains(handle)) {
+      return false;
+    }
+    const auto slotIndex = indexOf(handle);
+    auto& slot = slots[slotIndex];
+    const auto valueIndex = slot.next;
+    const auto lastIndex = static_cast<uint32_t>(values.size() - 1);
+
+    if (valueIndex != lastIndex) {
+      values[valueIndex] = std::move(values[lastIndex]);
+      valueSlots[valueIndex] = valueSlots[lastIndex];
+      slots[valueSlots[valueIndex]].next = valueIndex;
+    }
+    values.pop_back();
+    valueSlots.pop_back();
+
+    ++slot.generation;
+    slot.next = freeHead;
+    freeHead = slotIndex;
+    return true;
+  }
+
+  [[nodiscard]] auto contains(HandleType handle) const -> bool {
+    const auto slotIndex = indexOf(handle);
+    return slotIndex < slots.size() && slots[slotIndex].generation == generationOf(handle);
+  }
+
+  /// Null if the handle is stale.
+  [[nodiscard]] auto find(HandleType handle) -> T* {
+    return contains(handle) ? &values[slots[indexOf(handle)].next] : nullptr;
+  }
+
+  [[nodiscard]] auto find(HandleType handle) const -> const T* {
+    return contains(handle) ? &values[slots[indexOf(handle)].next] : nullptr;
+  }
+
+  [[nodiscard]] auto at(HandleType handle) -> T& {
+    assert(contains(handle) && "Stale or invalid SlotMap handle");
+    return values[slots[indexOf(handle)].next];
+  }
+
+  [[nodiscard]] auto at(HandleType handle) const -> const T& {
+    assert(contains(handle) && "Stale or invalid SlotMap handle");
+    return values[slots[indexOf(handle)].next];
+  }
+
+  auto clear() -> void {
+    for (const auto slotIndex : valueSlots) {
+      auto& slot = slots[slotIndex];
+      ++slot.generation;
+      slot.next = freeHead;
+      freeHead = slotIndex;
+    }
+    values.clear();
+    valueSlots.clear();
+  }
+
+  [[nodiscard]] auto size() const -> size_t {
+    return values.size();
+  }
+
+  [[nodiscard]] auto empty() const -> bool {
+    return values.empty();
+  }
+
+  [[nodiscard]] auto begin() {
+    return values.begin();
+  }
+  [[nodiscard]] auto end() {
+    return values.end();
+  }
+  [[nodiscard]] auto begin() const {
+    return values.begin();
+  }
+  [[nodiscard]] auto end() const {
+    return values.end();
+  }
+
+private:
+  static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+  struct Slot {
+    uint32_t generation{};
+    /// Index into `values` while occupied, next free slot otherwise.
+    uint32_t next{};
+  };
+
+  std::vector<Slot> slots;
+  std::vector<T> values;
+  std::vector<uint32_t> valueSlots;
+  uint32_t freeHead{NoSlot};
+
+  static auto makeHandle(uint32_t slotIndex, uint32_t generation) -> HandleType {
+    return HandleType{.id = (static_cast<size_t>(generation) << 32) | slotIndex};
+  }
+
+  static auto indexOf(HandleType handle) -> uint32_t {
+    return static_cast<uint32_t>(handle.id & 0xFFFFFFFF);
+  }
+
+  static auto generationOf(HandleType handle) -> uint32_t {
+    return static_cast<uint32_t>(handle.id >> 32);
+  }
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+namespace tr {
+
+/// Collects how long each tick or frame took and writes them out as CSV when destroyed, so two
+/// runs over the same replayed input can be lined up row by row and diffed. Rows are kept in
+/// memory until then so logging doesn't put file I/O into the loop being measured.
+///
+/// Columns are `<indexName>,start_ms,duration_ms`, with start times relative to the first row.
+class TimingLog {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  TimingLog(std::filesystem::path newPath, std::string newIndexName);
+  ~TimingLog();
+
+  TimingLog(const TimingLog&) = delete;
+  TimingLog(TimingLog&&) = delete;
+  auto operator=(const TimingLog&) -> TimingLog& = delete;
+  auto operator=(TimingLog&&) -> TimingLog& = delete;
+
+  /// Not thread safe, each loop being timed should have its own log.
+  auto record(uint64_t index, Clock::time_point start, Clock::time_point end) -> void;
+
+private:
+  struct Row {
+    uint64_t index;
+    Clock::time_point start;
+    Clock::duration duration;
+  };
+
+  static constexpr size_t InitialRows = 1 << 16;
+
+  std::filesystem::path path;
+  std::string indexName;
+  std::vector<Row> rows;
+
+  auto write() const -> void;
+};
+
+}
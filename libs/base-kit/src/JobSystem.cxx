@@ -0,0 +1,224 @@
+#include "bk/JobSystem.hpp"
+#include "bk/ThreadName.hpp"
+
+namespace tr {
+
+namespace {
+
+thread_local const JobSystem* currentSystem = nullptr;
+thread_local size_t currentWorker = 0;
+
+auto runJob(Job& job) -> void {
+  ZoneScopedN("Job");
+  try {
+    job();
+  } catch (const std::exception& ex) { Log.error("Job threw an exception: {}", ex.what()); }
+}
+
+}
+
+JobSystem::JobSystem(const JobSystemConfig& config) {
+  auto workerCount = config.workerCount;
+  if (workerCount == 0) {
+    const auto hardwareThreads = static_cast<size_t>(std::thread::hardware_concurrency());
+    workerCount =
+        hardwareThreads > config.reservedThreads ? hardwareThreads - config.reservedThreads : 1;
+  }
+
+  queues.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    queues.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  workers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    workers.emplace_back([this, i](const std::stop_token& token) { workerLoop(i, token); });
+  }
+  Log.trace("Created JobSystem with {} workers", workerCount);
+}
+
+/// Workers have to be joined before the queues and the sleep condition they use go away.
+JobSystem::~JobSystem() {
+  for (auto& worker : workers) {
+    worker.request_stop();
+  }
+  workers.clear();
+}
+
+auto JobSystem::submit(Job job, JobPriority priority) -> void {
+  auto index = currentWorkerIndex();
+  if (index == NoWorker) {
+    index = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+  }
+  push(index, std::move(job), priority);
+}
+
+auto JobSystem::submit(JobGroup& group, Job job, JobPriority priority) -> void {
+  group.pending.fetch_add(1, std::memory_order_relaxed);
+  submit(
+      [this, &group, job = std::move(job)]() mutable {
+        runJob(job);
+        finish(group);
+      },
+      priority);
+}
+
+auto JobSystem::then(JobGroup& group, Job continuation, JobPriority priority) -> void {
+  {
+    std::lock_guard lock(group.mutex);
+    if (group.pending.load(std::memory_order_acquire) != 0) {
+      group.continuations.emplace_back(std::move(continuation), priority);
+      return;
+    }
+  }
+  submit(std::move(continuation), priority);
+}
+
+auto JobSystem::wait(JobGroup& group) -> void {
+  ZoneScopedN("JobSystem::wait");
+  const auto index = currentWorkerIndex();
+  while (group.pending.load(std::memory_order_acquire) != 0) {
+    if (tryRunOne(index, JobPriority::Low)) {
+      continue;
+    }
+    // Nothing to help with, the group's jobs are running elsewhere. Sleep like an idle worker
+    // until one finishes the group or something new is queued.
+    std::unique_lock lock(sleepMutex);
+    sleepingWorkers.fetch_add(1);
+    sleepCondition.wait(lock, [&]() {
+      return group.pending.load(std::memory_order_acquire) == 0 || queuedJobs.load() > 0;
+    });
+    sleepingWorkers.fetch_sub(1);
+  }
+  // The job that finished the group may still be holding its lock.
+  std::lock_guard lock(group.mutex);
+}
+
+auto JobSystem::processCompleteTasks() -> void {
+  auto completed = std::vector<Job>{};
+  {
+    std::lock_guard lock(completeMutex);
+    completed.swap(completeQueue);
+  }
+  for (auto& task : completed) {
+    task();
+  }
+}
+
+auto JobSystem::workerLoop(size_t index, const std::stop_token& token) -> void {
+  setCurrentThreadName("JobWorker" + std::to_string(index));
+  currentSystem = this;
+  currentWorker = index;
+
+  while (true) {
+    if (tryRunOne(index, JobPriority::Low)) {
+      continue;
+    }
+    if (token.stop_requested()) {
+      return;
+    }
+    std::unique_lock lock(sleepMutex);
+    sleepingWorkers.fetch_add(1);
+    sleepCondition.wait(lock, token, [this]() { return queuedJobs.load() > 0; });
+    sleepingWorkers.fetch_sub(1);
+  }
+}
+
+auto JobSystem::push(size_t queueIndex, Job job, JobPriority priority) -> void {
+  {
+    auto& queue = *queues[queueIndex];
+    std::lock_guard lock(queue.mutex);
+    queue.lanes[static_cast<size_t>(priority)].push_back(std::move(job));
+    queuedJobs.fetch_add(1);
+  }
+  // Taking the lock means a worker that saw no jobs is already waiting and will get the notify.
+  if (sleepingWorkers.load() > 0) {
+    { std::lock_guard lock(sleepMutex); }
+    sleepCondition.notify_one();
+  }
+}
+
+/// Owners take their newest job first since its data is most likely still in cache.
+auto JobSystem::tryPop(size_t queueIndex, JobPriority lowestPriority) -> std::optional<Job> {
+  auto& queue = *queues[queueIndex];
+  std::lock_guard lock(queue.mutex);
+  for (size_t lane = 0; lane <= static_cast<size_t>(lowestPriority); ++lane) {
+    auto& jobs = queue.lanes[lane];
+    if (!jobs.empty()) {
+      auto job = std::move(jobs.back());
+      jobs.pop_back();
+      queuedJobs.fetch_sub(1);
+      return job;
+    }
+  }
+  return std::nullopt;
+}
+
+auto JobSystem::trySteal(size_t thief, JobPriority lowestPriority) -> std::optional<Job> {
+  const auto queueCount = queues.size();
+  const auto start = thief == NoWorker ? 0 : thief + 1;
+  for (size_t lane = 0; lane <= static_cast<size_t>(lowestPriority); ++lane) {
+    for (size_t offset = 0; offset < queueCount; ++offset) {
+      const auto victim = (start + offset) % queueCount;
+      if (victim == thief) {
+        continue;
+      }
+      auto& queue = *queues[victim];
+      std::lock_guard lock(queue.mutex);
+      auto& jobs = queue.lanes[lane];
+      if (!jobs.empty()) {
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+        queuedJobs.fetch_sub(1);
+        return job;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+auto JobSystem::tryRunOne(size_t index, JobPriority lowestPriority) -> bool {
+  auto job = index == NoWorker ? std::nullopt : tryPop(index, lowestPriority);
+  if (!job) {
+    job = trySteal(index, lowestPriority);
+  }
+  if (!job) {
+    return false;
+  }
+  runJob(*job);
+  return true;
+}
+
+/// The group's lock is held across the decrement so a waiter can't destroy the group out from
+/// under us, and nothing touches the group after it's released.
+auto JobSystem::finish(JobGroup& group) -> void {
+  auto ready = std::vector<std::pair<Job, JobPriority>>{};
+  auto drained = false;
+  {
+    std::lock_guard lock(group.mutex);
+    if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      ready.swap(group.continuations);
+      drained = true;
+    }
+  }
+  // Wake anyone sleeping in wait(). Taking the lock means a waiter that saw the group pending is
+  // already waiting and will get the notify.
+  if (drained && sleepingWorkers.load() > 0) {
+    { std::lock_guard lock(sleepMutex); }
+    sleepCondition.notify_all();
+  }
+  for (auto& [job, priority] : ready) {
+    submit(std::move(job), priority);
+  }
+}
+
+auto JobSystem::enqueueOnCallerThread(Job job) -> void {
+  std::lock_guard lock(completeMutex);
+  completeQueue.push_back(std::move(job));
+}
+
+auto JobSystem::currentWorkerIndex() const -> size_t {
+  return currentSystem == this ? currentWorker : NoWorker;
+}
+
+}
@@ -0,0 +1,46 @@
+#include "bk/TimingLog.hpp"
+
+namespace tr {
+
+TimingLog::TimingLog(std::filesystem::path newPath, std::string newIndexName)
+    : path{std::move(newPath)}, indexName{std::move(newIndexName)} {
+  rows.reserve(InitialRows);
+}
+
+TimingLog::~TimingLog() {
+  try {
+    write();
+  } catch (const std::exception& ex) {
+    Log.warn("Failed to write timings to {}: {}", path.string(), ex.what());
+  }
+}
+
+auto TimingLog::record(uint64_t index, Clock::time_point start, Clock::time_point end) -> void {
+  rows.push_back(Row{.index = index, .start = start, .duration = end - start});
+}
+
+auto TimingLog::write() const -> void {
+  if (rows.empty()) {
+    return;
+  }
+  if (path.has_parent_path() && !exists(path.parent_path())) {
+    create_directories(path.parent_path());
+  }
+  auto os = std::ofstream(path);
+  if (!os) {
+    Log.warn("Failed to open {} for writing timings", path.string());
+    return;
+  }
+
+  using Millis = std::chrono::duration<double, std::milli>;
+  const auto origin = rows.front().start;
+  os << indexName << ",start_ms,duration_ms\n";
+  os << std::fixed << std::setprecision(4);
+  for (const auto& row : rows) {
+    os << row.index << ',' << Millis(row.start - origin).count() << ','
+       << Millis(row.duration).count() << '\n';
+  }
+  Log.info("Wrote {} timings to {}", rows.size(), path.string());
+}
+
+}
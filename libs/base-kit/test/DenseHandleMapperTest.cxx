@@ -0,0 +1,74 @@
+#include "bk/DenseHandleMapper.hpp"
+
+namespace {
+
+struct PublicTag {};
+struct InternalTag {};
+
+using Mapper = tr::DenseHandleMapper<PublicTag, InternalTag>;
+using InternalHandle = tr::Handle<InternalTag>;
+
+struct Item {
+  tr::Handle<PublicTag> handle;
+};
+
+}
+
+TEST_CASE("DenseHandleMapper maps each internal handle once", "[DenseHandleMapper]") {
+  Mapper mapper;
+  const auto a = mapper.toPublic(InternalHandle{.id = 10});
+  const auto b = mapper.toPublic(InternalHandle{.id = 20});
+
+  CHECK(a != b);
+  CHECK(mapper.toPublic(InternalHandle{.id = 10}) == a);
+  CHECK(mapper.size() == 2);
+  CHECK(mapper.toInternal(a) == InternalHandle{.id = 10});
+  CHECK(mapper.toInternal(b) == InternalHandle{.id = 20});
+  CHECK_FALSE(mapper.toInternal(tr::Handle<PublicTag>{}).has_value());
+}
+
+TEST_CASE("DenseHandleMapper spans pages", "[DenseHandleMapper]") {
+  Mapper mapper;
+  const auto count = (Mapper::PageSize * 2) + 1;
+  auto handles = std::vector<tr::Handle<PublicTag>>{};
+  for (size_t i = 0; i < count; ++i) {
+    handles.push_back(mapper.toPublic(InternalHandle{.id = i + 1}));
+  }
+  for (size_t i = 0; i < count; ++i) {
+    REQUIRE(mapper.toInternal(handles[i]) == InternalHandle{.id = i + 1});
+  }
+}
+
+TEST_CASE("DenseHandleMapper reports erased handles as stale", "[DenseHandleMapper]") {
+  Mapper mapper;
+  const auto first = mapper.toPublic(InternalHandle{.id = 1});
+  REQUIRE(mapper.erase(first));
+  CHECK_FALSE(mapper.erase(first));
+
+  // Reuses the entry with a new generation.
+  const auto second = mapper.toPublic(InternalHandle{.id = 2});
+  CHECK(first != second);
+  CHECK_FALSE(mapper.toInternal(first).has_value());
+  CHECK(mapper.toInternal(second) == InternalHandle{.id = 2});
+  CHECK(mapper.toPublic(InternalHandle{.id = 1}) != first);
+}
+
+TEST_CASE("DenseHandleMapper translates a batch", "[DenseHandleMapper]") {
+  Mapper mapper;
+  auto items = std::vector<Item>{};
+  for (size_t i = 0; i < 5; ++i) {
+    items.push_back(Item{.handle = mapper.toPublic(InternalHandle{.id = i * 3})});
+  }
+
+  auto out = std::vector<InternalHandle>{};
+  CHECK(mapper.toInternal(std::span<const Item>{items}, &Item::handle, out));
+  REQUIRE(out.size() == items.size());
+  for (size_t i = 0; i < out.size(); ++i) {
+    CHECK(out[i] == InternalHandle{.id = i * 3});
+  }
+
+  mapper.erase(items[2].handle);
+  CHECK_FALSE(mapper.toInternal(std::span<const Item>{items}, &Item::handle, out));
+  CHECK(out[2] == InternalHandle{});
+  CHECK(out[3] == InternalHandle{.id = 9});
+}
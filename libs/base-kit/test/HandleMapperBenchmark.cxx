@@ -0,0 +1,71 @@
+#include "bk/DenseHandleMapper.hpp"
+#include "bk/HandleMapper.hpp"
+
+namespace {
+
+struct PublicTag {};
+struct InternalTag {};
+
+constexpr size_t HandleCount = 100'000;
+
+struct Item {
+  tr::Handle<PublicTag> handle;
+};
+
+/// Internal ids are spread out like the packed ids the SlotMap backed registries hand out.
+auto internalHandle(size_t i) -> tr::Handle<InternalTag> {
+  return tr::Handle<InternalTag>{.id = (size_t{1} << 32) | (i * 7)};
+}
+
+template <typename Mapper>
+auto mapAll(Mapper& mapper) -> std::vector<Item> {
+  auto items = std::vector<Item>{};
+  items.reserve(HandleCount);
+  for (size_t i = 0; i < HandleCount; ++i) {
+    items.push_back(Item{.handle = mapper.toPublic(internalHandle(i))});
+  }
+  // Objects don't reference geometry in the order it was loaded.
+  std::ranges::shuffle(items, std::mt19937{42});
+  return items;
+}
+
+}
+
+TEST_CASE("HandleMapper translation at 100k handles", "[.][benchmark][HandleMapper]") {
+  tr::HandleMapper<PublicTag, InternalTag> mapMapper;
+  tr::DenseHandleMapper<PublicTag, InternalTag> denseMapper;
+  const auto mapItems = mapAll(mapMapper);
+  const auto denseItems = mapAll(denseMapper);
+
+  BENCHMARK("map based toPublic, 100k new handles") {
+    tr::HandleMapper<PublicTag, InternalTag> mapper;
+    return mapAll(mapper).size();
+  };
+
+  BENCHMARK("dense toPublic, 100k new handles") {
+    tr::DenseHandleMapper<PublicTag, InternalTag> mapper;
+    return mapAll(mapper).size();
+  };
+
+  BENCHMARK("map based toInternal, 100k handles") {
+    size_t sum = 0;
+    for (const auto& item : mapItems) {
+      sum += mapMapper.toInternal(item.handle)->id;
+    }
+    return sum;
+  };
+
+  BENCHMARK("dense toInternal, 100k handles") {
+    size_t sum = 0;
+    for (const auto& item : denseItems) {
+      sum += denseMapper.toInternal(item.handle)->id;
+    }
+    return sum;
+  };
+
+  auto out = std::vector<tr::Handle<InternalTag>>{};
+  BENCHMARK("dense batch toInternal, 100k handles") {
+    denseMapper.toInternal(std::span<const Item>{denseItems}, &Item::handle, out);
+    return out.back().id;
+  };
+}
@@ -0,0 +1,50 @@
+#include "bk/JobSystem.hpp"
+
+namespace {
+
+auto workerCounts() -> std::vector<size_t> {
+  const auto hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  auto counts = std::vector<size_t>{};
+  for (size_t count = 1; count < hardwareThreads; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(hardwareThreads);
+  return counts;
+}
+
+}
+
+TEST_CASE("JobSystem submit to completion latency", "[.][benchmark][JobSystem]") {
+  tr::JobSystem jobSystem{};
+
+  BENCHMARK("round trip of one empty job") {
+    tr::JobGroup group;
+    jobSystem.submit(group, []() {});
+    jobSystem.wait(group);
+  };
+
+  BENCHMARK("1000 empty jobs") {
+    tr::JobGroup group;
+    for (size_t i = 0; i < 1000; ++i) {
+      jobSystem.submit(group, []() {});
+    }
+    jobSystem.wait(group);
+  };
+}
+
+TEST_CASE("JobSystem parallelFor scaling", "[.][benchmark][JobSystem]") {
+  constexpr size_t Count = 1'000'000;
+  auto values = std::vector<float>(Count, 2.f);
+
+  for (const auto workerCount : workerCounts()) {
+    tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = workerCount}};
+    BENCHMARK("parallelFor over 1M floats, " + std::to_string(workerCount) + " workers") {
+      jobSystem.parallelFor(Count, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          values[i] = std::sqrt(values[i] * values[i] + 1.f);
+        }
+      });
+      return values[0];
+    };
+  }
+}
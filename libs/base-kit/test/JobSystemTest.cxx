@@ -0,0 +1,166 @@
+#include "bk/JobSystem.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+/// Spins until `done` returns true, failing the test rather than hanging it.
+template <typename F>
+auto waitFor(F&& done) -> bool {
+  const auto deadline = steady_clock::now() + seconds(10);
+  while (!done()) {
+    if (steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}
+
+TEST_CASE("JobSystem parallelFor visits every index once", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 4}};
+  constexpr size_t Count = 100'000;
+  auto visits = std::vector<uint8_t>(Count);
+
+  jobSystem.parallelFor(Count, 64, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      ++visits[i];
+    }
+  });
+
+  CHECK(std::ranges::all_of(visits, [](uint8_t v) { return v == 1; }));
+}
+
+TEST_CASE("JobSystem parallelFor can be nested inside a job", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 2}};
+  std::atomic<size_t> total = 0;
+
+  tr::JobGroup group;
+  for (size_t i = 0; i < 4; ++i) {
+    jobSystem.submit(group, [&]() {
+      jobSystem.parallelFor(1000, 10, [&](size_t begin, size_t end) { total += end - begin; });
+    });
+  }
+  jobSystem.wait(group);
+
+  CHECK(total == 4000);
+}
+
+TEST_CASE("JobSystem runs continuations after the group drains", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 4}};
+  std::atomic<size_t> finished = 0;
+  std::atomic<size_t> seenByContinuation = 0;
+  std::atomic<bool> continued = false;
+
+  tr::JobGroup group;
+  for (size_t i = 0; i < 64; ++i) {
+    jobSystem.submit(group, [&]() { ++finished; });
+  }
+  jobSystem.then(group, [&]() {
+    seenByContinuation = finished.load();
+    continued = true;
+  });
+
+  REQUIRE(waitFor([&]() { return continued.load(); }));
+  CHECK(seenByContinuation == 64);
+  jobSystem.wait(group);
+}
+
+TEST_CASE("JobSystem completes enqueued tasks on the caller thread", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 2}};
+  auto workerThread = std::thread::id{};
+  auto completeThread = std::thread::id{};
+  auto result = 0;
+
+  jobSystem.enqueue(
+      [&]() {
+        workerThread = std::this_thread::get_id();
+        return 42;
+      },
+      [&](int value) {
+        completeThread = std::this_thread::get_id();
+        result = value;
+      });
+
+  REQUIRE(waitFor([&]() {
+    jobSystem.processCompleteTasks();
+    return result != 0;
+  }));
+  CHECK(result == 42);
+  CHECK(completeThread == std::this_thread::get_id());
+  CHECK(workerThread != std::this_thread::get_id());
+}
+
+TEST_CASE("JobSystem runs higher priority lanes first", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 1}};
+  std::atomic<bool> started = false;
+  std::atomic<bool> release = false;
+  std::mutex orderMutex;
+  auto order = std::vector<tr::JobPriority>{};
+
+  // Hold the only worker so everything below queues up behind it.
+  jobSystem.submit([&]() {
+    started = true;
+    waitFor([&]() { return release.load(); });
+  });
+  REQUIRE(waitFor([&]() { return started.load(); }));
+
+  for (auto priority : {tr::JobPriority::Low, tr::JobPriority::Normal, tr::JobPriority::High}) {
+    jobSystem.submit(
+        [&, priority]() {
+          std::lock_guard lock(orderMutex);
+          order.push_back(priority);
+        },
+        priority);
+  }
+  release = true;
+
+  // Waiting on a group here would let this thread help with the High job and race the worker.
+  REQUIRE(waitFor([&]() {
+    std::lock_guard lock(orderMutex);
+    return order.size() == 3;
+  }));
+  const auto expected =
+      std::vector{tr::JobPriority::High, tr::JobPriority::Normal, tr::JobPriority::Low};
+  CHECK(order == expected);
+}
+
+TEST_CASE("JobSystem wait helps with jobs in any lane", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 1}};
+  std::atomic<bool> started = false;
+  std::atomic<bool> release = false;
+
+  // Hold the only worker, so the group's job only runs if the waiting thread picks it up.
+  jobSystem.submit([&]() {
+    started = true;
+    waitFor([&]() { return release.load(); });
+  });
+  REQUIRE(waitFor([&]() { return started.load(); }));
+
+  auto ranOn = std::thread::id{};
+  tr::JobGroup group;
+  jobSystem.submit(group, [&]() { ranOn = std::this_thread::get_id(); }, tr::JobPriority::Low);
+  jobSystem.wait(group);
+  release = true;
+
+  CHECK(ranOn == std::this_thread::get_id());
+}
+
+TEST_CASE("JobSystem wait sleeps until a worker finishes the group", "[JobSystem]") {
+  tr::JobSystem jobSystem{tr::JobSystemConfig{.workerCount = 1}};
+  std::atomic<bool> started = false;
+  std::atomic<bool> finished = false;
+
+  tr::JobGroup group;
+  jobSystem.submit(group, [&]() {
+    started = true;
+    std::this_thread::sleep_for(milliseconds(20));
+    finished = true;
+  });
+  REQUIRE(waitFor([&]() { return started.load(); }));
+  jobSystem.wait(group);
+
+  CHECK(finished);
+}
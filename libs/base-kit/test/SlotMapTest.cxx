@@ -0,0 +1,55 @@
+#include "bk/SlotMap.hpp"
+
+namespace {
+
+struct Tag {};
+
+}
+
+TEST_CASE("SlotMap stores and retrieves values", "[SlotMap]") {
+  tr::SlotMap<std::string, Tag> map;
+  const auto a = map.insert("a");
+  const auto b = map.emplace(3, 'b');
+
+  CHECK(map.size() == 2);
+  CHECK(map.at(a) == "a");
+  CHECK(map.at(b) == "bbb");
+  CHECK(a != b);
+  CHECK_FALSE(map.contains(tr::Handle<Tag>{}));
+}
+
+TEST_CASE("SlotMap detects stale handles", "[SlotMap]") {
+  tr::SlotMap<int, Tag> map;
+  const auto first = map.insert(1);
+  REQUIRE(map.erase(first));
+
+  // The slot is reused, but with a new generation.
+  const auto second = map.insert(2);
+  CHECK(first != second);
+  CHECK_FALSE(map.contains(first));
+  CHECK(map.find(first) == nullptr);
+  CHECK_FALSE(map.erase(first));
+  CHECK(map.at(second) == 2);
+}
+
+TEST_CASE("SlotMap keeps values dense across erases", "[SlotMap]") {
+  tr::SlotMap<int, Tag> map;
+  auto handles = std::vector<tr::Handle<Tag>>{};
+  for (int i = 0; i < 8; ++i) {
+    handles.push_back(map.insert(i));
+  }
+
+  map.erase(handles[0]);
+  map.erase(handles[5]);
+
+  CHECK(map.size() == 6);
+  CHECK(std::ranges::distance(map.begin(), map.end()) == 6);
+  for (const auto i : {1, 2, 3, 4, 6, 7}) {
+    CHECK(map.at(handles[i]) == i);
+  }
+
+  map.clear();
+  CHECK(map.empty());
+  CHECK_FALSE(map.contains(handles[1]));
+  CHECK(map.at(map.insert(42)) == 42);
+}
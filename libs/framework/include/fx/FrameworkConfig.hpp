@@ -7,6 +7,17 @@ class IGuiAdapter;
 struct FrameworkConfig {
   glm::ivec2 initialWindowSize;
   std::string windowTitle;
+  /// Run with no window or GPU, see GraphicsContext::createHeadless
+  bool headless{};
+  /// Record input to this file while running, so the run can be replayed later
+  std::optional<std::filesystem::path> recordInputPath;
+  /// Play input back from a recording rather than taking it from the window
+  std::optional<std::filesystem::path> replayInputPath;
+  /// Write per tick and per frame timings as ticks.csv and frames.csv into this directory
+  std::optional<std::filesystem::path> timingsDirectory;
+  /// Close once this many frames have rendered, so a headless run that isn't replaying input,
+  /// like one on a build server, still ends on its own
+  std::optional<uint64_t> frameLimit;
 };
 
 }
@@ -10,9 +10,9 @@ public:
   GuiCallBackRegistrar() = default;
   ~GuiCallBackRegistrar() override = default;
 
-  GuiCallBackRegistrar(const GuiCallBackRegistrar&) = default;
+  GuiCallBackRegistrar(const GuiCallBackRegistrar&) = delete;
   GuiCallBackRegistrar(GuiCallBackRegistrar&&) = delete;
-  auto operator=(const GuiCallBackRegistrar&) -> GuiCallBackRegistrar& = default;
+  auto operator=(const GuiCallBackRegistrar&) -> GuiCallBackRegistrar& = delete;
   auto operator=(GuiCallBackRegistrar&&) -> GuiCallBackRegistrar& = delete;
 
   auto setRenderCallback(RenderFnType newRenderFn) -> void override;
@@ -21,9 +21,13 @@ public:
   auto setReadyCallback(std::function<void(void)> newReadyFn) -> void override;
   auto ready() -> void override;
 
+  auto setVisible(bool newVisible) -> void override;
+  [[nodiscard]] auto isVisible() const -> bool override;
+
 private:
   RenderFnType renderFn;
   std::function<void(void)> readyCallback;
+  std::atomic<bool> visible{true};
 };
 
 }
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "api/fx/IEventQueue.hpp"
+
+namespace tr {
+
+/// Event queue where each subscribing thread owns an inbox, and emitting pushes straight into the
+/// inboxes of the threads subscribed to that event type and channel.
+///
+/// Inboxes are intrusive MPSC queues, so emitting from any number of threads never takes a lock,
+/// and `dispatchPending` only ever touches the calling thread's own inbox. The routes from
+/// (type, channel) to inboxes are an immutable table that's swapped out whenever someone
+/// subscribes, and payloads and queue nodes come from a shared pool.
+///
+/// A thread with nothing else to do can block in `waitForEvents` until something lands in its
+/// inbox, rather than polling.
+///
+/// Every subscribed thread gets its own delivery of an event. Events emitted before anything has
+/// subscribed to them are held until something does, then handed to that first subscriber.
+class InboxEventQueue : public IEventQueue {
+public:
+  InboxEventQueue();
+  ~InboxEventQueue() override;
+
+  InboxEventQueue(const InboxEventQueue&) = delete;
+  InboxEventQueue(InboxEventQueue&&) = delete;
+  auto operator=(const InboxEventQueue&) -> InboxEventQueue& = delete;
+  auto operator=(InboxEventQueue&&) -> InboxEventQueue& = delete;
+
+  auto internChannel(std::string_view name) -> ChannelId override;
+  auto getPayloadResource() -> std::pmr::memory_resource* override;
+
+  void emitErased(EventTypeId type, std::shared_ptr<void> payload, ChannelId channel) override;
+
+  void subscribeErased(EventTypeId type,
+                       std::function<void(const std::shared_ptr<void>&)> listener,
+                       ChannelId channel) override;
+
+  void dispatchPending() override;
+  void waitForEvents(std::stop_token token) override;
+
+private:
+  using RouteKey = uint64_t;
+
+  struct Node {
+    std::atomic<Node*> next;
+    RouteKey route{};
+    std::shared_ptr<void> payload;
+  };
+
+  /// Vyukov style intrusive queue. Any thread may push, only the owning thread pops.
+  struct alignas(64) Inbox {
+    explicit Inbox(Node* stub);
+
+    std::atomic<Node*> head;
+    alignas(64) Node* tail;
+    std::thread::id owner;
+    std::unordered_map<RouteKey, std::vector<std::function<void(const std::shared_ptr<void>&)>>>
+        listeners;
+
+    /// Set while the owner is blocked in waitForEvents, so pushes only touch the mutex then
+    std::atomic<bool> sleeping{false};
+    std::mutex wakeMutex;
+    std::condition_variable_any wakeCondition;
+
+    auto push(Node* node) -> void;
+    auto pop() -> Node*;
+    [[nodiscard]] auto hasPending() const -> bool;
+  };
+
+  using RouteTable = std::unordered_map<RouteKey, std::vector<Inbox*>>;
+
+  /// Distinguishes this queue in the calling thread's inbox cache
+  uint64_t instanceId;
+  std::pmr::synchronized_pool_resource pool;
+
+  /// Tables are never freed before the queue is, so emitters can read one without pinning it.
+  std::atomic<const RouteTable*> routes;
+
+  /// Guards everything below. Only taken when subscribing, interning a new channel, or emitting
+  /// an event nothing has subscribed to yet.
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Inbox>> inboxes;
+  std::vector<std::unique_ptr<const RouteTable>> routeTables;
+  std::unordered_map<std::string, ChannelId> channels;
+  std::vector<std::pair<RouteKey, std::shared_ptr<void>>> unrouted;
+
+  static auto makeRoute(EventTypeId type, ChannelId channel) -> RouteKey;
+
+  auto newNode(RouteKey route, std::shared_ptr<void> payload) -> Node*;
+  auto deleteNode(Node* node) -> void;
+  auto deliver(const std::vector<Inbox*>& targets, RouteKey route, std::shared_ptr<void> payload)
+      -> void;
+  auto currentInbox() -> Inbox*;
+  auto getOrCreateInbox() -> Inbox&;
+};
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "api/fx/IStateBuffer.hpp"
+
+namespace tr {
+
+/// Single producer state buffer that never copies SimStates on the read side and never takes a
+/// lock. The producer either copies each pushed state into one of a fixed set of slots, or with
+/// writeState builds it directly in the slot. Either way the slot's vector capacity is reused so
+/// steady state ticks don't allocate. Readers pin the two slots that bracket the requested time
+/// and get a StateReadView pointing straight at them. Pinned slots are skipped by the producer
+/// until the view is released.
+///
+/// Each slot carries a sequence number that is odd while the slot is being written, and a pin word
+/// that is either a count of readers or the WriterBit. A reader only trusts a slot if it managed to
+/// pin it and the sequence it scanned is still current afterwards, so it can never observe a
+/// partially written state.
+///
+/// Readers waiting for a new state block on a condition the producer only signals when someone is
+/// actually waiting, so publishing stays lock free in the common case.
+class LockFreeStateBuffer : public IStateBuffer {
+public:
+  static constexpr size_t SlotCount = 9;
+
+  explicit LockFreeStateBuffer(size_t initialCapacity = 0);
+  ~LockFreeStateBuffer() override = default;
+
+  LockFreeStateBuffer(const LockFreeStateBuffer&) = delete;
+  LockFreeStateBuffer(LockFreeStateBuffer&&) = delete;
+  auto operator=(const LockFreeStateBuffer&) -> LockFreeStateBuffer& = delete;
+  auto operator=(LockFreeStateBuffer&&) -> LockFreeStateBuffer& = delete;
+
+  auto getStates(Timestamp t) -> std::optional<std::pair<SimState, SimState>> override;
+  auto readStates(Timestamp t) -> std::optional<StateReadView> override;
+  auto pushState(const SimState& newState, Timestamp t) -> void override;
+  auto writeState(Timestamp t, const std::function<void(SimState&)>& writer) -> void override;
+  [[nodiscard]] auto getPublishedState() const -> PublishedState override;
+  auto waitForPublish(uint64_t seenCount, Timestamp deadline) -> PublishedState override;
+
+private:
+  static constexpr uint32_t WriterBit = 1U << 31U;
+  static constexpr int MaxReadAttempts = 8;
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> sequence = 0;
+    std::atomic<uint32_t> pins = 0;
+    std::atomic<Timestamp::rep> timestamp = 0;
+    SimState state;
+  };
+
+  std::array<Slot, SlotCount> slots;
+  size_t writeCursor = 0;
+
+  std::atomic<uint64_t> publishedCount = 0;
+  std::atomic<Timestamp::rep> latestTimestamp = 0;
+  std::atomic<uint32_t> publishWaiters = 0;
+  std::mutex publishMutex;
+  std::condition_variable publishCondition;
+
+  auto acquireWriteSlot() -> Slot&;
+  auto tryPin(size_t index, uint64_t expectedSequence) -> bool;
+  auto unpin(size_t index) -> void;
+
+  static auto copyInto(SimState& dst, const SimState& src) -> void;
+};
+
+}
@@ -8,12 +8,13 @@ namespace tr {
 class GameWorldContext;
 class GraphicsContext;
 class IEventQueue;
-class IActionSystem;
+class ActionSystem;
 class IStateBuffer;
 class IApplication;
 class IWindow;
 class IAssetService;
 class EditorStateBuffer;
+class JobSystem;
 
 class ThreadedFrameworkContext {
 public:
@@ -24,12 +25,13 @@ public:
 
   ThreadedFrameworkContext(const FrameworkConfig& config,
                            std::shared_ptr<IEventQueue> newEventQueue,
-                           std::shared_ptr<IActionSystem> newActionSystem,
+                           std::shared_ptr<ActionSystem> newActionSystem,
                            std::shared_ptr<IStateBuffer> newStateBuffer,
                            std::shared_ptr<IWindow> newWindow,
                            std::shared_ptr<IAssetService> newAssetService,
                            std::shared_ptr<IGuiCallbackRegistrar> newGuiCallbackRegistrar,
-                           std::shared_ptr<EditorStateBuffer> newEditorStateBuffer);
+                           std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                           std::shared_ptr<JobSystem> newJobSystem);
 
   ~ThreadedFrameworkContext();
 
@@ -47,14 +49,19 @@ public:
   auto getEventQueue() -> std::shared_ptr<IEventQueue>;
 
 private:
+  bool headless;
+  std::optional<std::filesystem::path> recordInputPath;
+  std::optional<std::filesystem::path> timingsDirectory;
+  std::optional<uint64_t> frameLimit;
   std::shared_ptr<IGuiAdapter> guiAdapter;
   std::shared_ptr<IEventQueue> eventQueue;
-  std::shared_ptr<IActionSystem> actionSystem;
+  std::shared_ptr<ActionSystem> actionSystem;
   std::shared_ptr<IStateBuffer> stateBuffer;
   std::shared_ptr<IWindow> window;
   std::shared_ptr<IAssetService> assetService;
   std::shared_ptr<IGuiCallbackRegistrar> guiCallbackRegistrar;
   std::shared_ptr<EditorStateBuffer> editorStateBuffer;
+  std::shared_ptr<JobSystem> jobSystem;
 
   std::shared_ptr<GameWorldContext> gameWorldContext;
   std::shared_ptr<GraphicsContext> graphicsContext;
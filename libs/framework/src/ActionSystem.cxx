@@ -9,55 +9,9 @@ ActionSystem::ActionSystem(std::shared_ptr<IEventQueue> newEventQueue)
 
   Log.debug("Creating ActionSystem");
 
-  eventQueue->subscribe<MouseCaptured>([&](const auto& event) {
-    if (event->isMouseCaptured) {
-      firstMouse = true;
-    }
-  });
-
-  eventQueue->subscribe<KeyEvent>([&](const auto& event) {
-    const auto sourceIt = keyActionMap.find(event->key);
-    if (sourceIt == keyActionMap.end()) {
-      return;
-    }
-
-    const auto& [actionType, stateType, value] = sourceIt->second;
-
-    if (event->buttonState == ButtonState::Pressed) {
-      eventQueue->emit(Action{.actionType = actionType, .stateType = stateType, .value = true});
-    } else if (event->buttonState == ButtonState::Released) {
-      eventQueue->emit(Action{.actionType = actionType, .stateType = stateType, .value = false});
-    }
-  });
-
-  eventQueue->subscribe<MouseMoved>([&](const auto& event) {
-    const auto deltaX = static_cast<float>(prevX - event->x);
-    const auto deltaY = static_cast<float>(prevY - event->y);
-
-    prevX = event->x;
-    prevY = event->y;
-
-    if (firstMouse) {
-      firstMouse = !firstMouse;
-      return;
-    }
-
-    if (deltaX != 0) {
-      if (const auto xit = mouseActionMap.find(MouseInput::MOVE_X); xit != mouseActionMap.end()) {
-        eventQueue->emit(Action{.actionType = xit->second.actionType,
-                                .stateType = xit->second.stateType,
-                                .value = deltaX});
-      }
-    }
-
-    if (deltaY != 0) {
-      if (const auto yit = mouseActionMap.find(MouseInput::MOVE_Y); yit != mouseActionMap.end()) {
-        eventQueue->emit(Action{.actionType = yit->second.actionType,
-                                .stateType = yit->second.stateType,
-                                .value = deltaY});
-      }
-    }
-  });
+  eventQueue->subscribe<MouseCaptured>([&](const auto& event) { liveInput(*event); });
+  eventQueue->subscribe<KeyEvent>([&](const auto& event) { liveInput(*event); });
+  eventQueue->subscribe<MouseMoved>([&](const auto& event) { liveInput(*event); });
 }
 
 ActionSystem::~ActionSystem() {
@@ -78,4 +32,121 @@ void ActionSystem::mapSource(Source source, StateType sType, ActionType aType) {
   std::visit(visitor, source.src);
 }
 
+auto ActionSystem::takeActionFrame() -> ActionFrame {
+  std::lock_guard lock(frameMutex);
+  if (replay) {
+    const auto& inputs = replay->inputs;
+    while (replayCursor < inputs.size() && inputs[replayCursor].tick <= pendingFrame.sequence) {
+      applyInput(inputs[replayCursor++].event);
+    }
+    if (pendingFrame.sequence == replay->endTick) {
+      Log.info("Input replay finished after {} ticks", replay->endTick);
+      eventQueue->emit(WindowClosed{});
+    }
+  }
+  auto frame = pendingFrame;
+  ++pendingFrame.sequence;
+  pendingFrame.ranges.fill(0.f);
+  pendingFrame.pressed.reset();
+  pendingFrame.released.reset();
+  return frame;
+}
+
+auto ActionSystem::startRecording() -> void {
+  std::lock_guard lock(frameMutex);
+  recording.emplace();
+  recordingStart = std::chrono::steady_clock::now();
+}
+
+auto ActionSystem::stopRecording() -> InputRecording {
+  std::lock_guard lock(frameMutex);
+  auto finished = std::move(recording).value_or(InputRecording{});
+  recording.reset();
+  finished.endTick = pendingFrame.sequence;
+  return finished;
+}
+
+auto ActionSystem::startReplay(InputRecording newRecording) -> void {
+  std::lock_guard lock(frameMutex);
+  replay = std::move(newRecording);
+  replayCursor = 0;
+}
+
+auto ActionSystem::liveInput(const InputEvent& event) -> void {
+  std::lock_guard lock(frameMutex);
+  if (replay) {
+    return;
+  }
+  if (recording) {
+    recording->inputs.push_back(
+        RecordedInput{.tick = pendingFrame.sequence,
+                      .time = std::chrono::steady_clock::now() - recordingStart,
+                      .event = event});
+  }
+  applyInput(event);
+}
+
+/// Expects frameMutex to be held.
+auto ActionSystem::applyInput(const InputEvent& event) -> void {
+  auto visitor = [&]<typename T>(const T& input) {
+    if constexpr (std::is_same_v<T, MouseCaptured>) {
+      if (input.isMouseCaptured) {
+        firstMouse = true;
+      }
+    } else if constexpr (std::is_same_v<T, KeyEvent>) {
+      const auto sourceIt = keyActionMap.find(input.key);
+      if (sourceIt == keyActionMap.end() || sourceIt->second.stateType != StateType::State) {
+        return;
+      }
+      if (input.buttonState == ButtonState::Pressed) {
+        keyChanged(input.key, sourceIt->second, true);
+      } else if (input.buttonState == ButtonState::Released) {
+        keyChanged(input.key, sourceIt->second, false);
+      }
+    } else if constexpr (std::is_same_v<T, MouseMoved>) {
+      const auto deltaX = static_cast<float>(prevX - input.x);
+      const auto deltaY = static_cast<float>(prevY - input.y);
+
+      prevX = input.x;
+      prevY = input.y;
+
+      if (firstMouse) {
+        firstMouse = !firstMouse;
+        return;
+      }
+
+      if (const auto xit = mouseActionMap.find(MouseInput::MOVE_X); xit != mouseActionMap.end()) {
+        pendingFrame.ranges[static_cast<size_t>(xit->second.actionType)] += deltaX;
+      }
+      if (const auto yit = mouseActionMap.find(MouseInput::MOVE_Y); yit != mouseActionMap.end()) {
+        pendingFrame.ranges[static_cast<size_t>(yit->second.actionType)] += deltaY;
+      }
+    }
+  };
+  std::visit(visitor, event);
+}
+
+auto ActionSystem::keyChanged(Key key, const Action& action, bool down) -> void {
+  // Key repeats arrive as more presses, and a key can be released without us seeing the press
+  if (down == keysDown.contains(key)) {
+    return;
+  }
+  const auto index = static_cast<size_t>(action.actionType);
+  auto& count = heldCounts[index];
+  if (down) {
+    keysDown.insert(key);
+    ++count;
+  } else {
+    keysDown.erase(key);
+    --count;
+  }
+
+  if (down && !pendingFrame.held.test(index)) {
+    pendingFrame.pressed.set(index);
+  } else if (!down && count == 0) {
+    pendingFrame.released.set(index);
+  }
+  pendingFrame.held.set(index, count > 0);
+}
+
 }
@@ -3,6 +3,7 @@
 #include "api/action/IActionSystem.hpp"
 #include "api/action/Sources.hpp"
 #include "api/action/Inputs.hpp"
+#include "InputRecording.hpp"
 
 namespace tr {
 
@@ -13,12 +14,21 @@ public:
   explicit ActionSystem(std::shared_ptr<IEventQueue> newEventQueue);
   ~ActionSystem() override;
 
-  ActionSystem(const ActionSystem&) = default;
+  ActionSystem(const ActionSystem&) = delete;
   ActionSystem(ActionSystem&&) = delete;
-  auto operator=(const ActionSystem&) -> ActionSystem& = default;
+  auto operator=(const ActionSystem&) -> ActionSystem& = delete;
   auto operator=(ActionSystem&&) -> ActionSystem& = delete;
 
   void mapSource(Source source, StateType sType, ActionType aType) override;
+  auto takeActionFrame() -> ActionFrame override;
+
+  /// Keeps every input event from here on, along with the tick it lands in.
+  auto startRecording() -> void;
+  auto stopRecording() -> InputRecording;
+
+  /// Ignores live input from here on and feeds `recording` back in instead, each event landing in
+  /// the same tick it was recorded in. Emits WindowClosed once the recording runs out.
+  auto startReplay(InputRecording recording) -> void;
 
 private:
   std::shared_ptr<IEventQueue> eventQueue;
@@ -27,6 +37,26 @@ private:
   bool firstMouse = true;
   std::unordered_map<Key, Action> keyActionMap;
   std::unordered_map<MouseInput, Action> mouseActionMap;
+
+  /// Input events arrive on the main thread and frames are taken on the game thread. Guards
+  /// everything below.
+  std::mutex frameMutex;
+  ActionFrame pendingFrame;
+  /// Keys currently down, so key repeats don't count as presses
+  std::unordered_set<Key> keysDown;
+  /// How many keys mapped to each State action are down
+  std::array<uint8_t, ActionTypeCount> heldCounts{};
+
+  std::optional<InputRecording> recording;
+  std::chrono::steady_clock::time_point recordingStart;
+
+  std::optional<InputRecording> replay;
+  /// Next event in the replay to feed in
+  size_t replayCursor{};
+
+  auto liveInput(const InputEvent& event) -> void;
+  auto applyInput(const InputEvent& event) -> void;
+  auto keyChanged(Key key, const Action& action, bool down) -> void;
 };
 
 }
@@ -22,4 +22,12 @@ auto GuiCallBackRegistrar::ready() -> void {
   readyCallback();
 }
 
+auto GuiCallBackRegistrar::setVisible(bool newVisible) -> void {
+  visible.store(newVisible, std::memory_order_relaxed);
+}
+
+auto GuiCallBackRegistrar::isVisible() const -> bool {
+  return visible.load(std::memory_order_relaxed);
+}
+
 }
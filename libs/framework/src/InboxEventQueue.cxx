@@ -0,0 +1,213 @@
+#include "fx/InboxEventQueue.hpp"
+
+namespace tr {
+
+namespace {
+
+std::atomic<uint64_t> nextInstanceId = 1;
+
+struct InboxCache {
+  uint64_t instanceId;
+  void* inbox;
+};
+
+thread_local InboxCache inboxCache{};
+
+}
+
+InboxEventQueue::Inbox::Inbox(Node* stub)
+    : head{stub}, tail{stub}, owner{std::this_thread::get_id()} {
+}
+
+auto InboxEventQueue::Inbox::push(Node* node) -> void {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  auto* previous = head.exchange(node, std::memory_order_acq_rel);
+  previous->next.store(node, std::memory_order_release);
+
+  // Pairs with the fence in waitForEvents. Either the owner sees this node before it sleeps, or
+  // this sees it sleeping and wakes it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_relaxed)) {
+    std::lock_guard lock(wakeMutex);
+    wakeCondition.notify_one();
+  }
+}
+
+/// Returns the node that used to be the stub, with the popped event moved into it, or null if the
+/// inbox is empty or a push is still halfway done. The node that held the event becomes the stub.
+auto InboxEventQueue::Inbox::pop() -> Node* {
+  auto* stub = tail;
+  auto* next = stub->next.load(std::memory_order_acquire);
+  if (next == nullptr) {
+    return nullptr;
+  }
+  tail = next;
+  stub->route = next->route;
+  stub->payload = std::move(next->payload);
+  return stub;
+}
+
+auto InboxEventQueue::Inbox::hasPending() const -> bool {
+  return tail->next.load(std::memory_order_acquire) != nullptr;
+}
+
+InboxEventQueue::InboxEventQueue()
+    : instanceId{nextInstanceId.fetch_add(1, std::memory_order_relaxed)} {
+  routes.store(routeTables.emplace_back(std::make_unique<const RouteTable>()).get());
+  channels.emplace("default", DefaultChannel);
+}
+
+/// Payloads a listener is still holding on to past this point will dangle, since they live in the
+/// pool.
+InboxEventQueue::~InboxEventQueue() {
+  for (auto& inbox : inboxes) {
+    while (auto* node = inbox->pop()) {
+      deleteNode(node);
+    }
+    deleteNode(inbox->tail);
+  }
+}
+
+auto InboxEventQueue::internChannel(std::string_view name) -> ChannelId {
+  std::lock_guard lock(mutex);
+  auto [it, inserted] = channels.try_emplace(
+      std::string{name},
+      ChannelId{.id = static_cast<uint32_t>(channels.size())});
+  return it->second;
+}
+
+auto InboxEventQueue::getPayloadResource() -> std::pmr::memory_resource* {
+  return &pool;
+}
+
+void InboxEventQueue::emitErased(EventTypeId type,
+                                 std::shared_ptr<void> payload,
+                                 ChannelId channel) {
+  ZoneScopedN("InboxEventQueue::emit");
+  const auto route = makeRoute(type, channel);
+  {
+    const auto* table = routes.load(std::memory_order_acquire);
+    if (const auto it = table->find(route); it != table->end()) {
+      deliver(it->second, route, std::move(payload));
+      return;
+    }
+  }
+
+  // Someone may have subscribed since the table was loaded, and they only check `unrouted` while
+  // holding the lock.
+  std::lock_guard lock(mutex);
+  const auto* table = routes.load(std::memory_order_acquire);
+  if (const auto it = table->find(route); it != table->end()) {
+    deliver(it->second, route, std::move(payload));
+    return;
+  }
+  unrouted.emplace_back(route, std::move(payload));
+}
+
+void InboxEventQueue::subscribeErased(EventTypeId type,
+                                      std::function<void(const std::shared_ptr<void>&)> listener,
+                                      ChannelId channel) {
+  const auto route = makeRoute(type, channel);
+  auto& inbox = getOrCreateInbox();
+  inbox.listeners[route].emplace_back(std::move(listener));
+
+  std::lock_guard lock(mutex);
+  const auto* current = routes.load(std::memory_order_acquire);
+  if (const auto it = current->find(route);
+      it != current->end() && std::ranges::find(it->second, &inbox) != it->second.end()) {
+    return;
+  }
+  auto table = std::make_unique<RouteTable>(*current);
+  (*table)[route].push_back(&inbox);
+  routes.store(routeTables.emplace_back(std::move(table)).get(), std::memory_order_release);
+
+  auto held = std::ranges::partition(unrouted, [route](const auto& event) {
+    return event.first != route;
+  });
+  for (auto& [_, payload] : held) {
+    inbox.push(newNode(route, std::move(payload)));
+  }
+  unrouted.erase(held.begin(), held.end());
+}
+
+void InboxEventQueue::dispatchPending() {
+  ZoneScopedN("InboxEventQueue::dispatchPending");
+  auto* inbox = currentInbox();
+  if (inbox == nullptr) {
+    return;
+  }
+  while (auto* node = inbox->pop()) {
+    if (const auto it = inbox->listeners.find(node->route); it != inbox->listeners.end()) {
+      for (const auto& listener : it->second) {
+        listener(node->payload);
+      }
+    }
+    deleteNode(node);
+  }
+}
+
+void InboxEventQueue::waitForEvents(std::stop_token token) {
+  ZoneScopedN("InboxEventQueue::waitForEvents");
+  auto& inbox = getOrCreateInbox();
+  inbox.sleeping.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    std::unique_lock lock(inbox.wakeMutex);
+    inbox.wakeCondition.wait(lock, token, [&inbox] { return inbox.hasPending(); });
+  }
+  inbox.sleeping.store(false, std::memory_order_relaxed);
+}
+
+auto InboxEventQueue::makeRoute(EventTypeId type, ChannelId channel) -> RouteKey {
+  return (static_cast<RouteKey>(type) << 32) | channel.id;
+}
+
+auto InboxEventQueue::newNode(RouteKey route, std::shared_ptr<void> payload) -> Node* {
+  auto allocator = std::pmr::polymorphic_allocator<Node>{&pool};
+  auto* node = std::construct_at(allocator.allocate(1));
+  node->route = route;
+  node->payload = std::move(payload);
+  return node;
+}
+
+auto InboxEventQueue::deleteNode(Node* node) -> void {
+  auto allocator = std::pmr::polymorphic_allocator<Node>{&pool};
+  std::destroy_at(node);
+  allocator.deallocate(node, 1);
+}
+
+/// The last target takes the payload itself, so the usual single subscriber case doesn't touch the
+/// reference count.
+auto InboxEventQueue::deliver(const std::vector<Inbox*>& targets,
+                              RouteKey route,
+                              std::shared_ptr<void> payload) -> void {
+  for (size_t i = 0; i + 1 < targets.size(); ++i) {
+    targets[i]->push(newNode(route, payload));
+  }
+  targets.back()->push(newNode(route, std::move(payload)));
+}
+
+auto InboxEventQueue::currentInbox() -> Inbox* {
+  if (inboxCache.instanceId == instanceId) {
+    return static_cast<Inbox*>(inboxCache.inbox);
+  }
+  std::lock_guard lock(mutex);
+  const auto it = std::ranges::find(inboxes, std::this_thread::get_id(), &Inbox::owner);
+  if (it == inboxes.end()) {
+    return nullptr;
+  }
+  inboxCache = InboxCache{.instanceId = instanceId, .inbox = it->get()};
+  return it->get();
+}
+
+auto InboxEventQueue::getOrCreateInbox() -> Inbox& {
+  if (auto* inbox = currentInbox(); inbox != nullptr) {
+    return *inbox;
+  }
+  std::lock_guard lock(mutex);
+  auto& inbox = inboxes.emplace_back(std::make_unique<Inbox>(newNode(0, nullptr)));
+  inboxCache = InboxCache{.instanceId = instanceId, .inbox = inbox.get()};
+  return *inbox;
+}
+
+}
@@ -0,0 +1,66 @@
+#include "InputRecording.hpp"
+#include "api/SharedExceptions.hpp"
+
+#include <cereal/types/variant.hpp>
+#include <cereal/types/vector.hpp>
+
+namespace tr {
+
+template <class Archive>
+void serialize(Archive& archive, KeyEvent& event) {
+  archive(event.key, event.buttonState);
+}
+
+template <class Archive>
+void serialize(Archive& archive, MouseMoved& event) {
+  archive(event.x, event.y);
+}
+
+template <class Archive>
+void serialize(Archive& archive, MouseCaptured& event) {
+  archive(event.isMouseCaptured);
+}
+
+template <class Archive>
+void save(Archive& archive, const RecordedInput& input) {
+  archive(input.tick, static_cast<int64_t>(input.time.count()), input.event);
+}
+
+template <class Archive>
+void load(Archive& archive, RecordedInput& input) {
+  auto nanos = int64_t{};
+  archive(input.tick, nanos, input.event);
+  input.time = std::chrono::nanoseconds{nanos};
+}
+
+auto InputRecording::save(const std::filesystem::path& path) const -> void {
+  auto os = std::ofstream(path, std::ios::binary);
+  if (!os) {
+    throw IOException("Failed to open file: " + path.string());
+  }
+  cereal::PortableBinaryOutputArchive output(os);
+  output(version, endTick, inputs);
+}
+
+auto InputRecording::load(const std::filesystem::path& path) -> InputRecording {
+  auto is = std::ifstream(path, std::ios::binary);
+  if (!is) {
+    throw IOException("Failed to open file: " + path.string());
+  }
+
+  auto recording = InputRecording{};
+  try {
+    cereal::PortableBinaryInputArchive input(is);
+    input(recording.version);
+    if (recording.version != CurrentVersion) {
+      throw IOException("Unsupported input recording version " +
+                        std::to_string(recording.version));
+    }
+    input(recording.endTick, recording.inputs);
+  } catch (const cereal::Exception& ex) {
+    throw IOException("Error reading: " + path.string() + ": ", ex);
+  }
+  return recording;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "api/fx/Events.hpp"
+
+namespace tr {
+
+/// The raw input events that feed the ActionSystem.
+using InputEvent = std::variant<KeyEvent, MouseMoved, MouseCaptured>;
+
+struct RecordedInput {
+  /// Sequence of the ActionFrame the event was folded into, i.e. the game tick that consumed it
+  uint64_t tick{};
+  /// When the event arrived, relative to the start of the recording
+  std::chrono::nanoseconds time{};
+  InputEvent event;
+};
+
+/// Input captured tick by tick, so a run can be played back exactly. Events are kept in the order
+/// they arrived.
+struct InputRecording {
+  static constexpr uint32_t CurrentVersion = 1;
+
+  uint32_t version{CurrentVersion};
+  /// First tick the recording no longer covers. Replaying closes the window here.
+  uint64_t endTick{};
+  std::vector<RecordedInput> inputs;
+
+  auto save(const std::filesystem::path& path) const -> void;
+
+  /// Throws IOException if the file can't be read or was written by a different version.
+  static auto load(const std::filesystem::path& path) -> InputRecording;
+};
+
+}
@@ -0,0 +1,175 @@
+#include "fx/LockFreeStateBuffer.hpp"
+
+namespace tr {
+
+LockFreeStateBuffer::LockFreeStateBuffer(size_t initialCapacity) {
+  for (auto& slot : slots) {
+    slot.state.ensureCapacity(initialCapacity);
+  }
+}
+
+auto LockFreeStateBuffer::pushState(const SimState& newState, Timestamp t) -> void {
+  ZoneScoped;
+  writeState(t, [&newState](SimState& state) { copyInto(state, newState); });
+}
+
+auto LockFreeStateBuffer::writeState(Timestamp t, const std::function<void(SimState&)>& writer)
+    -> void {
+  ZoneScoped;
+  auto& slot = acquireWriteSlot();
+
+  // Odd sequence marks the slot as in flux for any reader that is mid-scan.
+  slot.sequence.fetch_add(1, std::memory_order_acq_rel);
+  writer(slot.state);
+  slot.timestamp.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+  slot.sequence.fetch_add(1, std::memory_order_release);
+
+  slot.pins.fetch_and(~WriterBit, std::memory_order_release);
+
+  latestTimestamp.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+  publishedCount.fetch_add(1);
+  // Taking the lock means a waiter that saw the old count is already waiting and will get this.
+  if (publishWaiters.load() > 0) {
+    { std::lock_guard lock(publishMutex); }
+    publishCondition.notify_all();
+  }
+}
+
+auto LockFreeStateBuffer::getPublishedState() const -> PublishedState {
+  const auto count = publishedCount.load();
+  return PublishedState{
+      .count = count,
+      .latest = Timestamp{Timestamp::duration{latestTimestamp.load(std::memory_order_relaxed)}}};
+}
+
+auto LockFreeStateBuffer::waitForPublish(uint64_t seenCount, Timestamp deadline)
+    -> PublishedState {
+  ZoneScoped;
+  if (publishedCount.load() <= seenCount) {
+    std::unique_lock lock(publishMutex);
+    publishWaiters.fetch_add(1);
+    publishCondition.wait_until(lock, deadline, [this, seenCount]() {
+      return publishedCount.load() > seenCount;
+    });
+    publishWaiters.fetch_sub(1);
+  }
+  return getPublishedState();
+}
+
+auto LockFreeStateBuffer::readStates(Timestamp target) -> std::optional<StateReadView> {
+  ZoneScoped;
+  const auto targetTicks = target.time_since_epoch().count();
+
+  for (int attempt = 0; attempt < MaxReadAttempts; ++attempt) {
+    std::optional<size_t> lower;
+    std::optional<size_t> upper;
+    std::array<uint64_t, SlotCount> sequences{};
+    std::array<Timestamp::rep, SlotCount> timestamps{};
+
+    for (size_t i = 0; i < SlotCount; ++i) {
+      const auto before = slots[i].sequence.load(std::memory_order_acquire);
+      if (before == 0 || (before & 1U) != 0) {
+        continue;
+      }
+      const auto ticks = slots[i].timestamp.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slots[i].sequence.load(std::memory_order_relaxed) != before) {
+        continue;
+      }
+      sequences[i] = before;
+      timestamps[i] = ticks;
+
+      // Strictly older, so asking for exactly the newest state's time still finds a pair.
+      if (ticks < targetTicks && (!lower || ticks > timestamps[*lower])) {
+        lower = i;
+      }
+      if (ticks >= targetTicks && (!upper || ticks < timestamps[*upper])) {
+        upper = i;
+      }
+    }
+
+    if (!lower || !upper || timestamps[*lower] == timestamps[*upper]) {
+      return std::nullopt;
+    }
+
+    if (!tryPin(*lower, sequences[*lower])) {
+      continue;
+    }
+    if (!tryPin(*upper, sequences[*upper])) {
+      unpin(*lower);
+      continue;
+    }
+
+    return StateReadView{&slots[*lower].state,
+                         &slots[*upper].state,
+                         [this, lowerIndex = *lower, upperIndex = *upper] {
+                           unpin(lowerIndex);
+                           unpin(upperIndex);
+                         }};
+  }
+
+  Log.trace("LockFreeStateBuffer::readStates gave up after {} attempts", MaxReadAttempts);
+  return std::nullopt;
+}
+
+auto LockFreeStateBuffer::getStates(Timestamp t) -> std::optional<std::pair<SimState, SimState>> {
+  const auto view = readStates(t);
+  if (!view) {
+    return std::nullopt;
+  }
+  return std::make_pair(view->previous(), view->next());
+}
+
+auto LockFreeStateBuffer::acquireWriteSlot() -> Slot& {
+  // Readers pin at most two slots each, so with a single reader there is always a free slot.
+  // Walking forward from the cursor overwrites the oldest unpinned state first.
+  while (true) {
+    for (size_t i = 0; i < SlotCount; ++i) {
+      const auto index = (writeCursor + i) % SlotCount;
+      auto expected = 0U;
+      if (slots[index].pins.compare_exchange_strong(expected,
+                                                    WriterBit,
+                                                    std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+        writeCursor = (index + 1) % SlotCount;
+        return slots[index];
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+auto LockFreeStateBuffer::tryPin(size_t index, uint64_t expectedSequence) -> bool {
+  auto& slot = slots[index];
+  const auto previous = slot.pins.fetch_add(1, std::memory_order_acquire);
+  if ((previous & WriterBit) != 0 ||
+      slot.sequence.load(std::memory_order_acquire) != expectedSequence) {
+    unpin(index);
+    return false;
+  }
+  return true;
+}
+
+auto LockFreeStateBuffer::unpin(size_t index) -> void {
+  slots[index].pins.fetch_sub(1, std::memory_order_release);
+}
+
+auto LockFreeStateBuffer::copyInto(SimState& dst, const SimState& src) -> void {
+  ZoneScoped;
+  dst.timeStamp = src.timeStamp;
+  dst.tag = src.tag;
+  dst.tick = src.tick;
+  dst.view = src.view;
+  dst.projection = src.projection;
+  // assign() reuses the destination's capacity, so once a slot has seen the largest state it will
+  // ever hold, pushing stops allocating.
+  dst.objectMetadata.assign(src.objectMetadata.begin(), src.objectMetadata.end());
+  dst.positions.assign(src.positions.begin(), src.positions.end());
+  dst.rotations.assign(src.rotations.begin(), src.rotations.end());
+  dst.scales.assign(src.scales.begin(), src.scales.end());
+  dst.stateHandles.assign(src.stateHandles.begin(), src.stateHandles.end());
+  dst.entityIds.assign(src.entityIds.begin(), src.entityIds.end());
+  dst.objectVersions.assign(src.objectVersions.begin(), src.objectVersions.end());
+}
+
+}
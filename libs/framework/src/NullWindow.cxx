@@ -0,0 +1,41 @@
+#include "NullWindow.hpp"
+#include "api/fx/Events.hpp"
+#include "api/fx/IEventQueue.hpp"
+
+namespace tr {
+
+NullWindow::NullWindow(glm::ivec2 newSize, const std::shared_ptr<IEventQueue>& eventQueue)
+    : size{newSize} {
+  eventQueue->subscribe<WindowClosed>(
+      [this]([[maybe_unused]] const auto& event) { closeRequested.store(true); });
+}
+
+void NullWindow::pollEvents() {
+}
+
+/// No OS events will ever arrive, so this always waits out the timeout.
+void NullWindow::waitEvents(std::chrono::milliseconds timeout) {
+  std::this_thread::sleep_for(timeout);
+}
+
+void NullWindow::setVulkanVersion([[maybe_unused]] std::string_view version) {
+}
+
+auto NullWindow::createVulkanSurface([[maybe_unused]] const vk::Instance& instance,
+                                     [[maybe_unused]] VkSurfaceKHR* outSurface) const -> void {
+  throw std::runtime_error("A headless window has no surface");
+}
+
+auto NullWindow::getFramebufferSize() const -> glm::ivec2 {
+  return size;
+}
+
+auto NullWindow::shouldClose() const -> bool {
+  return closeRequested.load();
+}
+
+auto NullWindow::getNativeWindow() const -> void* {
+  return nullptr;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "api/fx/IWindow.hpp"
+
+namespace tr {
+
+class IEventQueue;
+
+/// Window for running headless. There's nothing to draw to and no input, it just reports the
+/// configured size and closes when something emits WindowClosed, like an input replay running out
+/// or the renderer reaching FrameworkConfig::frameLimit.
+class NullWindow : public IWindow {
+public:
+  NullWindow(glm::ivec2 newSize, const std::shared_ptr<IEventQueue>& eventQueue);
+  ~NullWindow() override = default;
+
+  NullWindow(const NullWindow&) = delete;
+  NullWindow(NullWindow&&) = delete;
+  auto operator=(const NullWindow&) -> NullWindow& = delete;
+  auto operator=(NullWindow&&) -> NullWindow& = delete;
+
+  void pollEvents() override;
+  void waitEvents(std::chrono::milliseconds timeout) override;
+  void setVulkanVersion(std::string_view version) override;
+  auto createVulkanSurface(const vk::Instance& instance, VkSurfaceKHR* outSurface) const
+      -> void override;
+  [[nodiscard]] auto getFramebufferSize() const -> glm::ivec2 override;
+  [[nodiscard]] auto shouldClose() const -> bool override;
+  [[nodiscard]] auto getNativeWindow() const -> void* override;
+
+private:
+  glm::ivec2 size;
+  std::atomic<bool> closeRequested;
+};
+
+}
@@ -1,13 +1,15 @@
 #include "fx/ThreadedFrameworkContext.hpp"
 #include "ActionSystem.hpp"
 #include "DefaultAssetService.hpp"
-#include "EventQueue2.hpp"
+#include "fx/InboxEventQueue.hpp"
 #include "GlfwWindow.hpp"
+#include "NullWindow.hpp"
 #include "api/fx/IApplication.hpp"
 #include "api/fx/IAssetService.hpp"
 #include "api/fx/IGuiCallbackRegistrar.hpp"
-#include "bk/TaskQueue.hpp"
-#include "fx/HorribleStateBuffer.hpp"
+#include "bk/JobSystem.hpp"
+#include "bk/TimingLog.hpp"
+#include "fx/LockFreeStateBuffer.hpp"
 #include "gw/GameWorldContext.hpp"
 #include "gfx/GraphicsContext.hpp"
 #include "api/gw/EditorStateBuffer.hpp"
@@ -19,27 +21,38 @@ namespace di = boost::di;
 
 namespace tr {
 
+namespace {
+
+constexpr auto MainLoopTimeout = std::chrono::milliseconds(4);
+
+}
+
 auto ThreadedFrameworkContext::create(const FrameworkConfig& config,
                                       std::shared_ptr<IGuiAdapter> guiAdapter,
                                       std::shared_ptr<IGuiCallbackRegistrar> guiCallbackRegistrar)
     -> std::shared_ptr<ThreadedFrameworkContext> {
 
-  auto eventQueue = std::make_shared<EventQueue2>();
+  auto eventQueue = std::make_shared<InboxEventQueue>();
   auto actionSystem = std::make_shared<ActionSystem>(eventQueue);
 
-  auto taskQueue = std::make_shared<TaskQueue>(TaskQueueConfig{.maxQueueSize = 1024});
-  auto stateBuffer = std::make_shared<HorribleStateBuffer>();
+  auto jobSystem = std::make_shared<JobSystem>();
+  auto stateBuffer = std::make_shared<LockFreeStateBuffer>();
   auto editorStateBuffer = std::make_shared<EditorStateBuffer>();
-  auto window = std::make_shared<GlfwWindow>(WindowCreateInfo{.height = config.initialWindowSize.y,
-                                                              .width = config.initialWindowSize.x,
-                                                              .title = "Temporary Title"},
-                                             eventQueue,
-                                             guiAdapter);
+  auto window = std::shared_ptr<IWindow>{};
+  if (config.headless) {
+    window = std::make_shared<NullWindow>(config.initialWindowSize, eventQueue);
+  } else {
+    window = std::make_shared<GlfwWindow>(WindowCreateInfo{.height = config.initialWindowSize.y,
+                                                           .width = config.initialWindowSize.x,
+                                                           .title = "Temporary Title"},
+                                          eventQueue,
+                                          guiAdapter);
+  }
 
   const auto frameworkInjector =
-      di::make_injector(di::bind<TaskQueue>.to<>(taskQueue),
+      di::make_injector(di::bind<JobSystem>.to<>(jobSystem),
                         di::bind<IEventQueue>.to<>(eventQueue),
-                        di::bind<IActionSystem>.to<>(actionSystem),
+                        di::bind<ActionSystem>.to<>(actionSystem),
                         di::bind<IStateBuffer>.to<>(stateBuffer),
                         di::bind<IWindow>.to<>(window),
                         di::bind<IAssetService>.to<DefaultAssetService>(),
@@ -53,21 +66,27 @@ ThreadedFrameworkContext::~ThreadedFrameworkContext() {
 }
 
 ThreadedFrameworkContext::ThreadedFrameworkContext(
-    [[maybe_unused]] const FrameworkConfig& config,
+    const FrameworkConfig& config,
     std::shared_ptr<IEventQueue> newEventQueue,
-    std::shared_ptr<IActionSystem> newActionSystem,
+    std::shared_ptr<ActionSystem> newActionSystem,
     std::shared_ptr<IStateBuffer> newStateBuffer,
     std::shared_ptr<IWindow> newWindow,
     std::shared_ptr<IAssetService> newAssetService,
     std::shared_ptr<IGuiCallbackRegistrar> newGuiCallbackRegistrar,
-    std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
-    : eventQueue{std::move(newEventQueue)},
+    std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+    std::shared_ptr<JobSystem> newJobSystem)
+    : headless{config.headless},
+      recordInputPath{config.recordInputPath},
+      timingsDirectory{config.timingsDirectory},
+      frameLimit{config.frameLimit},
+      eventQueue{std::move(newEventQueue)},
       actionSystem{std::move(newActionSystem)},
       stateBuffer{std::move(newStateBuffer)},
       window{std::move(newWindow)},
       assetService{std::move(newAssetService)},
       guiCallbackRegistrar{std::move(newGuiCallbackRegistrar)},
-      editorStateBuffer{std::move(newEditorStateBuffer)} {
+      editorStateBuffer{std::move(newEditorStateBuffer)},
+      jobSystem{std::move(newJobSystem)} {
 
   // Find some other place to put this
   // Forward
@@ -106,13 +125,33 @@ ThreadedFrameworkContext::ThreadedFrameworkContext(
   actionSystem->mapSource(Source{MouseInput::MOVE_Y, SourceType::Float},
                           StateType::Range,
                           ActionType::LookVertical);
+
+  if (config.replayInputPath) {
+    if (recordInputPath) {
+      Log.warn("Not recording input while replaying it");
+      recordInputPath.reset();
+    }
+    Log.info("Replaying input from {}", config.replayInputPath->string());
+    actionSystem->startReplay(InputRecording::load(*config.replayInputPath));
+  } else if (recordInputPath) {
+    Log.info("Recording input to {}", recordInputPath->string());
+    actionSystem->startRecording();
+  }
 }
 
 auto ThreadedFrameworkContext::startGameworld() -> void {
   gameThread = std::jthread([this](std::stop_token token) {
     setCurrentThreadName("Game");
     try {
-      gameWorldContext = GameWorldContext::create(eventQueue, stateBuffer, editorStateBuffer);
+      gameWorldContext = GameWorldContext::create(eventQueue,
+                                                  stateBuffer,
+                                                  editorStateBuffer,
+                                                  jobSystem,
+                                                  actionSystem);
+      if (timingsDirectory) {
+        gameWorldContext->setTimingLog(
+            std::make_shared<TimingLog>(*timingsDirectory / "ticks.csv", "tick"));
+      }
       gameWorldContext->run(token);
       Log.trace("nulling out gameWorldContext");
       gameWorldContext = nullptr;
@@ -126,12 +165,26 @@ auto ThreadedFrameworkContext::startRenderer() -> void {
   graphicsThread = std::jthread([this](std::stop_token token) {
     setCurrentThreadName("Graphics");
     try {
-      graphicsContext = GraphicsContext::create(eventQueue,
-                                                stateBuffer,
-                                                window,
-                                                assetService,
-                                                guiCallbackRegistrar,
-                                                editorStateBuffer);
+      if (headless) {
+        graphicsContext = GraphicsContext::createHeadless(eventQueue,
+                                                          stateBuffer,
+                                                          assetService,
+                                                          editorStateBuffer);
+      } else {
+        graphicsContext = GraphicsContext::create(eventQueue,
+                                                  stateBuffer,
+                                                  window,
+                                                  assetService,
+                                                  guiCallbackRegistrar,
+                                                  editorStateBuffer);
+      }
+      if (graphicsContext && timingsDirectory) {
+        graphicsContext->setTimingLog(
+            std::make_shared<TimingLog>(*timingsDirectory / "frames.csv", "frame"));
+      }
+      if (graphicsContext && frameLimit) {
+        graphicsContext->setFrameLimit(*frameLimit);
+      }
       if (graphicsContext) {
         graphicsContext->run(token);
       }
@@ -147,9 +200,10 @@ auto ThreadedFrameworkContext::runApplication(const std::shared_ptr<IApplication
     -> void {
   application->onStart();
   while (!window->shouldClose()) {
-    window->pollEvents();
+    // Input wakes the loop straight away, the timeout only bounds how long events queued for the
+    // main thread can sit before onUpdate dispatches them.
+    window->waitEvents(MainLoopTimeout);
     application->onUpdate();
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
   }
   application->onShutdown();
 }
@@ -166,6 +220,19 @@ auto ThreadedFrameworkContext::stop() -> void {
   Log.trace("graphicsThread.join()");
   graphicsThread.join();
   Log.trace("graphicsThread after join()");
+
+  if (recordInputPath) {
+    try {
+      auto recording = actionSystem->stopRecording();
+      recording.save(*recordInputPath);
+      Log.info("Recorded {} input events over {} ticks to {}",
+               recording.inputs.size(),
+               recording.endTick,
+               recordInputPath->string());
+    } catch (const std::exception& ex) {
+      Log.error("Failed to save input recording: {}", ex.what());
+    }
+  }
 }
 
 auto ThreadedFrameworkContext::getEventQueue() -> std::shared_ptr<IEventQueue> {
@@ -0,0 +1,168 @@
+#include "ActionSystem.hpp"
+#include "api/fx/Events.hpp"
+#include "fx/InboxEventQueue.hpp"
+
+TEST_CASE("ActionSystem coalesces input into one frame per take", "[ActionSystem]") {
+  auto queue = std::make_shared<tr::InboxEventQueue>();
+  tr::ActionSystem actionSystem{queue};
+  actionSystem.mapSource(tr::Source{tr::Key::W, tr::SourceType::Boolean},
+                         tr::StateType::State,
+                         tr::ActionType::MoveForward);
+  actionSystem.mapSource(tr::Source{tr::Key::Up, tr::SourceType::Boolean},
+                         tr::StateType::State,
+                         tr::ActionType::MoveForward);
+  actionSystem.mapSource(tr::Source{tr::MouseInput::MOVE_X, tr::SourceType::Float},
+                         tr::StateType::Range,
+                         tr::ActionType::LookHorizontal);
+
+  // The first position only establishes where the mouse is.
+  queue->emit(tr::MouseMoved{.x = 100.0, .y = 0.0});
+  queue->emit(tr::MouseMoved{.x = 90.0, .y = 0.0});
+  queue->emit(tr::MouseMoved{.x = 85.0, .y = 0.0});
+  queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Pressed});
+  queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Pressed});
+  queue->dispatchPending();
+
+  const auto first = actionSystem.takeActionFrame();
+  CHECK(first.range(tr::ActionType::LookHorizontal) == 15.f);
+  CHECK(first.isHeld(tr::ActionType::MoveForward));
+  CHECK(first.wasPressed(tr::ActionType::MoveForward));
+  CHECK_FALSE(first.wasReleased(tr::ActionType::MoveForward));
+
+  SECTION("Held state carries over but deltas and edges don't") {
+    const auto second = actionSystem.takeActionFrame();
+    CHECK(second.sequence == first.sequence + 1);
+    CHECK(second.range(tr::ActionType::LookHorizontal) == 0.f);
+    CHECK(second.isHeld(tr::ActionType::MoveForward));
+    CHECK_FALSE(second.wasPressed(tr::ActionType::MoveForward));
+  }
+
+  SECTION("An action stays held until every key mapped to it is released") {
+    queue->emit(tr::KeyEvent{.key = tr::Key::Up, .buttonState = tr::ButtonState::Pressed});
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Released});
+    queue->dispatchPending();
+    const auto second = actionSystem.takeActionFrame();
+    CHECK(second.isHeld(tr::ActionType::MoveForward));
+    CHECK_FALSE(second.wasPressed(tr::ActionType::MoveForward));
+    CHECK_FALSE(second.wasReleased(tr::ActionType::MoveForward));
+
+    queue->emit(tr::KeyEvent{.key = tr::Key::Up, .buttonState = tr::ButtonState::Released});
+    queue->dispatchPending();
+    const auto third = actionSystem.takeActionFrame();
+    CHECK_FALSE(third.isHeld(tr::ActionType::MoveForward));
+    CHECK(third.wasReleased(tr::ActionType::MoveForward));
+  }
+
+  SECTION("A tap within one tick sets both edges") {
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Released});
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Pressed});
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Released});
+    queue->dispatchPending();
+    const auto second = actionSystem.takeActionFrame();
+    CHECK_FALSE(second.isHeld(tr::ActionType::MoveForward));
+    CHECK(second.wasPressed(tr::ActionType::MoveForward));
+    CHECK(second.wasReleased(tr::ActionType::MoveForward));
+  }
+}
+
+namespace {
+
+auto mapDefaults(tr::ActionSystem& actionSystem) -> void {
+  actionSystem.mapSource(tr::Source{tr::Key::W, tr::SourceType::Boolean},
+                         tr::StateType::State,
+                         tr::ActionType::MoveForward);
+  actionSystem.mapSource(tr::Source{tr::MouseInput::MOVE_X, tr::SourceType::Float},
+                         tr::StateType::Range,
+                         tr::ActionType::LookHorizontal);
+}
+
+}
+
+TEST_CASE("ActionSystem replays recorded input tick for tick", "[ActionSystem]") {
+  auto recording = tr::InputRecording{};
+  auto recordedFrames = std::vector<tr::ActionFrame>{};
+  {
+    auto queue = std::make_shared<tr::InboxEventQueue>();
+    tr::ActionSystem recorder{queue};
+    mapDefaults(recorder);
+    recorder.startRecording();
+
+    queue->emit(tr::MouseMoved{.x = 100.0, .y = 0.0});
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Pressed});
+    queue->dispatchPending();
+    recordedFrames.push_back(recorder.takeActionFrame());
+
+    // Nothing arrives during this tick
+    recordedFrames.push_back(recorder.takeActionFrame());
+
+    queue->emit(tr::MouseMoved{.x = 90.0, .y = 0.0});
+    queue->emit(tr::MouseMoved{.x = 80.0, .y = 0.0});
+    queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Released});
+    queue->dispatchPending();
+    recordedFrames.push_back(recorder.takeActionFrame());
+
+    recording = recorder.stopRecording();
+  }
+
+  REQUIRE(recording.inputs.size() == 5);
+  CHECK(recording.inputs.front().tick == 0);
+  CHECK(recording.inputs.back().tick == 2);
+  CHECK(recording.endTick == 3);
+
+  auto queue = std::make_shared<tr::InboxEventQueue>();
+  tr::ActionSystem player{queue};
+  mapDefaults(player);
+  auto closed = false;
+  queue->subscribe<tr::WindowClosed>([&closed](const auto&) { closed = true; });
+  player.startReplay(recording);
+
+  // Live input is ignored while replaying
+  queue->emit(tr::KeyEvent{.key = tr::Key::W, .buttonState = tr::ButtonState::Pressed});
+  queue->dispatchPending();
+
+  for (const auto& expected : recordedFrames) {
+    const auto frame = player.takeActionFrame();
+    CHECK(frame.sequence == expected.sequence);
+    CHECK(frame.ranges == expected.ranges);
+    CHECK(frame.held == expected.held);
+    CHECK(frame.pressed == expected.pressed);
+    CHECK(frame.released == expected.released);
+  }
+  queue->dispatchPending();
+  CHECK_FALSE(closed);
+
+  player.takeActionFrame();
+  queue->dispatchPending();
+  CHECK(closed);
+}
+
+TEST_CASE("InputRecording round trips through a file", "[ActionSystem]") {
+  auto recording = tr::InputRecording{
+      .endTick = 42,
+      .inputs = {
+          tr::RecordedInput{.tick = 1,
+                            .time = std::chrono::nanoseconds{1500},
+                            .event = tr::KeyEvent{.key = tr::Key::D,
+                                                  .buttonState = tr::ButtonState::Pressed}},
+          tr::RecordedInput{.tick = 7,
+                            .time = std::chrono::nanoseconds{9000},
+                            .event = tr::MouseMoved{.x = 12.5, .y = -3.0}},
+          tr::RecordedInput{.tick = 9,
+                            .time = std::chrono::nanoseconds{12000},
+                            .event = tr::MouseCaptured{.isMouseCaptured = true}},
+      }};
+
+  const auto path = std::filesystem::temp_directory_path() / "ActionSystemTest.input";
+  recording.save(path);
+  const auto loaded = tr::InputRecording::load(path);
+  std::filesystem::remove(path);
+
+  CHECK(loaded.endTick == 42);
+  REQUIRE(loaded.inputs.size() == 3);
+  CHECK(loaded.inputs[0].tick == 1);
+  CHECK(loaded.inputs[0].time == std::chrono::nanoseconds{1500});
+  CHECK(std::get<tr::KeyEvent>(loaded.inputs[0].event).key == tr::Key::D);
+  CHECK(std::get<tr::MouseMoved>(loaded.inputs[1].event).x == 12.5);
+  CHECK(std::get<tr::MouseMoved>(loaded.inputs[1].event).y == -3.0);
+  CHECK(std::get<tr::MouseCaptured>(loaded.inputs[2].event).isMouseCaptured);
+}
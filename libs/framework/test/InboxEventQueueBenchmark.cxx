@@ -0,0 +1,51 @@
+#include "fx/InboxEventQueue.hpp"
+
+namespace {
+
+struct MouseMoved {
+  double x;
+  double y;
+};
+
+}
+
+/// A single consumer thread drains the queue while producers emit, like the main, game and asset
+/// threads all feeding the graphics thread.
+TEST_CASE("InboxEventQueue throughput by producer count", "[.][benchmark][InboxEventQueue]") {
+  constexpr size_t EventsPerProducer = 100'000;
+  const auto maxProducers = std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+
+  for (size_t producerCount = 1; producerCount <= maxProducers; producerCount *= 2) {
+    const auto expected = producerCount * EventsPerProducer;
+
+    BENCHMARK(std::to_string(producerCount) + " producers, " + std::to_string(expected) +
+              " events") {
+      tr::InboxEventQueue queue;
+      auto received = std::atomic<size_t>{0};
+      auto subscribed = std::atomic<bool>{false};
+      auto consumer = std::jthread{[&]() {
+        queue.subscribe<MouseMoved>(
+            [&](const std::shared_ptr<MouseMoved>&) { received.fetch_add(1); });
+        subscribed.store(true);
+        while (received.load() < expected) {
+          queue.dispatchPending();
+        }
+      }};
+      while (!subscribed.load()) {
+        std::this_thread::yield();
+      }
+
+      auto producers = std::vector<std::jthread>{};
+      for (size_t p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&]() {
+          for (size_t i = 0; i < EventsPerProducer; ++i) {
+            queue.emit(MouseMoved{.x = static_cast<double>(i), .y = 0.0});
+          }
+        });
+      }
+      producers.clear();
+      consumer.join();
+      return received.load();
+    };
+  }
+}
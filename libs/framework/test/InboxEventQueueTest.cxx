@@ -0,0 +1,154 @@
+#include "fx/InboxEventQueue.hpp"
+
+namespace {
+
+struct Ping {
+  int value;
+};
+
+struct Pong {
+  int value;
+};
+
+}
+
+TEST_CASE("InboxEventQueue delivers to the subscribing thread", "[InboxEventQueue]") {
+  tr::InboxEventQueue queue;
+  auto received = std::vector<int>{};
+  queue.subscribe<Ping>(
+      [&](const std::shared_ptr<Ping>& ping) { received.push_back(ping->value); });
+
+  queue.emit(Ping{.value = 1});
+  queue.emit(Pong{.value = 2});
+  queue.emit(Ping{.value = 3});
+  CHECK(received.empty());
+
+  queue.dispatchPending();
+  CHECK(received == std::vector{1, 3});
+}
+
+TEST_CASE("InboxEventQueue holds events until something subscribes", "[InboxEventQueue]") {
+  tr::InboxEventQueue queue;
+  queue.emit(Ping{.value = 7});
+
+  auto received = std::vector<int>{};
+  queue.subscribe<Ping>(
+      [&](const std::shared_ptr<Ping>& ping) { received.push_back(ping->value); });
+  queue.dispatchPending();
+  CHECK(received == std::vector{7});
+}
+
+TEST_CASE("InboxEventQueue keeps channels apart", "[InboxEventQueue]") {
+  tr::InboxEventQueue queue;
+  const auto editor = queue.internChannel("editor");
+  CHECK(queue.internChannel("editor") == editor);
+  CHECK(queue.internChannel("default") == tr::DefaultChannel);
+  CHECK(editor != tr::DefaultChannel);
+
+  auto defaultCount = 0;
+  auto editorCount = 0;
+  queue.subscribe<Ping>([&](const std::shared_ptr<Ping>&) { ++defaultCount; });
+  queue.subscribe<Ping>([&](const std::shared_ptr<Ping>&) { ++editorCount; }, editor);
+
+  queue.emit(Ping{}, "editor");
+  queue.emit(Ping{}, editor);
+  queue.emit(Ping{});
+  queue.dispatchPending();
+  CHECK(defaultCount == 1);
+  CHECK(editorCount == 2);
+}
+
+TEST_CASE("InboxEventQueue delivers every event to every subscribed thread", "[InboxEventQueue]") {
+  constexpr int ProducerCount = 4;
+  constexpr int EventsPerProducer = 10'000;
+  constexpr int Expected = ProducerCount * EventsPerProducer;
+
+  tr::InboxEventQueue queue;
+  auto subscribed = std::atomic<int>{0};
+  auto done = std::atomic<bool>{false};
+
+  auto consume = [&](std::atomic<int64_t>& sum, std::atomic<int>& count) {
+    queue.subscribe<Ping>([&](const std::shared_ptr<Ping>& ping) {
+      sum.fetch_add(ping->value, std::memory_order_relaxed);
+      count.fetch_add(1, std::memory_order_relaxed);
+    });
+    subscribed.fetch_add(1);
+    while (!done.load() || count.load() < Expected) {
+      queue.dispatchPending();
+    }
+  };
+
+  auto sums = std::array<std::atomic<int64_t>, 2>{};
+  auto counts = std::array<std::atomic<int>, 2>{};
+  {
+    auto consumers = std::vector<std::jthread>{};
+    for (size_t i = 0; i < sums.size(); ++i) {
+      consumers.emplace_back([&, i]() { consume(sums[i], counts[i]); });
+    }
+    while (subscribed.load() < 2) {
+      std::this_thread::yield();
+    }
+
+    auto producers = std::vector<std::jthread>{};
+    for (int p = 0; p < ProducerCount; ++p) {
+      producers.emplace_back([&]() {
+        for (int i = 1; i <= EventsPerProducer; ++i) {
+          queue.emit(Ping{.value = i});
+        }
+      });
+    }
+    producers.clear();
+    done.store(true);
+  }
+
+  constexpr int64_t ExpectedSum =
+      static_cast<int64_t>(ProducerCount) * EventsPerProducer * (EventsPerProducer + 1) / 2;
+  for (size_t i = 0; i < sums.size(); ++i) {
+    CHECK(counts[i].load() == Expected);
+    CHECK(sums[i].load() == ExpectedSum);
+  }
+}
+
+TEST_CASE("InboxEventQueue wakes a thread waiting for events", "[InboxEventQueue]") {
+  constexpr int Expected = 1'000;
+
+  tr::InboxEventQueue queue;
+  auto subscribed = std::atomic<bool>{false};
+
+  SECTION("when an event arrives") {
+    auto received = std::atomic<int>{0};
+    {
+      auto consumer = std::jthread([&](std::stop_token token) {
+        queue.subscribe<Ping>([&](const auto&) { received.fetch_add(1); });
+        subscribed.store(true);
+        while (received.load() < Expected && !token.stop_requested()) {
+          queue.waitForEvents(token);
+          queue.dispatchPending();
+        }
+      });
+      while (!subscribed.load()) {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < Expected; ++i) {
+        queue.emit(Ping{.value = i});
+      }
+    }
+    CHECK(received.load() == Expected);
+  }
+
+  SECTION("when asked to stop") {
+    auto woken = std::atomic<bool>{false};
+    auto consumer = std::jthread([&](std::stop_token token) {
+      queue.subscribe<Pong>([](const auto&) {});
+      subscribed.store(true);
+      queue.waitForEvents(token);
+      woken.store(true);
+    });
+    while (!subscribed.load()) {
+      std::this_thread::yield();
+    }
+    consumer.request_stop();
+    consumer.join();
+    CHECK(woken.load());
+  }
+}
@@ -0,0 +1,250 @@
+#include "fx/HorribleStateBuffer.hpp"
+#include "fx/LockFreeStateBuffer.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr size_t ObjectCount = 2048;
+
+/// Every element of the state carries the tag, so a reader that sees a mix of two writes will find
+/// an element that disagrees with the state's own tag.
+auto fillTaggedState(tr::SimState& state, uint64_t tag) -> void {
+  state.clear();
+  state.tag = tag;
+  const auto value = static_cast<float>(tag);
+  for (size_t i = 0; i < ObjectCount; ++i) {
+    state.objectMetadata.push_back(
+        tr::GpuObjectData{.transformIndex = static_cast<uint32_t>(tag)});
+    state.positions.push_back(tr::GpuTransformData{.position = glm::vec3{value}});
+    state.rotations.push_back(tr::GpuRotationData{.rotation = glm::quat{value, 0.f, 0.f, 0.f}});
+    state.scales.push_back(tr::GpuScaleData{.scale = glm::vec3{value}});
+  }
+}
+
+auto isConsistent(const tr::SimState& state) -> bool {
+  if (state.objectMetadata.size() != ObjectCount || state.positions.size() != ObjectCount ||
+      state.rotations.size() != ObjectCount || state.scales.size() != ObjectCount) {
+    return false;
+  }
+  const auto value = static_cast<float>(state.tag);
+  for (size_t i = 0; i < ObjectCount; ++i) {
+    if (state.objectMetadata[i].transformIndex != state.tag ||
+        state.positions[i].position.x != value || state.rotations[i].rotation.w != value ||
+        state.scales[i].scale.z != value) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct StressResult {
+  uint64_t pushes{};
+  uint64_t reads{};
+  uint64_t tornReads{};
+  double seconds{};
+};
+
+/// Producer pushes as fast as it can while the consumer continuously asks for the pair bracketing
+/// the most recently published tick.
+template <typename ReadFn>
+auto runStress(tr::IStateBuffer& buffer, uint64_t tickCount, ReadFn&& read) -> StressResult {
+  const auto base = steady_clock::now();
+  const auto tickLength = microseconds(4167);
+  std::atomic<uint64_t> published = 0;
+  std::atomic<bool> done = false;
+  auto result = StressResult{};
+
+  const auto start = steady_clock::now();
+
+  std::thread consumer([&]() {
+    while (!done.load(std::memory_order_acquire)) {
+      const auto latest = published.load(std::memory_order_acquire);
+      if (latest < 2) {
+        std::this_thread::yield();
+        continue;
+      }
+      const auto target = base + tickLength * (latest - 2) + tickLength / 2;
+      if (read(buffer, target, result)) {
+        ++result.reads;
+      }
+    }
+  });
+
+  auto state = tr::SimState{ObjectCount};
+  for (uint64_t i = 1; i <= tickCount; ++i) {
+    fillTaggedState(state, i);
+    buffer.pushState(state, base + tickLength * i);
+    published.store(i, std::memory_order_release);
+  }
+  done.store(true, std::memory_order_release);
+  consumer.join();
+
+  result.pushes = tickCount;
+  result.seconds = duration<double>(steady_clock::now() - start).count();
+  return result;
+}
+
+}
+
+TEST_CASE("LockFreeStateBuffer brackets the requested time", "[LockFreeStateBuffer]") {
+  tr::LockFreeStateBuffer buffer{ObjectCount};
+  const auto base = steady_clock::now();
+
+  auto state = tr::SimState{ObjectCount};
+  for (uint64_t i = 1; i <= 4; ++i) {
+    fillTaggedState(state, i * 10);
+    buffer.pushState(state, base + milliseconds(100 * i));
+  }
+
+  SECTION("Returns views of the bracketing pair") {
+    const auto view = buffer.readStates(base + milliseconds(150));
+    REQUIRE(view.has_value());
+    CHECK(view->previous().tag == 10);
+    CHECK(view->next().tag == 20);
+  }
+
+  SECTION("Fails if time is not bracketed") {
+    CHECK_FALSE(buffer.readStates(base + milliseconds(50)).has_value());
+    CHECK_FALSE(buffer.readStates(base + milliseconds(500)).has_value());
+  }
+
+  SECTION("Asking for exactly the newest state's time pairs it with the one before") {
+    const auto view = buffer.readStates(base + milliseconds(400));
+    REQUIRE(view.has_value());
+    CHECK(view->previous().tag == 30);
+    CHECK(view->next().tag == 40);
+  }
+
+  SECTION("Copying getStates agrees with readStates") {
+    const auto states = buffer.getStates(base + milliseconds(250));
+    REQUIRE(states.has_value());
+    CHECK(states->first.tag == 20);
+    CHECK(states->second.tag == 30);
+  }
+}
+
+TEST_CASE("LockFreeStateBuffer wakes readers waiting for a publish", "[LockFreeStateBuffer]") {
+  tr::LockFreeStateBuffer buffer{ObjectCount};
+  const auto base = steady_clock::now();
+  auto state = tr::SimState{ObjectCount};
+  fillTaggedState(state, 1);
+  buffer.pushState(state, base);
+
+  const auto seen = buffer.getPublishedState();
+  CHECK(seen.count == 1);
+  CHECK(seen.latest == base);
+
+  SECTION("Times out if nothing is published") {
+    const auto published = buffer.waitForPublish(seen.count, steady_clock::now() + milliseconds(5));
+    CHECK(published.count == seen.count);
+  }
+
+  SECTION("Returns as soon as a new state lands") {
+    auto producer = std::jthread{[&]() {
+      std::this_thread::sleep_for(milliseconds(5));
+      fillTaggedState(state, 2);
+      buffer.pushState(state, base + milliseconds(1));
+    }};
+    const auto published = buffer.waitForPublish(seen.count, steady_clock::now() + seconds(10));
+    CHECK(published.count == 2);
+    CHECK(published.latest == base + milliseconds(1));
+  }
+}
+
+TEST_CASE("LockFreeStateBuffer never overwrites a pinned view", "[LockFreeStateBuffer]") {
+  tr::LockFreeStateBuffer buffer{ObjectCount};
+  const auto base = steady_clock::now();
+
+  auto state = tr::SimState{ObjectCount};
+  fillTaggedState(state, 1);
+  buffer.pushState(state, base + milliseconds(1));
+  fillTaggedState(state, 2);
+  buffer.pushState(state, base + milliseconds(2));
+
+  const auto view = buffer.readStates(base + microseconds(1500));
+  REQUIRE(view.has_value());
+  const auto* previousData = view->previous().positions.data();
+
+  // Wrap the ring several times while the view is held.
+  for (uint64_t i = 3; i < 3 + tr::LockFreeStateBuffer::SlotCount * 4; ++i) {
+    fillTaggedState(state, i);
+    buffer.pushState(state, base + milliseconds(i));
+  }
+
+  CHECK(view->previous().tag == 1);
+  CHECK(view->next().tag == 2);
+  CHECK(view->previous().positions.data() == previousData);
+  CHECK(isConsistent(view->previous()));
+  CHECK(isConsistent(view->next()));
+}
+
+TEST_CASE("LockFreeStateBuffer writeState reuses slot storage", "[LockFreeStateBuffer]") {
+  tr::LockFreeStateBuffer buffer;
+  const auto base = steady_clock::now();
+
+  size_t bytesAllocated = 0;
+  auto write = [&](uint64_t tag) {
+    buffer.writeState(base + milliseconds(tag), [&](tr::SimState& state) {
+      const auto before = state.capacityBytes();
+      fillTaggedState(state, tag);
+      bytesAllocated += state.capacityBytes() - before;
+    });
+  };
+
+  // Every slot grows once to fit the scene.
+  for (uint64_t i = 1; i <= tr::LockFreeStateBuffer::SlotCount; ++i) {
+    write(i);
+  }
+  CHECK(bytesAllocated > 0);
+
+  bytesAllocated = 0;
+  for (uint64_t i = tr::LockFreeStateBuffer::SlotCount + 1; i < 100; ++i) {
+    write(i);
+  }
+  CHECK(bytesAllocated == 0);
+
+  const auto view = buffer.readStates(base + microseconds(98500));
+  REQUIRE(view.has_value());
+  CHECK(view->previous().tag == 98);
+  CHECK(isConsistent(view->previous()));
+  CHECK(isConsistent(view->next()));
+}
+
+TEST_CASE("LockFreeStateBuffer producer / consumer stress test", "[multithreaded]") {
+  tr::LockFreeStateBuffer lockFree{ObjectCount};
+  const auto lockFreeResult = runStress(
+      lockFree, 5000, [](tr::IStateBuffer& buffer, tr::Timestamp target, StressResult& result) {
+        const auto view = buffer.readStates(target);
+        if (!view) {
+          return false;
+        }
+        if (!isConsistent(view->previous()) || !isConsistent(view->next()) ||
+            view->previous().tag >= view->next().tag) {
+          ++result.tornReads;
+        }
+        return true;
+      });
+
+  tr::HorribleStateBuffer horrible;
+  const auto horribleResult = runStress(
+      horrible, 5000, [](tr::IStateBuffer& buffer, tr::Timestamp target, StressResult& result) {
+        const auto states = buffer.getStates(target);
+        if (!states) {
+          return false;
+        }
+        if (!isConsistent(states->first) || !isConsistent(states->second)) {
+          ++result.tornReads;
+        }
+        return true;
+      });
+
+  WARN("LockFreeStateBuffer: " << lockFreeResult.pushes / lockFreeResult.seconds << " pushes/s, "
+                               << lockFreeResult.reads / lockFreeResult.seconds << " reads/s");
+  WARN("HorribleStateBuffer: " << horribleResult.pushes / horribleResult.seconds << " pushes/s, "
+                               << horribleResult.reads / horribleResult.seconds << " reads/s");
+
+  CHECK(lockFreeResult.reads > 0);
+  CHECK(lockFreeResult.tornReads == 0);
+  CHECK(horribleResult.tornReads == 0);
+}
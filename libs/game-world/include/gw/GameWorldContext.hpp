@@ -6,6 +6,9 @@ class IEventQueue;
 class IEntityManager;
 class IStateBuffer;
 class EditorStateBuffer;
+class JobSystem;
+class IActionSystem;
+class TimingLog;
 
 class GameWorldContext {
 public:
@@ -21,15 +24,21 @@ public:
 
   static auto create(std::shared_ptr<IEventQueue> newEventQueue,
                      std::shared_ptr<IStateBuffer> newStateBuffer,
-                     std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
+                     std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                     std::shared_ptr<JobSystem> newJobSystem,
+                     std::shared_ptr<IActionSystem> newActionSystem)
       -> std::shared_ptr<GameWorldContext>;
 
   auto run(std::stop_token token) -> void;
 
+  /// Records how long every tick takes from here on
+  auto setTimingLog(std::shared_ptr<TimingLog> newTickTimings) -> void;
+
 private:
   std::shared_ptr<IEventQueue> eventQueue;
   std::shared_ptr<IEntityManager> entityManager;
   std::shared_ptr<IStateBuffer> stateBuffer;
+  std::shared_ptr<TimingLog> tickTimings;
 };
 
 }
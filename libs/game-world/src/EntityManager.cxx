@@ -1,4 +1,5 @@
 #include "EntityManager.hpp"
+#include "api/action/IActionSystem.hpp"
 #include "api/fx/IEventQueue.hpp"
 #include "api/fx/IStateBuffer.hpp"
 #include "api/gw/editordata/EditorState.hpp"
@@ -11,6 +12,7 @@
 #include "systems2/FinalizerSystem.hpp"
 #include "systems2/EditorSystem.hpp"
 #include "api/gw/EditorStateBuffer.hpp"
+#include "bk/JobSystem.hpp"
 #include <cereal/archives/binary.hpp>
 
 namespace tr {
@@ -22,18 +24,19 @@ constexpr auto DefaultPosition = glm::vec3{0.f, 0.f, 5.f};
 
 EntityManager::EntityManager(std::shared_ptr<IEventQueue> newEventQueue,
                              std::shared_ptr<IStateBuffer> newStateBuffer,
-                             std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
+                             std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                             std::shared_ptr<JobSystem> newJobSystem,
+                             std::shared_ptr<IActionSystem> newActionSystem)
     : eventQueue{std::move(newEventQueue)},
       stateBuffer{std::move(newStateBuffer)},
-      editorStateBuffer{std::move(newEditorStateBuffer)} {
+      editorStateBuffer{std::move(newEditorStateBuffer)},
+      jobSystem{std::move(newJobSystem)},
+      actionSystem{std::move(newActionSystem)} {
   registry = std::make_unique<entt::registry>();
   registry->ctx().emplace<EditorContextData>();
+  finalizerSystem = std::make_unique<FinalizerSystem>(*registry, jobSystem);
   Log.trace("Created EntityManager");
 
-  eventQueue->subscribe<Action>([this](const std::shared_ptr<Action>& event) {
-    CameraHandler::handleAction(event, *registry);
-  });
-
   eventQueue->subscribe<SwapchainCreated>(
       [this](const std::shared_ptr<SwapchainCreated>& event) { renderAreaCreated(event); });
 
@@ -74,9 +77,15 @@ EntityManager::~EntityManager() {
 
 auto EntityManager::update() -> void {
   Timestamp currentTime = std::chrono::steady_clock::now();
-  SimState writeState = SimState{1};
-  FinalizerSystem::update(*registry, writeState, currentTime);
-  stateBuffer->pushState(writeState, currentTime);
+
+  CameraHandler::handleActionFrame(actionSystem->takeActionFrame(), *registry);
+
+  stateBuffer->writeState(currentTime, [this, currentTime](SimState& state) {
+    const auto capacityBefore = state.capacityBytes();
+    finalizerSystem->update(state, currentTime);
+    const auto allocated = state.capacityBytes() - capacityBefore;
+    TracyPlot("SimState bytes allocated", static_cast<int64_t>(allocated));
+  });
 
   editorStateBuffer->pushState(EditorSystem::update(*registry), currentTime);
 }
@@ -11,12 +11,16 @@ class IStateBuffer;
 class FrameState;
 class CameraHandler;
 class EditorStateBuffer;
+class JobSystem;
+class IActionSystem;
 
 class EntityManager : public IEntityManager {
 public:
   explicit EntityManager(std::shared_ptr<IEventQueue> newEventQueue,
                          std::shared_ptr<IStateBuffer> newStateBuffer,
-                         std::shared_ptr<EditorStateBuffer> newEditorStateBuffer);
+                         std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                         std::shared_ptr<JobSystem> newJobSystem,
+                         std::shared_ptr<IActionSystem> newActionSystem);
   ~EntityManager() override;
 
   EntityManager(const EntityManager&) = delete;
@@ -30,8 +34,11 @@ private:
   std::shared_ptr<IEventQueue> eventQueue;
   std::shared_ptr<IStateBuffer> stateBuffer;
   std::shared_ptr<EditorStateBuffer> editorStateBuffer;
+  std::shared_ptr<JobSystem> jobSystem;
+  std::shared_ptr<IActionSystem> actionSystem;
 
   std::unique_ptr<entt::registry> registry;
+  std::unique_ptr<FinalizerSystem> finalizerSystem;
 
   auto renderAreaCreated(const std::shared_ptr<SwapchainCreated>& event) -> void;
   auto renderAreaResized(const std::shared_ptr<SwapchainResized>& event) -> void;
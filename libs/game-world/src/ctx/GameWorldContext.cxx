@@ -4,6 +4,9 @@
 #include "api/fx/IStateBuffer.hpp"
 #include "gw/IEntityManager.hpp"
 #include "api/gw/EditorStateBuffer.hpp"
+#include "bk/JobSystem.hpp"
+#include "bk/TimingLog.hpp"
+#include "api/action/IActionSystem.hpp"
 
 #include <di.hpp>
 
@@ -21,13 +24,17 @@ GameWorldContext::GameWorldContext(std::shared_ptr<IEventQueue> newEventQueue,
 
 auto GameWorldContext::create(std::shared_ptr<IEventQueue> newEventQueue,
                               std::shared_ptr<IStateBuffer> newStateBuffer,
-                              std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
+                              std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                              std::shared_ptr<JobSystem> newJobSystem,
+                              std::shared_ptr<IActionSystem> newActionSystem)
     -> std::shared_ptr<GameWorldContext> {
 
   const auto injector = di::make_injector(di::bind<IEventQueue>.to<>(newEventQueue),
                                           di::bind<IEntityManager>.to<EntityManager>(),
                                           di::bind<IStateBuffer>.to<>(newStateBuffer),
-                                          di::bind<EditorStateBuffer>.to<>(newEditorStateBuffer));
+                                          di::bind<EditorStateBuffer>.to<>(newEditorStateBuffer),
+                                          di::bind<JobSystem>.to<>(newJobSystem),
+                                          di::bind<IActionSystem>.to<>(newActionSystem));
 
   return injector.create<std::shared_ptr<GameWorldContext>>();
 }
@@ -39,6 +46,7 @@ auto GameWorldContext::run(std::stop_token token) -> void {
   constexpr auto timestep = std::chrono::nanoseconds(1'000'000'000 / targetHz);
 
   auto nextTick = clock::now();
+  auto tick = uint64_t{};
 
   while (!token.stop_requested()) {
     ZoneScopedN("Gameworld Loop");
@@ -53,6 +61,10 @@ auto GameWorldContext::run(std::stop_token token) -> void {
         ZoneScopedN("entityManager update");
         entityManager->update();
       }
+      if (tickTimings) {
+        tickTimings->record(tick, now, clock::now());
+      }
+      ++tick;
 
       nextTick += timestep;
 
@@ -67,4 +79,8 @@ auto GameWorldContext::run(std::stop_token token) -> void {
   }
 }
 
+auto GameWorldContext::setTimingLog(std::shared_ptr<TimingLog> newTickTimings) -> void {
+  tickTimings = std::move(newTickTimings);
+}
+
 }
@@ -6,51 +6,29 @@ constexpr auto CameraSpeed = .010f;
 constexpr auto MouseSensitivity = 0.025f;
 constexpr auto PitchExtent = 89.f;
 
-auto CameraHandler::handleAction(const std::shared_ptr<Action>& action, entt::registry& registry)
-    -> void {
+auto CameraHandler::handleActionFrame(const ActionFrame& frame, entt::registry& registry) -> void {
   for (const auto view = registry.view<Camera>(); auto [entity, cam] : view.each()) {
-    if (action->stateType == StateType::State) {
-      handleStateAction(action, cam);
-    } else if (action->stateType == StateType::Range) {
-      handleRangeAction(action, cam);
-    }
+    applyMovement(frame, cam);
+    applyLook(frame, cam);
   }
 }
 
-auto CameraHandler::handleStateAction(const std::shared_ptr<Action>& action, Camera& cam) -> void {
-  const auto value = std::get<bool>(action->value);
-  switch (action->actionType) {
-    case ActionType::StrafeLeft:
-      cam.velocity.x = value ? -CameraSpeed : 0.f;
-      break;
-    case ActionType::StrafeRight:
-      cam.velocity.x = value ? CameraSpeed : 0.f;
-      break;
-    case ActionType::MoveForward:
-      cam.velocity.z = value ? CameraSpeed : 0.f;
-      break;
-    case ActionType::MoveBackward:
-      cam.velocity.z = value ? -CameraSpeed : 0.f;
-      break;
-    default:
-      break;
-  }
+/// Opposing directions cancel out rather than the most recent key winning.
+auto CameraHandler::applyMovement(const ActionFrame& frame, Camera& cam) -> void {
+  const auto axis = [&frame](ActionType positive, ActionType negative) {
+    return (static_cast<float>(frame.isHeld(positive)) -
+            static_cast<float>(frame.isHeld(negative))) *
+           CameraSpeed;
+  };
+  cam.velocity.x = axis(ActionType::StrafeRight, ActionType::StrafeLeft);
+  cam.velocity.z = axis(ActionType::MoveForward, ActionType::MoveBackward);
 }
 
-auto CameraHandler::handleRangeAction(const std::shared_ptr<Action>& action, Camera& cam) -> void {
-  const auto value = std::get<float>(action->value);
-  switch (action->actionType) {
-    case ActionType::LookHorizontal:
-      cam.yaw -= value * MouseSensitivity;
-      break;
-    case ActionType::LookVertical:
-      cam.pitch += value * MouseSensitivity; // Invert Y-Axis 4 life
-      cam.pitch = std::min(cam.pitch, PitchExtent);
-      cam.pitch = std::max(cam.pitch, -PitchExtent);
-      break;
-    default:
-      break;
-  }
+auto CameraHandler::applyLook(const ActionFrame& frame, Camera& cam) -> void {
+  cam.yaw -= frame.range(ActionType::LookHorizontal) * MouseSensitivity;
+  cam.pitch += frame.range(ActionType::LookVertical) * MouseSensitivity; // Invert Y-Axis 4 life
+  cam.pitch = std::min(cam.pitch, PitchExtent);
+  cam.pitch = std::max(cam.pitch, -PitchExtent);
 }
 
 }
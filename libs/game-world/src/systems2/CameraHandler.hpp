@@ -1,6 +1,6 @@
 #pragma once
 
-#include "api/action/Actions.hpp"
+#include "api/action/ActionFrame.hpp"
 #include "components/Camera.hpp"
 
 namespace tr {
@@ -12,13 +12,13 @@ public:
   auto operator=(const CameraHandler&) -> CameraHandler& = default;
   auto operator=(CameraHandler&&) -> CameraHandler& = delete;
 
-  static auto handleAction(const std::shared_ptr<Action>& action, entt::registry& registry) -> void;
+  static auto handleActionFrame(const ActionFrame& frame, entt::registry& registry) -> void;
 
 private:
   CameraHandler() = default;
   ~CameraHandler() = default;
-  static auto handleStateAction(const std::shared_ptr<Action>& action, Camera& cam) -> void;
-  static auto handleRangeAction(const std::shared_ptr<Action>& action, Camera& cam) -> void;
+  static auto applyMovement(const ActionFrame& frame, Camera& cam) -> void;
+  static auto applyLook(const ActionFrame& frame, Camera& cam) -> void;
 };
 
 }
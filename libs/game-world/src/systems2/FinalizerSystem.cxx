@@ -4,47 +4,157 @@
 #include "components/Resources.hpp"
 #include "components/Transform.hpp"
 #include "api/GlmToString.hpp"
+#include "bk/JobSystem.hpp"
 
 namespace tr {
 
-auto FinalizerSystem::update(entt::registry& registry, SimState& simState, Timestamp t) -> void {
+FinalizerSystem::FinalizerSystem(entt::registry& newRegistry,
+                                 std::shared_ptr<JobSystem> newJobSystem)
+    : registry{newRegistry}, jobSystem{std::move(newJobSystem)} {
+  registry.on_construct<Renderable>().connect<&FinalizerSystem::onConstruct>(*this);
+  registry.on_construct<Transform>().connect<&FinalizerSystem::onConstruct>(*this);
+  registry.on_update<Renderable>().connect<&FinalizerSystem::onUpdate>(*this);
+  registry.on_update<Transform>().connect<&FinalizerSystem::onUpdate>(*this);
+  registry.on_destroy<Renderable>().connect<&FinalizerSystem::onDestroy>(*this);
+  registry.on_destroy<Transform>().connect<&FinalizerSystem::onDestroy>(*this);
+
+  // Pick up anything created before we were listening
+  for (const auto entity : registry.view<Renderable, Transform>()) {
+    onConstruct(registry, entity);
+  }
+}
+
+FinalizerSystem::~FinalizerSystem() {
+  registry.on_construct<Renderable>().disconnect(this);
+  registry.on_construct<Transform>().disconnect(this);
+  registry.on_update<Renderable>().disconnect(this);
+  registry.on_update<Transform>().disconnect(this);
+  registry.on_destroy<Renderable>().disconnect(this);
+  registry.on_destroy<Transform>().disconnect(this);
+}
+
+auto FinalizerSystem::update(SimState& simState, Timestamp t) -> void {
   ZoneScopedN("FinalizerSystem::update");
-  // simState.clear();
-  simState = SimState{1};
+  ++currentTick;
+
+  // simState is reused from tick to tick. If it's an older state we wrote, it's already correct
+  // for every object that hasn't changed since its tick.
+  const auto incremental = simState.tick != 0 && simState.tick < currentTick &&
+                           simState.objectVersions.size() == simState.objectMetadata.size();
+  const auto since = incremental ? simState.tick : 0;
+  if (!incremental) {
+    simState.clear();
+  }
+
   simState.timeStamp = t;
+  simState.tick = currentTick;
+  std::tie(simState.view, simState.projection) = createCameraData();
+
+  const auto count = objectEntities.size();
+  simState.ensureCapacity(count);
+  simState.objectMetadata.resize(count);
+  simState.positions.resize(count);
+  simState.rotations.resize(count);
+  simState.scales.resize(count);
+  simState.stateHandles.resize(count);
+  simState.entityIds.resize(count);
+  simState.objectVersions.resize(count);
+
+  const auto written = writeObjects(simState, since);
+  TracyPlot("Finalizer objects written", static_cast<int64_t>(written));
+}
+
+/// Workers only read the registry, and each index is written by exactly one chunk.
+auto FinalizerSystem::writeObjects(SimState& simState, uint64_t since) -> size_t {
+  const auto count = objectEntities.size();
+  if (!jobSystem) {
+    return writeChunk(simState, since, 0, static_cast<uint32_t>(count));
+  }
+
+  std::atomic<size_t> written = 0;
+  jobSystem->parallelFor(count, ChunkSize, [&](size_t first, size_t last) {
+    const auto writtenByChunk =
+        writeChunk(simState, since, static_cast<uint32_t>(first), static_cast<uint32_t>(last));
+    written.fetch_add(writtenByChunk, std::memory_order_relaxed);
+  });
+  return written.load(std::memory_order_relaxed);
+}
 
-  const auto view = registry.view<Renderable, Transform>();
-  const auto size = view.size_hint();
-
-  simState.ensureCapacity(size);
-  size_t current = 0;
-
-  std::tie(simState.view, simState.projection) = createCameraData(registry);
-
-  for (const auto& [entity, renderable, transform] : view.each()) {
-    std::optional<Handle<TextureTag>> textureHandle =
-        renderable.textureHandles.empty()
-            ? std::nullopt
-            : std::make_optional<Handle<TextureTag>>(renderable.textureHandles.front());
-    simState.stateHandles.push_back(
-        StateHandles{.geometryHandle = renderable.geometryHandles.front(),
-                     .textureHandle = textureHandle});
-    simState.positions.push_back({.position = transform.position});
-    simState.rotations.push_back({.rotation = transform.rotation});
-    simState.scales.push_back({.scale = transform.scale});
-    simState.objectMetadata.push_back(
-        GpuObjectData{.transformIndex = static_cast<uint32_t>(simState.positions.size() - 1),
-                      .rotationIndex = static_cast<uint32_t>(simState.rotations.size() - 1),
-                      .scaleIndex = static_cast<uint32_t>(simState.scales.size() - 1),
-                      .geometryRegionId = static_cast<uint32_t>(current),
-                      .materialId = 0L,
-                      .animationId = 0L});
-    ++current;
+auto FinalizerSystem::writeChunk(SimState& simState, uint64_t since, uint32_t first, uint32_t last)
+    -> size_t {
+  ZoneScopedN("FinalizerSystem::writeChunk");
+  size_t written = 0;
+  for (uint32_t index = first; index < last; ++index) {
+    if (objectVersions[index] > since) {
+      writeObject(simState, index);
+      ++written;
+    }
+  }
+  return written;
+}
+
+auto FinalizerSystem::writeObject(SimState& simState, uint32_t index) -> void {
+  const auto entity = objectEntities[index];
+  // The const registry never creates storage, so lookups are safe from worker threads.
+  const auto& [renderable, transform] = std::as_const(registry).get<Renderable, Transform>(entity);
+
+  std::optional<Handle<TextureTag>> textureHandle =
+      renderable.textureHandles.empty()
+          ? std::nullopt
+          : std::make_optional<Handle<TextureTag>>(renderable.textureHandles.front());
+  simState.stateHandles[index] = StateHandles{.geometryHandle = renderable.geometryHandles.front(),
+                                              .textureHandle = textureHandle};
+  simState.positions[index] = {.position = transform.position};
+  simState.rotations[index] = {.rotation = transform.rotation};
+  simState.scales[index] = {.scale = transform.scale};
+  simState.entityIds[index] = static_cast<uint32_t>(entity);
+  simState.objectVersions[index] = objectVersions[index];
+  simState.objectMetadata[index] = GpuObjectData{.transformIndex = index,
+                                                 .rotationIndex = index,
+                                                 .scaleIndex = index,
+                                                 .geometryRegionId = index,
+                                                 .materialId = 0L,
+                                                 .animationId = 0L};
+}
+
+auto FinalizerSystem::onConstruct(entt::registry& reg, entt::entity entity) -> void {
+  if (objectIndices.contains(entity) || !reg.all_of<Renderable, Transform>(entity)) {
+    return;
+  }
+  objectIndices.emplace(entity, static_cast<uint32_t>(objectEntities.size()));
+  objectEntities.push_back(entity);
+  objectVersions.push_back(pendingTick());
+}
+
+auto FinalizerSystem::onUpdate([[maybe_unused]] entt::registry& reg, entt::entity entity) -> void {
+  if (const auto it = objectIndices.find(entity); it != objectIndices.end()) {
+    objectVersions[it->second] = pendingTick();
+  }
+}
+
+/// Swap-and-pop keeps the object indices dense. The object moved into the hole gets a new version
+/// since its index changed.
+auto FinalizerSystem::onDestroy([[maybe_unused]] entt::registry& reg, entt::entity entity)
+    -> void {
+  const auto it = objectIndices.find(entity);
+  if (it == objectIndices.end()) {
+    return;
+  }
+  const auto index = it->second;
+  const auto last = static_cast<uint32_t>(objectEntities.size() - 1);
+  objectIndices.erase(it);
+
+  if (index != last) {
+    const auto moved = objectEntities[last];
+    objectEntities[index] = moved;
+    objectVersions[index] = pendingTick();
+    objectIndices[moved] = index;
   }
+  objectEntities.pop_back();
+  objectVersions.pop_back();
 }
 
-auto FinalizerSystem::createCameraData(entt::registry& registry)
-    -> std::tuple<glm::mat4, glm::mat4> {
+auto FinalizerSystem::createCameraData() -> std::tuple<glm::mat4, glm::mat4> {
 
   if (!registry.ctx().contains<WindowDimensions>()) {
     return {glm::identity<glm::mat4>(), glm::identity<glm::mat4>()};
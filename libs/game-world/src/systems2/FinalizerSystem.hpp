@@ -4,20 +4,60 @@
 
 namespace tr {
 
+class JobSystem;
+
+/// Flattens Renderable + Transform entities into a SimState for the renderer.
+///
+/// Every renderable entity owns a dense object index for as long as it exists. Changes to its
+/// components are picked up through registry signals and stamped with the tick they will be
+/// published in, so components must be modified with `registry.patch`/`replace` for the change to
+/// be seen. When the SimState handed to `update` is an older state this system wrote, only objects
+/// that changed since that state's tick are rewritten. Anything else gets a full rebuild.
+///
+/// Objects are written in fixed size chunks of the dense index range. Each chunk owns its slice of
+/// the SoA arrays, so given a JobSystem the chunks are spread over its workers and the output is
+/// identical to the serial path regardless of scheduling.
 class FinalizerSystem {
 public:
-  FinalizerSystem() = default;
-  ~FinalizerSystem() = default;
+  static constexpr size_t ChunkSize = 4096;
+
+  explicit FinalizerSystem(entt::registry& newRegistry,
+                           std::shared_ptr<JobSystem> newJobSystem = nullptr);
+  ~FinalizerSystem();
 
-  FinalizerSystem(const FinalizerSystem&) = default;
+  FinalizerSystem(const FinalizerSystem&) = delete;
   FinalizerSystem(FinalizerSystem&&) = delete;
-  auto operator=(const FinalizerSystem&) -> FinalizerSystem& = default;
+  auto operator=(const FinalizerSystem&) -> FinalizerSystem& = delete;
   auto operator=(FinalizerSystem&&) -> FinalizerSystem& = delete;
 
-  static auto update(entt::registry& registry, SimState& simState, Timestamp t) -> void;
+  auto update(SimState& simState, Timestamp t) -> void;
+
+  [[nodiscard]] auto getObjectCount() const -> size_t {
+    return objectEntities.size();
+  }
 
 private:
-  static auto createCameraData(entt::registry& registry) -> std::tuple<glm::mat4, glm::mat4>;
+  entt::registry& registry;
+  std::shared_ptr<JobSystem> jobSystem;
+
+  uint64_t currentTick{};
+  std::vector<entt::entity> objectEntities;
+  std::vector<uint64_t> objectVersions;
+  std::unordered_map<entt::entity, uint32_t> objectIndices;
+
+  auto onConstruct(entt::registry& reg, entt::entity entity) -> void;
+  auto onUpdate(entt::registry& reg, entt::entity entity) -> void;
+  auto onDestroy(entt::registry& reg, entt::entity entity) -> void;
+
+  /// Changes made between updates are published by the next one.
+  [[nodiscard]] auto pendingTick() const -> uint64_t {
+    return currentTick + 1;
+  }
+
+  auto writeObjects(SimState& simState, uint64_t since) -> size_t;
+  auto writeChunk(SimState& simState, uint64_t since, uint32_t first, uint32_t last) -> size_t;
+  auto writeObject(SimState& simState, uint32_t index) -> void;
+  auto createCameraData() -> std::tuple<glm::mat4, glm::mat4>;
 };
 
 }
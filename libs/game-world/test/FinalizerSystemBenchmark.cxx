@@ -0,0 +1,58 @@
+#include "bk/JobSystem.hpp"
+#include "components/Renderable.hpp"
+#include "components/Transform.hpp"
+#include "systems2/FinalizerSystem.hpp"
+
+namespace {
+
+auto populate(entt::registry& registry, size_t count) -> void {
+  auto entities = std::vector<entt::entity>(count);
+  registry.create(entities.begin(), entities.end());
+  for (size_t i = 0; i < count; ++i) {
+    registry.emplace<tr::Renderable>(
+        entities[i],
+        std::vector<tr::Handle<tr::Geometry>>{tr::Handle<tr::Geometry>{.id = i % 64}},
+        std::vector<tr::Handle<tr::TextureTag>>{});
+    registry.emplace<tr::Transform>(entities[i],
+                                    tr::Transform{.rotation = glm::quat{1.f, 0.f, 0.f, 0.f},
+                                                  .position = glm::vec3{static_cast<float>(i)},
+                                                  .scale = glm::vec3{1.f}});
+  }
+}
+
+/// Resetting the tick forces a full rebuild, which is also what every tick costs when everything
+/// in the scene moves.
+auto benchmarkExtraction(size_t count) -> void {
+  entt::registry registry;
+  populate(registry, count);
+
+  tr::FinalizerSystem serial{registry};
+  tr::FinalizerSystem parallel{registry, std::make_shared<tr::JobSystem>()};
+  auto state = tr::SimState{count};
+
+  BENCHMARK("serial full rebuild, " + std::to_string(count)) {
+    state.tick = 0;
+    serial.update(state, tr::Timestamp{});
+    return state.objectMetadata.size();
+  };
+
+  BENCHMARK("parallel full rebuild, " + std::to_string(count)) {
+    state.tick = 0;
+    parallel.update(state, tr::Timestamp{});
+    return state.objectMetadata.size();
+  };
+}
+
+}
+
+TEST_CASE("FinalizerSystem extraction 10k entities", "[.][benchmark][FinalizerSystem]") {
+  benchmarkExtraction(10'000);
+}
+
+TEST_CASE("FinalizerSystem extraction 100k entities", "[.][benchmark][FinalizerSystem]") {
+  benchmarkExtraction(100'000);
+}
+
+TEST_CASE("FinalizerSystem extraction 1M entities", "[.][benchmark][FinalizerSystem]") {
+  benchmarkExtraction(1'000'000);
+}
@@ -0,0 +1,99 @@
+#include "bk/JobSystem.hpp"
+#include "components/Renderable.hpp"
+#include "components/Transform.hpp"
+#include "systems2/FinalizerSystem.hpp"
+
+namespace {
+
+auto createObject(entt::registry& registry, size_t i) -> entt::entity {
+  const auto entity = registry.create();
+  registry.emplace<tr::Renderable>(
+      entity,
+      std::vector<tr::Handle<tr::Geometry>>{tr::Handle<tr::Geometry>{.id = i}},
+      std::vector<tr::Handle<tr::TextureTag>>{});
+  registry.emplace<tr::Transform>(entity,
+                                  tr::Transform{.rotation = glm::quat{1.f, 0.f, 0.f, 0.f},
+                                                .position = glm::vec3{static_cast<float>(i)},
+                                                .scale = glm::vec3{1.f}});
+  return entity;
+}
+
+auto sameObjects(const tr::SimState& a, const tr::SimState& b) -> bool {
+  if (a.objectMetadata.size() != b.objectMetadata.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.objectMetadata.size(); ++i) {
+    if (a.entityIds[i] != b.entityIds[i] || a.positions[i].position != b.positions[i].position ||
+        a.rotations[i].rotation != b.rotations[i].rotation ||
+        a.scales[i].scale != b.scales[i].scale ||
+        a.stateHandles[i].geometryHandle != b.stateHandles[i].geometryHandle ||
+        a.objectMetadata[i].transformIndex != b.objectMetadata[i].transformIndex ||
+        a.objectVersions[i] != b.objectVersions[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+TEST_CASE("FinalizerSystem parallel extraction matches serial", "[FinalizerSystem]") {
+  entt::registry registry;
+  // Enough for a few full chunks and a partial one.
+  const auto objectCount = (tr::FinalizerSystem::ChunkSize * 3) + 17;
+  for (size_t i = 0; i < objectCount; ++i) {
+    createObject(registry, i);
+  }
+
+  auto jobSystem = std::make_shared<tr::JobSystem>(tr::JobSystemConfig{.workerCount = 4});
+  tr::FinalizerSystem serial{registry};
+  tr::FinalizerSystem parallel{registry, jobSystem};
+
+  auto serialState = tr::SimState{};
+  auto parallelState = tr::SimState{};
+  serial.update(serialState, tr::Timestamp{});
+  parallel.update(parallelState, tr::Timestamp{});
+
+  REQUIRE(serialState.objectMetadata.size() == objectCount);
+  CHECK(sameObjects(serialState, parallelState));
+  for (uint32_t i = 0; i < objectCount; ++i) {
+    CHECK(parallelState.objectMetadata[i].transformIndex == i);
+  }
+}
+
+TEST_CASE("FinalizerSystem only rewrites objects changed since the state's tick",
+          "[FinalizerSystem]") {
+  entt::registry registry;
+  auto entities = std::vector<entt::entity>{};
+  for (size_t i = 0; i < 8; ++i) {
+    entities.push_back(createObject(registry, i));
+  }
+  tr::FinalizerSystem finalizer{registry};
+
+  auto older = tr::SimState{};
+  auto newer = tr::SimState{};
+  finalizer.update(older, tr::Timestamp{});
+  finalizer.update(newer, tr::Timestamp{});
+
+  registry.patch<tr::Transform>(entities[3],
+                                [](tr::Transform& transform) { transform.position.x = 100.f; });
+
+  // Reusing `older` picks up the change, without clearing the rest of the state.
+  finalizer.update(older, tr::Timestamp{});
+  CHECK(older.tick == 3);
+  CHECK(older.positions[3].position.x == 100.f);
+  CHECK(older.objectVersions[3] == 3);
+  CHECK(older.objectVersions[2] == 1);
+  CHECK(older.positions[2].position.x == 2.f);
+
+  SECTION("A destroyed object's slot is filled by the last object") {
+    registry.destroy(entities[1]);
+    finalizer.update(newer, tr::Timestamp{});
+
+    REQUIRE(newer.objectMetadata.size() == 7);
+    CHECK(newer.entityIds[1] == static_cast<uint32_t>(entities[7]));
+    CHECK(newer.positions[1].position.x == 7.f);
+    CHECK(newer.objectVersions[1] == 4);
+    CHECK(newer.positions[3].position.x == 100.f);
+  }
+}
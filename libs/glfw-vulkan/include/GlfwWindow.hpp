@@ -32,6 +32,7 @@ public:
   auto operator=(GlfwWindow&&) -> GlfwWindow& = delete;
 
   void pollEvents() override;
+  void waitEvents(std::chrono::milliseconds timeout) override;
   void setVulkanVersion(std::string_view version) override;
   auto createVulkanSurface(const vk::Instance& instance, VkSurfaceKHR* outSurface) const
       -> void override;
@@ -50,8 +51,11 @@ private:
   bool isFullscreen{};
   bool isMouseCaptured{};
   int prevXPos{}, prevYPos{}, prevWidth{}, prevHeight{};
+  /// Latest cursor position seen while processing events, emitted once when they're done
+  std::optional<glm::dvec2> pendingCursorPos;
 
   auto toggleFullscreen() -> void;
+  auto emitPendingCursorPos() -> void;
 
   static void errorCallback(int code, const char* description);
   static void windowIconifiedCallback(GLFWwindow* window, int iconified);
@@ -132,8 +132,23 @@ auto GlfwWindow::shouldClose() const -> bool {
   return glfwWindowShouldClose(window) != 0;
 }
 
+/// High polling rate mice can report hundreds of positions per poll. Only the last one matters to
+/// anything downstream, so that's the only one emitted.
 auto GlfwWindow::pollEvents() -> void {
   glfwPollEvents();
+  emitPendingCursorPos();
+}
+
+auto GlfwWindow::waitEvents(std::chrono::milliseconds timeout) -> void {
+  glfwWaitEventsTimeout(std::chrono::duration<double>(timeout).count());
+  emitPendingCursorPos();
+}
+
+auto GlfwWindow::emitPendingCursorPos() -> void {
+  if (pendingCursorPos) {
+    eventBus->emit(tr::MouseMoved{.x = pendingCursorPos->x, .y = pendingCursorPos->y});
+    pendingCursorPos.reset();
+  }
 }
 
 auto GlfwWindow::setVulkanVersion(std::string_view vulkanVersion) -> void {
@@ -220,7 +235,7 @@ void GlfwWindow::keyCallback(GLFWwindow* window,
 void GlfwWindow::cursorPosCallback(GLFWwindow* window, const double xpos, const double ypos) {
   if (auto* const thisWindow = static_cast<GlfwWindow*>(glfwGetWindowUserPointer(window));
       thisWindow->isMouseCaptured) {
-    thisWindow->eventBus->emit(tr::MouseMoved{.x = xpos, .y = ypos});
+    thisWindow->pendingCursorPos = glm::dvec2{xpos, ypos};
   }
 }
 
@@ -2,11 +2,15 @@
 
 namespace tr {
 
+/// The acquire half of an image's ownership transfer to the graphics queue, matching the release
+/// recorded on the queue that uploaded it
 struct ImageTransitionInfo {
   vk::Image image;
   vk::ImageLayout oldLayout;
   vk::ImageLayout newLayout;
   vk::ImageSubresourceRange subresourceRange;
+  uint32_t srcQueueFamily;
+  uint32_t dstQueueFamily;
 };
 
 class ImageTransitionQueue {
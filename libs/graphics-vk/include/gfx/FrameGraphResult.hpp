@@ -0,0 +1,31 @@
+#pragma once
+
+#include "vk/command-buffer/QueueType.hpp"
+
+namespace tr {
+
+/// A submission waiting on another to be done, through the timeline semaphore of the other's queue
+struct SubmissionWait {
+  /// Index into the plan's submissions
+  size_t submission;
+  /// Waits on that submission from the run before, rather than from this one
+  bool previousRun;
+  /// Stages that can't start until then
+  vk::PipelineStageFlags2 stages;
+};
+
+/// Command buffers to submit together to one queue, once the submissions they wait on are done
+struct FrameGraphSubmission {
+  QueueType queueType;
+  std::vector<vk::CommandBuffer> commandBuffers;
+  /// Indices into the result's submissions, from this frame or the one before
+  std::vector<SubmissionWait> waits;
+};
+
+/// Submissions in the order they have to be submitted, the last one finishing means every one
+/// has
+struct FrameGraphResult {
+  std::vector<FrameGraphSubmission> submissions;
+};
+
+}
@@ -11,6 +11,7 @@ class IAssetSystem;
 class IAssetService;
 class IGuiCallbackRegistrar;
 class EditorStateBuffer;
+class TimingLog;
 
 class GraphicsContext {
 public:
@@ -34,8 +35,21 @@ public:
                      std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
       -> std::shared_ptr<GraphicsContext>;
 
+  /// Builds a context with no window or GPU, where everything that would go to Vulkan is counted
+  /// by a null device instead. Used to profile the engine's CPU cost on machines with no GPU.
+  static auto createHeadless(std::shared_ptr<IEventQueue> newEventQueue,
+                             std::shared_ptr<IStateBuffer> newStateBuffer,
+                             std::shared_ptr<IAssetService> newAssetService,
+                             std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
+      -> std::shared_ptr<GraphicsContext>;
+
   auto run(std::stop_token token) -> void;
 
+  /// Records how long every frame takes from here on
+  auto setTimingLog(std::shared_ptr<TimingLog> newFrameTimings) -> void;
+  /// Emits WindowClosed once this many frames have rendered
+  auto setFrameLimit(uint64_t newFrameLimit) -> void;
+
 private:
   std::shared_ptr<IEventQueue> eventQueue;
   std::shared_ptr<IRenderContext> renderContext;
@@ -43,6 +57,8 @@ private:
   std::shared_ptr<IWindow> window;
   std::shared_ptr<Device> device;
   std::shared_ptr<IAssetSystem> assetSystem;
+  std::shared_ptr<TimingLog> frameTimings;
+  std::optional<uint64_t> frameLimit;
 };
 
 }
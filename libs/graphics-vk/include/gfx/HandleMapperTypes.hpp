@@ -1,13 +1,13 @@
 #pragma once
 
 #include "api/gfx/Geometry.hpp"
-#include "bk/HandleMapper.hpp"
+#include "bk/DenseHandleMapper.hpp"
 #include "resources/allocators/GeometryAllocator.hpp"
 #include "img/Texture.hpp"
 
 namespace tr {
 
-using GeometryHandleMapper = HandleMapper<Geometry, GeometryRegion>;
-using TextureHandleMapper = HandleMapper<TextureTag, Texture>;
+using GeometryHandleMapper = DenseHandleMapper<Geometry, GeometryRegion>;
+using TextureHandleMapper = DenseHandleMapper<TextureTag, Texture>;
 
 }
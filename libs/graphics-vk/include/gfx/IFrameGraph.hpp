@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bk/Handle.hpp"
+#include "gfx/FrameGraphResult.hpp"
 #include "r3/ComponentIds.hpp"
 #include "vk/ResourceManagerHandles.hpp"
 #include "r3/render-pass/IRenderPass.hpp"
@@ -23,10 +24,6 @@ struct PassInfo2 {
   bool hasSideEffects = false;
 };
 
-struct FrameGraphResult {
-  std::vector<vk::CommandBuffer> commandBuffers;
-};
-
 class IFrameGraph {
 public:
   IFrameGraph() = default;
@@ -39,6 +36,12 @@ public:
 
   virtual auto addPass(std::unique_ptr<IRenderPass>&& pass) -> void = 0;
   [[nodiscard]] virtual auto getPass(PassId id) -> std::unique_ptr<IRenderPass>& = 0;
+  /// The queue `pass` is submitted to, which isn't always the one it asks for
+  [[nodiscard]] virtual auto getQueueType(const IRenderPass& pass) const -> QueueType = 0;
+
+  /// A disabled image is left out of every pass's reads, so a pass that only feeds it is culled.
+  /// Takes effect at the next bake().
+  virtual auto setImageEnabled(ImageAlias alias, bool enabled) -> void = 0;
 
   virtual auto bake() -> void = 0;
 
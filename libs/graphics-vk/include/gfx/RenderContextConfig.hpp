@@ -1,6 +1,16 @@
 #pragma once
 
 namespace tr {
+
+/// Which game tick the render thread draws each frame.
+enum class FramePacing : uint8_t {
+  /// Wait for a tick that hasn't been drawn yet and draw it as-is. Lowest latency, but the frame
+  /// rate follows the tick rate.
+  Latest = 0,
+  /// Draw `interpolationLag` behind the current time, blending the ticks either side of it.
+  Interpolate
+};
+
 struct RenderContextConfig {
   bool useDescriptorBuffers{};
   uint32_t maxStaticObjects{};
@@ -12,5 +22,14 @@ struct RenderContextConfig {
   uint32_t initialHeight{};
   float renderScale{1.f};
   uint32_t maxDebugObjects{};
+  FramePacing framePacing{FramePacing::Interpolate};
+  std::chrono::milliseconds interpolationLag{};
+  /// How long a frame waits for the state it needs before giving up and drawing nothing
+  std::chrono::milliseconds maxStateWait{100};
+  /// Threads the frame graph records passes on, with none they're recorded on the render thread
+  uint8_t recordingThreads{};
+  /// Run passes that ask for it, like culling, on a compute queue family of their own so they can
+  /// overlap graphics work. Passes stay on the graphics queue when the device has no such family.
+  bool asyncCompute{};
 };
 }
@@ -4,10 +4,13 @@
 #include "gfx/QueueTypes.hpp"
 #include "r3/GeometryBufferPack.hpp"
 #include "r3/graph/OrderedFrameGraph.hpp"
+#include "r3/graph/PassRecorder.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
 #include "resources/DefaultAssetSystem.hpp"
 #include "DefaultDebugManager.hpp"
+#include "api/fx/Events.hpp"
 #include "api/fx/IEventQueue.hpp"
+#include "bk/TimingLog.hpp"
 #include "mem/Allocator.hpp"
 #include "pipeline/SpirvShaderModuleFactory.hpp"
 #include "resources/TransferSystem.hpp"
@@ -40,6 +43,11 @@
 
 #include "api/gw/EditorStateBuffer.hpp"
 
+#include "headless/NullAssetSystem.hpp"
+#include "headless/NullDevice.hpp"
+#include "headless/NullGeometryStore.hpp"
+#include "headless/NullRenderContext.hpp"
+
 #define BOOST_DI_CFG_CTOR_LIMIT_SIZE 25
 #include <di.hpp>
 
@@ -81,7 +89,11 @@ auto GraphicsContext::create(std::shared_ptr<IEventQueue> newEventQueue,
                                             .framesInFlight = 2,
                                             .initialWidth = 1920,
                                             .initialHeight = 1080,
-                                            .maxDebugObjects = 32};
+                                            .maxDebugObjects = 32,
+                                            .framePacing = FramePacing::Interpolate,
+                                            .interpolationLag = std::chrono::milliseconds{0},
+                                            .recordingThreads = 2,
+                                            .asyncCompute = true};
 
   const auto injector = di::make_injector(
       di::bind<IEventQueue>.to<>(newEventQueue),
@@ -107,6 +119,7 @@ auto GraphicsContext::create(std::shared_ptr<IEventQueue> newEventQueue,
       di::bind<IFrameManager>.to<DefaultFrameManager>(),
       di::bind<IRenderContext>.to<R3Renderer>(),
       di::bind<IFrameGraph>.to<OrderedFrameGraph>(),
+      di::bind<PassRecorder>.to<PassRecorder>(),
       di::bind<PipelineFactory>.to<PipelineFactory>(),
       di::bind<ImageManager>.to<ImageManager>(),
       di::bind<BufferSystem>.to<BufferSystem>(),
@@ -126,6 +139,40 @@ auto GraphicsContext::create(std::shared_ptr<IEventQueue> newEventQueue,
   return injector.create<std::shared_ptr<GraphicsContext>>();
 }
 
+auto GraphicsContext::createHeadless(std::shared_ptr<IEventQueue> newEventQueue,
+                                     std::shared_ptr<IStateBuffer> newStateBuffer,
+                                     std::shared_ptr<IAssetService> newAssetService,
+                                     std::shared_ptr<EditorStateBuffer> newEditorStateBuffer)
+    -> std::shared_ptr<GraphicsContext> {
+  Log.trace("GraphicsContext::createHeadless()");
+  // Draw each tick once, so frame counts are comparable between runs
+  auto rendererConfig = RenderContextConfig{.maxStaticObjects = 1024,
+                                            .maxDynamicObjects = 1024,
+                                            .maxTerrainChunks = 1024,
+                                            .maxTextures = 16,
+                                            .framesInFlight = 2,
+                                            .maxDebugObjects = 32,
+                                            .framePacing = FramePacing::Latest};
+
+  const auto injector =
+      di::make_injector(di::bind<IEventQueue>.to<>(newEventQueue),
+                        di::bind<IStateBuffer>.to<>(newStateBuffer),
+                        di::bind<IAssetService>.to<>(newAssetService),
+                        di::bind<EditorStateBuffer>.to<>(newEditorStateBuffer),
+                        di::bind<RenderContextConfig>.to<>(rendererConfig),
+                        di::bind<GeometryHandleMapper>.to(std::make_shared<GeometryHandleMapper>()),
+                        di::bind<NullDevice>.to<NullDevice>(),
+                        di::bind<NullGeometryStore>.to<NullGeometryStore>(),
+                        di::bind<IRenderContext>.to<NullRenderContext>(),
+                        di::bind<IAssetSystem>.to<NullAssetSystem>());
+
+  return std::make_shared<GraphicsContext>(newEventQueue,
+                                           injector.create<std::shared_ptr<IRenderContext>>(),
+                                           newStateBuffer,
+                                           nullptr,
+                                           injector.create<std::shared_ptr<IAssetSystem>>());
+}
+
 // NOLINTNEXTLINE
 auto GraphicsContext::run(std::stop_token token) -> void {
   using Clock = std::chrono::steady_clock;
@@ -133,6 +180,7 @@ auto GraphicsContext::run(std::stop_token token) -> void {
 
   assetSystem->run();
 
+  auto frame = uint64_t{};
   while (!token.stop_requested()) {
     auto newTime = Clock::now();
     auto frameTime = newTime - currentTime;
@@ -143,10 +191,29 @@ auto GraphicsContext::run(std::stop_token token) -> void {
 
     eventQueue->dispatchPending();
     renderContext->renderNextFrame();
+    if (frameTimings) {
+      frameTimings->record(frame, newTime, Clock::now());
+    }
+    ++frame;
+    if (frame == frameLimit) {
+      Log.info("Rendered {} frames, closing", frame);
+      eventQueue->emit(WindowClosed{});
+    }
   }
   Log.trace("graphicsThread token stop_requested()");
-  device->waitIdle();
+  // Headless contexts have no device
+  if (device) {
+    device->waitIdle();
+  }
   assetSystem->requestStop();
 }
 
+auto GraphicsContext::setTimingLog(std::shared_ptr<TimingLog> newFrameTimings) -> void {
+  frameTimings = std::move(newFrameTimings);
+}
+
+auto GraphicsContext::setFrameLimit(uint64_t newFrameLimit) -> void {
+  frameLimit = newFrameLimit;
+}
+
 }
@@ -34,5 +34,10 @@ struct BufferCreateInfo {
   size_t itemStride = 0;
   std::string debugName;
   bool indirect{false};
+  /// Shared concurrently between the graphics, compute and transfer queue families, so it can be
+  /// read on any of them without transferring ownership, and the frame graph leaves it out of its
+  /// transfers. For buffers only the host or the transfer queue writes that culling and drawing
+  /// both read, like the geometry and per object buffers.
+  bool concurrent{false};
 };
 }
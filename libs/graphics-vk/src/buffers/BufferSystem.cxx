@@ -21,12 +21,18 @@ BufferSystem::BufferSystem(std::shared_ptr<IFrameManager> newFrameManager,
       allocator{std::move(newAllocator)},
       frameState{std::move(newFramestate)} {
   Log.trace("Creating BufferSystem");
+  sharedQueueFamilies = {device->getGraphicsQueueFamily(),
+                         device->getComputeQueueFamily(),
+                         device->getTransferQueueFamily()};
+  std::ranges::sort(sharedQueueFamilies);
+  const auto duplicates = std::ranges::unique(sharedQueueFamilies);
+  sharedQueueFamilies.erase(duplicates.begin(), duplicates.end());
 }
 
 BufferSystem::~BufferSystem() {
   Log.trace("Destroying BufferSystem");
   device->waitIdle();
-  bufferMap.clear();
+  buffers.clear();
   Log.trace("BufferSystem Destroyed");
 }
 
@@ -46,7 +52,7 @@ auto BufferSystem::resize(const std::shared_ptr<TransferSystem>& transferSystem,
   // Prepare resizes
   for (const auto& resize : resizeRequests) {
     auto handle = resize.bufferHandle;
-    if (!bufferMap.contains(handle)) {
+    if (!buffers.contains(handle)) {
       continue;
     }
 
@@ -73,7 +79,7 @@ auto BufferSystem::resize(const std::shared_ptr<TransferSystem>& transferSystem,
       newName = input.substr(0, pos + 2) + std::to_string(version + 1);
     }
 
-    auto newBuffer = allocator->createBuffer2(bci, aci, newName);
+    auto newBuffer = createManagedBuffer(bci, aci, newName);
     copyPairs.emplace_back(*oldBuffer, newBuffer.get());
 
     jobs.push_back(ResizeJob{.handle = handle,
@@ -86,31 +92,46 @@ auto BufferSystem::resize(const std::shared_ptr<TransferSystem>& transferSystem,
 
   // Finalize buffer version
   const auto currentFrame = frameState->getFrame();
+  if (!jobs.empty()) {
+    if (latestVersionFrame <= currentFrame) {
+      settledVersionFrame = latestVersionFrame;
+    }
+    latestVersionFrame = currentFrame + 1;
+  }
   for (auto& job : jobs) {
     job.newBuffer->setValidFromFrame(currentFrame + 1);
     job.oldBuffer->setValidToFrame(currentFrame + 1);
 
-    auto& entry = bufferMap.at(job.handle);
-    entry->versions.emplace_back(std::move(job.newBuffer));
-    entry->currentSize = job.newSize;
+    auto& entry = buffers.at(job.handle);
+    entry.versions.emplace_back(std::move(job.newBuffer));
+    entry.currentSize = job.newSize;
 
     // Somehow update bufferMeta's bci with new size
-    entry->versions.back()->setSize(job.newSize);
-    if (allocatorMap.contains(job.handle)) {
-      allocatorMap.at(job.handle)->notifyBufferResized(job.newSize);
+    entry.versions.back()->setSize(job.newSize);
+    if (entry.allocator) {
+      entry.allocator->notifyBufferResized(job.newSize);
     } else {
       Log.warn("Resized a buffer with no allocator: {}", job.handle.id);
     }
   }
 }
 
-auto BufferSystem::getBufferAddress(Handle<ManagedBuffer> handle) -> std::optional<uint64_t> {
-  const auto managedBuffer = getCurrentManagedBufferConst(handle);
+auto BufferSystem::getBufferAddress(Handle<ManagedBuffer> handle) const
+    -> std::optional<uint64_t> {
+  return getCurrentManagedBufferConst(handle).and_then(
+      [](const ManagedBuffer* mb) { return mb->getDeviceAddress(); });
+}
 
-  return managedBuffer.transform([this](const ManagedBuffer* mb) -> uint64_t {
-    return device->getVkDevice().getBufferAddress(
-        vk::BufferDeviceAddressInfo{.buffer = mb->getVkBuffer()});
-  });
+auto BufferSystem::isConcurrent(Handle<ManagedBuffer> handle) const -> bool {
+  return buffers.at(handle).concurrent;
+}
+
+auto BufferSystem::isConcurrent(LogicalHandle<ManagedBuffer> handle) const -> bool {
+  return isConcurrent(frameManager->getFrames().front()->getLogicalBuffer(handle));
+}
+
+auto BufferSystem::getAddressGeneration() const -> uint64_t {
+  return frameState->getFrame() >= latestVersionFrame ? latestVersionFrame : settledVersionFrame;
 }
 
 auto BufferSystem::getVkBuffer(Handle<ManagedBuffer> handle) -> std::optional<const vk::Buffer*> {
@@ -121,28 +142,30 @@ auto BufferSystem::getVkBuffer(Handle<ManagedBuffer> handle) -> std::optional<co
 }
 
 auto BufferSystem::registerBuffer(const BufferCreateInfo& createInfo) -> Handle<ManagedBuffer> {
-  const auto handle = bufferHandleGenerator.requestHandle();
-
   auto [bci, aci] = fromCreateInfo(createInfo);
+  // Concurrent sharing needs at least two families, with one there's nothing to transfer anyway
+  if (createInfo.concurrent && sharedQueueFamilies.size() > 1) {
+    bci.sharingMode = vk::SharingMode::eConcurrent;
+    bci.queueFamilyIndexCount = static_cast<uint32_t>(sharedQueueFamilies.size());
+    bci.pQueueFamilyIndices = sharedQueueFamilies.data();
+  }
 
   auto versions = std::deque<std::unique_ptr<ManagedBuffer>>{};
   const auto name = std::format("{}-v0", createInfo.debugName);
-  versions.emplace_back(allocator->createBuffer2(bci, aci, name));
-  bufferMap.emplace(
-      handle,
-      std::make_unique<BufferEntry>(BufferEntry{.lifetime = createInfo.bufferLifetime,
-                                                .versions = std::move(versions),
-                                                .currentSize = createInfo.initialSize}));
+  versions.emplace_back(createManagedBuffer(bci, aci, name));
+  const auto handle = buffers.insert(BufferEntry{.lifetime = createInfo.bufferLifetime,
+                                                 .versions = std::move(versions),
+                                                 .currentSize = createInfo.initialSize,
+                                                 .concurrent = createInfo.concurrent});
+  auto& entry = buffers.at(handle);
   switch (createInfo.allocationStrategy) {
     case AllocationStrategy::Linear:
-      allocatorMap.emplace(
-          handle,
-          std::make_unique<LinearAllocator>(handle, createInfo.initialSize, createInfo.debugName));
+      entry.allocator =
+          std::make_unique<LinearAllocator>(handle, createInfo.initialSize, createInfo.debugName);
       break;
     case AllocationStrategy::Arena:
-      allocatorMap.emplace(
-          handle,
-          std::make_unique<ArenaAllocator>(handle, createInfo.initialSize, createInfo.debugName));
+      entry.allocator =
+          std::make_unique<ArenaAllocator>(handle, createInfo.initialSize, createInfo.debugName);
       break;
     case AllocationStrategy::Resizable:
 
@@ -166,11 +189,11 @@ auto BufferSystem::registerPerFrameBuffer(const BufferCreateInfo& createInfo)
 }
 
 auto BufferSystem::insert(Handle<ManagedBuffer> handle,
-                          void* data,
+                          const void* data,
                           const BufferRegion& targetRegion) -> std::optional<BufferRegion> {
   std::optional<BufferRegion> maybeBufferRegion = std::nullopt;
   auto managedBuffer = getCurrentManagedBuffer(handle);
-  const auto lifetime = bufferMap.at(handle)->lifetime;
+  const auto lifetime = buffers.at(handle).lifetime;
 
   if (lifetime == BufferLifetime::Transient) {
     if (managedBuffer.has_value()) {
@@ -184,14 +207,13 @@ auto BufferSystem::insert(Handle<ManagedBuffer> handle,
 }
 
 auto BufferSystem::allocate(Handle<ManagedBuffer> handle, size_t size) -> BufferRegion {
-  assert(bufferMap.contains(handle) && "During allocation, buffer handle doesn't exist");
+  assert(buffers.contains(handle) && "During allocation, buffer handle doesn't exist");
 
-  const auto lifetime = bufferMap.at(handle)->lifetime;
+  auto& entry = buffers.at(handle);
 
-  if (lifetime == BufferLifetime::Persistent) {
-    assert(allocatorMap.contains(handle) && "No allocator found for given buffer");
-    auto& bufferAllocator = allocatorMap.at(handle);
-    return bufferAllocator->allocate(BufferRequest{.size = size});
+  if (entry.lifetime == BufferLifetime::Persistent) {
+    assert(entry.allocator && "No allocator found for given buffer");
+    return entry.allocator->allocate(BufferRequest{.size = size});
   }
   assert("Tried to allocate a transient buffer");
   return BufferRegion{};
@@ -199,18 +221,18 @@ auto BufferSystem::allocate(Handle<ManagedBuffer> handle, size_t size) -> Buffer
 
 auto BufferSystem::checkSize(Handle<ManagedBuffer> handle, size_t size)
     -> std::optional<ResizeRequest> {
-  if (!allocatorMap.contains(handle)) {
+  auto* entry = buffers.find(handle);
+  if (entry == nullptr || !entry->allocator) {
     Log.warn("Check size of a buffer that doesn't have an allocator, handle={}", handle.id);
     return std::nullopt;
   }
-  auto& allocator = allocatorMap.at(handle);
-  return allocator->checkSize(BufferRequest{.size = size});
+  return entry->allocator->checkSize(BufferRequest{.size = size});
 }
 
 auto BufferSystem::removeData(Handle<ManagedBuffer> handle, const BufferRegion& region) -> void {
-  assert(bufferMap.contains(handle));
-  if (allocatorMap.contains(handle)) {
-    allocatorMap.at(handle)->freeRegion(region);
+  auto& entry = buffers.at(handle);
+  if (entry.allocator) {
+    entry.allocator->freeRegion(region);
   } else {
     Log.warn("removeData called with a buffer that has no allocator registered");
   }
@@ -219,11 +241,11 @@ auto BufferSystem::removeData(Handle<ManagedBuffer> handle, const BufferRegion&
 auto BufferSystem::pruneOldVersions() -> void {
   const auto currentFrame = frameState->getFrame();
 
-  for (auto& [handle, entry] : bufferMap) {
-    if (entry->lifetime == BufferLifetime::Transient) {
+  for (auto& entry : buffers) {
+    if (entry.lifetime == BufferLifetime::Transient) {
       continue;
     }
-    auto& versions = entry->versions;
+    auto& versions = entry.versions;
     const auto pruneBeforeFrame = currentFrame > 3 ? currentFrame - 3 : 0;
     versions.erase(std::ranges::remove_if(versions,
                                           [&](const std::unique_ptr<ManagedBuffer>& buffer) {
@@ -236,6 +258,16 @@ auto BufferSystem::pruneOldVersions() -> void {
   }
 }
 
+auto BufferSystem::createManagedBuffer(const vk::BufferCreateInfo& bci,
+                                       const vma::AllocationCreateInfo& aci,
+                                       const std::string& name) const
+    -> std::unique_ptr<ManagedBuffer> {
+  auto managedBuffer = allocator->createBuffer2(bci, aci, name);
+  managedBuffer->setDeviceAddress(device->getVkDevice().getBufferAddress(
+      vk::BufferDeviceAddressInfo{.buffer = managedBuffer->getVkBuffer()}));
+  return managedBuffer;
+}
+
 auto BufferSystem::fromCreateInfo(const BufferCreateInfo& createInfo)
     -> std::tuple<vk::BufferCreateInfo, vma::AllocationCreateInfo> {
   auto bci = vk::BufferCreateInfo{.size = createInfo.initialSize,
@@ -280,14 +312,13 @@ auto BufferSystem::fromCreateInfo(const BufferCreateInfo& createInfo)
 
 auto BufferSystem::getCurrentManagedBufferConst(Handle<ManagedBuffer> handle) const
     -> std::optional<const ManagedBuffer*> {
-  assert(bufferMap.contains(handle));
-  const auto& entry = bufferMap.at(handle);
+  const auto& entry = buffers.at(handle);
   std::optional<const ManagedBuffer*> managedBuffer = std::nullopt;
 
-  if (entry->lifetime == BufferLifetime::Transient) {
-    managedBuffer.emplace(entry->versions.front().get());
+  if (entry.lifetime == BufferLifetime::Transient) {
+    managedBuffer.emplace(entry.versions.front().get());
   } else {
-    for (const auto& rec : entry->versions | std::ranges::views::reverse) {
+    for (const auto& rec : entry.versions | std::ranges::views::reverse) {
       if (rec->getValidFromFrame() <= frameState->getFrame() &&
           (!rec->getValidToFrame() || *rec->getValidToFrame() > frameState->getFrame())) {
         managedBuffer.emplace(rec.get());
@@ -299,14 +330,13 @@ auto BufferSystem::getCurrentManagedBufferConst(Handle<ManagedBuffer> handle) co
 
 auto BufferSystem::getCurrentManagedBuffer(Handle<ManagedBuffer> handle)
     -> std::optional<ManagedBuffer*> {
-  assert(bufferMap.contains(handle));
-  const auto& entry = bufferMap.at(handle);
+  const auto& entry = buffers.at(handle);
   std::optional<ManagedBuffer*> managedBuffer = std::nullopt;
 
-  if (entry->lifetime == BufferLifetime::Transient) {
-    managedBuffer.emplace(entry->versions.front().get());
+  if (entry.lifetime == BufferLifetime::Transient) {
+    managedBuffer.emplace(entry.versions.front().get());
   } else {
-    for (const auto& rec : entry->versions | std::ranges::views::reverse) {
+    for (const auto& rec : entry.versions | std::ranges::views::reverse) {
       if (rec->getValidFromFrame() <= frameState->getFrame() &&
           (!rec->getValidToFrame() || *rec->getValidToFrame() > frameState->getFrame())) {
         managedBuffer.emplace(rec.get());
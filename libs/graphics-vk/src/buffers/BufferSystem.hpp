@@ -2,6 +2,7 @@
 
 #include "bk/Handle.hpp"
 #include "bk/HandleGenerator.hpp"
+#include "bk/SlotMap.hpp"
 #include "buffers/BufferCreateInfo.hpp"
 #include "buffers/ManagedBuffer.hpp"
 #include "resources/allocators/IBufferAllocator.hpp"
@@ -21,6 +22,9 @@ struct BufferEntry {
   BufferLifetime lifetime;
   std::deque<std::unique_ptr<ManagedBuffer>> versions;
   size_t currentSize{0};
+  /// Null for buffers that aren't suballocated.
+  std::unique_ptr<IBufferAllocator> allocator;
+  bool concurrent{false};
 };
 
 class BufferSystem {
@@ -46,7 +50,7 @@ public:
   auto registerPerFrameBuffer(const BufferCreateInfo& createInfo) -> LogicalHandle<ManagedBuffer>;
 
   /// Write `size` data at the specified `offset` in the buffer.
-  auto insert(Handle<ManagedBuffer> handle, void* data, const BufferRegion& targetRegion)
+  auto insert(Handle<ManagedBuffer> handle, const void* data, const BufferRegion& targetRegion)
       -> std::optional<BufferRegion>;
 
   /// Removes the data from the buffer described by the given `BufferRegion`. Should be quick as it
@@ -62,8 +66,21 @@ public:
 
   auto checkSize(Handle<ManagedBuffer> handle, size_t size) -> std::optional<ResizeRequest>;
 
-  /// Gets the buffer's address as a uint64_t to be set into a PushConstant.
-  auto getBufferAddress(Handle<ManagedBuffer> handle) -> std::optional<uint64_t>;
+  /// Gets the buffer's address as a uint64_t to be set into a PushConstant. Each version of a
+  /// buffer has its address looked up once when it's created, so this only reads.
+  [[nodiscard]] auto getBufferAddress(Handle<ManagedBuffer> handle) const
+      -> std::optional<uint64_t>;
+
+  /// Moves on whenever a resized buffer's new version takes over from the old one, which is the
+  /// only time an address handed out by getBufferAddress changes. Anything holding on to
+  /// addresses can compare this against the value it last fetched them at.
+  [[nodiscard]] auto getAddressGeneration() const -> uint64_t;
+
+  /// Whether the buffer was registered `concurrent`, so any queue family can use it without
+  /// ownership transfers.
+  [[nodiscard]] auto isConcurrent(Handle<ManagedBuffer> handle) const -> bool;
+  /// Every frame's buffer is registered from the same create info, so they all agree.
+  [[nodiscard]] auto isConcurrent(LogicalHandle<ManagedBuffer> handle) const -> bool;
 
   /// Escape Hatch to get the `vk::Buffer`
   auto getVkBuffer(Handle<ManagedBuffer> handle) -> std::optional<const vk::Buffer*>;
@@ -84,9 +101,17 @@ private:
   std::shared_ptr<Allocator> allocator;
   std::shared_ptr<FrameState> frameState;
 
+  /// The distinct graphics, compute and transfer families, which concurrent buffers are shared
+  /// between. Resizes reuse a buffer's create info, so this has to outlive every buffer.
+  std::vector<uint32_t> sharedQueueFamilies;
+
   HandleGenerator<ManagedBuffer> bufferHandleGenerator;
-  std::unordered_map<Handle<ManagedBuffer>, std::unique_ptr<BufferEntry>> bufferMap;
-  std::unordered_map<Handle<ManagedBuffer>, std::unique_ptr<IBufferAllocator>> allocatorMap;
+  SlotMap<BufferEntry, ManagedBuffer> buffers;
+
+  /// Frame the newest versions from a resize become current on, and the one before that. Resizes
+  /// always take over on the next frame, so at most one can be waiting at a time.
+  uint64_t latestVersionFrame{};
+  uint64_t settledVersionFrame{};
 
   [[nodiscard]] auto getCurrentManagedBuffer(Handle<ManagedBuffer> handle)
       -> std::optional<ManagedBuffer*>;
@@ -94,6 +119,12 @@ private:
   [[nodiscard]] auto getCurrentManagedBufferConst(Handle<ManagedBuffer> handle) const
       -> std::optional<const ManagedBuffer*>;
 
+  /// Creates a version of a buffer and stores its device address on it.
+  [[nodiscard]] auto createManagedBuffer(const vk::BufferCreateInfo& bci,
+                                         const vma::AllocationCreateInfo& aci,
+                                         const std::string& name) const
+      -> std::unique_ptr<ManagedBuffer>;
+
   static auto fromCreateInfo(const BufferCreateInfo& createInfo)
       -> std::tuple<vk::BufferCreateInfo, vma::AllocationCreateInfo>;
 };
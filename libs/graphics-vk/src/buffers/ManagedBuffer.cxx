@@ -42,7 +42,7 @@ auto ManagedBuffer::setSize(size_t newSize) -> void {
   bufferMeta.bufferCreateInfo.setSize(newSize);
 }
 
-auto ManagedBuffer::uploadData(void* srcData, size_t size, size_t offset) -> void {
+auto ManagedBuffer::uploadData(const void* srcData, size_t size, size_t offset) -> void {
   assert(isMappable());
   if (this->mappedData == nullptr) {
     map();
@@ -94,4 +94,12 @@ auto ManagedBuffer::setValidToFrame(uint64_t frame) -> void {
   validToFrame = frame;
 }
 
+auto ManagedBuffer::getDeviceAddress() const -> std::optional<uint64_t> {
+  return deviceAddress;
+}
+
+auto ManagedBuffer::setDeviceAddress(uint64_t address) -> void {
+  deviceAddress = address;
+}
+
 }
@@ -42,7 +42,7 @@ public:
 
   auto map() -> void;
 
-  auto uploadData(void* srcData, size_t size, size_t offset = 0) -> void;
+  auto uploadData(const void* srcData, size_t size, size_t offset = 0) -> void;
 
   [[nodiscard]] auto getMeta() const -> const BufferMeta&;
 
@@ -54,6 +54,11 @@ public:
 
   auto setSize(size_t newSize) -> void;
 
+  /// Set by BufferSystem when it creates the buffer, as it can't change for the life of the
+  /// vk::Buffer.
+  [[nodiscard]] auto getDeviceAddress() const -> std::optional<uint64_t>;
+  auto setDeviceAddress(uint64_t address) -> void;
+
 private:
   vk::Buffer vkBuffer;
   BufferMeta bufferMeta;
@@ -63,6 +68,7 @@ private:
 
   uint64_t validFromFrame{};
   std::optional<uint64_t> validToFrame;
+  std::optional<uint64_t> deviceAddress;
 };
 
 }
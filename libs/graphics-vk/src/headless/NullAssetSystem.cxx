@@ -0,0 +1,116 @@
+#include "headless/NullAssetSystem.hpp"
+#include "api/fx/IAssetService.hpp"
+#include "bk/ThreadName.hpp"
+#include "headless/NullDevice.hpp"
+#include "headless/NullGeometryStore.hpp"
+#include "resources/DefaultAssetSystem.hpp"
+#include "resources/processors/Helpers.hpp"
+
+namespace tr {
+
+/// Matches TransferSystem's staging buffers, so batches are split up the same way
+constexpr size_t NullStagingBufferSize = 183886080;
+
+NullAssetSystem::NullAssetSystem(std::shared_ptr<IEventQueue> newEventQueue,
+                                 std::shared_ptr<IAssetService> newAssetService,
+                                 std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+                                 std::shared_ptr<NullGeometryStore> newGeometryStore,
+                                 std::shared_ptr<NullDevice> newDevice)
+    : eventQueue{std::move(newEventQueue)},
+      assetService{std::move(newAssetService)},
+      geometryHandleMapper{std::move(newGeometryHandleMapper)},
+      geometryStore{std::move(newGeometryStore)},
+      device{std::move(newDevice)} {
+  Log.trace("Constructing NullAssetSystem");
+}
+
+NullAssetSystem::~NullAssetSystem() {
+  Log.trace("Destroying NullAssetSystem");
+}
+
+auto NullAssetSystem::run() -> void {
+  Log.trace("NullAssetSystem::run()");
+
+  thread = std::jthread([&](std::stop_token token) mutable {
+    setCurrentThreadName("Assets");
+    eventQueue->subscribe<BeginResourceBatch>(
+        [this](const auto& batch) { eventBatches[batch->batchId].clear(); });
+
+    eventQueue->subscribe<StaticModelRequest>(
+        [this](const auto& smRequest) { eventBatches[smRequest->batchId].push_back(smRequest); });
+
+    eventQueue->subscribe<StaticMeshRequest>([](const auto& request) {
+      Log.warn("Headless asset system can't upload static mesh {}", request->entityName);
+    });
+    eventQueue->subscribe<DynamicModelRequest>([](const auto& request) {
+      Log.warn("Headless asset system can't upload dynamic model {}", request->entityName);
+    });
+
+    eventQueue->subscribe<EndResourceBatch>(
+        [this](const std::shared_ptr<EndResourceBatch>& batch) {
+          processBatchedResources(batch->batchId);
+        });
+
+    while (!token.stop_requested()) {
+      eventQueue->waitForEvents(token);
+      eventQueue->dispatchPending();
+    }
+    Log.trace("NullAssetSystem thread shutting down");
+  });
+}
+
+auto NullAssetSystem::requestStop() -> void {
+  thread.request_stop();
+}
+
+auto NullAssetSystem::processBatchedResources(uint64_t batchId) -> void {
+  ZoneScopedN("NullAssetSystem::processBatchedResources");
+  auto requirements = std::vector<StagingRequirements>{};
+  for (const auto& request : eventBatches[batchId]) {
+    requirements.push_back(analyze(batchId, *request));
+  }
+  eventBatches.erase(batchId);
+
+  const auto subBatches = DefaultAssetSystem::partition(
+      {.geometry = NullStagingBufferSize, .image = NullStagingBufferSize},
+      requirements);
+
+  for (const auto& subBatch : subBatches) {
+    for (const auto& item : subBatch.items) {
+      upload(item);
+    }
+  }
+}
+
+auto NullAssetSystem::analyze(uint64_t batchId, const StaticModelRequest& request)
+    -> StagingRequirements {
+  const auto& model = assetService->loadModel(request.modelFilename);
+  auto geometryData = processorHelpers::deInterleave(*model.staticVertices, model.indices);
+  return {
+      .cargo = Cargo{.batchId = batchId,
+                     .requestId = request.requestId,
+                     .entityName = request.entityName},
+      .responseType = typeid(StaticModelUploaded),
+      .geometrySize = geometryData->getSize(),
+      .imageSize = model.imageData.data.size(),
+      .geometryData = geometryData,
+      .imageDataList = {std::make_shared<as::ImageData>(model.imageData)},
+  };
+}
+
+auto NullAssetSystem::upload(const StagingRequirements& requirements) -> void {
+  const auto regionHandle = geometryStore->allocate(*requirements.geometryData);
+  device->uploadGeometry(requirements.geometrySize.value_or(0));
+  for (const auto& imageData : requirements.imageDataList) {
+    device->uploadImage(imageData->data.size());
+  }
+
+  eventQueue->emit(StaticModelUploaded{
+      .batchId = requirements.cargo.batchId,
+      .requestId = requirements.cargo.requestId,
+      .entityName = requirements.cargo.entityName,
+      .geometryHandle = geometryHandleMapper->toPublic(regionHandle),
+  });
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "api/fx/IEventQueue.hpp"
+#include "api/fx/ResourceEvents.hpp"
+#include "gfx/HandleMapperTypes.hpp"
+#include "gfx/IAssetSystem.hpp"
+#include "resources/processors/StagingRequirements.hpp"
+
+namespace tr {
+
+class IAssetService;
+class NullDevice;
+class NullGeometryStore;
+
+/// Headless stand-in for DefaultAssetSystem. Loads, de-interleaves and partitions batches the same
+/// way, then records the uploads on a NullDevice instead of staging them, and answers with the
+/// same events so the game world carries on as normal.
+///
+/// Textures are counted but not created, so models come back without a texture handle.
+class NullAssetSystem : public IAssetSystem {
+public:
+  NullAssetSystem(std::shared_ptr<IEventQueue> newEventQueue,
+                  std::shared_ptr<IAssetService> newAssetService,
+                  std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+                  std::shared_ptr<NullGeometryStore> newGeometryStore,
+                  std::shared_ptr<NullDevice> newDevice);
+  ~NullAssetSystem() override;
+
+  NullAssetSystem(const NullAssetSystem&) = delete;
+  NullAssetSystem(NullAssetSystem&&) = delete;
+  auto operator=(const NullAssetSystem&) -> NullAssetSystem& = delete;
+  auto operator=(NullAssetSystem&&) -> NullAssetSystem& = delete;
+
+  auto run() -> void override;
+  auto requestStop() -> void override;
+
+private:
+  std::shared_ptr<IEventQueue> eventQueue;
+  std::shared_ptr<IAssetService> assetService;
+  std::shared_ptr<GeometryHandleMapper> geometryHandleMapper;
+  std::shared_ptr<NullGeometryStore> geometryStore;
+  std::shared_ptr<NullDevice> device;
+
+  std::jthread thread;
+
+  std::unordered_map<uint64_t, std::vector<std::shared_ptr<StaticModelRequest>>> eventBatches;
+
+  auto processBatchedResources(uint64_t batchId) -> void;
+  auto analyze(uint64_t batchId, const StaticModelRequest& request) -> StagingRequirements;
+  auto upload(const StagingRequirements& requirements) -> void;
+};
+
+}
@@ -0,0 +1,56 @@
+#include "headless/NullDevice.hpp"
+
+namespace tr {
+
+auto NullDevice::writeBuffer(size_t bytes) -> void {
+  bufferWrites.fetch_add(1, std::memory_order_relaxed);
+  bufferBytes.fetch_add(bytes, std::memory_order_relaxed);
+  frameBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto NullDevice::uploadGeometry(size_t bytes) -> void {
+  geometryUploads.fetch_add(1, std::memory_order_relaxed);
+  geometryBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto NullDevice::uploadImage(size_t bytes) -> void {
+  imageUploads.fetch_add(1, std::memory_order_relaxed);
+  imageBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+auto NullDevice::recordPass(size_t barrierCount) -> void {
+  recordedPasses.fetch_add(1, std::memory_order_relaxed);
+  barriers.fetch_add(barrierCount, std::memory_order_relaxed);
+}
+
+auto NullDevice::submitQueue() -> void {
+  queueSubmits.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto NullDevice::submit(size_t objectCount) -> void {
+  submits.fetch_add(1, std::memory_order_relaxed);
+  drawnObjects.fetch_add(objectCount, std::memory_order_relaxed);
+  TracyPlot("Null device bytes per frame",
+            static_cast<int64_t>(frameBytes.exchange(0, std::memory_order_relaxed)));
+}
+
+auto NullDevice::waitIdle() -> void {
+}
+
+auto NullDevice::getCounters() const -> NullDeviceCounters {
+  return NullDeviceCounters{
+      .submits = submits.load(std::memory_order_relaxed),
+      .drawnObjects = drawnObjects.load(std::memory_order_relaxed),
+      .bufferWrites = bufferWrites.load(std::memory_order_relaxed),
+      .bufferBytes = bufferBytes.load(std::memory_order_relaxed),
+      .geometryUploads = geometryUploads.load(std::memory_order_relaxed),
+      .geometryBytes = geometryBytes.load(std::memory_order_relaxed),
+      .imageUploads = imageUploads.load(std::memory_order_relaxed),
+      .imageBytes = imageBytes.load(std::memory_order_relaxed),
+      .recordedPasses = recordedPasses.load(std::memory_order_relaxed),
+      .barriers = barriers.load(std::memory_order_relaxed),
+      .queueSubmits = queueSubmits.load(std::memory_order_relaxed),
+  };
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+namespace tr {
+
+struct NullDeviceCounters {
+  uint64_t submits{};
+  uint64_t drawnObjects{};
+  uint64_t bufferWrites{};
+  uint64_t bufferBytes{};
+  uint64_t geometryUploads{};
+  uint64_t geometryBytes{};
+  uint64_t imageUploads{};
+  uint64_t imageBytes{};
+  uint64_t recordedPasses{};
+  uint64_t barriers{};
+  uint64_t queueSubmits{};
+};
+
+/// Stands in for the GPU when running headless. Everything the renderer and asset system would
+/// have handed to Vulkan is recorded here as a count and a size, and then dropped.
+///
+/// The render and asset threads both record into it, so the counters are atomic.
+class NullDevice {
+public:
+  NullDevice() = default;
+  ~NullDevice() = default;
+
+  NullDevice(const NullDevice&) = delete;
+  NullDevice(NullDevice&&) = delete;
+  auto operator=(const NullDevice&) -> NullDevice& = delete;
+  auto operator=(NullDevice&&) -> NullDevice& = delete;
+
+  auto writeBuffer(size_t bytes) -> void;
+  auto uploadGeometry(size_t bytes) -> void;
+  auto uploadImage(size_t bytes) -> void;
+  /// A frame graph pass that would have recorded `barrierCount` barriers around its commands.
+  auto recordPass(size_t barrierCount) -> void;
+  /// One of a frame's submissions of recorded passes to a queue.
+  auto submitQueue() -> void;
+  /// Ends a frame that would have drawn `objectCount` objects.
+  auto submit(size_t objectCount) -> void;
+  auto waitIdle() -> void;
+
+  [[nodiscard]] auto getCounters() const -> NullDeviceCounters;
+
+private:
+  std::atomic<uint64_t> submits;
+  std::atomic<uint64_t> drawnObjects;
+  std::atomic<uint64_t> bufferWrites;
+  std::atomic<uint64_t> bufferBytes;
+  std::atomic<uint64_t> geometryUploads;
+  std::atomic<uint64_t> geometryBytes;
+  std::atomic<uint64_t> imageUploads;
+  std::atomic<uint64_t> imageBytes;
+  std::atomic<uint64_t> recordedPasses;
+  std::atomic<uint64_t> barriers;
+  std::atomic<uint64_t> queueSubmits;
+
+  /// Buffer bytes written since the last submit, for the per frame plot
+  std::atomic<uint64_t> frameBytes;
+};
+
+}
@@ -0,0 +1,46 @@
+#include "headless/NullGeometryStore.hpp"
+#include "r3/FrustumCulling.hpp"
+
+namespace tr {
+
+namespace {
+
+/// Reserves `data`'s elements at the end of a buffer that's `used` elements long, returning the
+/// offset of the first one, or INVALID_OFFSET if there's no data.
+template <typename T>
+auto reserve(const std::shared_ptr<std::vector<std::byte>>& data, uint32_t& used) -> uint32_t {
+  if (data == nullptr) {
+    return INVALID_OFFSET;
+  }
+  const auto offset = used;
+  used += static_cast<uint32_t>(data->size() / sizeof(T));
+  return offset;
+}
+
+}
+
+auto NullGeometryStore::allocate(const GeometryData& data) -> Handle<GeometryRegion> {
+  std::lock_guard lock(mutex);
+  const auto regionIndexCount =
+      data.indexData ? static_cast<uint32_t>(data.indexData->size() / sizeof(GpuIndexData)) : 0U;
+  const auto bounds = data.positionData ? computeBounds(*data.positionData) : GeometryBounds{};
+  return regions.insert(GpuGeometryRegionData{
+      .indexCount = regionIndexCount,
+      .indexOffset = reserve<GpuIndexData>(data.indexData, indexCount),
+      .positionOffset = reserve<GpuVertexPositionData>(data.positionData, positionCount),
+      .colorOffset = reserve<GpuVertexColorData>(data.colorData, colorCount),
+      .texCoordOffset = reserve<GpuVertexTexCoordData>(data.texCoordData, texCoordCount),
+      .normalOffset = reserve<GpuVertexNormalData>(data.normalData, normalCount),
+      .boundingSphere = bounds.sphere,
+      .boundsMin = bounds.min,
+      .boundsMax = bounds.max,
+  });
+}
+
+auto NullGeometryStore::getRegionData(Handle<GeometryRegion> handle) const
+    -> GpuGeometryRegionData {
+  std::lock_guard lock(mutex);
+  return regions.at(handle);
+}
+
+}
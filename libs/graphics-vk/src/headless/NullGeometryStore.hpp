@@ -0,0 +1,38 @@
+#pragma once
+
+#include "api/gfx/GeometryData.hpp"
+#include "api/gfx/GpuMaterialData.hpp"
+#include "bk/SlotMap.hpp"
+#include "resources/allocators/GeometryAllocator.hpp"
+
+namespace tr {
+
+/// Headless stand-in for GeometryAllocator. Hands out the same element offsets the geometry
+/// buffers would have, without any buffers behind them.
+///
+/// Written by the asset thread and read by the render thread, so it's guarded by a mutex.
+class NullGeometryStore {
+public:
+  NullGeometryStore() = default;
+  ~NullGeometryStore() = default;
+
+  NullGeometryStore(const NullGeometryStore&) = delete;
+  NullGeometryStore(NullGeometryStore&&) = delete;
+  auto operator=(const NullGeometryStore&) -> NullGeometryStore& = delete;
+  auto operator=(NullGeometryStore&&) -> NullGeometryStore& = delete;
+
+  auto allocate(const GeometryData& data) -> Handle<GeometryRegion>;
+  [[nodiscard]] auto getRegionData(Handle<GeometryRegion> handle) const -> GpuGeometryRegionData;
+
+private:
+  mutable std::mutex mutex;
+  SlotMap<GpuGeometryRegionData, GeometryRegion> regions;
+
+  uint32_t indexCount{};
+  uint32_t positionCount{};
+  uint32_t colorCount{};
+  uint32_t texCoordCount{};
+  uint32_t normalCount{};
+};
+
+}
@@ -0,0 +1,197 @@
+#include "headless/NullRenderContext.hpp"
+#include "api/gw/EditorStateBuffer.hpp"
+#include "headless/NullDevice.hpp"
+#include "headless/NullGeometryStore.hpp"
+#include "headless/NullRenderPass.hpp"
+#include "r3/graph/FrameGraphCompiler.hpp"
+#include "r3/graph/barriers/BarrierScheduleCompiler.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
+
+namespace tr {
+
+namespace {
+
+/// The headless queues' families. Apart, so async compute hands resources between them the way it
+/// would on a GPU with a compute family of its own.
+constexpr uint32_t GraphicsFamily = 0;
+constexpr uint32_t ComputeFamily = 1;
+
+auto makePass(PassId passId, QueueType queueType, PassGraphInfo graphInfo)
+    -> std::unique_ptr<IRenderPass> {
+  return std::make_unique<NullRenderPass>(passId, queueType, std::move(graphInfo));
+}
+
+}
+
+NullRenderContext::NullRenderContext(RenderContextConfig newRenderConfig,
+                                     std::shared_ptr<IStateBuffer> newStateBuffer,
+                                     std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                                     std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+                                     std::shared_ptr<NullGeometryStore> newGeometryStore,
+                                     std::shared_ptr<NullDevice> newDevice)
+    : rendererConfig{newRenderConfig},
+      stateBuffer{std::move(newStateBuffer)},
+      editorStateBuffer{std::move(newEditorStateBuffer)},
+      geometryHandleMapper{std::move(newGeometryHandleMapper)},
+      geometryStore{std::move(newGeometryStore)},
+      device{std::move(newDevice)},
+      framePacer{stateBuffer,
+                 rendererConfig.framePacing,
+                 rendererConfig.interpolationLag,
+                 rendererConfig.maxStateWait},
+      frameTables{geometryHandleMapper,
+                  [store = geometryStore](Handle<GeometryRegion> handle) {
+                    return store->getRegionData(handle);
+                  },
+                  // Nothing creates textures headless
+                  []([[maybe_unused]] Handle<TextureTag> handle) { return 0U; }},
+      // Nor are there any buffers with device addresses
+      resourceTables{[]([[maybe_unused]] Handle<ManagedBuffer> handle) {
+        return std::optional<uint64_t>{};
+      }} {
+  Log.trace("Constructing NullRenderContext");
+
+  // R3Renderer's passes in the order it adds them, each with its own and its contexts' graph info
+  auto lateForward = forwardDrawGraphInfo(CullPhase::Late);
+  mergeGraphInfo(lateForward,
+                 forwardLoadGraphInfo(ImageAlias::GeometryColorImage, ImageAlias::DepthImage));
+  auto imGui = imGuiTargetGraphInfo(ImageAlias::GuiColorImage);
+  mergeGraphInfo(imGui, imGuiDrawGraphInfo());
+
+  renderPasses.push_back(
+      makePass(PassId::Culling, QueueType::Compute, cullingGraphInfo(CullPhase::Early)));
+  renderPasses.push_back(
+      makePass(PassId::Forward, QueueType::Graphics, forwardDrawGraphInfo(CullPhase::Early)));
+  renderPasses.push_back(makePass(
+      PassId::DepthPyramid,
+      QueueType::Graphics,
+      depthPyramidGraphInfo(ImageAlias::DepthImage, GlobalBufferAlias::DepthPyramid)));
+  renderPasses.push_back(
+      makePass(PassId::LateCulling, QueueType::Graphics, cullingGraphInfo(CullPhase::Late)));
+  renderPasses.push_back(makePass(PassId::LateForward, QueueType::Graphics, lateForward));
+  renderPasses.push_back(makePass(PassId::ImGui, QueueType::Graphics, imGui));
+  renderPasses.push_back(makePass(PassId::Composition, QueueType::Graphics, compositionGraphInfo()));
+  renderPasses.push_back(makePass(PassId::Present, QueueType::Graphics, presentGraphInfo()));
+
+  bakeFrameGraph();
+}
+
+NullRenderContext::~NullRenderContext() {
+  const auto counters = device->getCounters();
+  Log.info("NullRenderContext: {} frames, {} objects drawn, {} buffer writes totalling {} bytes",
+           counters.submits,
+           counters.drawnObjects,
+           counters.bufferWrites,
+           counters.bufferBytes);
+  Log.info("NullRenderContext: {} passes recorded with {} barriers in {} queue submissions",
+           counters.recordedPasses,
+           counters.barriers,
+           counters.queueSubmits);
+}
+
+void NullRenderContext::renderNextFrame() {
+  ZoneScopedN("NullRenderContext::renderNextFrame");
+  auto paced = framePacer.acquire();
+  if (!paced) {
+    Log.warn(
+        "Failed to get states this frame. Either game world is behind, or we're shutting down");
+    return;
+  }
+
+  [[maybe_unused]] const auto editorState = editorStateBuffer->getStates(paced->target);
+
+  stateInterpolator.interpolate(paced->states.previous(),
+                                paced->states.next(),
+                                paced->target,
+                                interpolatedState);
+  const auto& current = interpolatedState;
+
+  frameTables.update(current);
+
+  const auto frameData = frameTables.getFrameData(
+      current, glm::uvec2{rendererConfig.initialWidth, rendererConfig.initialHeight});
+  device->writeBuffer(sizeof(frameData));
+  if (resourceTables.isStale(frameIndex, 0)) {
+    resourceTables.rebuild(frameIndex, 0, {});
+    device->writeBuffer(sizeof(GpuResourceTable));
+  }
+
+  for (const auto& write :
+       frameTables.collectWrites(frameIndex, current, paced->states.previous().tick)) {
+    device->writeBuffer(write.size);
+  }
+
+  executeFrameGraph();
+  device->submit(current.objectMetadata.size());
+  const auto framesInFlight = std::max<uint8_t>(rendererConfig.framesInFlight, 1);
+  frameIndex = static_cast<uint8_t>((frameIndex + 1) % framesInFlight);
+  FrameMark;
+}
+
+void NullRenderContext::waitIdle() {
+  device->waitIdle();
+}
+
+auto NullRenderContext::bakeFrameGraph() -> void {
+  ZoneScopedN("NullRenderContext::bakeFrameGraph");
+  // Nothing draws the editor overlay headless, so the graph is baked as if it were hidden
+  const auto disabledImages = std::unordered_set<ImageAlias>{ImageAlias::GuiColorImage};
+  const auto compiled = FrameGraphCompiler::compile(renderPasses, disabledImages);
+  passOrder = compiled.passOrder;
+
+  auto passQueues = std::vector<QueueType>{};
+  auto passFamilies = std::vector<uint32_t>{};
+  for (const auto index : passOrder) {
+    const auto queueType = rendererConfig.asyncCompute ? renderPasses[index]->getQueueType()
+                                                       : QueueType::Graphics;
+    passQueues.push_back(queueType);
+    passFamilies.push_back(queueType == QueueType::Compute ? ComputeFamily : GraphicsFamily);
+  }
+
+  // The buffers R3Renderer and GeometryBufferPack create shared between the queue families
+  const auto concurrentBuffers = std::unordered_set<BufferAliasVariant>{
+      BufferAlias::ObjectData,
+      BufferAlias::ObjectPositions,
+      BufferAlias::ObjectRotations,
+      BufferAlias::ObjectScales,
+      BufferAlias::GeometryRegion,
+      BufferAlias::FrameData,
+      BufferAlias::ResourceTable,
+      GlobalBufferAlias::ObjectVisibility,
+      GlobalBufferAlias::Index,
+      GlobalBufferAlias::Position,
+      GlobalBufferAlias::Color,
+      GlobalBufferAlias::TexCoord,
+      GlobalBufferAlias::Normal,
+  };
+  barrierSchedule = BarrierScheduleCompiler::compile(
+      renderPasses, passOrder, {}, passFamilies, concurrentBuffers, disabledImages);
+  submissions = QueuePlanner::plan(passQueues, barrierSchedule.transfers);
+  Log.debug("NullRenderContext submits {} passes in {} submissions with {} ownership transfers",
+            passOrder.size(),
+            submissions.size(),
+            barrierSchedule.transfers.size());
+}
+
+auto NullRenderContext::executeFrameGraph() -> void {
+  ZoneScopedN("NullRenderContext::executeFrameGraph");
+  if (frameIndex >= frameHasRun.size()) {
+    frameHasRun.resize(frameIndex + 1);
+  }
+
+  const auto& passes = frameHasRun[frameIndex] ? barrierSchedule.steadyState
+                       : hasRun                ? barrierSchedule.frameFirstRun
+                                               : barrierSchedule.firstRun;
+  frameHasRun[frameIndex] = true;
+  hasRun = true;
+
+  for (const auto& pass : passes) {
+    device->recordPass(pass.imageBarriers.size() + pass.bufferBarriers.size() +
+                       pass.releaseImageBarriers.size() + pass.releaseBufferBarriers.size());
+  }
+  for (size_t i = 0; i < submissions.size(); ++i) {
+    device->submitQueue();
+  }
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "api/fx/IStateBuffer.hpp"
+#include "gfx/HandleMapperTypes.hpp"
+#include "gfx/IRenderContext.hpp"
+#include "gfx/RenderContextConfig.hpp"
+#include "r3/FramePacer.hpp"
+#include "r3/FrameTables.hpp"
+#include "r3/ResourceTableCache.hpp"
+#include "r3/StateInterpolator.hpp"
+#include "r3/graph/QueuePlanner.hpp"
+#include "r3/graph/barriers/BarrierSchedule.hpp"
+#include "r3/render-pass/IRenderPass.hpp"
+
+namespace tr {
+
+class EditorStateBuffer;
+class NullDevice;
+class NullGeometryStore;
+
+/// Render context for running without a GPU or a window. Each frame does the CPU side of what
+/// R3Renderer does, pacing, interpolation, rebuilding the object tables and collecting the writes
+/// each frame in flight needs from them, then hands the writes to a NullDevice that only counts
+/// them.
+///
+/// The frame graph is compiled from the same graph infos as R3Renderer's passes, ordered, culled,
+/// and its barriers and queue submissions planned, then each frame walks the schedule the way
+/// OrderedFrameGraph does and counts what it would have recorded. Transient images aren't aliased,
+/// sharing their memory needs the real images' memory requirements.
+class NullRenderContext : public IRenderContext {
+public:
+  NullRenderContext(RenderContextConfig newRenderConfig,
+                    std::shared_ptr<IStateBuffer> newStateBuffer,
+                    std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
+                    std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+                    std::shared_ptr<NullGeometryStore> newGeometryStore,
+                    std::shared_ptr<NullDevice> newDevice);
+  ~NullRenderContext() override;
+
+  NullRenderContext(const NullRenderContext&) = delete;
+  NullRenderContext(NullRenderContext&&) = delete;
+  auto operator=(const NullRenderContext&) -> NullRenderContext& = delete;
+  auto operator=(NullRenderContext&&) -> NullRenderContext& = delete;
+
+  void renderNextFrame() override;
+  void waitIdle() override;
+
+private:
+  auto bakeFrameGraph() -> void;
+  auto executeFrameGraph() -> void;
+
+  RenderContextConfig rendererConfig;
+  std::shared_ptr<IStateBuffer> stateBuffer;
+  std::shared_ptr<EditorStateBuffer> editorStateBuffer;
+  std::shared_ptr<GeometryHandleMapper> geometryHandleMapper;
+  std::shared_ptr<NullGeometryStore> geometryStore;
+  std::shared_ptr<NullDevice> device;
+
+  FramePacer framePacer;
+  StateInterpolator stateInterpolator;
+  SimState interpolatedState;
+
+  FrameTables frameTables;
+  /// Nothing is ever resized headless, so each frame in flight writes its table once
+  ResourceTableCache resourceTables;
+  uint8_t frameIndex{};
+
+  std::vector<std::unique_ptr<IRenderPass>> renderPasses;
+  std::vector<size_t> passOrder;
+  BarrierSchedule barrierSchedule;
+  std::vector<QueueSubmission> submissions;
+  /// Which frames in flight have run the graph, and whether any has, to pick each run's barriers
+  std::vector<bool> frameHasRun;
+  bool hasRun{};
+};
+
+}
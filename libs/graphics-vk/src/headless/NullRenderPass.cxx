@@ -0,0 +1,31 @@
+#include "headless/NullRenderPass.hpp"
+
+namespace tr {
+
+NullRenderPass::NullRenderPass(PassId newPassId, QueueType newQueueType, PassGraphInfo newGraphInfo)
+    : passId{newPassId}, queueType{newQueueType}, graphInfo{std::move(newGraphInfo)} {
+}
+
+auto NullRenderPass::getId() const -> PassId {
+  return passId;
+}
+
+auto NullRenderPass::execute([[maybe_unused]] Frame* frame,
+                             [[maybe_unused]] vk::raii::CommandBuffer& cmdBuffer) -> void {
+  // NOOP
+}
+
+auto NullRenderPass::registerDispatchContext([[maybe_unused]] Handle<IDispatchContext> handle)
+    -> void {
+  // NOOP
+}
+
+auto NullRenderPass::getGraphInfo() const -> PassGraphInfo {
+  return graphInfo;
+}
+
+auto NullRenderPass::getQueueType() const -> QueueType {
+  return queueType;
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "r3/render-pass/IRenderPass.hpp"
+
+namespace tr {
+
+/// A frame graph pass that only has graph info, so the graph can be compiled and its barriers
+/// planned headless. Records nothing.
+class NullRenderPass : public IRenderPass {
+public:
+  NullRenderPass(PassId newPassId, QueueType newQueueType, PassGraphInfo newGraphInfo);
+  ~NullRenderPass() override = default;
+
+  NullRenderPass(const NullRenderPass&) = default;
+  NullRenderPass(NullRenderPass&&) = delete;
+  auto operator=(const NullRenderPass&) -> NullRenderPass& = default;
+  auto operator=(NullRenderPass&&) -> NullRenderPass& = delete;
+
+  [[nodiscard]] auto getId() const -> PassId override;
+  auto execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void override;
+  auto registerDispatchContext(Handle<IDispatchContext> handle) -> void override;
+  [[nodiscard]] auto getGraphInfo() const -> PassGraphInfo override;
+  [[nodiscard]] auto getQueueType() const -> QueueType override;
+
+private:
+  PassId passId;
+  QueueType queueType;
+  PassGraphInfo graphInfo;
+};
+
+}
@@ -8,6 +8,37 @@
 
 namespace tr {
 
+namespace {
+
+auto makeImageCreateInfo(const ImageRequest& request) -> vk::ImageCreateInfo {
+  return vk::ImageCreateInfo{
+      .imageType = vk::ImageType::e2D,
+      .format = request.format,
+      .extent =
+          vk::Extent3D{.width = request.extent.width, .height = request.extent.height, .depth = 1},
+      .mipLevels = request.mipLevels,
+      .arrayLayers = request.layers,
+      .samples = vk::SampleCountFlagBits::e1,
+      .tiling = vk::ImageTiling::eOptimal,
+      .usage = request.usageFlags,
+      .sharingMode = vk::SharingMode::eExclusive,
+      .initialLayout = vk::ImageLayout::eUndefined};
+}
+
+auto makeImageViewCreateInfo(const ImageRequest& request, vk::Image image)
+    -> vk::ImageViewCreateInfo {
+  return vk::ImageViewCreateInfo{.image = image,
+                                 .viewType = vk::ImageViewType::e2D,
+                                 .format = request.format,
+                                 .subresourceRange = {
+                                     .aspectMask = request.aspectFlags,
+                                     .levelCount = 1,
+                                     .layerCount = 1,
+                                 }};
+}
+
+}
+
 ImageManager::ImageManager(std::shared_ptr<Allocator> newAllocator,
                            std::shared_ptr<IDebugManager> newDebugManager,
                            std::shared_ptr<Device> newDevice,
@@ -25,22 +56,11 @@ ImageManager::ImageManager(std::shared_ptr<Allocator> newAllocator,
 
 ImageManager::~ImageManager() {
   Log.trace("Destroying ImageManager");
-  imageMap.clear();
+  images.clear();
 }
 
 auto ImageManager::createImage(ImageRequest request) -> Handle<ManagedImage> {
-  const auto imageCreateInfo = vk::ImageCreateInfo{
-      .imageType = vk::ImageType::e2D,
-      .format = request.format,
-      .extent =
-          vk::Extent3D{.width = request.extent.width, .height = request.extent.height, .depth = 1},
-      .mipLevels = request.mipLevels,
-      .arrayLayers = request.layers,
-      .samples = vk::SampleCountFlagBits::e1,
-      .tiling = vk::ImageTiling::eOptimal,
-      .usage = request.usageFlags,
-      .sharingMode = vk::SharingMode::eExclusive,
-      .initialLayout = vk::ImageLayout::eUndefined};
+  const auto imageCreateInfo = makeImageCreateInfo(request);
   constexpr auto imageAllocateCreateInfo =
       vma::AllocationCreateInfo{.usage = vma::MemoryUsage::eGpuOnly,
                                 .requiredFlags = vk::MemoryPropertyFlagBits::eDeviceLocal};
@@ -52,26 +72,16 @@ auto ImageManager::createImage(ImageRequest request) -> Handle<ManagedImage> {
     debugManager->setObjectName(image, *request.debugName);
   }
 
-  const auto imageViewInfo = vk::ImageViewCreateInfo{.image = image,
-                                                     .viewType = vk::ImageViewType::e2D,
-                                                     .format = request.format,
-                                                     .subresourceRange = {
-                                                         .aspectMask = request.aspectFlags,
-                                                         .levelCount = 1,
-                                                         .layerCount = 1,
-                                                     }};
-  const auto key = generator.requestHandle();
-
-  imageMap.emplace(
-      key,
-      std::make_unique<ManagedImage>(
+  const auto imageViewInfo = makeImageViewCreateInfo(request, image);
+  return images.insert(ImageEntry{
+      .image = std::make_unique<ManagedImage>(
           std::make_unique<AllocatedImage>(image, allocation, *allocator->getAllocator()),
           device->getVkDevice().createImageView(imageViewInfo),
           request.extent,
           request.format,
           request.usageFlags,
-          request.debugName));
-  return key;
+          request.debugName),
+      .request = request});
 }
 
 auto ImageManager::createPerFrameImage(ImageRequest request) -> LogicalHandle<ManagedImage> {
@@ -87,6 +97,49 @@ auto ImageManager::createPerFrameImage(ImageRequest request) -> LogicalHandle<Ma
   return logicalHandle;
 }
 
+auto ImageManager::getMemoryRequirements(LogicalHandle<ManagedImage> logicalHandle)
+    -> vk::MemoryRequirements {
+  const auto& frame = frameManager->getFrames().front();
+  const auto& image = getImage(frame->getLogicalImage(logicalHandle));
+  return device->getVkDevice().getImageMemoryRequirements(image.getImage());
+}
+
+auto ImageManager::aliasPerFrameImages(const std::vector<SharedImageBlock>& blocks) -> void {
+  const auto vmaAllocator = *allocator->getAllocator();
+  const auto vkDevice = *device->getVkDevice();
+  constexpr auto memoryAllocateCreateInfo =
+      vma::AllocationCreateInfo{.usage = vma::MemoryUsage::eGpuOnly,
+                                .requiredFlags = vk::MemoryPropertyFlagBits::eDeviceLocal};
+
+  for (const auto& frame : frameManager->getFrames()) {
+    for (const auto& block : blocks) {
+      auto memory = std::make_shared<SharedImageMemory>(
+          vmaAllocator.allocateMemory(block.requirements, memoryAllocateCreateInfo),
+          vmaAllocator);
+
+      for (const auto& [logicalHandle, offset] : block.images) {
+        auto& entry = images.at(frame->getLogicalImage(logicalHandle));
+        assert(entry.request && "Only images the ImageManager created can share memory");
+        const auto& request = *entry.request;
+
+        const auto image = vkDevice.createImage(makeImageCreateInfo(request));
+        vmaAllocator.bindImageMemory2(memory->getAllocation(), offset, image, nullptr);
+        if (request.debugName) {
+          debugManager->setObjectName(image, *request.debugName);
+        }
+
+        entry.image = std::make_unique<ManagedImage>(
+            std::make_unique<AllocatedImage>(image, memory, vkDevice),
+            device->getVkDevice().createImageView(makeImageViewCreateInfo(request, image)),
+            request.extent,
+            request.format,
+            request.usageFlags,
+            request.debugName);
+      }
+    }
+  }
+}
+
 auto ImageManager::registerSwapchainImages() -> void {
   swapchainLogicalHandle = generator.requestLogicalHandle();
 
@@ -94,24 +147,22 @@ auto ImageManager::registerSwapchainImages() -> void {
     for (uint32_t index = 0; index < swapchain->getImages().size(); ++index) {
       frame->registerSwapchainLogicalHandle(swapchainLogicalHandle);
       const auto handle = registerSwapchainImage(index);
-      handleToSwapchainIndex.emplace(handle, index);
       frame->addSwapchainImage(handle, index);
     }
   }
 }
 
 auto ImageManager::registerSwapchainImage(uint32_t index) -> Handle<ManagedImage> {
-  const auto handle = generator.requestHandle();
+  const auto handle = images.insert(
+      ImageEntry{.image = std::make_unique<ManagedImage>(swapchain->getSwapchainImage(index),
+                                                         swapchain->getSwapchainImageView(index),
+                                                         swapchain->getImageExtent(),
+                                                         swapchain->getImageFormat(),
+                                                         vk::ImageUsageFlagBits::eColorAttachment,
+                                                         "SwapchainImage"),
+                 .swapchainIndex = index});
 
-  Log.trace("Registering swapchain image index={}, handle={}", index, handle.id);
-
-  imageMap.emplace(handle,
-                   std::make_unique<ManagedImage>(swapchain->getSwapchainImage(index),
-                                                  swapchain->getSwapchainImageView(index),
-                                                  swapchain->getImageExtent(),
-                                                  swapchain->getImageFormat(),
-                                                  vk::ImageUsageFlagBits::eColorAttachment,
-                                                  "SwapchainImage"));
+  Log.trace("Registered swapchain image index={}, handle={}", index, handle.id);
 
   return handle;
 }
@@ -134,9 +185,7 @@ auto ImageManager::registerDefaultSampler() -> Handle<vk::raii::Sampler> {
       .borderColor = vk::BorderColor::eIntOpaqueBlack,
       .unnormalizedCoordinates = VK_FALSE,
   };
-  defaultSampler = samplerGenerator.requestHandle();
-
-  samplers.emplace(defaultSampler, device->getVkDevice().createSampler(samplerInfo));
+  defaultSampler = samplers.insert(device->getVkDevice().createSampler(samplerInfo));
 
   return defaultSampler;
 }
@@ -150,15 +199,16 @@ auto ImageManager::getSwapchainImageHandle() const -> LogicalHandle<ManagedImage
 }
 
 auto ImageManager::getImage(Handle<ManagedImage> imageHandle) -> ManagedImage& {
-  if (handleToSwapchainIndex.contains(imageHandle)) {
-    const auto imageIndex = handleToSwapchainIndex.at(imageHandle);
-    auto& managedImage = imageMap.at(imageHandle);
-    managedImage->setExternalImage(swapchain->getSwapchainImage(imageIndex));
-    managedImage->setExternalImageView(swapchain->getSwapchainImageView(imageIndex));
-    return *managedImage;
+  return *images.at(imageHandle).image;
+}
+
+auto ImageManager::refreshSwapchainImages() -> void {
+  for (auto& entry : images) {
+    if (entry.swapchainIndex) {
+      entry.image->setExternalImage(swapchain->getSwapchainImage(*entry.swapchainIndex));
+      entry.image->setExternalImageView(swapchain->getSwapchainImageView(*entry.swapchainIndex));
+    }
   }
-  assert(imageMap.contains(imageHandle));
-  return *imageMap.at(imageHandle);
 }
 
 auto ImageManager::getImageMetadata(LogicalHandle<ManagedImage> logicalHandle) -> ImageMetadata {
@@ -168,8 +218,7 @@ auto ImageManager::getImageMetadata(LogicalHandle<ManagedImage> logicalHandle) -
 }
 
 auto ImageManager::getImageMetadata(Handle<ManagedImage> handle) -> ImageMetadata {
-  assert(imageMap.contains(handle));
-  const auto& image = imageMap.at(handle);
+  const auto& image = images.at(handle).image;
   return ImageMetadata{
       .format = image->getFormat(),
       .extent = image->getExtent(),
@@ -179,7 +228,6 @@ auto ImageManager::getImageMetadata(Handle<ManagedImage> handle) -> ImageMetadat
 
 [[nodiscard]] auto ImageManager::getSampler(Handle<vk::raii::Sampler> handle) const
     -> const vk::Sampler& {
-  assert(samplers.contains(handle));
   return *samplers.at(handle);
 }
 
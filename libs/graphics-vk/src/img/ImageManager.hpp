@@ -3,6 +3,7 @@
 #include "bk/Handle.hpp"
 #include "bk/HandleGenerator.hpp"
 #include "bk/Rando.hpp"
+#include "bk/SlotMap.hpp"
 #include "img/ImageRequest.hpp"
 #include "img/ManagedImage.hpp"
 namespace tr {
@@ -23,6 +24,21 @@ struct ImageUsageProfile {
   std::optional<std::string> debugName = std::nullopt;
 };
 
+struct ImageEntry {
+  std::unique_ptr<ManagedImage> image;
+  /// Set for swapchain images, whose vk::Image is refreshed from the swapchain by
+  /// refreshSwapchainImages().
+  std::optional<uint32_t> swapchainIndex;
+  /// What the image was created from, so it can be created again in shared memory
+  std::optional<ImageRequest> request;
+};
+
+/// Per frame images that take turns using one allocation, each at its own offset
+struct SharedImageBlock {
+  vk::MemoryRequirements requirements;
+  std::vector<std::pair<LogicalHandle<ManagedImage>, vk::DeviceSize>> images;
+};
+
 struct ImageMetadata {
   vk::Format format;
   vk::Extent2D extent;
@@ -51,10 +67,21 @@ public:
 
   auto createImage(ImageRequest request) -> Handle<ManagedImage>;
   auto createPerFrameImage(ImageRequest request) -> LogicalHandle<ManagedImage>;
+  /// Only reads, so passes can call it from the PassRecorder's threads at the same time, as long
+  /// as nothing creates images or calls refreshSwapchainImages() meanwhile.
   auto getImage(Handle<ManagedImage> imageHandle) -> ManagedImage&;
+  /// Points the swapchain images at the swapchain's current images and views, which recreating
+  /// the swapchain replaces. Called each frame before anything records with them.
+  auto refreshSwapchainImages() -> void;
   auto getImageMetadata(LogicalHandle<ManagedImage> logicalHandle) -> ImageMetadata;
   auto getImageMetadata(Handle<ManagedImage> handle) -> ImageMetadata;
   auto getSwapchainImageHandle() const -> LogicalHandle<ManagedImage>;
+  /// What each frame's copy of the image needs, they're all created from the same request
+  auto getMemoryRequirements(LogicalHandle<ManagedImage> logicalHandle) -> vk::MemoryRequirements;
+  /// Creates each frame's copy of every image in `blocks` again, bound into a block of memory per
+  /// frame that they share. Handles stay the same, but anything holding on to the old vk::Image or
+  /// view has to look it up again, so this is meant for before the first frame is rendered.
+  auto aliasPerFrameImages(const std::vector<SharedImageBlock>& blocks) -> void;
   auto getSampler(Handle<vk::raii::Sampler>) const -> const vk::Sampler&;
   auto registerSwapchainImage(uint32_t index) -> Handle<ManagedImage>;
   auto registerDefaultSampler() -> Handle<vk::raii::Sampler>;
@@ -68,12 +95,10 @@ private:
   std::shared_ptr<Swapchain> swapchain;
 
   HandleGenerator<ManagedImage> generator;
-  std::unordered_map<Handle<ManagedImage>, std::unique_ptr<ManagedImage>> imageMap;
+  SlotMap<ImageEntry, ManagedImage> images;
   LogicalHandle<ManagedImage> swapchainLogicalHandle;
-  std::unordered_map<Handle<ManagedImage>, uint32_t> handleToSwapchainIndex;
 
-  HandleGenerator<vk::raii::Sampler> samplerGenerator;
-  std::unordered_map<Handle<vk::raii::Sampler>, vk::raii::Sampler> samplers;
+  SlotMap<vk::raii::Sampler> samplers;
 
   Handle<vk::raii::Sampler> defaultSampler;
 
@@ -2,14 +2,49 @@
 
 namespace tr {
 
+/// Memory that several images are bound into, freed along with the last of them
+class SharedImageMemory {
+public:
+  SharedImageMemory(vma::Allocation newAllocation, vma::Allocator newAllocator)
+      : allocation{newAllocation}, allocator{newAllocator} {
+  }
+
+  ~SharedImageMemory() {
+    allocator.freeMemory(allocation);
+  }
+
+  SharedImageMemory(const SharedImageMemory&) = delete;
+  SharedImageMemory(SharedImageMemory&&) = delete;
+  auto operator=(const SharedImageMemory&) -> SharedImageMemory& = delete;
+  auto operator=(SharedImageMemory&&) -> SharedImageMemory& = delete;
+
+  [[nodiscard]] auto getAllocation() const -> vma::Allocation {
+    return allocation;
+  }
+
+private:
+  vma::Allocation allocation;
+  vma::Allocator allocator;
+};
+
 class AllocatedImage {
 public:
   AllocatedImage(vk::Image newImage, vma::Allocation newAllocation, vma::Allocator newAllocator)
       : image{newImage}, allocation{newAllocation}, allocator{newAllocator} {
   }
 
+  AllocatedImage(vk::Image newImage,
+                 std::shared_ptr<SharedImageMemory> newSharedMemory,
+                 vk::Device newDevice)
+      : image{newImage}, sharedMemory{std::move(newSharedMemory)}, device{newDevice} {
+  }
+
   ~AllocatedImage() {
-    allocator.destroyImage(image, allocation);
+    if (sharedMemory) {
+      device.destroyImage(image);
+    } else {
+      allocator.destroyImage(image, allocation);
+    }
   }
 
   AllocatedImage(const AllocatedImage&) = default;
@@ -25,6 +60,9 @@ private:
   vk::Image image;
   vma::Allocation allocation;
   vma::Allocator allocator;
+  /// Set instead of `allocation` when the image doesn't own its memory
+  std::shared_ptr<SharedImageMemory> sharedMemory;
+  vk::Device device;
 };
 
 // TODO(Images) This class can have images or external images, and its intent could be
@@ -27,9 +27,9 @@ TextureArena::TextureArena(std::shared_ptr<IShaderBindingFactory> newShaderBindi
 auto TextureArena::insert(vk::ImageView imageView, vk::Sampler sampler) -> Handle<Texture> {
   std::scoped_lock lock(swapMutex);
   const auto handle = textureHandleGenerator.requestHandle();
-  const auto position = textures.size();
+  const auto position = static_cast<uint32_t>(textures.size() + stagingTextures.size());
   stagingTextures.push_back({.view = imageView, .sampler = sampler});
-  stagingHandleMap.emplace(handle, position);
+  stagingHandles.emplace_back(handle, position);
 
   for (auto& [key, value] : dirty) {
     value = true;
@@ -53,12 +53,15 @@ auto TextureArena::updateShaderBindings(const Frame* frame) -> void {
       textures.emplace_back(tex);
     }
 
-    for (const auto& [key, value] : stagingHandleMap) {
-      handleMap[key] = value;
+    for (const auto& [handle, position] : stagingHandles) {
+      if (handle.id >= textureIndices.size()) {
+        textureIndices.resize(handle.id + 1);
+      }
+      textureIndices[handle.id] = position;
     }
 
     stagingTextures.clear();
-    stagingHandleMap.clear();
+    stagingHandles.clear();
     for (auto& [key, value] : dirty) {
       value = true;
     }
@@ -82,8 +85,8 @@ auto TextureArena::updateShaderBindings(const Frame* frame) -> void {
 
 /// Must only be called *after* updateShaderBindings
 auto TextureArena::getTextureIndex(Handle<Texture> handle) -> uint32_t {
-  assert(handleMap.contains(handle));
-  return handleMap.at(handle);
+  assert(handle.id < textureIndices.size() && textureIndices[handle.id].has_value());
+  return *textureIndices[handle.id];
 }
 
 auto TextureArena::getDSLayoutHandle() const -> Handle<DSLayout> {
@@ -40,7 +40,9 @@ private:
   HandleGenerator<Texture> textureHandleGenerator{};
 
   std::unordered_map<uint32_t, bool> dirty;
-  std::unordered_map<Handle<Texture>, size_t> handleMap;
+  /// Texture handles are sequential and textures are never compacted, so this is indexed by handle
+  /// id and holds the texture's descriptor index.
+  std::vector<std::optional<uint32_t>> textureIndices;
   std::vector<Texture> textures;
 
   Handle<DSLayout> dsLayout;
@@ -48,7 +50,7 @@ private:
 
   std::mutex swapMutex;
   std::vector<Texture> stagingTextures;
-  std::unordered_map<Handle<Texture>, size_t> stagingHandleMap;
+  std::vector<std::pair<Handle<Texture>, uint32_t>> stagingHandles;
   std::atomic_bool newDataAvailable = false;
 };
 
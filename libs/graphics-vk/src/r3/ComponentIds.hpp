@@ -5,6 +5,9 @@ namespace tr {
 enum class PassId : uint8_t {
   Culling = 0,
   Forward,
+  DepthPyramid,
+  LateCulling,
+  LateForward,
   Composition,
   PostProcessing,
   ImGui,
@@ -16,6 +19,8 @@ enum class ContextId : uint8_t {
   Cube,
   Composition,
   ImGui,
+  LateCulling,
+  LateCube,
 };
 
 }
@@ -37,6 +42,15 @@ struct std::formatter<tr::PassId> {
       case tr::PassId::Forward:
         name = "Forward";
         break;
+      case tr::PassId::DepthPyramid:
+        name = "DepthPyramid";
+        break;
+      case tr::PassId::LateCulling:
+        name = "LateCulling";
+        break;
+      case tr::PassId::LateForward:
+        name = "LateForward";
+        break;
       case tr::PassId::Composition:
         name = "Composition";
         break;
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "api/gfx/GpuMaterialData.hpp"
+
+// CPU simulation of the compaction in compute2.comp, run lane by lane so the scans themselves are
+// what gets tested. Keep the two in step.
+//
+// Each workgroup culls a run of consecutive draw instances. Instances are sorted by batch, so a
+// workgroup's survivors fall into a few runs that share a batch. A segmented prefix sum over the
+// workgroup gives every survivor its offset within its run, and the run's last lane reserves space
+// for the whole run with a single atomic on the batch's instanceCount. Whichever workgroup
+// finishes last then packs the commands of batches with any survivors to the front of the command
+// buffer, and writes how many there are to the count buffer.
+//
+// Culling runs twice a frame, see HzbCulling.hpp. Both phases write into the same visible object
+// buffer, the early phase packing each batch's survivors from its first instance and the late
+// phase packing them back from its last. No object survives both, so the two never overlap.
+
+namespace tr {
+
+/// Lanes per workgroup in compute2.comp
+constexpr uint32_t CullWorkgroupSize = 64;
+
+/// Which of the two culling dispatches a frame makes. Matches the phase push constant in
+/// compute2.comp.
+enum class CullPhase : uint32_t {
+  Early = 0,
+  Late,
+};
+
+using LaneValues = std::array<uint32_t, CullWorkgroupSize>;
+
+/// Hillis-Steele inclusive scan, each step reading every lane before any lane writes, as the
+/// shader does with a barrier.
+inline auto inclusiveScan(LaneValues& values) -> void {
+  for (uint32_t offset = 1; offset < CullWorkgroupSize; offset *= 2) {
+    const auto previous = values;
+    for (uint32_t lane = offset; lane < CullWorkgroupSize; ++lane) {
+      values[lane] = previous[lane] + previous[lane - offset];
+    }
+  }
+}
+
+/// Inclusive scan that restarts at every lane where `isHead` is set. Returns each lane's
+/// segment head in `heads`.
+inline auto segmentedInclusiveScan(LaneValues& values,
+                                   const std::array<bool, CullWorkgroupSize>& isHead,
+                                   LaneValues& heads) -> void {
+  for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+    heads[lane] = isHead[lane] ? lane : 0;
+  }
+  // Max scan, so every lane learns the nearest head at or before it
+  for (uint32_t offset = 1; offset < CullWorkgroupSize; offset *= 2) {
+    const auto previous = heads;
+    for (uint32_t lane = offset; lane < CullWorkgroupSize; ++lane) {
+      heads[lane] = std::max(previous[lane], previous[lane - offset]);
+    }
+  }
+  for (uint32_t offset = 1; offset < CullWorkgroupSize; offset *= 2) {
+    const auto previous = values;
+    for (uint32_t lane = offset; lane < CullWorkgroupSize; ++lane) {
+      if (lane - offset >= heads[lane]) {
+        values[lane] = previous[lane] + previous[lane - offset];
+      }
+    }
+  }
+}
+
+/// The instance pass. Adds each batch's survivors to its command's instanceCount and writes them
+/// into `visibleObjects`, packed from the batch's firstInstance, or back from its last instance in
+/// the late phase. `visible` is parallel to `instances`, and 1 for those that survived culling.
+/// Returns how many atomics the workgroups issued.
+inline auto compactVisibleInstances(std::span<const GpuDrawInstance> instances,
+                                    std::span<const uint32_t> visible,
+                                    std::span<const GpuDrawBatch> batches,
+                                    std::span<GpuIndirectCommand> commands,
+                                    std::span<uint32_t> visibleObjects,
+                                    CullPhase phase = CullPhase::Early) -> uint32_t {
+  constexpr auto NoBatch = std::numeric_limits<uint32_t>::max();
+  const auto instanceCount = static_cast<uint32_t>(instances.size());
+  auto atomics = 0U;
+
+  for (uint32_t first = 0; first < instanceCount; first += CullWorkgroupSize) {
+    auto batchIds = LaneValues{};
+    auto counts = LaneValues{};
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      const auto index = first + lane;
+      // Lanes past the end still take part in the scans, as nothing
+      batchIds[lane] = index < instanceCount ? instances[index].batchId : NoBatch;
+      counts[lane] = index < instanceCount ? visible[index] : 0;
+    }
+    const auto survivors = counts;
+
+    auto isHead = std::array<bool, CullWorkgroupSize>{};
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      isHead[lane] = lane == 0 || batchIds[lane] != batchIds[lane - 1];
+    }
+    auto heads = LaneValues{};
+    segmentedInclusiveScan(counts, isHead, heads);
+
+    // The last lane of each run reserves the run's instances and shares the base with the run
+    auto bases = LaneValues{};
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      const auto isTail = lane == CullWorkgroupSize - 1 || batchIds[lane + 1] != batchIds[lane];
+      if (isTail && counts[lane] > 0) {
+        auto& command = commands[batchIds[lane]];
+        bases[heads[lane]] = command.instanceCount;
+        command.instanceCount += counts[lane];
+        ++atomics;
+      }
+    }
+
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      if (survivors[lane] == 0) {
+        continue;
+      }
+      const auto slot = bases[heads[lane]] + counts[lane] - 1;
+      const auto& batch = batches[batchIds[lane]];
+      const auto index = phase == CullPhase::Late
+                             ? batch.firstInstance + batch.instanceCount - 1 - slot
+                             : batch.firstInstance + slot;
+      visibleObjects[index] = instances[first + lane].objectId;
+    }
+  }
+  return atomics;
+}
+
+/// The last workgroup's pass. Moves the commands with any instances to the front, keeping their
+/// order, and returns how many there are. Works through the commands a workgroup's worth at a
+/// time, reading a whole chunk before writing any of it, so it can pack them in place. In the
+/// late phase each command is moved onto the end of its batch, from `batches`, where the
+/// instance pass packed its survivors.
+inline auto compactDrawCommands(std::span<GpuIndirectCommand> commands,
+                                CullPhase phase = CullPhase::Early,
+                                std::span<const GpuDrawBatch> batches = {}) -> uint32_t {
+  const auto commandCount = static_cast<uint32_t>(commands.size());
+  auto packed = 0U;
+
+  for (uint32_t first = 0; first < commandCount; first += CullWorkgroupSize) {
+    auto chunk = std::array<GpuIndirectCommand, CullWorkgroupSize>{};
+    auto offsets = LaneValues{};
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      if (first + lane < commandCount) {
+        chunk[lane] = commands[first + lane];
+        offsets[lane] = chunk[lane].instanceCount > 0 ? 1 : 0;
+        if (phase == CullPhase::Late) {
+          const auto& batch = batches[first + lane];
+          chunk[lane].firstInstance =
+              batch.firstInstance + batch.instanceCount - chunk[lane].instanceCount;
+        }
+      }
+    }
+    inclusiveScan(offsets);
+
+    for (uint32_t lane = 0; lane < CullWorkgroupSize; ++lane) {
+      if (first + lane < commandCount && chunk[lane].instanceCount > 0) {
+        commands[packed + offsets[lane] - 1] = chunk[lane];
+      }
+    }
+    packed += offsets[CullWorkgroupSize - 1];
+  }
+  return packed;
+}
+
+}
@@ -0,0 +1,47 @@
+#include "DirtyRangeTracker.hpp"
+
+namespace tr {
+
+DirtyRangeTracker::DirtyRangeTracker(uint32_t newMergeGap) : mergeGap{newMergeGap} {
+}
+
+auto DirtyRangeTracker::collect(size_t consumer, std::span<const uint64_t> versions)
+    -> const std::vector<ObjectRange>& {
+  ZoneScopedN("DirtyRangeTracker::collect");
+  const auto since = getSyncedTick(consumer);
+  ranges.clear();
+
+  for (uint32_t index = 0; index < versions.size(); ++index) {
+    if (versions[index] <= since) {
+      continue;
+    }
+    if (!ranges.empty()) {
+      auto& last = ranges.back();
+      const auto end = last.first + last.count;
+      if (index - end <= mergeGap) {
+        last.count = index - last.first + 1;
+        continue;
+      }
+    }
+    ranges.push_back(ObjectRange{.first = index, .count = 1});
+  }
+
+  return ranges;
+}
+
+auto DirtyRangeTracker::markSynced(size_t consumer, uint64_t tick) -> void {
+  if (consumer >= syncedTicks.size()) {
+    syncedTicks.resize(consumer + 1, 0);
+  }
+  syncedTicks[consumer] = tick;
+}
+
+auto DirtyRangeTracker::invalidate(size_t consumer) -> void {
+  markSynced(consumer, 0);
+}
+
+auto DirtyRangeTracker::getSyncedTick(size_t consumer) const -> uint64_t {
+  return consumer < syncedTicks.size() ? syncedTicks[consumer] : 0;
+}
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace tr {
+
+struct ObjectRange {
+  uint32_t first{};
+  uint32_t count{};
+
+  auto operator==(const ObjectRange&) const -> bool = default;
+};
+
+/// Turns SimState::objectVersions into the ranges of objects a consumer still has to rewrite.
+///
+/// A consumer is anything holding its own copy of the object tables, such as a frame in flight's
+/// buffers or a CPU side mirror. Each remembers the newest tick it has been brought up to date
+/// with, and anything stamped with a later tick is dirty for it.
+class DirtyRangeTracker {
+public:
+  /// Dirty runs separated by fewer clean objects than this are merged into one range, trading a
+  /// few redundant bytes for fewer writes.
+  static constexpr uint32_t DefaultMergeGap = 8;
+
+  explicit DirtyRangeTracker(uint32_t newMergeGap = DefaultMergeGap);
+  ~DirtyRangeTracker() = default;
+
+  DirtyRangeTracker(const DirtyRangeTracker&) = default;
+  DirtyRangeTracker(DirtyRangeTracker&&) = default;
+  auto operator=(const DirtyRangeTracker&) -> DirtyRangeTracker& = default;
+  auto operator=(DirtyRangeTracker&&) -> DirtyRangeTracker& = default;
+
+  /// Ranges of objects whose version is newer than the tick `consumer` last synced to. The result
+  /// is only valid until the next call.
+  auto collect(size_t consumer, std::span<const uint64_t> versions)
+      -> const std::vector<ObjectRange>&;
+
+  /// Records that `consumer` now reflects every change up to and including `tick`.
+  auto markSynced(size_t consumer, uint64_t tick) -> void;
+
+  /// Forces the next collect for `consumer` to return everything.
+  auto invalidate(size_t consumer) -> void;
+
+  [[nodiscard]] auto getSyncedTick(size_t consumer) const -> uint64_t;
+
+private:
+  uint32_t mergeGap;
+  std::vector<uint64_t> syncedTicks;
+  std::vector<ObjectRange> ranges;
+};
+
+}
@@ -0,0 +1,33 @@
+#include "r3/DrawBatcher.hpp"
+
+namespace tr {
+
+auto DrawBatcher::build(std::span<const GpuObjectData> objects,
+                        std::span<const GpuMaterialData> materials) -> void {
+  ZoneScopedN("DrawBatcher::build");
+  sortKeys.clear();
+  sortKeys.reserve(objects.size());
+  for (uint32_t i = 0; i < objects.size(); ++i) {
+    const auto& object = objects[i];
+    const auto key = (static_cast<uint64_t>(object.geometryRegionId) << 32U) |
+                     materials[object.materialId].albedoTextureId;
+    sortKeys.emplace_back(key, i);
+  }
+  std::ranges::sort(sortKeys);
+
+  batches.clear();
+  instances.resize(sortKeys.size());
+  for (uint32_t instance = 0; instance < sortKeys.size(); ++instance) {
+    const auto [key, slot] = sortKeys[instance];
+    if (instance == 0 || key != sortKeys[instance - 1].first) {
+      batches.push_back(GpuDrawBatch{.geometryRegionId = static_cast<uint32_t>(key >> 32U),
+                                     .firstInstance = instance,
+                                     .instanceCount = 0});
+    }
+    ++batches.back().instanceCount;
+    instances[instance] = GpuDrawInstance{.objectId = slot,
+                                          .batchId = static_cast<uint32_t>(batches.size() - 1)};
+  }
+}
+
+}
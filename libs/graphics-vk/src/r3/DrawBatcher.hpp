@@ -0,0 +1,44 @@
+#pragma once
+
+#include "api/gfx/GpuMaterialData.hpp"
+
+namespace tr {
+
+/// Groups objects that share a geometry region and material so each group can be drawn with one
+/// instanced indirect command.
+///
+/// Each batch covers a contiguous run of instances, and the instance list maps every instance back
+/// to the object slot it draws and the batch it belongs to. Objects within a batch keep their slot
+/// order, so the same scene always batches the same way.
+///
+/// Materials are compared by texture, since that's all that currently differs between them.
+class DrawBatcher {
+public:
+  DrawBatcher() = default;
+  ~DrawBatcher() = default;
+
+  DrawBatcher(const DrawBatcher&) = delete;
+  DrawBatcher(DrawBatcher&&) = delete;
+  auto operator=(const DrawBatcher&) -> DrawBatcher& = delete;
+  auto operator=(DrawBatcher&&) -> DrawBatcher& = delete;
+
+  /// Rebuilds the batches from scratch. `materials` is indexed by GpuObjectData::materialId.
+  auto build(std::span<const GpuObjectData> objects, std::span<const GpuMaterialData> materials)
+      -> void;
+
+  [[nodiscard]] auto getBatches() const -> const std::vector<GpuDrawBatch>& {
+    return batches;
+  }
+
+  [[nodiscard]] auto getInstances() const -> const std::vector<GpuDrawInstance>& {
+    return instances;
+  }
+
+private:
+  /// (batch key, object slot), kept around so rebuilding doesn't allocate
+  std::vector<std::pair<uint64_t, uint32_t>> sortKeys;
+  std::vector<GpuDrawBatch> batches;
+  std::vector<GpuDrawInstance> instances;
+};
+
+}
@@ -0,0 +1,68 @@
+#include "r3/FramePacer.hpp"
+
+namespace tr {
+
+namespace {
+
+auto toMilliseconds(std::chrono::steady_clock::duration duration) -> double {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}
+
+FramePacer::FramePacer(std::shared_ptr<IStateBuffer> newStateBuffer,
+                       FramePacing newPacing,
+                       std::chrono::milliseconds newInterpolationLag,
+                       std::chrono::milliseconds newMaxWait)
+    : stateBuffer{std::move(newStateBuffer)},
+      pacing{newPacing},
+      interpolationLag{newInterpolationLag},
+      maxWait{newMaxWait} {
+}
+
+auto FramePacer::acquire() -> std::optional<PacedStates> {
+  ZoneScopedN("FramePacer::acquire");
+  const auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + maxWait;
+
+  auto published = stateBuffer->getPublishedState();
+  if (pacing == FramePacing::Latest && published.count <= drawnCount) {
+    ZoneScopedN("Wait for tick");
+    published = stateBuffer->waitForPublish(drawnCount, deadline);
+  }
+
+  auto target = pacing == FramePacing::Latest ? published.latest : start - interpolationLag;
+
+  while (true) {
+    if (auto states = stateBuffer->readStates(target)) {
+      drawnCount = published.count;
+      reportPacing(start, std::chrono::steady_clock::now(), target);
+      return PacedStates{.states = std::move(*states), .target = target};
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return std::nullopt;
+    }
+    ZoneScopedN("Wait for state");
+    published = stateBuffer->waitForPublish(published.count, deadline);
+    if (pacing == FramePacing::Latest) {
+      target = published.latest;
+    }
+  }
+}
+
+auto FramePacer::reportPacing(Timestamp start, Timestamp now, Timestamp target) -> void {
+  TracyPlot("Frame state wait (ms)", toMilliseconds(now - start));
+  TracyPlot("Frame render lag (ms)", toMilliseconds(now - target));
+
+  if (lastFrameTime) {
+    const auto intervalMs = toMilliseconds(now - *lastFrameTime);
+    TracyPlot("Frame interval (ms)", intervalMs);
+    if (lastIntervalMs) {
+      TracyPlot("Frame jitter (ms)", std::abs(intervalMs - *lastIntervalMs));
+    }
+    lastIntervalMs = intervalMs;
+  }
+  lastFrameTime = now;
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "api/fx/IStateBuffer.hpp"
+#include "gfx/RenderContextConfig.hpp"
+
+namespace tr {
+
+/// Decides which game time the render thread draws each frame, and blocks until the state buffer
+/// has published the ticks needed to draw it.
+///
+/// The wait is on the buffer's publish signal rather than a sleep, so a frame starts as soon as
+/// the tick it needs lands. Frame interval, interval jitter, time spent waiting on the game
+/// thread, and how far behind now the drawn time is are all reported as Tracy plots.
+class FramePacer {
+public:
+  struct PacedStates {
+    StateReadView states;
+    /// The time to interpolate the states to
+    Timestamp target;
+  };
+
+  FramePacer(std::shared_ptr<IStateBuffer> newStateBuffer,
+             FramePacing newPacing,
+             std::chrono::milliseconds newInterpolationLag,
+             std::chrono::milliseconds newMaxWait);
+  ~FramePacer() = default;
+
+  FramePacer(const FramePacer&) = delete;
+  FramePacer(FramePacer&&) = delete;
+  auto operator=(const FramePacer&) -> FramePacer& = delete;
+  auto operator=(FramePacer&&) -> FramePacer& = delete;
+
+  /// Returns nullopt if the states needed still weren't there after the max wait. In Latest mode,
+  /// a game thread that simply hasn't ticked again gets its newest tick drawn a second time.
+  auto acquire() -> std::optional<PacedStates>;
+
+private:
+  std::shared_ptr<IStateBuffer> stateBuffer;
+  FramePacing pacing;
+  std::chrono::milliseconds interpolationLag;
+  std::chrono::milliseconds maxWait;
+
+  /// Publish count as of the last frame drawn in Latest mode
+  uint64_t drawnCount{};
+  std::optional<Timestamp> lastFrameTime;
+  std::optional<double> lastIntervalMs;
+
+  auto reportPacing(Timestamp start, Timestamp now, Timestamp target) -> void;
+};
+
+}
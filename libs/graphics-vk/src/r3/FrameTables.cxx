@@ -0,0 +1,185 @@
+#include "r3/FrameTables.hpp"
+#include "r3/HzbCulling.hpp"
+
+namespace tr {
+
+namespace {
+
+const auto DefaultBaseColor = glm::vec4{1.f, 0.f, 0.f, 1.f};
+/// Objects with no texture sample whatever texture was registered first
+constexpr uint32_t DefaultTextureId = 0;
+/// Culling counts up from this, so it's written over the last frame's count every frame
+constexpr auto EmptyDrawCount = GpuDrawCount{};
+
+template <typename T>
+auto appendRanges(std::vector<TableWrite>& writes,
+                  FrameTable table,
+                  const std::vector<T>& contents,
+                  const std::vector<ObjectRange>& ranges) -> void {
+  for (const auto& range : ranges) {
+    writes.push_back(TableWrite{.table = table,
+                                .data = contents.data() + range.first,
+                                .offset = sizeof(T) * range.first,
+                                .size = sizeof(T) * range.count});
+  }
+}
+
+template <typename T>
+auto appendWhole(std::vector<TableWrite>& writes, FrameTable table, const std::vector<T>& contents)
+    -> void {
+  writes.push_back(TableWrite{
+      .table = table, .data = contents.data(), .offset = 0, .size = sizeof(T) * contents.size()});
+}
+
+}
+
+FrameTables::FrameTables(std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+                         RegionLookup newRegionLookup,
+                         TextureLookup newTextureLookup)
+    : geometryHandleMapper{std::move(newGeometryHandleMapper)},
+      regionLookup{std::move(newRegionLookup)},
+      textureLookup{std::move(newTextureLookup)} {
+}
+
+auto FrameTables::update(const SimState& state) -> void {
+  ZoneScopedN("FrameTables::update");
+  const auto count = state.objectMetadata.size();
+  auto batchesChanged = count != objectData.size();
+  objectData.resize(count);
+  materials.resize(count);
+
+  for (const auto& range : tracker.collect(0, state.objectVersions)) {
+    const auto rangeHandles = std::span{state.stateHandles}.subspan(range.first, range.count);
+    const auto allFound = geometryHandleMapper->toInternal(
+        rangeHandles, &StateHandles::geometryHandle, regionHandles);
+    if (!allFound) {
+      Log.warn("SimState references geometry with no region, objects {}-{}",
+               range.first,
+               range.first + range.count - 1);
+    }
+
+    for (uint32_t j = 0; j < range.count; ++j) {
+      const auto i = range.first + j;
+      const auto& handles = rangeHandles[j];
+      // A default handle is only ambiguous when the batch came back with stale ones in it
+      const auto region = allFound ? std::optional{regionHandles[j]}
+                                   : geometryHandleMapper->toInternal(handles.geometryHandle);
+      const auto previousRegionId = objectData[i].geometryRegionId;
+      const auto previousTextureId = materials[i].albedoTextureId;
+
+      objectData[i] = state.objectMetadata[i];
+      objectData[i].geometryRegionId = regionIndex(handles.geometryHandle, region);
+      objectData[i].materialId = i;
+      materials[i] = GpuMaterialData{.baseColor = DefaultBaseColor,
+                                     .albedoTextureId = handles.textureHandle
+                                                            ? textureLookup(*handles.textureHandle)
+                                                            : DefaultTextureId};
+
+      batchesChanged = batchesChanged || previousRegionId != objectData[i].geometryRegionId ||
+                       previousTextureId != materials[i].albedoTextureId;
+    }
+  }
+
+  tracker.markSynced(0, state.tick);
+
+  if (batchesChanged) {
+    drawBatcher.build(objectData, materials);
+    ++batchGeneration;
+  }
+
+  if (batchesChanged || commandRegionGeneration != regionGeneration) {
+    drawCommands.clear();
+    for (const auto& batch : drawBatcher.getBatches()) {
+      const auto& region = geometryRegions[batch.geometryRegionId];
+      drawCommands.push_back(GpuIndirectCommand{.vertexCount = region.indexCount,
+                                                .instanceCount = 0,
+                                                .firstVertex = region.indexOffset,
+                                                .firstInstance = batch.firstInstance});
+    }
+    commandRegionGeneration = regionGeneration;
+  }
+}
+
+auto FrameTables::collectWrites(uint8_t frameIndex, const SimState& state, uint64_t syncedTick)
+    -> const std::vector<TableWrite>& {
+  ZoneScopedN("FrameTables::collectWrites");
+  writes.clear();
+
+  // Each frame's object tables persist between uses, so only objects that changed since the
+  // states it was last built from need rewriting
+  const auto& ranges = uploadTracker.collect(frameIndex, state.objectVersions);
+  appendRanges(writes, FrameTable::ObjectData, objectData, ranges);
+  appendRanges(writes, FrameTable::Materials, materials, ranges);
+  appendRanges(writes, FrameTable::Positions, state.positions, ranges);
+  appendRanges(writes, FrameTable::Rotations, state.rotations, ranges);
+  // For some reason the last object's scales are getting set to 0s
+  static_assert(sizeof(GpuScaleData) == 12);
+  appendRanges(writes, FrameTable::Scales, state.scales, ranges);
+  uploadTracker.markSynced(frameIndex, syncedTick);
+
+  // Regions only change when a mesh is first drawn, however many objects share it
+  appendRanges(writes,
+               FrameTable::GeometryRegions,
+               geometryRegions,
+               regionUploadTracker.collect(frameIndex, regionVersions));
+  regionUploadTracker.markSynced(frameIndex, regionGeneration);
+
+  // Batches only change when objects come and go or swap mesh or material
+  if (frameIndex >= batchUploadGenerations.size()) {
+    batchUploadGenerations.resize(frameIndex + 1);
+  }
+  if (batchUploadGenerations[frameIndex] < batchGeneration) {
+    appendWhole(writes, FrameTable::DrawBatches, drawBatcher.getBatches());
+    appendWhole(writes, FrameTable::DrawInstances, drawBatcher.getInstances());
+    batchUploadGenerations[frameIndex] = batchGeneration;
+  }
+
+  // Each culling phase counts each batch's instances up from zero then packs the commands in
+  // place, so both phases' commands and their counts are reset every frame
+  for (const auto [commands, count] :
+       {std::pair{FrameTable::DrawCommands, FrameTable::DrawCount},
+        std::pair{FrameTable::LateDrawCommands, FrameTable::LateDrawCount}}) {
+    appendWhole(writes, commands, drawCommands);
+    writes.push_back(TableWrite{
+        .table = count, .data = &EmptyDrawCount, .offset = 0, .size = sizeof(GpuDrawCount)});
+  }
+
+  return writes;
+}
+
+auto FrameTables::getFrameData(const SimState& state, glm::uvec2 hzbExtent) const
+    -> GpuFrameData {
+  const auto viewProjection = state.projection * state.view;
+  return GpuFrameData{
+      .view = state.view,
+      .projection = state.projection,
+      .cameraPosition = glm::vec4(0.f, 0.f, 5.f, 1.f),
+      .time = 0.f,
+      .maxObjects = static_cast<uint32_t>(state.objectMetadata.size()),
+      .batchCount = static_cast<uint32_t>(drawBatcher.getBatches().size()),
+      .frustumPlanes = extractFrustumPlanes(viewProjection),
+      .viewProjection = viewProjection,
+      .hzbExtent = hzbExtent,
+      .hzbMipCount = hzbMipCount(hzbExtent),
+  };
+}
+
+auto FrameTables::regionIndex(Handle<Geometry> geometry,
+                              std::optional<Handle<GeometryRegion>> region) -> uint32_t {
+  const auto index = GeometryHandleMapper::indexOf(geometry);
+  if (index >= regionSources.size()) {
+    geometryRegions.resize(index + 1);
+    regionSources.resize(index + 1);
+    regionVersions.resize(index + 1);
+  }
+  if (regionSources[index] == geometry) {
+    return index;
+  }
+
+  geometryRegions[index] = region ? regionLookup(*region) : GpuGeometryRegionData{};
+  regionSources[index] = geometry;
+  regionVersions[index] = ++regionGeneration;
+  return index;
+}
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "api/gfx/SimState.hpp"
+#include "gfx/HandleMapperTypes.hpp"
+#include "r3/DirtyRangeTracker.hpp"
+#include "r3/DrawBatcher.hpp"
+
+namespace tr {
+
+/// The tables each frame in flight keeps its own copy of on the GPU
+enum class FrameTable : uint8_t {
+  ObjectData = 0,
+  Materials,
+  Positions,
+  Rotations,
+  Scales,
+  GeometryRegions,
+  DrawBatches,
+  DrawInstances,
+  DrawCommands,
+  DrawCount,
+  LateDrawCommands,
+  LateDrawCount,
+};
+
+/// One write into a frame in flight's copy of a table. `offset` and `size` are in bytes.
+struct TableWrite {
+  FrameTable table;
+  const void* data;
+  size_t offset;
+  size_t size;
+};
+
+/// CPU side copies of the object, geometry region and material tables the GPU reads, brought up
+/// to date with each SimState a dirty range at a time. Texture lookups are only redone for objects
+/// that changed.
+///
+/// The object and material tables are indexed by the object's slot in the SimState, so they can be
+/// uploaded with the same dirty ranges. The geometry region table has one entry per mesh instead,
+/// indexed by the mesh's GeometryHandleMapper entry, and objects point at it with
+/// geometryRegionId. An entry is only looked up when a mesh is first drawn or its mapping changes,
+/// and carries its own version so it's only uploaded then too.
+///
+/// Objects are also grouped into instanced draw batches. Those only depend on which mesh and
+/// material each slot holds, so they're rebuilt when that changes rather than whenever an object
+/// moves. Each batch has an indirect command with no instances yet, for culling to fill in.
+///
+/// R3Renderer and the headless NullRenderContext both take their per frame uploads from one of
+/// these with `collectWrites`, and only differ in where the writes go, so profiling either one
+/// measures the same CPU work.
+class FrameTables {
+public:
+  using RegionLookup = std::function<GpuGeometryRegionData(Handle<GeometryRegion>)>;
+  using TextureLookup = std::function<uint32_t(Handle<TextureTag>)>;
+
+  FrameTables(std::shared_ptr<GeometryHandleMapper> newGeometryHandleMapper,
+              RegionLookup newRegionLookup,
+              TextureLookup newTextureLookup);
+  ~FrameTables() = default;
+
+  FrameTables(const FrameTables&) = delete;
+  FrameTables(FrameTables&&) = delete;
+  auto operator=(const FrameTables&) -> FrameTables& = delete;
+  auto operator=(FrameTables&&) -> FrameTables& = delete;
+
+  auto update(const SimState& state) -> void;
+
+  /// Everything frame `frameIndex`'s copies of the tables need rewritten to match the last
+  /// `update`, with `state` the one it was given. `syncedTick` is the newest tick those tables
+  /// can be counted as up to date with afterwards. The writes point into these tables and `state`,
+  /// and are only valid until the next update.
+  auto collectWrites(uint8_t frameIndex, const SimState& state, uint64_t syncedTick)
+      -> const std::vector<TableWrite>&;
+
+  /// The per frame constants culling and drawing `state` read
+  [[nodiscard]] auto getFrameData(const SimState& state, glm::uvec2 hzbExtent) const
+      -> GpuFrameData;
+
+  [[nodiscard]] auto getObjectData() const -> const std::vector<GpuObjectData>& {
+    return objectData;
+  }
+
+  [[nodiscard]] auto getGeometryRegions() const -> const std::vector<GpuGeometryRegionData>& {
+    return geometryRegions;
+  }
+
+  /// Version each geometry region entry last changed at, comparable with `getRegionGeneration`.
+  /// Entries no object has referenced yet are 0.
+  [[nodiscard]] auto getRegionVersions() const -> const std::vector<uint64_t>& {
+    return regionVersions;
+  }
+
+  /// Newest region version handed out so far.
+  [[nodiscard]] auto getRegionGeneration() const -> uint64_t {
+    return regionGeneration;
+  }
+
+  [[nodiscard]] auto getMaterials() const -> const std::vector<GpuMaterialData>& {
+    return materials;
+  }
+
+  [[nodiscard]] auto getDrawBatches() const -> const std::vector<GpuDrawBatch>& {
+    return drawBatcher.getBatches();
+  }
+
+  [[nodiscard]] auto getDrawInstances() const -> const std::vector<GpuDrawInstance>& {
+    return drawBatcher.getInstances();
+  }
+
+  /// One per batch, with instanceCount left at 0
+  [[nodiscard]] auto getDrawCommands() const -> const std::vector<GpuIndirectCommand>& {
+    return drawCommands;
+  }
+
+  /// Bumped every time the draw batches are rebuilt
+  [[nodiscard]] auto getBatchGeneration() const -> uint64_t {
+    return batchGeneration;
+  }
+
+private:
+  std::shared_ptr<GeometryHandleMapper> geometryHandleMapper;
+  RegionLookup regionLookup;
+  TextureLookup textureLookup;
+
+  DirtyRangeTracker tracker;
+
+  std::vector<GpuObjectData> objectData;
+  std::vector<GpuMaterialData> materials;
+
+  std::vector<GpuGeometryRegionData> geometryRegions;
+  /// Parallel to geometryRegions. The handle each entry was looked up for, so an entry the mapper
+  /// has since reused for another mesh is noticed.
+  std::vector<Handle<Geometry>> regionSources;
+  std::vector<uint64_t> regionVersions;
+  uint64_t regionGeneration{};
+
+  DrawBatcher drawBatcher;
+  uint64_t batchGeneration{};
+  std::vector<GpuIndirectCommand> drawCommands;
+  /// Region generation drawCommands were built against
+  uint64_t commandRegionGeneration{};
+
+  /// Scratch for translating a dirty range's geometry handles in one go
+  std::vector<Handle<GeometryRegion>> regionHandles;
+
+  /// One consumer per frame in flight, indexed by frameIndex
+  DirtyRangeTracker uploadTracker;
+  /// Same again for the geometry region table, which is versioned separately
+  DirtyRangeTracker regionUploadTracker;
+  /// Draw batches are rewritten whole, this just remembers which batch generation each frame has,
+  /// indexed by frameIndex
+  std::vector<uint64_t> batchUploadGenerations;
+  std::vector<TableWrite> writes;
+
+  /// Returns the index of `geometry`'s region entry, looking `region` up first if it's new. A
+  /// missing `region` leaves the entry empty.
+  auto regionIndex(Handle<Geometry> geometry, std::optional<Handle<GeometryRegion>> region)
+      -> uint32_t;
+};
+
+}
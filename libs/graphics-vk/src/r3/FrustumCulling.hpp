@@ -0,0 +1,134 @@
+#pragma once
+
+#include "api/gfx/GpuMaterialData.hpp"
+
+// CPU mirror of the frustum test in compute2.comp. Keep the two in step, the tests for this are
+// the only check the shader's math gets without a GPU.
+
+namespace tr {
+
+/// Mesh space bounds of a piece of geometry
+struct GeometryBounds {
+  /// xyz is the center, w the radius
+  glm::vec4 sphere{0.f};
+  glm::vec3 min{0.f};
+  glm::vec3 max{0.f};
+};
+
+/// Planes as (normal, distance) with normals pointing into the frustum, in left, right, bottom,
+/// top, near, far order.
+using FrustumPlanes = std::array<glm::vec4, 6>;
+
+inline auto computeBounds(std::span<const GpuVertexPositionData> positions) -> GeometryBounds {
+  if (positions.empty()) {
+    return GeometryBounds{};
+  }
+
+  const auto& first = positions.front().position;
+  auto bounds = GeometryBounds{.min = first, .max = first};
+  for (const auto& vertex : positions) {
+    bounds.min = glm::min(bounds.min, vertex.position);
+    bounds.max = glm::max(bounds.max, vertex.position);
+  }
+
+  // Centering the sphere on the box is a little loose, but it's cheap and stable
+  const auto center = (bounds.min + bounds.max) * 0.5f;
+  auto radius = 0.f;
+  for (const auto& vertex : positions) {
+    radius = std::max(radius, glm::length(vertex.position - center));
+  }
+  bounds.sphere = glm::vec4{center, radius};
+  return bounds;
+}
+
+/// Bounds of raw GeometryData::positionData
+inline auto computeBounds(std::span<const std::byte> positionData) -> GeometryBounds {
+  return computeBounds(
+      std::span{reinterpret_cast<const GpuVertexPositionData*>(positionData.data()),
+                positionData.size() / sizeof(GpuVertexPositionData)});
+}
+
+/// Extracts the planes from a projection * view matrix whose clip space depth runs from 0 to 1.
+inline auto extractFrustumPlanes(const glm::mat4& viewProjection) -> FrustumPlanes {
+  const auto row = [&viewProjection](glm::length_t index) {
+    return glm::vec4{viewProjection[0][index],
+                     viewProjection[1][index],
+                     viewProjection[2][index],
+                     viewProjection[3][index]};
+  };
+  const auto r0 = row(0);
+  const auto r1 = row(1);
+  const auto r2 = row(2);
+  const auto r3 = row(3);
+
+  auto planes = FrustumPlanes{r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2};
+  for (auto& plane : planes) {
+    plane /= glm::length(glm::vec3{plane});
+  }
+  return planes;
+}
+
+/// Same as the vertex shader's applyQuaternion
+inline auto applyQuaternion(const glm::quat& q, const glm::vec3& v) -> glm::vec3 {
+  const auto u = glm::vec3{q.x, q.y, q.z};
+  const auto s = q.w;
+  return 2.f * glm::dot(u, v) * u + (s * s - glm::dot(u, u)) * v + 2.f * s * glm::cross(u, v);
+}
+
+inline auto sphereInFrustum(const FrustumPlanes& planes, const glm::vec3& center, float radius)
+    -> bool {
+  return std::ranges::all_of(planes, [&](const glm::vec4& plane) {
+    return glm::dot(glm::vec3{plane}, center) + plane.w >= -radius;
+  });
+}
+
+/// `extents` are the box's half sizes along each world axis
+inline auto boxInFrustum(const FrustumPlanes& planes,
+                         const glm::vec3& center,
+                         const glm::vec3& extents) -> bool {
+  return std::ranges::all_of(planes, [&](const glm::vec4& plane) {
+    const auto normal = glm::vec3{plane};
+    return glm::dot(normal, center) + plane.w >= -glm::dot(glm::abs(normal), extents);
+  });
+}
+
+/// A box around an object, aligned to the world axes
+struct WorldBox {
+  glm::vec3 center;
+  /// Half sizes along each world axis
+  glm::vec3 extents;
+};
+
+/// The box around `region`'s bounding box once it's been scaled, rotated and moved into place
+inline auto computeWorldBox(const GpuGeometryRegionData& region,
+                            const glm::vec3& position,
+                            const glm::quat& rotation,
+                            const glm::vec3& scale) -> WorldBox {
+  const auto center =
+      applyQuaternion(rotation, scale * ((region.boundsMin + region.boundsMax) * 0.5f)) + position;
+  const auto halfSize = glm::abs(scale * ((region.boundsMax - region.boundsMin) * 0.5f));
+  const auto extents = glm::abs(applyQuaternion(rotation, glm::vec3{1.f, 0.f, 0.f})) * halfSize.x +
+                       glm::abs(applyQuaternion(rotation, glm::vec3{0.f, 1.f, 0.f})) * halfSize.y +
+                       glm::abs(applyQuaternion(rotation, glm::vec3{0.f, 0.f, 1.f})) * halfSize.z;
+  return WorldBox{.center = center, .extents = extents};
+}
+
+/// Whether an object drawing `region` with the given transform might be on screen. Tests the
+/// bounding sphere first, then the box around the rotated bounding box for anything that passes.
+inline auto isObjectVisible(const FrustumPlanes& planes,
+                            const GpuGeometryRegionData& region,
+                            const glm::vec3& position,
+                            const glm::quat& rotation,
+                            const glm::vec3& scale) -> bool {
+  const auto sphereCenter = applyQuaternion(rotation, scale * glm::vec3{region.boundingSphere}) +
+                            position;
+  const auto maxScale = std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+  if (!sphereInFrustum(planes, sphereCenter, region.boundingSphere.w * maxScale)) {
+    return false;
+  }
+
+  const auto box = computeWorldBox(region, position, rotation, scale);
+  return boxInFrustum(planes, box.center, box.extents);
+}
+
+}
@@ -15,31 +15,36 @@ GeometryBufferPack::GeometryBufferPack(std::shared_ptr<BufferSystem> newBufferSy
                            .bufferLifetime = BufferLifetime::Persistent,
                            .initialSize = IndexBufferInitialSize,
                            .itemStride = sizeof(uint32_t),
-                           .debugName = "Buffer-GeometryIndex"})},
+                           .debugName = "Buffer-GeometryIndex",
+                           .concurrent = true})},
       positionBuffer{bufferSystem->registerBuffer(
           BufferCreateInfo{.allocationStrategy = AllocationStrategy::Arena,
                            .bufferLifetime = BufferLifetime::Persistent,
                            .initialSize = PositionBufferInitialSize,
                            .itemStride = sizeof(glm::vec3),
-                           .debugName = "Buffer-GeometryPosition"})},
+                           .debugName = "Buffer-GeometryPosition",
+                           .concurrent = true})},
       colorBuffer{bufferSystem->registerBuffer(
           BufferCreateInfo{.allocationStrategy = AllocationStrategy::Arena,
                            .bufferLifetime = BufferLifetime::Persistent,
                            .initialSize = ColorBufferInitialSize,
                            .itemStride = sizeof(glm::vec4),
-                           .debugName = "Buffer-GeometryColors"})},
+                           .debugName = "Buffer-GeometryColors",
+                           .concurrent = true})},
       texCoordBuffer{bufferSystem->registerBuffer(
           BufferCreateInfo{.allocationStrategy = AllocationStrategy::Arena,
                            .bufferLifetime = BufferLifetime::Persistent,
                            .initialSize = TexCoordBufferInitialSize,
                            .itemStride = sizeof(glm::vec2),
-                           .debugName = "Buffer-GeometryTexCoords"})},
+                           .debugName = "Buffer-GeometryTexCoords",
+                           .concurrent = true})},
       normalBuffer{bufferSystem->registerBuffer(
           BufferCreateInfo{.allocationStrategy = AllocationStrategy::Arena,
                            .bufferLifetime = BufferLifetime::Persistent,
                            .initialSize = NormalBufferInitialSize,
                            .itemStride = sizeof(glm::vec3),
-                           .debugName = "Buffer-GeometryNormal"})},
+                           .debugName = "Buffer-GeometryNormal",
+                           .concurrent = true})},
       animationBuffer{bufferSystem->registerBuffer(
           BufferCreateInfo{.allocationStrategy = AllocationStrategy::Arena,
                            .bufferLifetime = BufferLifetime::Persistent,
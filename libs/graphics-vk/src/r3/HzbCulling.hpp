@@ -0,0 +1,183 @@
+#pragma once
+
+#include "r3/FrustumCulling.hpp"
+
+// CPU mirror of the depth pyramid built by depth_pyramid.comp and the occlusion test against it
+// in compute2.comp. Keep the three in step.
+//
+// The pyramid is one buffer holding every mip back to back. Mip 0 is a copy of the depth image
+// and each mip after it is half the size of the one before, rounded up, with each texel keeping
+// the farthest depth of the texels it covers. Depth is cleared to 1 and tested with less, so the
+// farthest depth is the largest.
+
+namespace tr {
+
+/// Mips down to and including 1x1
+inline auto hzbMipCount(glm::uvec2 extent) -> uint32_t {
+  auto count = 1U;
+  for (auto size = std::max(extent.x, extent.y); size > 1; size = (size + 1) / 2) {
+    ++count;
+  }
+  return count;
+}
+
+inline auto hzbMipExtent(glm::uvec2 extent, uint32_t level) -> glm::uvec2 {
+  return glm::uvec2{((extent.x - 1) >> level) + 1, ((extent.y - 1) >> level) + 1};
+}
+
+/// Index of a mip's first texel in the pyramid buffer
+inline auto hzbMipOffset(glm::uvec2 extent, uint32_t level) -> uint32_t {
+  auto offset = 0U;
+  for (uint32_t i = 0; i < level; ++i) {
+    const auto size = hzbMipExtent(extent, i);
+    offset += size.x * size.y;
+  }
+  return offset;
+}
+
+inline auto hzbTexelCount(glm::uvec2 extent) -> uint32_t {
+  return hzbMipOffset(extent, hzbMipCount(extent));
+}
+
+/// One texel of `level`, from the up to 2x2 texels of the mip before it that it covers. Texels
+/// past the edge of an odd sized mip clamp back onto it.
+inline auto reduceHzbTexel(std::span<const float> pyramid,
+                           glm::uvec2 extent,
+                           uint32_t level,
+                           glm::uvec2 texel) -> float {
+  const auto source = hzbMipExtent(extent, level - 1);
+  const auto offset = hzbMipOffset(extent, level - 1);
+  const auto x0 = texel.x * 2;
+  const auto y0 = texel.y * 2;
+  const auto x1 = std::min(x0 + 1, source.x - 1);
+  const auto y1 = std::min(y0 + 1, source.y - 1);
+  return std::max({pyramid[offset + (y0 * source.x) + x0],
+                   pyramid[offset + (y0 * source.x) + x1],
+                   pyramid[offset + (y1 * source.x) + x0],
+                   pyramid[offset + (y1 * source.x) + x1]});
+}
+
+/// The whole pyramid for a depth image, built a mip at a time the way the dispatches are
+inline auto buildDepthPyramid(std::span<const float> depth, glm::uvec2 extent)
+    -> std::vector<float> {
+  auto pyramid = std::vector<float>(hzbTexelCount(extent));
+  std::ranges::copy(depth, pyramid.begin());
+  const auto mipCount = hzbMipCount(extent);
+  for (uint32_t level = 1; level < mipCount; ++level) {
+    const auto size = hzbMipExtent(extent, level);
+    const auto offset = hzbMipOffset(extent, level);
+    for (uint32_t y = 0; y < size.y; ++y) {
+      for (uint32_t x = 0; x < size.x; ++x) {
+        pyramid[offset + (y * size.x) + x] =
+            reduceHzbTexel(pyramid, extent, level, glm::uvec2{x, y});
+      }
+    }
+  }
+  return pyramid;
+}
+
+/// The mip 0 texels an object might cover, inclusive, and the depth of its nearest point
+struct HzbFootprint {
+  glm::uvec2 min;
+  glm::uvec2 max;
+  float nearestDepth;
+};
+
+/// Projects a world space box onto a screen of `extent` texels. Returns nothing for boxes that
+/// reach past the near plane, as nothing can be said about what they cover.
+inline auto projectBox(const glm::mat4& viewProjection,
+                       const glm::vec3& center,
+                       const glm::vec3& extents,
+                       glm::uvec2 extent) -> std::optional<HzbFootprint> {
+  auto minX = 1.f;
+  auto minY = 1.f;
+  auto maxX = -1.f;
+  auto maxY = -1.f;
+  auto nearestDepth = 1.f;
+  for (uint32_t corner = 0; corner < 8; ++corner) {
+    const auto sign = glm::vec3{(corner & 1U) != 0 ? 1.f : -1.f,
+                                (corner & 2U) != 0 ? 1.f : -1.f,
+                                (corner & 4U) != 0 ? 1.f : -1.f};
+    const auto clip = viewProjection * glm::vec4{center + (sign * extents), 1.f};
+    if (clip.w <= 0.f || clip.z < 0.f) {
+      return std::nullopt;
+    }
+    minX = std::min(minX, clip.x / clip.w);
+    minY = std::min(minY, clip.y / clip.w);
+    maxX = std::max(maxX, clip.x / clip.w);
+    maxY = std::max(maxY, clip.y / clip.w);
+    nearestDepth = std::min(nearestDepth, clip.z / clip.w);
+  }
+
+  // Vulkan puts -1 at the top of the viewport, the same as row 0 of the depth image
+  const auto toTexel = [](float ndc, uint32_t size) {
+    const auto texel =
+        std::floor(std::clamp((ndc * 0.5f) + 0.5f, 0.f, 1.f) * static_cast<float>(size));
+    return std::min(static_cast<uint32_t>(texel), size - 1);
+  };
+  return HzbFootprint{
+      .min = glm::uvec2{toTexel(minX, extent.x), toTexel(minY, extent.y)},
+      .max = glm::uvec2{toTexel(maxX, extent.x), toTexel(maxY, extent.y)},
+      .nearestDepth = nearestDepth,
+  };
+}
+
+/// The finest mip at which the footprint covers no more than 2x2 texels
+inline auto selectHzbLevel(const HzbFootprint& footprint, uint32_t mipCount) -> uint32_t {
+  auto level = 0U;
+  while (level + 1 < mipCount && (((footprint.max.x >> level) - (footprint.min.x >> level) > 1) ||
+                                  ((footprint.max.y >> level) - (footprint.min.y >> level) > 1))) {
+    ++level;
+  }
+  return level;
+}
+
+/// Whether everything under the footprint was drawn in front of it
+inline auto isFootprintOccluded(std::span<const float> pyramid,
+                                glm::uvec2 extent,
+                                const HzbFootprint& footprint) -> bool {
+  const auto level = selectHzbLevel(footprint, hzbMipCount(extent));
+  const auto size = hzbMipExtent(extent, level);
+  const auto offset = hzbMipOffset(extent, level);
+
+  auto farthest = 0.f;
+  for (auto y = footprint.min.y >> level; y <= footprint.max.y >> level; ++y) {
+    for (auto x = footprint.min.x >> level; x <= footprint.max.x >> level; ++x) {
+      farthest = std::max(farthest, pyramid[offset + (y * size.x) + x]);
+    }
+  }
+  return footprint.nearestDepth > farthest;
+}
+
+/// Whether an object is hidden behind what was drawn into the pyramid. `viewProjection` is the
+/// one the pyramid's depth was drawn with.
+inline auto isObjectOccluded(std::span<const float> pyramid,
+                             glm::uvec2 extent,
+                             const glm::mat4& viewProjection,
+                             const GpuGeometryRegionData& region,
+                             const glm::vec3& position,
+                             const glm::quat& rotation,
+                             const glm::vec3& scale) -> bool {
+  const auto box = computeWorldBox(region, position, rotation, scale);
+  const auto footprint = projectBox(viewProjection, box.center, box.extents, extent);
+  return footprint && isFootprintOccluded(pyramid, extent, *footprint);
+}
+
+// Culling runs in two phases a frame. The early phase draws what was visible last frame and is
+// still in the frustum, without testing it against anything, and the pyramid is built from its
+// depth. The late phase tests everything in the frustum against that pyramid. Whatever passes is
+// visible for the next frame's early phase, and drawn now unless the early phase already drew it,
+// so an object coming out from behind another is drawn the frame it does.
+
+/// Whether the early phase draws an object
+inline auto isDrawnEarly(bool inFrustum, bool wasVisible) -> bool {
+  return inFrustum && wasVisible;
+}
+
+/// Whether the late phase draws an object, `visible` being whether it's in the frustum and not
+/// occluded
+inline auto isDrawnLate(bool wasVisible, bool visible) -> bool {
+  return visible && !wasVisible;
+}
+
+}
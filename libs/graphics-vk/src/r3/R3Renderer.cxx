@@ -1,5 +1,6 @@
 #include "R3Renderer.hpp"
 #include "FrameState.hpp"
+#include "api/fx/IGuiCallbackRegistrar.hpp"
 #include "api/gw/EditorStateBuffer.hpp"
 #include "buffers/BufferCreateInfo.hpp"
 #include "buffers/BufferSystem.hpp"
@@ -9,8 +10,10 @@
 #include "img/ImageManager.hpp"
 #include "img/TextureArena.hpp"
 #include "r3/GeometryBufferPack.hpp"
+#include "r3/HzbCulling.hpp"
 #include "r3/draw-context/ContextFactory.hpp"
 #include "r3/draw-context/IDispatchContext.hpp"
+#include "r3/graph/PassRecorder.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
 #include "r3/render-pass/IRenderPass.hpp"
 #include "r3/render-pass/RenderPassFactory.hpp"
@@ -27,17 +30,31 @@
 
 namespace tr {
 
+namespace {
+
+auto createTimeline(const Device& device) -> QueueTimeline {
+  const auto typeInfo =
+      vk::SemaphoreTypeCreateInfo{.semaphoreType = vk::SemaphoreType::eTimeline, .initialValue = 0};
+  const auto createInfo = vk::SemaphoreCreateInfo{.pNext = &typeInfo};
+  return QueueTimeline{.semaphore = device.getVkDevice().createSemaphore(createInfo)};
+}
+
+}
+
 const std::unordered_map<ContextId, std::vector<PassId>> GraphicsMap = {
     {ContextId::Cube, {PassId::Forward}},
+    {ContextId::LateCube, {PassId::LateForward}},
     {ContextId::ImGui, {PassId::ImGui}},
     {ContextId::Composition, {PassId::Composition}}};
 
 const std::unordered_map<ContextId, std::vector<PassId>> ComputeMap = {
-    {ContextId::Culling, {PassId::Culling}}};
+    {ContextId::Culling, {PassId::Culling}},
+    {ContextId::LateCulling, {PassId::LateCulling}}};
 
 R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
                        std::shared_ptr<IFrameManager> newFrameManager,
                        std::shared_ptr<queue::Graphics> newGraphicsQueue,
+                       std::shared_ptr<queue::Compute> newComputeQueue,
                        std::shared_ptr<Swapchain> newSwapchain,
                        std::shared_ptr<IFrameGraph> newFrameGraph,
                        std::shared_ptr<RenderPassFactory> newRenderPassFactory,
@@ -56,10 +73,14 @@ R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
                        std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
                        std::shared_ptr<ImageTransitionQueue> newImageQueue,
                        std::shared_ptr<TextureHandleMapper> newTextureHandleMapper,
-                       std::shared_ptr<TextureArena> newTextureArena)
+                       std::shared_ptr<TextureArena> newTextureArena,
+                       std::shared_ptr<PassRecorder> newPassRecorder,
+                       std::shared_ptr<IGuiCallbackRegistrar> newGuiCallbackRegistrar,
+                       std::shared_ptr<Device> newDevice)
     : rendererConfig{newRenderConfig},
       frameManager{std::move(newFrameManager)},
       graphicsQueue{std::move(newGraphicsQueue)},
+      computeQueue{std::move(newComputeQueue)},
       swapchain{std::move(newSwapchain)},
       frameGraph{std::move(newFrameGraph)},
       renderPassFactory{std::move(newRenderPassFactory)},
@@ -78,21 +99,49 @@ R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
       editorStateBuffer{std::move(newEditorStateBuffer)},
       imageQueue{std::move(newImageQueue)},
       textureHandleMapper{std::move(newTextureHandleMapper)},
-      textureArena{std::move(newTextureArena)} {
+      textureArena{std::move(newTextureArena)},
+      passRecorder{std::move(newPassRecorder)},
+      guiCallbackRegistrar{std::move(newGuiCallbackRegistrar)},
+      device{std::move(newDevice)},
+      framePacer{stateBuffer,
+                 rendererConfig.framePacing,
+                 rendererConfig.interpolationLag,
+                 rendererConfig.maxStateWait},
+      frameTables{geometryHandleMapper,
+                  [allocator = geometryAllocator](Handle<GeometryRegion> handle) {
+                    return allocator->getRegionData(handle);
+                  },
+                  [mapper = textureHandleMapper, arena = textureArena](Handle<TextureTag> handle) {
+                    return arena->getTextureIndex(*mapper->toInternal(handle));
+                  }},
+      resourceTables{[system = bufferSystem](Handle<ManagedBuffer> handle) {
+        return system->getBufferAddress(handle);
+      }} {
   Log.trace("Constructing R3Renderer");
 
+  timelines.emplace(QueueType::Graphics, createTimeline(*device));
+  timelines.emplace(QueueType::Compute, createTimeline(*device));
+
   createGlobalBuffers();
   createGlobalImages();
   createGlobalShaderBindings();
 
-  auto cullingPass = createComputeCullingPass();
-  auto forwardPass = createForwardRenderPass();
+  // The early phase draws what was visible last frame, the late phase tests everything else
+  // against the pyramid those draws leave behind and draws what turned out to be visible
+  auto cullingPass = createComputeCullingPass(PassId::Culling, CullPhase::Early);
+  auto forwardPass = createForwardRenderPass(PassId::Forward, vk::AttachmentLoadOp::eClear);
+  auto depthPyramidPass = createDepthPyramidPass();
+  auto lateCullingPass = createComputeCullingPass(PassId::LateCulling, CullPhase::Late);
+  auto lateForwardPass = createForwardRenderPass(PassId::LateForward, vk::AttachmentLoadOp::eLoad);
   auto imguiPass = createImGuiPass();
   auto compositionPass = createCompositionRenderPass();
   auto presentPass = createPresentPass();
 
   frameGraph->addPass(std::move(cullingPass));
   frameGraph->addPass(std::move(forwardPass));
+  frameGraph->addPass(std::move(depthPyramidPass));
+  frameGraph->addPass(std::move(lateCullingPass));
+  frameGraph->addPass(std::move(lateForwardPass));
   frameGraph->addPass(std::move(imguiPass));
   frameGraph->addPass(std::move(compositionPass));
   frameGraph->addPass(std::move(presentPass));
@@ -113,6 +162,13 @@ R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
 
   drawContextFactory->createDispatchContext(ContextId::Cube, forwardDrawCreateInfo);
 
+  auto lateForwardDrawCreateInfo = forwardDrawCreateInfo;
+  lateForwardDrawCreateInfo.indirectCommand = globalBuffers.lateDrawCommands;
+  lateForwardDrawCreateInfo.indirectCommandCount = globalBuffers.lateDrawCounts;
+  lateForwardDrawCreateInfo.phase = CullPhase::Late;
+
+  drawContextFactory->createDispatchContext(ContextId::LateCube, lateForwardDrawCreateInfo);
+
   const auto cullingCreateInfo = CullingDispatchContextCreateInfo{
       .resourceTable = globalBuffers.resourceTable,
       .frameData = globalBuffers.frameData,
@@ -120,6 +176,14 @@ R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
 
   drawContextFactory->createDispatchContext(ContextId::Culling, cullingCreateInfo);
 
+  const auto lateCullingCreateInfo = CullingDispatchContextCreateInfo{
+      .resourceTable = globalBuffers.resourceTable,
+      .frameData = globalBuffers.frameData,
+      .phase = CullPhase::Late,
+  };
+
+  drawContextFactory->createDispatchContext(ContextId::LateCulling, lateCullingCreateInfo);
+
   const auto compositionCreateInfo = CompositionContextCreateInfo{
       .viewport = vk::Viewport{.width = static_cast<float>(rendererConfig.initialWidth),
                                .height = static_cast<float>(rendererConfig.initialHeight),
@@ -158,6 +222,8 @@ R3Renderer::R3Renderer(RenderContextConfig newRenderConfig,
   }
 
   frameGraph->bake();
+  // Baking may have moved images into shared memory, so views are only taken after it
+  bindCompositionImages();
 }
 
 auto R3Renderer::createGlobalBuffers() -> void {
@@ -170,11 +236,25 @@ auto R3Renderer::createGlobalBuffers() -> void {
 
   globalBuffers.drawCounts = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
-                       .initialSize = 4,
+                       .initialSize = sizeof(GpuDrawCount),
                        .debugName = "DrawCounts",
                        .indirect = true});
   aliasRegistry->setHandle(BufferAlias::IndirectCommandCount, globalBuffers.drawCounts);
 
+  globalBuffers.lateDrawCommands = bufferSystem->registerPerFrameBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
+                       .initialSize = 20480,
+                       .debugName = "LateDrawCommands",
+                       .indirect = true});
+  aliasRegistry->setHandle(BufferAlias::LateIndirectCommand, globalBuffers.lateDrawCommands);
+
+  globalBuffers.lateDrawCounts = bufferSystem->registerPerFrameBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
+                       .initialSize = sizeof(GpuDrawCount),
+                       .debugName = "LateDrawCounts",
+                       .indirect = true});
+  aliasRegistry->setHandle(BufferAlias::LateIndirectCommandCount, globalBuffers.lateDrawCounts);
+
   globalBuffers.drawMetadata = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient, .debugName = "DrawMetadata"});
   aliasRegistry->setHandle(BufferAlias::IndirectMetaData, globalBuffers.drawMetadata);
@@ -182,31 +262,36 @@ auto R3Renderer::createGlobalBuffers() -> void {
   globalBuffers.objectData = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
                        .initialSize = 40960,
-                       .debugName = "Buffer-ObjectData"});
+                       .debugName = "Buffer-ObjectData",
+                       .concurrent = true});
   aliasRegistry->setHandle(BufferAlias::ObjectData, globalBuffers.objectData);
 
   globalBuffers.objectPositions = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
                        .initialSize = 40960,
-                       .debugName = "Buffer-ObjectPositions"});
+                       .debugName = "Buffer-ObjectPositions",
+                       .concurrent = true});
   aliasRegistry->setHandle(BufferAlias::ObjectPositions, globalBuffers.objectPositions);
 
   globalBuffers.objectRotations = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
                        .initialSize = 40960,
-                       .debugName = "Buffer-ObjectRotations"});
+                       .debugName = "Buffer-ObjectRotations",
+                       .concurrent = true});
   aliasRegistry->setHandle(BufferAlias::ObjectRotations, globalBuffers.objectRotations);
 
   globalBuffers.objectScales = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
                        .initialSize = 40960,
-                       .debugName = "Buffer-ObjectScales"});
+                       .debugName = "Buffer-ObjectScales",
+                       .concurrent = true});
   aliasRegistry->setHandle(BufferAlias::ObjectScales, globalBuffers.objectScales);
 
   globalBuffers.geometryRegion = bufferSystem->registerPerFrameBuffer(
       BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
                        .initialSize = 8192,
-                       .debugName = "Buffer-GeometryRegion"});
+                       .debugName = "Buffer-GeometryRegion",
+                       .concurrent = true});
   aliasRegistry->setHandle(BufferAlias::GeometryRegion, globalBuffers.geometryRegion);
 
   globalBuffers.materials =
@@ -215,11 +300,30 @@ auto R3Renderer::createGlobalBuffers() -> void {
                                             .debugName = "Buffer-Materials"});
   aliasRegistry->setHandle(BufferAlias::Materials, globalBuffers.materials);
 
+  globalBuffers.drawBatches = bufferSystem->registerPerFrameBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
+                       .initialSize = 40960,
+                       .debugName = "Buffer-DrawBatches"});
+  aliasRegistry->setHandle(BufferAlias::DrawBatches, globalBuffers.drawBatches);
+
+  globalBuffers.drawInstances = bufferSystem->registerPerFrameBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
+                       .initialSize = 40960,
+                       .debugName = "Buffer-DrawInstances"});
+  aliasRegistry->setHandle(BufferAlias::DrawInstances, globalBuffers.drawInstances);
+
+  globalBuffers.visibleObjects = bufferSystem->registerPerFrameBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Transient,
+                       .initialSize = 40960,
+                       .debugName = "Buffer-VisibleObjects"});
+  aliasRegistry->setHandle(BufferAlias::VisibleObjects, globalBuffers.visibleObjects);
+
   globalBuffers.frameData = bufferSystem->registerPerFrameBuffer(BufferCreateInfo{
       .bufferLifetime = BufferLifetime::Transient,
       .bufferUsage = BufferUsage::Storage,
       .initialSize = 40960,
       .debugName = "Buffer-FrameData",
+      .concurrent = true,
   });
   aliasRegistry->setHandle(BufferAlias::FrameData, globalBuffers.frameData);
 
@@ -227,8 +331,25 @@ auto R3Renderer::createGlobalBuffers() -> void {
       .bufferLifetime = BufferLifetime::Transient,
       .bufferUsage = BufferUsage::Storage,
       .debugName = "Buffer-ResourceTable",
+      .concurrent = true,
   });
   aliasRegistry->setHandle(BufferAlias::ResourceTable, globalBuffers.resourceTable);
+
+  const auto hzbExtent = glm::uvec2{rendererConfig.initialWidth, rendererConfig.initialHeight};
+  globalBuffers.depthPyramid = bufferSystem->registerBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Persistent,
+                       .initialSize = hzbTexelCount(hzbExtent) * sizeof(float),
+                       .debugName = "Buffer-DepthPyramid"});
+  aliasRegistry->setHandle(GlobalBufferAlias::DepthPyramid, globalBuffers.depthPyramid);
+
+  // Never cleared, whatever it starts out holding only costs the first frame some early draws.
+  // Early culling runs on compute and late culling on graphics, so it's shared between them.
+  globalBuffers.objectVisibility = bufferSystem->registerBuffer(
+      BufferCreateInfo{.bufferLifetime = BufferLifetime::Persistent,
+                       .initialSize = 40960,
+                       .debugName = "Buffer-ObjectVisibility",
+                       .concurrent = true});
+  aliasRegistry->setHandle(GlobalBufferAlias::ObjectVisibility, globalBuffers.objectVisibility);
 }
 
 auto R3Renderer::createGlobalImages() -> void {
@@ -257,7 +378,8 @@ auto R3Renderer::createGlobalImages() -> void {
                    .format = vk::Format::eD32Sfloat,
                    .extent = vk::Extent2D{.width = rendererConfig.initialWidth,
                                           .height = rendererConfig.initialHeight},
-                   .usageFlags = vk::ImageUsageFlagBits::eDepthStencilAttachment,
+                   .usageFlags = vk::ImageUsageFlagBits::eDepthStencilAttachment |
+                                 vk::ImageUsageFlagBits::eTransferSrc,
                    .aspectFlags = vk::ImageAspectFlagBits::eDepth,
                    .debugName = "depth"});
 
@@ -270,6 +392,10 @@ auto R3Renderer::createGlobalImages() -> void {
 
 void R3Renderer::renderNextFrame() {
   ZoneScopedN("renderNextFrame");
+  if (const auto visible = guiCallbackRegistrar->isVisible(); visible != overlayVisible) {
+    setOverlayVisible(visible);
+  }
+
   const auto result = frameManager->acquireFrame();
 
   if (std::holds_alternative<ImageAcquireResult>(result)) {
@@ -284,140 +410,84 @@ void R3Renderer::renderNextFrame() {
 
   auto* frame = std::get<Frame*>(result);
 
-  std::optional<std::pair<SimState, SimState>> states = std::nullopt;
-  std::optional<EditorState> editorState = std::nullopt;
-  {
-    ZoneScopedN("getStates");
-    Timestamp currentTime = Clock::now();
-    int retries = 100; // e.g. timeout after ~100 * 10ms = 1s
-    while (retries-- > 0 && states == std::nullopt) {
-      ZoneScopedN("getStates try");
-      states = stateBuffer->getStates(currentTime);
-      if (states == std::nullopt) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-      }
-      editorState = editorStateBuffer->getStates(currentTime);
-      if (editorState == std::nullopt) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-      }
-    }
-  }
+  auto paced = framePacer.acquire();
 
-  if (editorState) {
-    frame->setEditorState(editorState);
-  }
+  // Set every frame, even one without states. A frame keeping the last batch it was given would
+  // acquire those textures from the transfer queue a second time.
+  frame->setImageTransitionInfo(imageQueue->dequeue());
+
+  if (paced) {
+    if (auto editorState = editorStateBuffer->getStates(paced->target)) {
+      frame->setEditorState(editorState);
+    }
 
-  if (states != std::nullopt) {
-    auto& current = (*states).first;
+    stateInterpolator.interpolate(paced->states.previous(),
+                                  paced->states.next(),
+                                  paced->target,
+                                  interpolatedState);
+    const auto& current = interpolatedState;
 
     textureArena->updateShaderBindings(frame);
-    buildFrameState(current.objectMetadata, current.stateHandles, geometryRegionContents);
+    frameTables.update(current);
+    const auto drawCount = static_cast<uint32_t>(frameTables.getDrawBatches().size());
 
     {
       ZoneScopedN("Per Frame buffers");
       // FrameData
-      auto frameData = GpuFrameData{.view = current.view,
-                                    .projection = current.projection,
-                                    .cameraPosition = glm::vec4(0.f, 0.f, 5.f, 1.f),
-                                    .time = 0.f,
-                                    .maxObjects = frame->getObjectCount()};
+      const auto frameData = frameTables.getFrameData(
+          current, glm::uvec2{rendererConfig.initialWidth, rendererConfig.initialHeight});
 
       bufferSystem->insert(frame->getLogicalBuffer(globalBuffers.frameData),
                            &frameData,
                            BufferRegion{.size = sizeof(GpuFrameData)});
 
-      // ResourceTable
-      auto resourceTableData = GpuResourceTable{
-          .objectDataBufferAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.objectData))
-                  .or_else([] {
-                    Log.warn("getBufferAddress could not find an address for objectData buffer");
-                    return std::optional<uint64_t>{0};
-                  })
-                  .value(),
-          .objectPositionsAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.objectPositions))
-                  .value_or(0L),
-          .objectRotationsAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.objectRotations))
-                  .value_or(0L),
-          .objectScalesAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.objectScales))
-                  .value_or(0L),
-          .regionBufferAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.geometryRegion))
-                  .value_or(0L),
-          .indexBufferAddress =
-              bufferSystem->getBufferAddress(geometryBufferPack->getIndexBuffer()).value_or(0L),
-          .positionBufferAddress =
-              bufferSystem->getBufferAddress(geometryBufferPack->getPositionBuffer()).value_or(0L),
-          .colorBufferAddress =
-              bufferSystem->getBufferAddress(geometryBufferPack->getColorBuffer()).value_or(0L),
-          .texCoordBufferAddress =
-              bufferSystem->getBufferAddress(geometryBufferPack->getTexCoordBuffer()).value_or(0L),
-          .normalBufferAddress =
-              bufferSystem->getBufferAddress(geometryBufferPack->getNormalBuffer()).value_or(0L),
-          .materialBufferAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.materials))
-                  .value_or(0L),
-          .indirectCommandAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.drawCommands))
-                  .value_or(0L),
-          .indirectCountAddress =
-              bufferSystem->getBufferAddress(frame->getLogicalBuffer(globalBuffers.drawCounts))
-                  .value_or(0L),
-      };
-      bufferSystem->insert(frame->getLogicalBuffer(globalBuffers.resourceTable),
-                           &resourceTableData,
-                           BufferRegion{.size = sizeof(GpuResourceTable)});
-
-      // GeometryRegionBuffer
-      if (!geometryRegionContents.empty()) {
-        bufferSystem->insert(
-            frame->getLogicalBuffer(globalBuffers.geometryRegion),
-            geometryRegionContents.data(),
-            BufferRegion{.size = sizeof(GpuGeometryRegionData) * geometryRegionContents.size()});
+      // ResourceTable, only rebuilt when a resize has moved one of the buffers it points at
+      auto uploadedBytes = sizeof(GpuFrameData);
+      const auto addressGeneration = bufferSystem->getAddressGeneration();
+      if (resourceTables.isStale(frame->getIndex(), addressGeneration)) {
+        const auto resourceTableData = resourceTables.rebuild(
+            frame->getIndex(),
+            addressGeneration,
+            ResourceTableBuffers{
+                .objectData = frame->getLogicalBuffer(globalBuffers.objectData),
+                .objectPositions = frame->getLogicalBuffer(globalBuffers.objectPositions),
+                .objectRotations = frame->getLogicalBuffer(globalBuffers.objectRotations),
+                .objectScales = frame->getLogicalBuffer(globalBuffers.objectScales),
+                .geometryRegion = frame->getLogicalBuffer(globalBuffers.geometryRegion),
+                .index = geometryBufferPack->getIndexBuffer(),
+                .position = geometryBufferPack->getPositionBuffer(),
+                .color = geometryBufferPack->getColorBuffer(),
+                .texCoord = geometryBufferPack->getTexCoordBuffer(),
+                .normal = geometryBufferPack->getNormalBuffer(),
+                .animation = geometryBufferPack->getAnimationBuffer(),
+                .materials = frame->getLogicalBuffer(globalBuffers.materials),
+                .indirectCommand = frame->getLogicalBuffer(globalBuffers.drawCommands),
+                .indirectCount = frame->getLogicalBuffer(globalBuffers.drawCounts),
+                .drawBatches = frame->getLogicalBuffer(globalBuffers.drawBatches),
+                .drawInstances = frame->getLogicalBuffer(globalBuffers.drawInstances),
+                .visibleObjects = frame->getLogicalBuffer(globalBuffers.visibleObjects),
+                .depthPyramid = globalBuffers.depthPyramid,
+                .lateIndirectCommand = frame->getLogicalBuffer(globalBuffers.lateDrawCommands),
+                .lateIndirectCount = frame->getLogicalBuffer(globalBuffers.lateDrawCounts),
+                .objectVisibility = globalBuffers.objectVisibility,
+            });
+        bufferSystem->insert(frame->getLogicalBuffer(globalBuffers.resourceTable),
+                             &resourceTableData,
+                             BufferRegion{.size = sizeof(GpuResourceTable)});
+        uploadedBytes += sizeof(GpuResourceTable);
       }
 
-      // MaterialDataBuffer
-      if (!materialDataContents.empty()) {
-        bufferSystem->insert(
-            frame->getLogicalBuffer(globalBuffers.materials),
-            materialDataContents.data(),
-            BufferRegion{.size = sizeof(GpuMaterialData) * materialDataContents.size()});
-      }
-      // TODO: might need to allow resizing transient buffers, or at least track their size/usage as
-      // metrics and get a better sense of how large they need to be. Right now the materialData
-      // buffer is not large enough to hold 60 materials
-      //  Object Data Buffers
-      if (!current.objectMetadata.empty()) {
-        bufferSystem->insert(
-            frame->getLogicalBuffer(globalBuffers.objectData),
-            current.objectMetadata.data(),
-            BufferRegion{.size = sizeof(GpuObjectData) * current.objectMetadata.size()});
-      }
-      if (!current.positions.empty()) {
-        bufferSystem->insert(
-            frame->getLogicalBuffer(globalBuffers.objectPositions),
-            current.positions.data(),
-            BufferRegion{.size = sizeof(GpuTransformData) * current.positions.size()});
-      }
-      if (!current.rotations.empty()) {
-        bufferSystem->insert(
-            frame->getLogicalBuffer(globalBuffers.objectRotations),
-            current.rotations.data(),
-            BufferRegion{.size = sizeof(GpuRotationData) * current.rotations.size()});
-      }
-      // For some reason the last object's scales are getting set to 0s
-      static_assert(sizeof(GpuScaleData) == 12);
-      if (!current.scales.empty()) {
-        bufferSystem->insert(frame->getLogicalBuffer(globalBuffers.objectScales),
-                             current.scales.data(),
-                             BufferRegion{.size = sizeof(GpuScaleData) * current.scales.size()});
+      for (const auto& write :
+           frameTables.collectWrites(frame->getIndex(), current, paced->states.previous().tick)) {
+        bufferSystem->insert(frame->getLogicalBuffer(getTableBuffer(write.table)),
+                             write.data,
+                             BufferRegion{.offset = write.offset, .size = write.size});
+        uploadedBytes += write.size;
       }
+      TracyPlot("Frame bytes uploaded", static_cast<int64_t>(uploadedBytes));
       // Set host values in frame
-      frame->setImageTransitionInfo(imageQueue->dequeue());
       frame->setObjectCount(current.objectMetadata.size());
+      frame->setDrawCount(drawCount);
     }
   } else {
     Log.warn(
@@ -428,53 +498,76 @@ void R3Renderer::renderNextFrame() {
   endFrame(frame, results);
 }
 
-auto R3Renderer::buildFrameState(std::vector<GpuObjectData>& objectData,
-                                 std::vector<StateHandles>& stateHandles,
-                                 std::vector<GpuGeometryRegionData>& regionBuffer) -> void {
-  ZoneScopedN("R3Renderer::buildFrameState");
-  regionBuffer.clear();
-  regionBuffer.reserve(objectData.size());
-
-  materialDataContents.clear();
-
-  for (size_t i = 0; i < objectData.size(); ++i) {
-    auto regionHandle = geometryHandleMapper->toInternal(stateHandles[i].geometryHandle);
-    auto regionData = geometryAllocator->getRegionData(*regionHandle);
-    objectData[i].geometryRegionId = regionBuffer.size();
-    if (stateHandles[i].textureHandle) {
-      auto textureHandle = textureHandleMapper->toInternal(*stateHandles[i].textureHandle);
-      auto textureId = textureArena->getTextureIndex(*textureHandle);
-      materialDataContents.push_back(
-          GpuMaterialData{.baseColor = {1.f, 0.f, 0.f, 1.f}, .albedoTextureId = textureId});
-    }
-    regionBuffer.push_back(regionData);
-  }
-}
-
 auto R3Renderer::endFrame(const Frame* frame, const FrameGraphResult& results) -> void {
   ZoneScopedN("R3Renderer::endFrame");
   buffers.clear();
 
-  constexpr auto waitStages =
-      std::array<vk::PipelineStageFlags, 1>{vk::PipelineStageFlagBits::eColorAttachmentOutput};
-
   const auto swapchainImageIndex = frame->getSwapchainImageIndex();
   const auto& swapchainImageSemaphore = swapchain->getImageSemaphore(swapchainImageIndex);
 
-  const auto submitInfo = vk::SubmitInfo{
-      .waitSemaphoreCount = 1,
-      .pWaitSemaphores = &*frame->getImageAvailableSemaphore(),
-      .pWaitDstStageMask = waitStages.data(),
-      .commandBufferCount = static_cast<uint32_t>(results.commandBuffers.size()),
-      .pCommandBuffers = results.commandBuffers.data(),
-      .signalSemaphoreCount = 1,
-      .pSignalSemaphores = &swapchainImageSemaphore,
-  };
+  // Each submission signals its queue's timeline, and waits on the values the submissions it
+  // depends on signal, from this frame or the last
+  auto signals = std::vector<uint64_t>(results.submissions.size());
+  auto waitedForImage = false;
 
   try {
     ZoneScopedN("queue submit");
-    const auto fence = *frame->getInFlightFence();
-    graphicsQueue->getQueue().submit(submitInfo, fence);
+    for (size_t index = 0; index < results.submissions.size(); ++index) {
+      const auto& submission = results.submissions[index];
+      auto& timeline = timelines.at(submission.queueType);
+
+      auto waitInfos = std::vector<vk::SemaphoreSubmitInfo>{};
+      for (const auto& wait : submission.waits) {
+        const auto& waitedOn = results.submissions[wait.submission];
+        if (wait.previousRun && wait.submission >= previousSignals.size()) {
+          continue;
+        }
+        waitInfos.push_back(vk::SemaphoreSubmitInfo{
+            .semaphore = *timelines.at(waitedOn.queueType).semaphore,
+            .value = wait.previousRun ? previousSignals[wait.submission] : signals[wait.submission],
+            .stageMask = wait.stages});
+      }
+      // Only graphics passes touch the swapchain image
+      if (!waitedForImage && submission.queueType == QueueType::Graphics) {
+        waitInfos.push_back(vk::SemaphoreSubmitInfo{
+            .semaphore = *frame->getImageAvailableSemaphore(),
+            .stageMask = vk::PipelineStageFlagBits2::eColorAttachmentOutput});
+        waitedForImage = true;
+      }
+
+      signals[index] = ++timeline.value;
+      auto signalInfos = std::vector<vk::SemaphoreSubmitInfo>{
+          vk::SemaphoreSubmitInfo{.semaphore = *timeline.semaphore,
+                                  .value = signals[index],
+                                  .stageMask = vk::PipelineStageFlagBits2::eAllCommands}};
+      // The last submission finishing means the whole frame has
+      const auto isLast = index + 1 == results.submissions.size();
+      if (isLast) {
+        signalInfos.push_back(
+            vk::SemaphoreSubmitInfo{.semaphore = swapchainImageSemaphore,
+                                    .stageMask = vk::PipelineStageFlagBits2::eAllCommands});
+      }
+
+      auto commandBufferInfos = std::vector<vk::CommandBufferSubmitInfo>{};
+      commandBufferInfos.reserve(submission.commandBuffers.size());
+      for (const auto& commandBuffer : submission.commandBuffers) {
+        commandBufferInfos.push_back(vk::CommandBufferSubmitInfo{.commandBuffer = commandBuffer});
+      }
+
+      const auto submitInfo = vk::SubmitInfo2{
+          .waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos.size()),
+          .pWaitSemaphoreInfos = waitInfos.data(),
+          .commandBufferInfoCount = static_cast<uint32_t>(commandBufferInfos.size()),
+          .pCommandBufferInfos = commandBufferInfos.data(),
+          .signalSemaphoreInfoCount = static_cast<uint32_t>(signalInfos.size()),
+          .pSignalSemaphoreInfos = signalInfos.data(),
+      };
+      const auto fence = isLast ? *frame->getInFlightFence() : vk::Fence{};
+      auto& queue = submission.queueType == QueueType::Compute ? computeQueue->getQueue()
+                                                                : graphicsQueue->getQueue();
+      queue.submit2(submitInfo, fence);
+    }
+    previousSignals = std::move(signals);
     frameState->advanceFrame();
   } catch (const std::exception& ex) {
     Log.error("Failed to submit command buffer submission {}", ex.what());
@@ -501,49 +594,72 @@ auto R3Renderer::endFrame(const Frame* frame, const FrameGraphResult& results) -
 void R3Renderer::waitIdle() {
 }
 
-auto R3Renderer::createComputeCullingPass() -> std::unique_ptr<IRenderPass> {
+auto R3Renderer::getTableBuffer(FrameTable table) const -> LogicalHandle<ManagedBuffer> {
+  switch (table) {
+    case FrameTable::ObjectData:
+      return globalBuffers.objectData;
+    case FrameTable::Materials:
+      return globalBuffers.materials;
+    case FrameTable::Positions:
+      return globalBuffers.objectPositions;
+    case FrameTable::Rotations:
+      return globalBuffers.objectRotations;
+    case FrameTable::Scales:
+      return globalBuffers.objectScales;
+    case FrameTable::GeometryRegions:
+      return globalBuffers.geometryRegion;
+    case FrameTable::DrawBatches:
+      return globalBuffers.drawBatches;
+    case FrameTable::DrawInstances:
+      return globalBuffers.drawInstances;
+    case FrameTable::DrawCommands:
+      return globalBuffers.drawCommands;
+    case FrameTable::DrawCount:
+      return globalBuffers.drawCounts;
+    case FrameTable::LateDrawCommands:
+      return globalBuffers.lateDrawCommands;
+    case FrameTable::LateDrawCount:
+      return globalBuffers.lateDrawCounts;
+  }
+  throw std::runtime_error("No buffer for that frame table");
+}
+
+auto R3Renderer::createComputeCullingPass(PassId passId, CullPhase phase)
+    -> std::unique_ptr<IRenderPass> {
 
   auto cullingPass = renderPassFactory->createRenderPass(RenderPassCreateInfo{
-      .passId = PassId::Culling,
-      .passInfo = CullingPassCreateInfo{},
+      .passId = passId,
+      .passInfo = CullingPassCreateInfo{.phase = phase},
   });
 
-  auto cmdBufferUses = std::vector<CommandBufferUse>{};
-
-  for (const auto& frame : frameManager->getFrames()) {
-    cmdBufferUses.emplace_back(CommandBufferUse{.threadId = std::this_thread::get_id(),
-                                                .frameId = frame->getIndex(),
-                                                .passId = cullingPass->getId()});
-  }
-
-  const auto commandBufferInfo = CommandBufferInfo{
-      .queueConfigs = {QueueConfig{.queueType = QueueType::Graphics, .uses = cmdBufferUses}}};
-  commandBufferManager->allocateCommandBuffers(commandBufferInfo);
+  allocatePassCommandBuffers(*cullingPass);
 
   return cullingPass;
 }
 
-auto R3Renderer::createForwardRenderPass() -> std::unique_ptr<IRenderPass> {
+auto R3Renderer::createForwardRenderPass(PassId passId, vk::AttachmentLoadOp loadOp)
+    -> std::unique_ptr<IRenderPass> {
   auto forwardPass = renderPassFactory->createRenderPass(RenderPassCreateInfo{
-      .passId = PassId::Forward,
+      .passId = passId,
       .passInfo = ForwardPassCreateInfo{.colorImage = ImageAlias::GeometryColorImage,
                                         .depthImage = ImageAlias::DepthImage,
-                                        .dsLayoutHandles = {textureArena->getDSLayoutHandle()}}});
+                                        .dsLayoutHandles = {textureArena->getDSLayoutHandle()},
+                                        .loadOp = loadOp}});
 
-  std::vector<CommandBufferUse> cmdBufferUses{};
+  allocatePassCommandBuffers(*forwardPass);
 
-  for (const auto& frame : frameManager->getFrames()) {
-    cmdBufferUses.emplace_back(CommandBufferUse{.threadId = std::this_thread::get_id(),
-                                                .frameId = frame->getIndex(),
-                                                .passId = forwardPass->getId()});
-  }
+  return forwardPass;
+}
 
-  const auto commandBufferInfo = CommandBufferInfo{
-      .queueConfigs = {QueueConfig{.queueType = QueueType::Graphics, .uses = cmdBufferUses}}};
+auto R3Renderer::createDepthPyramidPass() -> std::unique_ptr<IRenderPass> {
+  auto depthPyramidPass = renderPassFactory->createRenderPass(RenderPassCreateInfo{
+      .passId = PassId::DepthPyramid,
+      .passInfo = DepthPyramidPassCreateInfo{.depthImage = ImageAlias::DepthImage,
+                                             .depthPyramid = GlobalBufferAlias::DepthPyramid}});
 
-  commandBufferManager->allocateCommandBuffers(commandBufferInfo);
+  allocatePassCommandBuffers(*depthPyramidPass);
 
-  return forwardPass;
+  return depthPyramidPass;
 }
 
 auto R3Renderer::createCompositionRenderPass() -> std::unique_ptr<IRenderPass> {
@@ -556,18 +672,7 @@ auto R3Renderer::createCompositionRenderPass() -> std::unique_ptr<IRenderPass> {
                                     .defaultDSLayout = globalShaderBindings.defaultBindingLayout},
   });
 
-  std::vector<CommandBufferUse> cmdBufferUses{};
-
-  for (const auto& frame : frameManager->getFrames()) {
-    cmdBufferUses.emplace_back(CommandBufferUse{.threadId = std::this_thread::get_id(),
-                                                .frameId = frame->getIndex(),
-                                                .passId = compositionPass->getId()});
-  }
-
-  const auto commandBufferInfo = CommandBufferInfo{
-      .queueConfigs = {QueueConfig{.queueType = QueueType::Graphics, .uses = cmdBufferUses}}};
-
-  commandBufferManager->allocateCommandBuffers(commandBufferInfo);
+  allocatePassCommandBuffers(*compositionPass);
 
   return compositionPass;
 }
@@ -577,37 +682,31 @@ auto R3Renderer::createImGuiPass() -> std::unique_ptr<IRenderPass> {
       .passId = PassId::ImGui,
       .passInfo = ImGuiPassCreateInfo{.colorImage = ImageAlias::GuiColorImage}});
 
-  std::vector<CommandBufferUse> cmdBufferUses{};
-
-  for (const auto& frame : frameManager->getFrames()) {
-    cmdBufferUses.emplace_back(CommandBufferUse{.threadId = std::this_thread::get_id(),
-                                                .frameId = frame->getIndex(),
-                                                .passId = imGuiPass->getId()});
-  }
-
-  const auto commandBufferInfo = CommandBufferInfo{
-      .queueConfigs = {QueueConfig{.queueType = QueueType::Graphics, .uses = cmdBufferUses}}};
-
-  commandBufferManager->allocateCommandBuffers(commandBufferInfo);
+  allocatePassCommandBuffers(*imGuiPass);
 
   return imGuiPass;
 }
 
 auto R3Renderer::createPresentPass() -> std::unique_ptr<IRenderPass> {
   auto pass = std::make_unique<PresentPass>(PassId::Present);
-  std::vector<CommandBufferUse> cmdBufferUses{};
+  allocatePassCommandBuffers(*pass);
+  return pass;
+}
+
+auto R3Renderer::allocatePassCommandBuffers(const IRenderPass& pass) -> void {
+  auto cmdBufferUses = std::vector<CommandBufferUse>{};
 
   for (const auto& frame : frameManager->getFrames()) {
-    cmdBufferUses.emplace_back(CommandBufferUse{.threadId = std::this_thread::get_id(),
-                                                .frameId = frame->getIndex(),
-                                                .passId = pass->getId()});
+    for (const auto threadId : passRecorder->getThreadIds()) {
+      cmdBufferUses.emplace_back(CommandBufferUse{.threadId = threadId,
+                                                  .frameId = frame->getIndex(),
+                                                  .passId = pass.getId()});
+    }
   }
 
-  const auto commandBufferInfo = CommandBufferInfo{
-      .queueConfigs = {QueueConfig{.queueType = QueueType::Graphics, .uses = cmdBufferUses}}};
-
+  const auto commandBufferInfo = CommandBufferInfo{.queueConfigs = {
+      QueueConfig{.queueType = frameGraph->getQueueType(pass), .uses = cmdBufferUses}}};
   commandBufferManager->allocateCommandBuffers(commandBufferInfo);
-  return pass;
 }
 
 auto R3Renderer::createGlobalShaderBindings() -> void {
@@ -627,7 +726,9 @@ auto R3Renderer::createGlobalShaderBindings() -> void {
                                                 globalShaderBindings.defaultBindingLayout);
 
   globalShaderBindings.defaultSampler = imageManager->registerDefaultSampler();
+}
 
+auto R3Renderer::bindCompositionImages() -> void {
   const auto defaultSampler = imageManager->getSampler(globalShaderBindings.defaultSampler);
 
   for (const auto& frame : frameManager->getFrames()) {
@@ -638,7 +739,10 @@ auto R3Renderer::createGlobalShaderBindings() -> void {
     const auto imageHandle = frame->getLogicalImage(globalImages.forwardColorImage);
     const auto& colorImage = imageManager->getImage(imageHandle);
 
-    const auto imguiImageHandle = frame->getLogicalImage(globalImages.imguiColorImage);
+    // With the overlay hidden the ImGui pass is culled and its image never written, so the scene
+    // goes in both slots and composition blends it with itself
+    const auto imguiImageHandle = frame->getLogicalImage(
+        overlayVisible ? globalImages.imguiColorImage : globalImages.forwardColorImage);
     const auto& imguiImage = imageManager->getImage(imguiImageHandle);
 
     std::vector<vk::DescriptorImageInfo> imageInfos = {
@@ -657,4 +761,17 @@ auto R3Renderer::createGlobalShaderBindings() -> void {
   }
 }
 
+/// Hiding the overlay disables the GUI image in the graph, which culls the ImGui pass that
+/// only existed to write it. Rebaking can move images around, so nothing can be in flight.
+auto R3Renderer::setOverlayVisible(bool visible) -> void {
+  ZoneScopedN("R3Renderer::setOverlayVisible");
+  device->waitIdle();
+  overlayVisible = visible;
+  frameGraph->setImageEnabled(ImageAlias::GuiColorImage, visible);
+  frameGraph->bake();
+  bindCompositionImages();
+  // The new graph may split into different submissions, and the old ones have all finished
+  previousSignals.clear();
+}
+
 }
@@ -6,6 +6,13 @@
 #include "gfx/RenderContextConfig.hpp"
 #include "gfx/HandleMapperTypes.hpp"
 #include "img/ManagedImage.hpp"
+#include "r3/ComponentIds.hpp"
+#include "r3/CullCompaction.hpp"
+#include "r3/FramePacer.hpp"
+#include "r3/FrameTables.hpp"
+#include "r3/ResourceTableCache.hpp"
+#include "r3/StateInterpolator.hpp"
+#include "vk/command-buffer/QueueType.hpp"
 
 namespace tr {
 
@@ -31,9 +38,13 @@ class DSLayout;
 class EditorStateBuffer;
 class ImageTransitionQueue;
 class TextureArena;
+class PassRecorder;
+class Device;
+class IGuiCallbackRegistrar;
 
 namespace queue {
 class Graphics;
+class Compute;
 }
 
 const std::filesystem::path SHADER_ROOT = std::filesystem::current_path() / "assets" / "shaders";
@@ -41,6 +52,9 @@ const std::filesystem::path SHADER_ROOT = std::filesystem::current_path() / "ass
 struct GlobalBuffers {
   LogicalHandle<ManagedBuffer> drawCommands;
   LogicalHandle<ManagedBuffer> drawCounts;
+  /// The late culling phase's own commands, the visible object buffer is shared between phases
+  LogicalHandle<ManagedBuffer> lateDrawCommands;
+  LogicalHandle<ManagedBuffer> lateDrawCounts;
   LogicalHandle<ManagedBuffer> drawMetadata;
   LogicalHandle<ManagedBuffer> objectData;
   LogicalHandle<ManagedBuffer> objectPositions;
@@ -48,8 +62,16 @@ struct GlobalBuffers {
   LogicalHandle<ManagedBuffer> objectScales;
   LogicalHandle<ManagedBuffer> geometryRegion;
   LogicalHandle<ManagedBuffer> materials;
+  LogicalHandle<ManagedBuffer> drawBatches;
+  LogicalHandle<ManagedBuffer> drawInstances;
+  LogicalHandle<ManagedBuffer> visibleObjects;
   LogicalHandle<ManagedBuffer> frameData;
   LogicalHandle<ManagedBuffer> resourceTable;
+  /// Built from each frame's early draws for its late culling phase to test against
+  Handle<ManagedBuffer> depthPyramid;
+  /// Shared by every frame, so each frame's early culling phase draws what the frame before found
+  /// visible
+  Handle<ManagedBuffer> objectVisibility;
 };
 
 struct GlobalImages {
@@ -58,6 +80,12 @@ struct GlobalImages {
   LogicalHandle<ManagedImage> imguiColorImage;
 };
 
+/// A timeline semaphore for one queue, counting up by one with each submission to it
+struct QueueTimeline {
+  vk::raii::Semaphore semaphore;
+  uint64_t value{};
+};
+
 struct GlobalShaderBindings {
   Handle<DSLayout> defaultBindingLayout;
   LogicalHandle<IShaderBinding> defaultBinding;
@@ -69,6 +97,7 @@ public:
   R3Renderer(RenderContextConfig newRenderConfig,
              std::shared_ptr<IFrameManager> newFrameManager,
              std::shared_ptr<queue::Graphics> newGraphicsQueue,
+             std::shared_ptr<queue::Compute> newComputeQueue,
              std::shared_ptr<Swapchain> newSwapchain,
              std::shared_ptr<IFrameGraph> newFrameGraph,
              std::shared_ptr<RenderPassFactory> newRenderPassFactory,
@@ -87,7 +116,10 @@ public:
              std::shared_ptr<EditorStateBuffer> newEditorStateBuffer,
              std::shared_ptr<ImageTransitionQueue> newImageQueue,
              std::shared_ptr<TextureHandleMapper> newTextureHandleMapper,
-             std::shared_ptr<TextureArena> newTextureArena);
+             std::shared_ptr<TextureArena> newTextureArena,
+             std::shared_ptr<PassRecorder> newPassRecorder,
+             std::shared_ptr<IGuiCallbackRegistrar> newGuiCallbackRegistrar,
+             std::shared_ptr<Device> newDevice);
   ~R3Renderer() override = default;
 
   R3Renderer(const R3Renderer&) = delete;
@@ -102,6 +134,7 @@ private:
   RenderContextConfig rendererConfig;
   std::shared_ptr<IFrameManager> frameManager;
   std::shared_ptr<queue::Graphics> graphicsQueue;
+  std::shared_ptr<queue::Compute> computeQueue;
   std::shared_ptr<Swapchain> swapchain;
   std::shared_ptr<IFrameGraph> frameGraph;
   std::shared_ptr<RenderPassFactory> renderPassFactory;
@@ -121,28 +154,49 @@ private:
   std::shared_ptr<ImageTransitionQueue> imageQueue;
   std::shared_ptr<TextureHandleMapper> textureHandleMapper;
   std::shared_ptr<TextureArena> textureArena;
+  std::shared_ptr<PassRecorder> passRecorder;
+  std::shared_ptr<IGuiCallbackRegistrar> guiCallbackRegistrar;
+  std::shared_ptr<Device> device;
 
   std::vector<vk::CommandBuffer> buffers;
 
+  std::unordered_map<QueueType, QueueTimeline> timelines;
+  /// What each of the last frame's submissions signalled, for the next frame's submissions that
+  /// wait on it
+  std::vector<uint64_t> previousSignals;
+
   GlobalBuffers globalBuffers{};
   GlobalImages globalImages{};
   GlobalShaderBindings globalShaderBindings{};
 
-  std::vector<GpuGeometryRegionData> geometryRegionContents;
-  std::vector<GpuMaterialData> materialDataContents;
+  FramePacer framePacer;
+  StateInterpolator stateInterpolator;
+  SimState interpolatedState;
+
+  FrameTables frameTables;
+  /// Each frame's resource table only changes when a buffer it points at is resized
+  ResourceTableCache resourceTables;
+  /// Whether the graph is currently baked with the ImGui pass in it
+  bool overlayVisible{true};
+
+  /// The buffer each frame in flight keeps its copy of `table` in
+  [[nodiscard]] auto getTableBuffer(FrameTable table) const -> LogicalHandle<ManagedBuffer>;
 
   auto createGlobalBuffers() -> void;
   auto createGlobalImages() -> void;
   auto createGlobalShaderBindings() -> void;
-  auto createComputeCullingPass() -> std::unique_ptr<IRenderPass>;
-  auto createForwardRenderPass() -> std::unique_ptr<IRenderPass>;
+  auto bindCompositionImages() -> void;
+  auto setOverlayVisible(bool visible) -> void;
+  auto createComputeCullingPass(PassId passId, CullPhase phase) -> std::unique_ptr<IRenderPass>;
+  auto createForwardRenderPass(PassId passId, vk::AttachmentLoadOp loadOp)
+      -> std::unique_ptr<IRenderPass>;
+  auto createDepthPyramidPass() -> std::unique_ptr<IRenderPass>;
   auto createCompositionRenderPass() -> std::unique_ptr<IRenderPass>;
   auto createImGuiPass() -> std::unique_ptr<IRenderPass>;
   auto createPresentPass() -> std::unique_ptr<IRenderPass>;
+  /// Gives the pass a command buffer for each frame on every thread it may be recorded on, from
+  /// the queue the frame graph submits it to
+  auto allocatePassCommandBuffers(const IRenderPass& pass) -> void;
   auto endFrame(const Frame* frame, const FrameGraphResult& result) -> void;
-
-  auto buildFrameState(std::vector<GpuObjectData>& objectData,
-                       std::vector<StateHandles>& stateHandles,
-                       std::vector<GpuGeometryRegionData>& regionBuffer) -> void;
 };
 }
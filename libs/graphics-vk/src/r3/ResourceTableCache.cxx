@@ -0,0 +1,52 @@
+#include "r3/ResourceTableCache.hpp"
+
+namespace tr {
+
+ResourceTableCache::ResourceTableCache(AddressProvider newAddressProvider)
+    : addressProvider{std::move(newAddressProvider)} {
+}
+
+auto ResourceTableCache::isStale(uint8_t frameIndex, uint64_t addressGeneration) const -> bool {
+  return frameIndex >= builtGenerations.size() || !builtGenerations[frameIndex] ||
+         *builtGenerations[frameIndex] < addressGeneration;
+}
+
+auto ResourceTableCache::rebuild(uint8_t frameIndex,
+                                 uint64_t addressGeneration,
+                                 const ResourceTableBuffers& buffers) -> GpuResourceTable {
+  const auto addressOf = [this](Handle<ManagedBuffer> handle) {
+    return addressProvider(handle).value_or(0L);
+  };
+
+  const auto table = GpuResourceTable{
+      .objectDataBufferAddress = addressOf(buffers.objectData),
+      .objectPositionsAddress = addressOf(buffers.objectPositions),
+      .objectRotationsAddress = addressOf(buffers.objectRotations),
+      .objectScalesAddress = addressOf(buffers.objectScales),
+      .regionBufferAddress = addressOf(buffers.geometryRegion),
+      .indexBufferAddress = addressOf(buffers.index),
+      .positionBufferAddress = addressOf(buffers.position),
+      .colorBufferAddress = addressOf(buffers.color),
+      .texCoordBufferAddress = addressOf(buffers.texCoord),
+      .normalBufferAddress = addressOf(buffers.normal),
+      .animationBufferAddress = addressOf(buffers.animation),
+      .materialBufferAddress = addressOf(buffers.materials),
+      .indirectCommandAddress = addressOf(buffers.indirectCommand),
+      .indirectCountAddress = addressOf(buffers.indirectCount),
+      .drawBatchAddress = addressOf(buffers.drawBatches),
+      .drawInstanceAddress = addressOf(buffers.drawInstances),
+      .visibleObjectAddress = addressOf(buffers.visibleObjects),
+      .depthPyramidAddress = addressOf(buffers.depthPyramid),
+      .lateIndirectCommandAddress = addressOf(buffers.lateIndirectCommand),
+      .lateIndirectCountAddress = addressOf(buffers.lateIndirectCount),
+      .objectVisibilityAddress = addressOf(buffers.objectVisibility),
+  };
+
+  if (frameIndex >= builtGenerations.size()) {
+    builtGenerations.resize(frameIndex + 1);
+  }
+  builtGenerations[frameIndex] = addressGeneration;
+  return table;
+}
+
+}
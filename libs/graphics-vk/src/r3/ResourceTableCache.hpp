@@ -0,0 +1,65 @@
+#pragma once
+
+#include "api/gfx/GpuMaterialData.hpp"
+#include "bk/Handle.hpp"
+
+namespace tr {
+
+class ManagedBuffer;
+
+/// The buffer behind each address in a frame's GpuResourceTable
+struct ResourceTableBuffers {
+  Handle<ManagedBuffer> objectData;
+  Handle<ManagedBuffer> objectPositions;
+  Handle<ManagedBuffer> objectRotations;
+  Handle<ManagedBuffer> objectScales;
+  Handle<ManagedBuffer> geometryRegion;
+  Handle<ManagedBuffer> index;
+  Handle<ManagedBuffer> position;
+  Handle<ManagedBuffer> color;
+  Handle<ManagedBuffer> texCoord;
+  Handle<ManagedBuffer> normal;
+  Handle<ManagedBuffer> animation;
+  Handle<ManagedBuffer> materials;
+  Handle<ManagedBuffer> indirectCommand;
+  Handle<ManagedBuffer> indirectCount;
+  Handle<ManagedBuffer> drawBatches;
+  Handle<ManagedBuffer> drawInstances;
+  Handle<ManagedBuffer> visibleObjects;
+  Handle<ManagedBuffer> depthPyramid;
+  Handle<ManagedBuffer> lateIndirectCommand;
+  Handle<ManagedBuffer> lateIndirectCount;
+  Handle<ManagedBuffer> objectVisibility;
+};
+
+/// Remembers the address generation each frame's GpuResourceTable was built at, so the table is
+/// only rebuilt and uploaded when an address in it could have changed. Each frame's resource
+/// table buffer is its own and persists between uses, so a table that's still current can be left
+/// where it is.
+class ResourceTableCache {
+public:
+  using AddressProvider = std::function<std::optional<uint64_t>(Handle<ManagedBuffer>)>;
+
+  explicit ResourceTableCache(AddressProvider newAddressProvider);
+  ~ResourceTableCache() = default;
+
+  ResourceTableCache(const ResourceTableCache&) = delete;
+  ResourceTableCache(ResourceTableCache&&) = delete;
+  auto operator=(const ResourceTableCache&) -> ResourceTableCache& = delete;
+  auto operator=(ResourceTableCache&&) -> ResourceTableCache& = delete;
+
+  /// Whether the frame has no table yet, or one built before `addressGeneration`.
+  [[nodiscard]] auto isStale(uint8_t frameIndex, uint64_t addressGeneration) const -> bool;
+
+  /// Looks up every buffer's current address and records the frame's table as current as of
+  /// `addressGeneration`. Buffers without an address are left as 0.
+  auto rebuild(uint8_t frameIndex, uint64_t addressGeneration, const ResourceTableBuffers& buffers)
+      -> GpuResourceTable;
+
+private:
+  AddressProvider addressProvider;
+  /// Indexed by frame, empty until that frame's table is first built
+  std::vector<std::optional<uint64_t>> builtGenerations;
+};
+
+}
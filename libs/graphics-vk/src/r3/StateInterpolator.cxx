@@ -0,0 +1,161 @@
+#include "StateInterpolator.hpp"
+
+namespace tr {
+
+static_assert(sizeof(GpuTransformData) == 3 * sizeof(float));
+static_assert(sizeof(GpuRotationData) == 4 * sizeof(float));
+static_assert(sizeof(GpuScaleData) == 3 * sizeof(float));
+
+namespace {
+
+/// The SoA arrays are plain floats underneath, and treating them that way gives the compiler a
+/// simple loop it can auto-vectorize.
+auto lerpKernel(const float* __restrict a,
+                const float* __restrict b,
+                float* __restrict out,
+                size_t count,
+                float alpha) -> void {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = a[i] + ((b[i] - a[i]) * alpha);
+  }
+}
+
+/// Normalized lerp along the shortest arc. Ticks are close enough together that nlerp is
+/// indistinguishable from slerp here, and it stays branch free.
+auto nlerpKernel(const float* __restrict a,
+                 const float* __restrict b,
+                 float* __restrict out,
+                 size_t quatCount,
+                 float alpha) -> void {
+  for (size_t i = 0; i < quatCount; ++i) {
+    const auto* qa = a + (i * 4);
+    const auto* qb = b + (i * 4);
+    auto* q = out + (i * 4);
+
+    const float dot = (qa[0] * qb[0]) + (qa[1] * qb[1]) + (qa[2] * qb[2]) + (qa[3] * qb[3]);
+    const float sign = dot < 0.f ? -1.f : 1.f;
+
+    float x = qa[0] + (((sign * qb[0]) - qa[0]) * alpha);
+    float y = qa[1] + (((sign * qb[1]) - qa[1]) * alpha);
+    float z = qa[2] + (((sign * qb[2]) - qa[2]) * alpha);
+    float w = qa[3] + (((sign * qb[3]) - qa[3]) * alpha);
+
+    const float lengthSq = (x * x) + (y * y) + (z * z) + (w * w);
+    const float invLength = lengthSq > 0.f ? 1.f / std::sqrt(lengthSq) : 0.f;
+    q[0] = x * invLength;
+    q[1] = y * invLength;
+    q[2] = z * invLength;
+    q[3] = w * invLength;
+  }
+}
+
+template <typename T>
+auto asFloats(const T* data) -> const float* {
+  return reinterpret_cast<const float*>(data);
+}
+
+template <typename T>
+auto asFloats(T* data) -> float* {
+  return reinterpret_cast<float*>(data);
+}
+
+}
+
+auto StateInterpolator::computeAlpha(Timestamp previous, Timestamp next, Timestamp t) -> float {
+  const auto span = std::chrono::duration<float>(next - previous).count();
+  if (span <= 0.f) {
+    return 1.f;
+  }
+  const auto elapsed = std::chrono::duration<float>(t - previous).count();
+  return std::clamp(elapsed / span, 0.f, 1.f);
+}
+
+auto StateInterpolator::interpolate(const SimState& previous,
+                                    const SimState& next,
+                                    Timestamp t,
+                                    SimState& out) -> void {
+  ZoneScopedN("StateInterpolator::interpolate");
+  const auto alpha = computeAlpha(previous.timeStamp, next.timeStamp, t);
+  const auto count = next.objectMetadata.size();
+
+  out.timeStamp = t;
+  out.tag = next.tag;
+  out.tick = next.tick;
+  out.objectMetadata.assign(next.objectMetadata.begin(), next.objectMetadata.end());
+  out.stateHandles.assign(next.stateHandles.begin(), next.stateHandles.end());
+  out.entityIds.assign(next.entityIds.begin(), next.entityIds.end());
+  out.objectVersions.assign(next.objectVersions.begin(), next.objectVersions.end());
+  out.positions.resize(count);
+  out.rotations.resize(count);
+  out.scales.resize(count);
+
+  // Element-wise blending of the view matrix is fine for the small deltas between ticks.
+  for (glm::length_t column = 0; column < 4; ++column) {
+    out.view[column] = glm::mix(previous.view[column], next.view[column], alpha);
+  }
+  out.projection = next.projection;
+
+  if (count == 0) {
+    return;
+  }
+
+  const GpuTransformData* previousPositions = previous.positions.data();
+  const GpuRotationData* previousRotations = previous.rotations.data();
+  const GpuScaleData* previousScales = previous.scales.data();
+
+  // Common case is nothing was spawned or destroyed this tick and the arrays already line up.
+  if (previous.entityIds != next.entityIds || previous.positions.size() != count) {
+    alignPrevious(previous, next);
+    previousPositions = alignedPositions.data();
+    previousRotations = alignedRotations.data();
+    previousScales = alignedScales.data();
+  }
+
+  lerpKernel(asFloats(previousPositions),
+             asFloats(next.positions.data()),
+             asFloats(out.positions.data()),
+             count * 3,
+             alpha);
+  nlerpKernel(asFloats(previousRotations),
+              asFloats(next.rotations.data()),
+              asFloats(out.rotations.data()),
+              count,
+              alpha);
+  lerpKernel(asFloats(previousScales),
+             asFloats(next.scales.data()),
+             asFloats(out.scales.data()),
+             count * 3,
+             alpha);
+}
+
+/// Gathers previous' values into next's order. Objects with no counterpart in previous get next's
+/// own values so they blend to themselves and appear without popping in from the origin.
+auto StateInterpolator::alignPrevious(const SimState& previous, const SimState& next) -> void {
+  ZoneScopedN("StateInterpolator::alignPrevious");
+  const auto count = next.objectMetadata.size();
+
+  previousIndexByEntity.clear();
+  for (size_t i = 0; i < previous.entityIds.size(); ++i) {
+    previousIndexByEntity.emplace(previous.entityIds[i], static_cast<uint32_t>(i));
+  }
+
+  alignedPositions.resize(count);
+  alignedRotations.resize(count);
+  alignedScales.resize(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    const auto it = i < next.entityIds.size() ? previousIndexByEntity.find(next.entityIds[i])
+                                              : previousIndexByEntity.end();
+    if (it == previousIndexByEntity.end()) {
+      alignedPositions[i] = next.positions[i];
+      alignedRotations[i] = next.rotations[i];
+      alignedScales[i] = next.scales[i];
+      continue;
+    }
+    alignedPositions[i] = previous.positions[it->second];
+    alignedRotations[i] = previous.rotations[it->second];
+    alignedScales[i] = previous.scales[it->second];
+  }
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "api/gfx/SimState.hpp"
+
+namespace tr {
+
+/// Blends the two SimStates bracketing a render time into a single state for upload, so the
+/// display doesn't have to run in lockstep with the game tick.
+///
+/// Objects are matched across the two states by `SimState::entityIds`. The output always has the
+/// object set of `next`: objects that only exist in `next` are drawn where `next` puts them, and
+/// objects that only exist in `previous` are dropped. The SoA arrays (positions, rotations,
+/// scales) are expected to be parallel to `objectMetadata`, which is how FinalizerSystem lays them
+/// out.
+class StateInterpolator {
+public:
+  StateInterpolator() = default;
+  ~StateInterpolator() = default;
+
+  StateInterpolator(const StateInterpolator&) = delete;
+  StateInterpolator(StateInterpolator&&) = delete;
+  auto operator=(const StateInterpolator&) -> StateInterpolator& = delete;
+  auto operator=(StateInterpolator&&) -> StateInterpolator& = delete;
+
+  auto interpolate(const SimState& previous,
+                   const SimState& next,
+                   Timestamp t,
+                   SimState& out) -> void;
+
+  /// Where `t` falls between `previous` and `next`, clamped to [0, 1].
+  static auto computeAlpha(Timestamp previous, Timestamp next, Timestamp t) -> float;
+
+private:
+  // Scratch storage reused between frames for when the two states don't line up 1:1
+  std::unordered_map<uint32_t, uint32_t> previousIndexByEntity;
+  std::vector<GpuTransformData> alignedPositions;
+  std::vector<GpuRotationData> alignedRotations;
+  std::vector<GpuScaleData> alignedScales;
+
+  auto alignPrevious(const SimState& previous, const SimState& next) -> void;
+};
+
+}
@@ -1,4 +1,5 @@
 #include "CompositionContext.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "task/Frame.hpp"
 #include "vk/sb/IShaderBinding.hpp"
 #include "vk/sb/IShaderBindingFactory.hpp"
@@ -36,31 +37,7 @@ auto CompositionContext::getPushConstantSize() -> size_t {
 }
 
 auto CompositionContext::getGraphInfo() const -> PassGraphInfo {
-  auto graphInfo = PassGraphInfo{};
-
-  graphInfo.imageReads = {ImageUsageInfo{.alias = ImageAlias::GeometryColorImage,
-                                         .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
-                                         .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
-                                         .aspectFlags = vk::ImageAspectFlagBits::eColor,
-                                         .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
-                                         .clearValue = {}},
-                          ImageUsageInfo{.alias = ImageAlias::GuiColorImage,
-                                         .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
-                                         .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
-                                         .aspectFlags = vk::ImageAspectFlagBits::eColor,
-                                         .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
-                                         .clearValue = {}}};
-
-  graphInfo.imageWrites = {ImageUsageInfo{
-      .alias = ImageAlias::SwapchainImage,
-      .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
-      .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
-      .aspectFlags = vk::ImageAspectFlagBits::eColor,
-      .layout = vk::ImageLayout::eColorAttachmentOptimal,
-      .clearValue = {vk::ClearColorValue{std::array<float, 4>{0.392f, 0.584f, 0.929f, 1.0f}}},
-  }};
-
-  return graphInfo;
+  return compositionGraphInfo();
 }
 
 }
@@ -1,5 +1,6 @@
 #include "CullingDispatchContext.hpp"
 #include "buffers/BufferSystem.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "task/Frame.hpp"
 
 namespace tr {
@@ -21,7 +22,8 @@ auto CullingDispatchContext::bind(const Frame* frame,
               .value_or(0L),
       .frameDataAddress =
           bufferSystem->getBufferAddress(frame->getLogicalBuffer(createInfo.frameData))
-              .value_or(0L)};
+              .value_or(0L),
+      .phase = createInfo.phase};
   commandBuffer.pushConstants<PushConstants>(layout,
                                              vk::ShaderStageFlagBits::eCompute,
                                              0,
@@ -30,6 +32,7 @@ auto CullingDispatchContext::bind(const Frame* frame,
 
 auto CullingDispatchContext::dispatch(const Frame* frame, vk::raii::CommandBuffer& commandBuffer)
     -> void {
+  // One invocation per instance, each culls one object into its batch
   uint32_t workgroupCount = (frame->getObjectCount() + WorkgroupSize - 1) / WorkgroupSize;
   commandBuffer.dispatch(workgroupCount, 1, 1);
 }
@@ -39,71 +42,6 @@ auto CullingDispatchContext::getPushConstantSize() -> size_t {
 }
 
 [[nodiscard]] auto CullingDispatchContext::getGraphInfo() const -> PassGraphInfo {
-  auto passGraphInfo = PassGraphInfo{
-      .bufferWrites =
-          {
-              BufferUsageInfo{
-                  .alias = BufferAlias::IndirectCommand,
-                  .accessFlags = vk::AccessFlagBits2::eShaderWrite,
-                  .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-              },
-              BufferUsageInfo{
-                  .alias = BufferAlias::IndirectCommandCount,
-                  .accessFlags = vk::AccessFlagBits2::eShaderWrite,
-                  .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-              },
-          },
-      .bufferReads = {BufferUsageInfo{
-                          .alias = BufferAlias::ObjectData,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = BufferAlias::ObjectPositions,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = BufferAlias::ObjectRotations,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = BufferAlias::ObjectScales,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = BufferAlias::GeometryRegion,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = GlobalBufferAlias::Index,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = GlobalBufferAlias::Position,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = GlobalBufferAlias::Normal,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = GlobalBufferAlias::TexCoord,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      },
-                      BufferUsageInfo{
-                          .alias = GlobalBufferAlias::Color,
-                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
-                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
-                      }},
-  };
-  return passGraphInfo;
+  return cullingGraphInfo(createInfo.phase);
 }
 }
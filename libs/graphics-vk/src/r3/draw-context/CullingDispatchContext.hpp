@@ -32,6 +32,7 @@ private:
   struct PushConstants {
     uint64_t resourceTableAddress;
     uint64_t frameDataAddress;
+    CullPhase phase;
   };
 
   CullingDispatchContextCreateInfo createInfo;
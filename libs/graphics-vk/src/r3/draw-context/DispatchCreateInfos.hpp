@@ -1,6 +1,7 @@
 #pragma once
 
 #include "buffers/ManagedBuffer.hpp"
+#include "r3/CullCompaction.hpp"
 
 namespace tr {
 
@@ -9,6 +10,7 @@ class IShaderBinding;
 struct CullingDispatchContextCreateInfo {
   LogicalHandle<ManagedBuffer> resourceTable;
   LogicalHandle<ManagedBuffer> frameData;
+  CullPhase phase{CullPhase::Early};
 };
 
 struct ForwardDrawContextCreateInfo {
@@ -18,6 +20,8 @@ struct ForwardDrawContextCreateInfo {
   LogicalHandle<ManagedBuffer> frameData;
   LogicalHandle<ManagedBuffer> indirectCommand;
   LogicalHandle<ManagedBuffer> indirectCommandCount;
+  /// Which culling phase's commands it draws
+  CullPhase phase{CullPhase::Early};
 };
 
 struct CompositionContextCreateInfo {
@@ -0,0 +1,189 @@
+#include "FrameGraphCompiler.hpp"
+
+namespace tr {
+
+namespace {
+
+using GraphResource = std::variant<ImageAlias, BufferAliasVariant>;
+
+struct PassUses {
+  std::vector<GraphResource> reads;
+  std::vector<GraphResource> writes;
+  bool usesSwapchain{};
+};
+
+auto collectUses(const IRenderPass& pass, const std::unordered_set<ImageAlias>& disabledImages)
+    -> PassUses {
+  const auto info = pass.getGraphInfo();
+  auto uses = PassUses{};
+  for (const auto& read : info.imageReads) {
+    if (disabledImages.contains(read.alias)) {
+      continue;
+    }
+    uses.reads.emplace_back(read.alias);
+    uses.usesSwapchain |= read.alias == ImageAlias::SwapchainImage;
+  }
+  for (const auto& write : info.imageWrites) {
+    uses.writes.emplace_back(write.alias);
+    uses.usesSwapchain |= write.alias == ImageAlias::SwapchainImage;
+  }
+  for (const auto& read : info.bufferReads) {
+    uses.reads.emplace_back(read.alias);
+  }
+  for (const auto& write : info.bufferWrites) {
+    uses.writes.emplace_back(write.alias);
+  }
+  return uses;
+}
+
+auto addUnique(std::vector<size_t>& list, size_t value) -> void {
+  if (std::ranges::find(list, value) == list.end()) {
+    list.push_back(value);
+  }
+}
+
+}
+
+auto FrameGraphCompiler::compile(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                                 const std::unordered_set<ImageAlias>& disabledImages)
+    -> CompiledFrameGraph {
+  const auto passCount = passes.size();
+
+  // Passes each pass has to run after
+  auto dependencies = std::vector<std::vector<size_t>>(passCount);
+  // Passes whose writes each pass reads, this frame's or the previous one's
+  auto producers = std::vector<std::vector<size_t>>(passCount);
+
+  auto passUses = std::vector<PassUses>{};
+  passUses.reserve(passCount);
+  auto lastWriter = std::unordered_map<GraphResource, size_t>{};
+  auto readersSinceWrite = std::unordered_map<GraphResource, std::vector<size_t>>{};
+  auto historyReads = std::vector<std::pair<size_t, GraphResource>>{};
+
+  for (size_t i = 0; i < passCount; ++i) {
+    const auto& uses = passUses.emplace_back(collectUses(*passes[i], disabledImages));
+
+    for (const auto& resource : uses.reads) {
+      if (const auto it = lastWriter.find(resource); it != lastWriter.end()) {
+        addUnique(dependencies[i], it->second);
+        addUnique(producers[i], it->second);
+      } else {
+        historyReads.emplace_back(i, resource);
+      }
+      readersSinceWrite[resource].push_back(i);
+    }
+
+    for (const auto& resource : uses.writes) {
+      if (const auto it = lastWriter.find(resource); it != lastWriter.end() && it->second != i) {
+        addUnique(dependencies[i], it->second);
+      }
+      for (const auto reader : readersSinceWrite[resource]) {
+        if (reader != i) {
+          addUnique(dependencies[i], reader);
+        }
+      }
+      readersSinceWrite[resource].clear();
+      lastWriter.insert_or_assign(resource, i);
+    }
+  }
+
+  for (const auto& [reader, resource] : historyReads) {
+    if (const auto it = lastWriter.find(resource); it != lastWriter.end() && it->second != reader) {
+      addUnique(producers[reader], it->second);
+    }
+  }
+
+  // Walk back from the outputs to find every pass that contributes to them
+  const auto hasOutput =
+      std::ranges::any_of(passUses, [](const PassUses& uses) { return uses.usesSwapchain; });
+  auto live = std::vector<bool>(passCount, !hasOutput);
+  auto pending = std::vector<size_t>{};
+  for (size_t i = 0; i < passCount; ++i) {
+    if (hasOutput && passUses[i].usesSwapchain) {
+      live[i] = true;
+      pending.push_back(i);
+    }
+  }
+  while (!pending.empty()) {
+    const auto pass = pending.back();
+    pending.pop_back();
+    for (const auto producer : producers[pass]) {
+      if (!live[producer]) {
+        live[producer] = true;
+        pending.push_back(producer);
+      }
+    }
+  }
+
+  auto result = CompiledFrameGraph{};
+  for (size_t i = 0; i < passCount; ++i) {
+    if (!live[i]) {
+      result.culledPasses.push_back(passes[i]->getId());
+    }
+  }
+
+  // Schedule the live passes, a culled pass never holds anything up
+  auto positions = std::vector<std::optional<size_t>>(passCount);
+  const auto liveCount = passCount - result.culledPasses.size();
+  while (result.passOrder.size() < liveCount) {
+    auto next = std::optional<size_t>{};
+    auto nextReadyAt = size_t{0};
+    for (size_t i = 0; i < passCount; ++i) {
+      if (!live[i] || positions[i]) {
+        continue;
+      }
+      auto ready = true;
+      // One past the position of the last dependency, 0 for a pass without any
+      auto readyAt = size_t{0};
+      for (const auto dependency : dependencies[i]) {
+        if (!live[dependency]) {
+          continue;
+        }
+        if (!positions[dependency]) {
+          ready = false;
+          break;
+        }
+        readyAt = std::max(readyAt, *positions[dependency] + 1);
+      }
+      if (ready && (!next || readyAt < nextReadyAt)) {
+        next = i;
+        nextReadyAt = readyAt;
+      }
+    }
+    assert(next && "Frame graph dependencies only point at earlier passes");
+    positions[*next] = result.passOrder.size();
+    result.passOrder.push_back(*next);
+  }
+
+  // Images whose contents carry over between frames can't give up their memory
+  auto persistent = std::unordered_set<ImageAlias>{ImageAlias::SwapchainImage};
+  for (const auto& [reader, resource] : historyReads) {
+    const auto* alias = std::get_if<ImageAlias>(&resource);
+    if (alias != nullptr && live[reader]) {
+      persistent.insert(*alias);
+    }
+  }
+
+  for (size_t position = 0; position < result.passOrder.size(); ++position) {
+    const auto& uses = passUses[result.passOrder[position]];
+    for (const auto* list : {&uses.reads, &uses.writes}) {
+      for (const auto& resource : *list) {
+        const auto* alias = std::get_if<ImageAlias>(&resource);
+        if (alias == nullptr || persistent.contains(*alias)) {
+          continue;
+        }
+        auto it = std::ranges::find(result.transientImages, *alias, &ResourceLifetime::alias);
+        if (it == result.transientImages.end()) {
+          result.transientImages.push_back(
+              ResourceLifetime{.alias = *alias, .firstUse = position, .lastUse = position});
+        } else {
+          it->lastUse = position;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+}
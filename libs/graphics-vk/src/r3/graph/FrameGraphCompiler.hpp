@@ -0,0 +1,55 @@
+#pragma once
+
+#include "r3/render-pass/IRenderPass.hpp"
+
+namespace tr {
+
+/// Where an image is first and last used, as positions in the pass order
+struct ResourceLifetime {
+  ImageAlias alias;
+  size_t firstUse;
+  size_t lastUse;
+};
+
+struct CompiledFrameGraph {
+  /// Indices into the passes given to compile(), in the order they should run
+  std::vector<size_t> passOrder;
+  /// Passes left out of passOrder as nothing that reaches the swapchain reads what they write
+  std::vector<PassId> culledPasses;
+  /// Images whose contents don't outlive the frame, so their memory can be shared with images
+  /// used at other times. Leaves out the swapchain image and images read before they're written.
+  std::vector<ResourceLifetime> transientImages;
+};
+
+/// Orders passes by what they read and write rather than the order they were added.
+///
+/// The order passes were added in says which write a read sees: a read depends on the last pass
+/// added before it that writes the same resource, and a write waits on earlier reads and writes
+/// of it. A read with no earlier write sees what the previous frame left, so the last pass to
+/// write that resource is kept alive for it, but isn't ordered before it. Edges only ever point
+/// from an earlier added pass to a later one, so the graph can't have a cycle.
+///
+/// Passes that use the swapchain image are the graph's outputs, anything they don't depend on is
+/// culled. A graph without any is left whole. Among the passes that are ready to run, the one
+/// whose dependencies finished earliest goes first, which puts independent work between a pass
+/// and whatever is waiting on it.
+///
+/// Reads of a disabled image are left out, as if the pass didn't sample it, so a pass that only
+/// feeds that image is culled. That's how the ImGui pass drops out with the editor overlay hidden.
+class FrameGraphCompiler {
+public:
+  FrameGraphCompiler(const FrameGraphCompiler&) = default;
+  FrameGraphCompiler(FrameGraphCompiler&&) = delete;
+  auto operator=(const FrameGraphCompiler&) -> FrameGraphCompiler& = default;
+  auto operator=(FrameGraphCompiler&&) -> FrameGraphCompiler& = delete;
+
+  static auto compile(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                      const std::unordered_set<ImageAlias>& disabledImages = {})
+      -> CompiledFrameGraph;
+
+private:
+  FrameGraphCompiler() = default;
+  ~FrameGraphCompiler() = default;
+};
+
+}
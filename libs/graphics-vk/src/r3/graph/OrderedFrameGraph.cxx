@@ -1,9 +1,11 @@
 #include "OrderedFrameGraph.hpp"
 #include "buffers/BufferSystem.hpp"
+#include "gfx/QueueTypes.hpp"
 #include "img/ImageManager.hpp"
+#include "r3/graph/PassRecorder.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
-#include "r3/graph/barriers/BarrierBuilder.hpp"
-#include "r3/graph/barriers/BarrierPrecursorGenerator.hpp"
+#include "r3/graph/TransientMemoryPlanner.hpp"
+#include "r3/graph/barriers/BarrierScheduleCompiler.hpp"
 #include "r3/render-pass/IRenderPass.hpp"
 #include "task/Frame.hpp"
 #include "vk/command-buffer/CommandBufferManager.hpp"
@@ -14,11 +16,22 @@ namespace tr {
 OrderedFrameGraph::OrderedFrameGraph(std::shared_ptr<CommandBufferManager> newCommandBufferManager,
                                      std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
                                      std::shared_ptr<ImageManager> newImageManager,
-                                     std::shared_ptr<BufferSystem> newBufferSystem)
+                                     std::shared_ptr<BufferSystem> newBufferSystem,
+                                     std::shared_ptr<PassRecorder> newPassRecorder,
+                                     const RenderContextConfig& renderConfig,
+                                     std::shared_ptr<queue::Graphics> newGraphicsQueue,
+                                     std::shared_ptr<queue::Compute> newComputeQueue)
     : commandBufferManager{std::move(newCommandBufferManager)},
       aliasRegistry{std::move(newAliasRegistry)},
       imageManager{std::move(newImageManager)},
-      bufferSystem{std::move(newBufferSystem)} {
+      bufferSystem{std::move(newBufferSystem)},
+      passRecorder{std::move(newPassRecorder)},
+      graphicsQueue{std::move(newGraphicsQueue)},
+      computeQueue{std::move(newComputeQueue)},
+      asyncCompute{renderConfig.asyncCompute} {
+  if (asyncCompute && computeQueue->getFamily() == graphicsQueue->getFamily()) {
+    Log.info("No compute queue family apart from graphics, compute passes use the graphics queue");
+  }
 }
 
 auto OrderedFrameGraph::addPass(std::unique_ptr<IRenderPass>&& pass) -> void {
@@ -26,6 +39,22 @@ auto OrderedFrameGraph::addPass(std::unique_ptr<IRenderPass>&& pass) -> void {
   const auto passId = pass->getId();
   renderPasses.push_back(std::move(pass));
   passesById.emplace(passId, size);
+
+  // The order and every barrier may have changed
+  barrierSchedule.reset();
+  frameBarriers.clear();
+  hasRun = false;
+}
+
+auto OrderedFrameGraph::setImageEnabled(ImageAlias alias, bool enabled) -> void {
+  const auto changed = enabled ? disabledImages.erase(alias) > 0
+                               : disabledImages.insert(alias).second;
+  if (changed) {
+    // Which passes run and every barrier may have changed
+    barrierSchedule.reset();
+    frameBarriers.clear();
+    hasRun = false;
+  }
 }
 
 auto OrderedFrameGraph::getPass(PassId id) -> std::unique_ptr<IRenderPass>& {
@@ -33,116 +62,278 @@ auto OrderedFrameGraph::getPass(PassId id) -> std::unique_ptr<IRenderPass>& {
   return renderPasses[passesById.at(id)];
 }
 
-auto OrderedFrameGraph::bake() -> void {
-  auto barrierPrecursorGenerator = BarrierPrecursorGenerator{};
-  barrierPrecursorPlan = barrierPrecursorGenerator.build(renderPasses);
+auto OrderedFrameGraph::getQueueType(const IRenderPass& pass) const -> QueueType {
+  if (pass.getQueueType() == QueueType::Compute && asyncCompute &&
+      computeQueue->getFamily() != graphicsQueue->getFamily()) {
+    return QueueType::Compute;
+  }
+  return QueueType::Graphics;
 }
 
-auto OrderedFrameGraph::execute(Frame* frame) -> FrameGraphResult {
-  auto result = FrameGraphResult{};
+auto OrderedFrameGraph::bake() -> void {
+  const auto compiled = FrameGraphCompiler::compile(renderPasses, disabledImages);
+  for (const auto passId : compiled.culledPasses) {
+    Log.debug("Culling {}, nothing reaching the swapchain reads what it writes", passId);
+  }
+  passOrder = compiled.passOrder;
+  passNames.clear();
+  passQueues.clear();
+  auto passFamilies = std::vector<uint32_t>{};
+  for (const auto index : passOrder) {
+    passNames.push_back(std::format("{}", renderPasses[index]->getId()));
+    const auto queueType = getQueueType(*renderPasses[index]);
+    passQueues.push_back(queueType);
+    passFamilies.push_back(queueType == QueueType::Compute ? computeQueue->getFamily()
+                                                           : graphicsQueue->getFamily());
+  }
+  const auto sharedMemory = aliasTransientImages(compiled.transientImages);
+  barrierSchedule = BarrierScheduleCompiler::compile(renderPasses,
+                                                     passOrder,
+                                                     sharedMemory,
+                                                     passFamilies,
+                                                     concurrentBuffers(),
+                                                     disabledImages);
+  submissions = QueuePlanner::plan(passQueues, barrierSchedule->transfers);
+  Log.debug("Submitting {} passes in {} submissions with {} ownership transfers",
+            passOrder.size(),
+            submissions.size(),
+            barrierSchedule->transfers.size());
+  frameBarriers.clear();
+  hasRun = false;
+}
 
-  for (const auto& renderPass : renderPasses) {
-    const auto passId = renderPass->getId();
+auto OrderedFrameGraph::concurrentBuffers() const -> std::unordered_set<BufferAliasVariant> {
+  const auto isConcurrent = [&](auto alias) {
+    return bufferSystem->isConcurrent(aliasRegistry->getHandle(alias));
+  };
 
-    auto imageBarriers = std::vector<vk::ImageMemoryBarrier2>{};
+  auto concurrent = std::unordered_set<BufferAliasVariant>{};
+  for (const auto index : passOrder) {
+    const auto graphInfo = renderPasses[index]->getGraphInfo();
+    for (const auto* usages : {&graphInfo.bufferReads, &graphInfo.bufferWrites}) {
+      for (const auto& usage : *usages) {
+        if (std::visit(isConcurrent, usage.alias)) {
+          concurrent.insert(usage.alias);
+        }
+      }
+    }
+  }
+  return concurrent;
+}
 
-    if (barrierPrecursorPlan.imagePrecursors.contains(passId)) {
-      for (const auto& precursor : barrierPrecursorPlan.imagePrecursors.at(passId)) {
-        const auto handle = frame->getLogicalImage(aliasRegistry->getHandle(precursor.alias));
+auto OrderedFrameGraph::aliasTransientImages(const std::vector<ResourceLifetime>& lifetimes)
+    -> std::unordered_map<ImageAlias, size_t> {
+  auto resources = std::vector<TransientResource>{};
+  resources.reserve(lifetimes.size());
+  for (const auto& lifetime : lifetimes) {
+    const auto requirements =
+        imageManager->getMemoryRequirements(aliasRegistry->getHandle(lifetime.alias));
+    resources.push_back(TransientResource{
+        .alias = lifetime.alias,
+        .size = requirements.size,
+        .alignment = requirements.alignment,
+        .memoryTypeBits = requirements.memoryTypeBits,
+        .firstUse = lifetime.firstUse,
+        .lastUse = lifetime.lastUse,
+    });
+  }
 
-        auto lastUse = std::optional<LastImageUse>();
+  const auto plan = TransientMemoryPlanner::plan(resources);
+  Log.info("Transient images need {} bytes per frame shared, {} bytes apart, saving {} bytes",
+           plan.aliasedBytes,
+           plan.unaliasedBytes,
+           plan.savedBytes());
 
-        if (precursor.alias == ImageAlias::SwapchainImage) {
-          lastUse = getSwapchainImageLastUse(handle);
-        } else {
-          lastUse = frame->getLastImageUse(precursor.alias);
-        }
-        auto imageBarrier = BarrierBuilder::build(precursor, lastUse);
-        if (imageBarrier) {
+  auto occupants = std::vector<size_t>(plan.blocks.size());
+  for (const auto& placement : plan.placements) {
+    ++occupants[placement.block];
+  }
 
-          const auto& image = imageManager->getImage(handle);
-          imageBarrier->setImage(image.getImage());
-          imageBarriers.push_back(*imageBarrier);
-        }
-        const auto newLastUse = LastImageUse{
-            .accessMode = precursor.accessMode,
-            .access = precursor.accessFlags,
-            .stage = precursor.stageFlags,
-            .layout = precursor.layout,
-        };
-        if (precursor.alias == ImageAlias::SwapchainImage) {
-          setSwapchainImageLastUse(handle, newLastUse);
-        } else {
-          frame->setLastImageUse(precursor.alias, newLastUse);
-        }
-      }
+  // An image alone in its block keeps the allocation it already has, unless that's memory an
+  // earlier bake shared out
+  auto sharedMemory = std::unordered_map<ImageAlias, size_t>{};
+  auto blocks = std::vector<SharedImageBlock>(plan.blocks.size());
+  for (const auto& placement : plan.placements) {
+    const auto shared = occupants[placement.block] > 1;
+    if (!shared && !aliasedImages.contains(placement.alias)) {
+      continue;
     }
+    const auto& block = plan.blocks[placement.block];
+    blocks[placement.block].requirements =
+        vk::MemoryRequirements{.size = block.size,
+                               .alignment = block.alignment,
+                               .memoryTypeBits = block.memoryTypeBits};
+    blocks[placement.block].images.emplace_back(aliasRegistry->getHandle(placement.alias),
+                                                placement.offset);
+    if (shared) {
+      sharedMemory.emplace(placement.alias, placement.block);
+      aliasedImages.insert(placement.alias);
+    } else {
+      aliasedImages.erase(placement.alias);
+    }
+  }
+  std::erase_if(blocks, [](const SharedImageBlock& block) { return block.images.empty(); });
 
-    auto bufferBarriers = std::vector<vk::BufferMemoryBarrier2>{};
-    if (barrierPrecursorPlan.bufferPrecursors.contains(passId)) {
+  if (!blocks.empty()) {
+    imageManager->aliasPerFrameImages(blocks);
+  }
+  return sharedMemory;
+}
 
-      const auto visitor = [&]<typename T>(T&& arg) {
-        using U = std::decay_t<T>;
-        if constexpr (std::is_same_v<U, BufferAlias>) {
-          const auto logicalHandle = aliasRegistry->getHandle(std::forward<T>(arg));
-          return bufferSystem->getVkBuffer(frame->getLogicalBuffer(logicalHandle));
-        }
-        if constexpr (std::is_same_v<U, GlobalBufferAlias>) {
-          const auto handle = aliasRegistry->getHandle(std::forward<T>(arg));
-          return bufferSystem->getVkBuffer(handle);
-        }
-      };
-
-      for (const auto& precursor : barrierPrecursorPlan.bufferPrecursors.at(passId)) {
-        const auto& buffer = std::visit(visitor, precursor.alias);
-        auto lastUse = frame->getLastBufferUse(precursor.alias);
-        auto bufferBarrier = BarrierBuilder::build(precursor, lastUse);
-        if (bufferBarrier) {
-          bufferBarrier->setBuffer(**buffer);
-          bufferBarriers.push_back(*bufferBarrier);
-        }
-        frame->setLastBufferUse(precursor.alias,
-                                LastBufferUse{
-                                    .passId = passId,
-                                    .accessMask = precursor.accessFlags,
-                                    .stageMask = precursor.stageFlags,
-                                });
-      }
-    }
+auto OrderedFrameGraph::execute(Frame* frame) -> FrameGraphResult {
+  if (!barrierSchedule) {
+    bake();
+  }
+
+  // Passes look images and buffer addresses up from the recorder's threads, where they can only
+  // read, so the swapchain images are brought up to date here first
+  imageManager->refreshSwapchainImages();
+  auto& passBarriers = prepareBarriers(frame);
+
+  // Each pass writes only its own slot, so the buffers are submitted in graph order no matter
+  // which thread finishes first
+  auto commandBuffers = std::vector<vk::CommandBuffer>(passOrder.size());
+  passRecorder->record(passOrder.size(), [&](size_t position) {
+    ZoneScopedN("Record Pass");
+    ZoneText(passNames[position].data(), passNames[position].size());
 
-    auto dependencyInfo = vk::DependencyInfo{
-        .bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()),
-        .pBufferMemoryBarriers = bufferBarriers.data(),
-        .imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()),
-        .pImageMemoryBarriers = imageBarriers.data(),
-    };
+    const auto& renderPass = renderPasses[passOrder[position]];
+    const auto& barriers = passBarriers[position];
 
-    const auto request = CommandBufferRequest{.threadId = std::this_thread::get_id(),
+    const auto request = CommandBufferRequest{.threadId = passRecorder->getThreadId(position),
                                               .frameId = frame->getIndex(),
-                                              .passId = passId,
-                                              .queueType = QueueType::Graphics};
+                                              .passId = barriers.passId,
+                                              .queueType = passQueues[position]};
     auto& commandBuffer = commandBufferManager->requestCommandBuffer(request);
     commandBuffer.begin(vk::CommandBufferBeginInfo{});
-    commandBuffer.pipelineBarrier2(dependencyInfo);
+    if (!barriers.imageBarriers.empty() || !barriers.bufferBarriers.empty()) {
+      commandBuffer.pipelineBarrier2(vk::DependencyInfo{
+          .bufferMemoryBarrierCount = static_cast<uint32_t>(barriers.bufferBarriers.size()),
+          .pBufferMemoryBarriers = barriers.bufferBarriers.data(),
+          .imageMemoryBarrierCount = static_cast<uint32_t>(barriers.imageBarriers.size()),
+          .pImageMemoryBarriers = barriers.imageBarriers.data(),
+      });
+    }
     renderPass->execute(frame, commandBuffer);
+    if (!barriers.releaseImageBarriers.empty() || !barriers.releaseBufferBarriers.empty()) {
+      commandBuffer.pipelineBarrier2(vk::DependencyInfo{
+          .bufferMemoryBarrierCount = static_cast<uint32_t>(barriers.releaseBufferBarriers.size()),
+          .pBufferMemoryBarriers = barriers.releaseBufferBarriers.data(),
+          .imageMemoryBarrierCount = static_cast<uint32_t>(barriers.releaseImageBarriers.size()),
+          .pImageMemoryBarriers = barriers.releaseImageBarriers.data(),
+      });
+    }
 
     commandBuffer.end();
-    result.commandBuffers.push_back(commandBuffer);
-  }
+    commandBuffers[position] = *commandBuffer;
+  });
 
+  auto result = FrameGraphResult{};
+  result.submissions.reserve(submissions.size());
+  for (const auto& submission : submissions) {
+    result.submissions.push_back(FrameGraphSubmission{
+        .queueType = submission.queueType,
+        .commandBuffers = {commandBuffers.begin() + submission.firstPosition,
+                           commandBuffers.begin() + submission.endPosition},
+        .waits = submission.waits});
+  }
   return result;
 }
 
-auto OrderedFrameGraph::getSwapchainImageLastUse(Handle<ManagedImage> handle)
-    -> std::optional<LastImageUse> {
-  return swapchainLastUses.contains(handle)
-             ? std::make_optional<LastImageUse>(swapchainLastUses.at(handle))
-             : std::nullopt;
+auto OrderedFrameGraph::prepareBarriers(Frame* frame) -> std::vector<PassBarriers>& {
+  const auto frameIndex = frame->getIndex();
+  if (frameIndex >= frameBarriers.size()) {
+    frameBarriers.resize(frameIndex + 1);
+  }
+
+  auto& barriers = frameBarriers[frameIndex];
+  if (!barriers) {
+    barriers = FrameBarriers{.firstRun = barrierSchedule->firstRun,
+                             .frameFirstRun = barrierSchedule->frameFirstRun,
+                             .steadyState = barrierSchedule->steadyState};
+    setImages(frame, barriers->firstRun);
+    setImages(frame, barriers->frameFirstRun);
+    setImages(frame, barriers->steadyState);
+  }
+
+  const auto bufferGeneration = bufferSystem->getAddressGeneration();
+  if (barriers->bufferGeneration != bufferGeneration) {
+    setBuffers(frame, barriers->firstRun);
+    setBuffers(frame, barriers->frameFirstRun);
+    setBuffers(frame, barriers->steadyState);
+    barriers->bufferGeneration = bufferGeneration;
+  }
+
+  auto& passes = barriers->hasRun ? barriers->steadyState
+                 : hasRun         ? barriers->frameFirstRun
+                                  : barriers->firstRun;
+  barriers->hasRun = true;
+  hasRun = true;
+
+  // The swapchain image is the only thing that changes from one run to the next
+  auto swapchainImage = std::optional<vk::Image>{};
+  for (auto& pass : passes) {
+    for (const auto index : pass.swapchainBarriers) {
+      if (!swapchainImage) {
+        const auto handle =
+            frame->getLogicalImage(aliasRegistry->getHandle(ImageAlias::SwapchainImage));
+        swapchainImage = imageManager->getImage(handle).getImage();
+      }
+      pass.imageBarriers[index].setImage(*swapchainImage);
+    }
+  }
+
+  return passes;
+}
+
+auto OrderedFrameGraph::setImages(Frame* frame, std::vector<PassBarriers>& passes) -> void {
+  for (auto& pass : passes) {
+    for (size_t i = 0; i < pass.imageBarriers.size(); ++i) {
+      if (pass.imageAliases[i] == ImageAlias::SwapchainImage) {
+        continue;
+      }
+      const auto handle = frame->getLogicalImage(aliasRegistry->getHandle(pass.imageAliases[i]));
+      pass.imageBarriers[i].setImage(imageManager->getImage(handle).getImage());
+    }
+    for (size_t i = 0; i < pass.releaseImageBarriers.size(); ++i) {
+      const auto handle =
+          frame->getLogicalImage(aliasRegistry->getHandle(pass.releaseImageAliases[i]));
+      pass.releaseImageBarriers[i].setImage(imageManager->getImage(handle).getImage());
+    }
+  }
 }
 
-auto OrderedFrameGraph::setSwapchainImageLastUse(Handle<ManagedImage> handle,
-                                                 LastImageUse lastImageUse) -> void {
-  swapchainLastUses.insert_or_assign(handle, lastImageUse);
+auto OrderedFrameGraph::setBuffers(Frame* frame, std::vector<PassBarriers>& passes) -> void {
+  const auto visitor = [&]<typename T>(T&& arg) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, BufferAlias>) {
+      const auto logicalHandle = aliasRegistry->getHandle(std::forward<T>(arg));
+      return bufferSystem->getVkBuffer(frame->getLogicalBuffer(logicalHandle));
+    }
+    if constexpr (std::is_same_v<U, GlobalBufferAlias>) {
+      const auto handle = aliasRegistry->getHandle(std::forward<T>(arg));
+      return bufferSystem->getVkBuffer(handle);
+    }
+  };
+
+  for (auto& pass : passes) {
+    for (size_t i = 0; i < pass.bufferBarriers.size(); ++i) {
+      const auto buffer = std::visit(visitor, pass.bufferAliases[i]);
+      if (!buffer) {
+        Log.warn("{} has a barrier on {} which has no buffer", pass.passId, pass.bufferAliases[i]);
+        continue;
+      }
+      pass.bufferBarriers[i].setBuffer(**buffer);
+    }
+    for (size_t i = 0; i < pass.releaseBufferBarriers.size(); ++i) {
+      const auto buffer = std::visit(visitor, pass.releaseBufferAliases[i]);
+      if (!buffer) {
+        Log.warn("{} releases {} which has no buffer", pass.passId, pass.releaseBufferAliases[i]);
+        continue;
+      }
+      pass.releaseBufferBarriers[i].setBuffer(**buffer);
+    }
+  }
 }
 
 }
@@ -1,22 +1,55 @@
 #pragma once
 
 #include "gfx/IFrameGraph.hpp"
-#include "r3/graph/barriers/BarrierPrecursorPlan.hpp"
-#include "r3/graph/barriers/LastImageUse.hpp"
+#include "gfx/RenderContextConfig.hpp"
+#include "r3/graph/FrameGraphCompiler.hpp"
+#include "r3/graph/QueuePlanner.hpp"
+#include "r3/graph/barriers/BarrierSchedule.hpp"
 
 namespace tr {
 
 class CommandBufferManager;
+class PassRecorder;
 class ResourceAliasRegistry;
 class ImageManager;
 class BufferSystem;
 
+namespace queue {
+class Graphics;
+class Compute;
+}
+
+/// The barrier schedule with one frame's images and buffers filled in
+struct FrameBarriers {
+  std::vector<PassBarriers> firstRun;
+  std::vector<PassBarriers> frameFirstRun;
+  std::vector<PassBarriers> steadyState;
+  bool hasRun{};
+  /// BufferSystem's address generation the buffers were filled in at, resizing a buffer replaces
+  /// its vk::Buffer
+  std::optional<uint64_t> bufferGeneration;
+};
+
+/// Runs passes in an order worked out by bake() from what they read and write, leaving out any
+/// that don't contribute to the swapchain image. bake() also moves images that are never in use
+/// at the same time into shared memory, and compiles the barriers between passes. Running the
+/// graph only fills in the swapchain image and any buffers that were resized, then records the
+/// passes in parallel on the PassRecorder's threads.
+///
+/// With async compute on and a compute queue family apart from the graphics one, passes that ask
+/// for the compute queue run there. bake() then has ownership of what they share with graphics
+/// passes transferred between the families, and splits the passes into submissions that wait on
+/// each other where a transfer needs it.
 class OrderedFrameGraph : public IFrameGraph {
 public:
   OrderedFrameGraph(std::shared_ptr<CommandBufferManager> newCommandBufferManager,
                     std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
                     std::shared_ptr<ImageManager> newImageManager,
-                    std::shared_ptr<BufferSystem> newBufferSystem);
+                    std::shared_ptr<BufferSystem> newBufferSystem,
+                    std::shared_ptr<PassRecorder> newPassRecorder,
+                    const RenderContextConfig& renderConfig,
+                    std::shared_ptr<queue::Graphics> newGraphicsQueue,
+                    std::shared_ptr<queue::Compute> newComputeQueue);
   ~OrderedFrameGraph() override = default;
 
   OrderedFrameGraph(const OrderedFrameGraph&) = delete;
@@ -27,25 +60,58 @@ public:
   auto addPass(std::unique_ptr<IRenderPass>&& pass) -> void override;
 
   [[nodiscard]] auto getPass(PassId id) -> std::unique_ptr<IRenderPass>& override;
+  [[nodiscard]] auto getQueueType(const IRenderPass& pass) const -> QueueType override;
+
+  auto setImageEnabled(ImageAlias alias, bool enabled) -> void override;
 
   auto bake() -> void override;
 
   auto execute(Frame* frame) -> FrameGraphResult override;
 
-  auto getSwapchainImageLastUse(Handle<ManagedImage> handle) -> std::optional<LastImageUse>;
-  auto setSwapchainImageLastUse(Handle<ManagedImage> handle, LastImageUse lastImageUse) -> void;
-
 private:
   std::shared_ptr<CommandBufferManager> commandBufferManager;
   std::shared_ptr<ResourceAliasRegistry> aliasRegistry;
   std::shared_ptr<ImageManager> imageManager;
   std::shared_ptr<BufferSystem> bufferSystem;
+  std::shared_ptr<PassRecorder> passRecorder;
+  std::shared_ptr<queue::Graphics> graphicsQueue;
+  std::shared_ptr<queue::Compute> computeQueue;
+  bool asyncCompute;
 
   std::vector<std::unique_ptr<IRenderPass>> renderPasses;
   std::unordered_map<PassId, size_t> passesById;
-  BarrierPrecursorPlan barrierPrecursorPlan;
 
-  std::unordered_map<Handle<ManagedImage>, LastImageUse> swapchainLastUses;
+  /// Indices into renderPasses in the order they run, set by bake()
+  std::vector<size_t> passOrder;
+  /// Tracy zone text for each pass in passOrder
+  std::vector<std::string> passNames;
+  /// The queue each pass in passOrder is submitted to
+  std::vector<QueueType> passQueues;
+  /// How passOrder is split between the queues, set by bake()
+  std::vector<QueueSubmission> submissions;
+  /// Empty until bake(), and again after a pass is added
+  std::optional<BarrierSchedule> barrierSchedule;
+  /// Indexed by frame, each filled in from `barrierSchedule` the first time that frame runs
+  std::vector<std::optional<FrameBarriers>> frameBarriers;
+  /// Whether any frame has run since bake(), global buffers are shared between frames so their
+  /// barriers depend on it rather than the frame's own history
+  bool hasRun{};
+  std::unordered_set<ImageAlias> disabledImages;
+  /// Transient images an earlier bake put in shared memory. One left alone in its block by a
+  /// later bake still overlaps whatever it shared with, so it's given memory of its own.
+  std::unordered_set<ImageAlias> aliasedImages;
+
+  /// Packs the transient images into shared memory, returning the block each image that now
+  /// shares one is in
+  auto aliasTransientImages(const std::vector<ResourceLifetime>& lifetimes)
+      -> std::unordered_map<ImageAlias, size_t>;
+  /// The buffers the ordered passes use that were created shared between queue families, so need
+  /// no ownership transfers
+  [[nodiscard]] auto concurrentBuffers() const -> std::unordered_set<BufferAliasVariant>;
+  /// Returns the barriers for this run of `frame`, with its images and buffers filled in
+  auto prepareBarriers(Frame* frame) -> std::vector<PassBarriers>&;
+  auto setImages(Frame* frame, std::vector<PassBarriers>& passes) -> void;
+  auto setBuffers(Frame* frame, std::vector<PassBarriers>& passes) -> void;
 };
 
 }
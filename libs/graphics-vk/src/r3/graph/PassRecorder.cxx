@@ -0,0 +1,94 @@
+#include "PassRecorder.hpp"
+#include "bk/ThreadName.hpp"
+
+namespace tr {
+
+PassRecorder::PassRecorder(const RenderContextConfig& renderConfig) {
+  const auto workerCount = static_cast<size_t>(renderConfig.recordingThreads);
+  if (workerCount == 0) {
+    threadIds.push_back(std::this_thread::get_id());
+    return;
+  }
+
+  threadIds.reserve(workerCount);
+  workers.reserve(workerCount);
+  for (size_t i = 0; i < workerCount; ++i) {
+    workers.emplace_back([this, i](const std::stop_token& token) { workerLoop(i, token); });
+    threadIds.push_back(workers.back().get_id());
+  }
+  Log.trace("Recording passes on {} threads", workerCount);
+}
+
+/// Workers have to be joined before the condition variables they wait on go away.
+PassRecorder::~PassRecorder() {
+  for (auto& worker : workers) {
+    worker.request_stop();
+  }
+  workers.clear();
+}
+
+auto PassRecorder::getThreadIds() const -> const std::vector<std::thread::id>& {
+  return threadIds;
+}
+
+auto PassRecorder::getThreadId(size_t position) const -> std::thread::id {
+  return threadIds[position % threadIds.size()];
+}
+
+auto PassRecorder::record(size_t count, const std::function<void(size_t)>& recordPass) -> void {
+  if (workers.empty()) {
+    for (size_t position = 0; position < count; ++position) {
+      recordPass(position);
+    }
+    return;
+  }
+
+  std::unique_lock lock(mutex);
+  batch = &recordPass;
+  batchCount = count;
+  busyWorkers = workers.size();
+  ++generation;
+  workReady.notify_all();
+  workDone.wait(lock, [this] { return busyWorkers == 0; });
+  batch = nullptr;
+
+  if (error) {
+    std::rethrow_exception(std::exchange(error, nullptr));
+  }
+}
+
+auto PassRecorder::workerLoop(size_t index, const std::stop_token& token) -> void {
+  setCurrentThreadName("PassRecorder" + std::to_string(index));
+
+  auto seenGeneration = uint64_t{0};
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      if (!workReady.wait(lock, token, [&] { return generation != seenGeneration; })) {
+        return;
+      }
+      seenGeneration = generation;
+    }
+
+    {
+      ZoneScopedN("PassRecorder::record");
+      for (auto position = index; position < batchCount; position += workers.size()) {
+        try {
+          (*batch)(position);
+        } catch (...) {
+          std::lock_guard lock(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+
+    std::lock_guard lock(mutex);
+    if (--busyWorkers == 0) {
+      workDone.notify_one();
+    }
+  }
+}
+
+}
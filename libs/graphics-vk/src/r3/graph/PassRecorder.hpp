@@ -0,0 +1,56 @@
+#pragma once
+
+#include "gfx/RenderContextConfig.hpp"
+
+namespace tr {
+
+/// Records frame graph passes on a fixed set of worker threads.
+///
+/// The pass at each position always goes to the same worker, round robin, so command buffers can
+/// be allocated up front from pools belonging to that worker's thread, and no pool is ever used
+/// from two threads. record() only returns once every pass is done, so callers that collect
+/// their results by position get them in graph order however the workers happen to finish.
+///
+/// With no workers configured, passes are recorded on the calling thread, and the thread that
+/// created the PassRecorder is the one command buffers are allocated for.
+class PassRecorder {
+public:
+  explicit PassRecorder(const RenderContextConfig& renderConfig);
+  ~PassRecorder();
+
+  PassRecorder(const PassRecorder&) = delete;
+  PassRecorder(PassRecorder&&) = delete;
+  auto operator=(const PassRecorder&) -> PassRecorder& = delete;
+  auto operator=(PassRecorder&&) -> PassRecorder& = delete;
+
+  /// Every thread a pass can be recorded on, each needs its own command buffers
+  [[nodiscard]] auto getThreadIds() const -> const std::vector<std::thread::id>&;
+
+  /// The thread the pass at `position` is recorded on
+  [[nodiscard]] auto getThreadId(size_t position) const -> std::thread::id;
+
+  /// Calls `recordPass(position)` for every position in [0, count), each on the thread
+  /// getThreadId(position) returns. Blocks until they've all finished, then rethrows the first
+  /// exception any of them threw.
+  auto record(size_t count, const std::function<void(size_t)>& recordPass) -> void;
+
+private:
+  std::vector<std::thread::id> threadIds;
+  std::vector<std::jthread> workers;
+
+  std::mutex mutex;
+  std::condition_variable_any workReady;
+  std::condition_variable workDone;
+
+  /// The batch being recorded, only touched by workers between a bump of `generation` and them
+  /// reporting back through `busyWorkers`
+  const std::function<void(size_t)>* batch{};
+  size_t batchCount{};
+  uint64_t generation{};
+  size_t busyWorkers{};
+  std::exception_ptr error;
+
+  auto workerLoop(size_t index, const std::stop_token& token) -> void;
+};
+
+}
@@ -0,0 +1,103 @@
+#include "QueuePlanner.hpp"
+
+namespace tr {
+
+namespace {
+
+/// Transfers something has to wait on. A frame's own resources come back to it from its own last
+/// run, which the frame's fence has already waited on before this run is recorded, so only global
+/// buffers need waits from the previous run.
+auto needsWait(const OwnershipTransfer& transfer) -> bool {
+  const auto* buffer = std::get_if<BufferAliasVariant>(&transfer.resource);
+  return !transfer.fromPreviousRun ||
+         (buffer != nullptr && std::holds_alternative<GlobalBufferAlias>(*buffer));
+}
+
+auto addWait(QueueSubmission& submission, const SubmissionWait& wait) -> void {
+  auto it = std::ranges::find_if(submission.waits, [&](const SubmissionWait& existing) {
+    return existing.submission == wait.submission && existing.previousRun == wait.previousRun;
+  });
+  if (it == submission.waits.end()) {
+    submission.waits.push_back(wait);
+    return;
+  }
+  it->stages |= wait.stages;
+}
+
+/// Every submission `last` is ordered after, through queue order and this run's waits
+auto findReached(const std::vector<QueueSubmission>& submissions, size_t last)
+    -> std::vector<bool> {
+  auto reached = std::vector<bool>(submissions.size());
+  auto pending = std::vector<size_t>{last};
+  while (!pending.empty()) {
+    const auto index = pending.back();
+    pending.pop_back();
+    if (reached[index]) {
+      continue;
+    }
+    reached[index] = true;
+    for (size_t earlier = 0; earlier < index; ++earlier) {
+      if (submissions[earlier].queueType == submissions[index].queueType) {
+        pending.push_back(earlier);
+      }
+    }
+    for (const auto& wait : submissions[index].waits) {
+      if (!wait.previousRun) {
+        pending.push_back(wait.submission);
+      }
+    }
+  }
+  return reached;
+}
+
+}
+
+auto QueuePlanner::plan(const std::vector<QueueType>& passQueues,
+                        const std::vector<OwnershipTransfer>& transfers)
+    -> std::vector<QueueSubmission> {
+  auto waited = std::vector<OwnershipTransfer>{};
+  std::ranges::copy_if(transfers, std::back_inserter(waited), needsWait);
+
+  auto releasing = std::vector<bool>(passQueues.size());
+  for (const auto& transfer : waited) {
+    releasing[transfer.releasePosition] = true;
+  }
+
+  auto submissions = std::vector<QueueSubmission>{};
+  auto submissionOf = std::vector<size_t>(passQueues.size());
+  for (size_t position = 0; position < passQueues.size(); ++position) {
+    const auto startsNew = position == 0 || passQueues[position] != passQueues[position - 1] ||
+                           releasing[position - 1];
+    if (startsNew) {
+      submissions.push_back(QueueSubmission{.queueType = passQueues[position],
+                                            .firstPosition = position,
+                                            .endPosition = position});
+    }
+    ++submissions.back().endPosition;
+    submissionOf[position] = submissions.size() - 1;
+  }
+
+  for (const auto& transfer : waited) {
+    addWait(submissions[submissionOf[transfer.acquirePosition]],
+            SubmissionWait{.submission = submissionOf[transfer.releasePosition],
+                           .previousRun = transfer.fromPreviousRun,
+                           .stages = transfer.acquireStages});
+  }
+
+  if (!submissions.empty()) {
+    const auto last = submissions.size() - 1;
+    const auto reached = findReached(submissions, last);
+    for (size_t index = 0; index < last; ++index) {
+      if (!reached[index]) {
+        addWait(submissions[last],
+                SubmissionWait{.submission = index,
+                               .previousRun = false,
+                               .stages = vk::PipelineStageFlagBits2::eAllCommands});
+      }
+    }
+  }
+
+  return submissions;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "gfx/FrameGraphResult.hpp"
+#include "r3/graph/barriers/BarrierSchedule.hpp"
+
+namespace tr {
+
+/// The passes at positions [firstPosition, endPosition) in the pass order, submitted together to
+/// one queue
+struct QueueSubmission {
+  QueueType queueType;
+  size_t firstPosition;
+  size_t endPosition;
+  std::vector<SubmissionWait> waits;
+};
+
+/// Splits the pass order into submissions, one for each stretch of passes on the same queue, and
+/// works out what each has to wait on from the other queues. A submission also ends after any pass
+/// that releases a resource to another queue, so whatever acquires it only waits on that much.
+///
+/// Passes on one queue run in order, so only ownership transfers need a wait, and of those from the
+/// previous run only the global buffers'. The last submission also waits on any submission it isn't
+/// already ordered after, so that it finishing means the whole run has, and so the frame's fence
+/// covers everything the frame's next run takes back.
+class QueuePlanner {
+public:
+  QueuePlanner(const QueuePlanner&) = default;
+  QueuePlanner(QueuePlanner&&) = delete;
+  auto operator=(const QueuePlanner&) -> QueuePlanner& = default;
+  auto operator=(QueuePlanner&&) -> QueuePlanner& = delete;
+
+  /// `passQueues` is the queue each position in the pass order is submitted to
+  static auto plan(const std::vector<QueueType>& passQueues,
+                   const std::vector<OwnershipTransfer>& transfers)
+      -> std::vector<QueueSubmission>;
+
+private:
+  QueuePlanner() = default;
+  ~QueuePlanner() = default;
+};
+
+}
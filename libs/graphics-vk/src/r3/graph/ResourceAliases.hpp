@@ -14,6 +14,11 @@ enum class BufferAlias : uint8_t {
   FrameData,
   ResourceTable,
   Materials,
+  DrawBatches,
+  DrawInstances,
+  VisibleObjects,
+  LateIndirectCommand,
+  LateIndirectCommandCount,
   Count
 };
 
@@ -24,6 +29,8 @@ enum class GlobalBufferAlias : uint8_t {
   TexCoord,
   Color,
   Animation,
+  DepthPyramid,
+  ObjectVisibility,
   Count
 };
 
@@ -41,6 +48,10 @@ inline auto to_string(GlobalBufferAlias alias) -> std::string {
       return "Color";
     case GlobalBufferAlias::Animation:
       return "Animation";
+    case GlobalBufferAlias::DepthPyramid:
+      return "DepthPyramid";
+    case GlobalBufferAlias::ObjectVisibility:
+      return "ObjectVisibility";
     case tr::GlobalBufferAlias::Count:
       return "Count";
   }
@@ -66,6 +77,16 @@ inline auto to_string(BufferAlias alias) -> std::string {
       return "Count";
     case BufferAlias::Materials:
       return "Materials";
+    case BufferAlias::DrawBatches:
+      return "DrawBatches";
+    case BufferAlias::DrawInstances:
+      return "DrawInstances";
+    case BufferAlias::VisibleObjects:
+      return "VisibleObjects";
+    case BufferAlias::LateIndirectCommand:
+      return "LateIndirectCommand";
+    case BufferAlias::LateIndirectCommandCount:
+      return "LateIndirectCommandCount";
     default:
       return "UnknownBufferAlias";
   }
@@ -0,0 +1,96 @@
+#include "TransientMemoryPlanner.hpp"
+
+namespace tr {
+
+namespace {
+
+auto alignUp(uint64_t value, uint64_t alignment) -> uint64_t {
+  return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+}
+
+auto overlaps(const TransientResource& a, const TransientResource& b) -> bool {
+  return a.firstUse <= b.lastUse && b.firstUse <= a.lastUse;
+}
+
+struct Placed {
+  const TransientResource* resource;
+  uint64_t offset;
+};
+
+/// The lowest offset in a block holding `placed` where `resource` doesn't touch anything alive at
+/// the same time
+auto findOffset(const std::vector<Placed>& placed, const TransientResource& resource) -> uint64_t {
+  auto occupied = std::vector<std::pair<uint64_t, uint64_t>>{};
+  for (const auto& other : placed) {
+    if (overlaps(*other.resource, resource)) {
+      occupied.emplace_back(other.offset, other.offset + other.resource->size);
+    }
+  }
+  std::ranges::sort(occupied);
+
+  auto cursor = uint64_t{0};
+  for (const auto& [begin, end] : occupied) {
+    if (alignUp(cursor, resource.alignment) + resource.size <= begin) {
+      break;
+    }
+    cursor = std::max(cursor, end);
+  }
+  return alignUp(cursor, resource.alignment);
+}
+
+}
+
+auto TransientMemoryPlanner::plan(std::vector<TransientResource> resources)
+    -> TransientMemoryPlan {
+  std::ranges::stable_sort(resources, std::greater{}, &TransientResource::size);
+
+  auto result = TransientMemoryPlan{};
+  auto placedInBlock = std::vector<std::vector<Placed>>{};
+
+  for (const auto& resource : resources) {
+    result.unaliasedBytes += resource.size;
+
+    auto bestBlock = std::optional<size_t>{};
+    auto bestOffset = uint64_t{0};
+    auto bestGrowth = resource.size;
+
+    for (size_t i = 0; i < result.blocks.size(); ++i) {
+      const auto& block = result.blocks[i];
+      if ((block.memoryTypeBits & resource.memoryTypeBits) == 0) {
+        continue;
+      }
+      const auto offset = findOffset(placedInBlock[i], resource);
+      const auto end = offset + resource.size;
+      const auto growth = end > block.size ? end - block.size : 0;
+      if (growth < bestGrowth) {
+        bestBlock = i;
+        bestOffset = offset;
+        bestGrowth = growth;
+      }
+    }
+
+    if (!bestBlock) {
+      bestBlock = result.blocks.size();
+      result.blocks.push_back(TransientMemoryBlock{.size = 0,
+                                                   .alignment = resource.alignment,
+                                                   .memoryTypeBits = resource.memoryTypeBits});
+      placedInBlock.emplace_back();
+    }
+
+    auto& block = result.blocks[*bestBlock];
+    block.size = std::max(block.size, bestOffset + resource.size);
+    block.alignment = std::max(block.alignment, resource.alignment);
+    block.memoryTypeBits &= resource.memoryTypeBits;
+    placedInBlock[*bestBlock].push_back(Placed{.resource = &resource, .offset = bestOffset});
+    result.placements.push_back(
+        TransientPlacement{.alias = resource.alias, .block = *bestBlock, .offset = bestOffset});
+  }
+
+  for (const auto& block : result.blocks) {
+    result.aliasedBytes += block.size;
+  }
+
+  return result;
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "r3/graph/ImageAlias.hpp"
+
+namespace tr {
+
+/// A resource that only holds data between its first and last use in a frame. Uses are positions
+/// in the frame graph's pass order.
+struct TransientResource {
+  ImageAlias alias;
+  uint64_t size;
+  uint64_t alignment;
+  uint32_t memoryTypeBits;
+  size_t firstUse;
+  size_t lastUse;
+};
+
+struct TransientMemoryBlock {
+  uint64_t size;
+  uint64_t alignment;
+  uint32_t memoryTypeBits;
+};
+
+struct TransientPlacement {
+  ImageAlias alias;
+  size_t block;
+  uint64_t offset;
+};
+
+struct TransientMemoryPlan {
+  std::vector<TransientMemoryBlock> blocks;
+  std::vector<TransientPlacement> placements;
+  /// What the resources take with an allocation each
+  uint64_t unaliasedBytes{};
+  /// What the blocks take, the most the resources can need at once given how they're packed
+  uint64_t aliasedBytes{};
+
+  [[nodiscard]] auto savedBytes() const -> uint64_t {
+    return unaliasedBytes - aliasedBytes;
+  }
+};
+
+/// Packs transient resources into as little memory as it can, letting resources whose lifetimes
+/// don't overlap share the same bytes. Largest first, each resource goes at the lowest offset in
+/// an existing block that nothing alive at the same time is using, in whichever block that grows
+/// the least. It only starts a new block when every existing one would have to grow by the whole
+/// resource.
+class TransientMemoryPlanner {
+public:
+  TransientMemoryPlanner(const TransientMemoryPlanner&) = default;
+  TransientMemoryPlanner(TransientMemoryPlanner&&) = delete;
+  auto operator=(const TransientMemoryPlanner&) -> TransientMemoryPlanner& = default;
+  auto operator=(TransientMemoryPlanner&&) -> TransientMemoryPlanner& = delete;
+
+  static auto plan(std::vector<TransientResource> resources) -> TransientMemoryPlan;
+
+private:
+  TransientMemoryPlanner() = default;
+  ~TransientMemoryPlanner() = default;
+};
+
+}
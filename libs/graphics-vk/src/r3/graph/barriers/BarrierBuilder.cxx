@@ -47,4 +47,58 @@ auto BarrierBuilder::build(const ImageBarrierPrecursor& ibp, std::optional<LastI
                                      .layerCount = 1,
                                  }};
 }
+
+auto BarrierBuilder::buildTransfer(const BufferBarrierPrecursor& bbp,
+                                   const LastBufferUse& lastUse,
+                                   uint32_t srcFamily,
+                                   uint32_t dstFamily)
+    -> TransferBarriers<vk::BufferMemoryBarrier2> {
+  // The release's destination and the acquire's source are covered by the semaphore between the
+  // two queues
+  const auto release = vk::BufferMemoryBarrier2{
+      .srcStageMask = lastUse.stageMask,
+      .srcAccessMask = lastUse.accessMask,
+      .dstStageMask = vk::PipelineStageFlagBits2::eNone,
+      .dstAccessMask = vk::AccessFlagBits2::eNone,
+      .srcQueueFamilyIndex = srcFamily,
+      .dstQueueFamilyIndex = dstFamily,
+      .offset = 0,
+      .size = VK_WHOLE_SIZE,
+  };
+  auto acquire = release;
+  acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+  acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+  acquire.dstStageMask = bbp.stageFlags;
+  acquire.dstAccessMask = bbp.accessFlags;
+  return {.release = release, .acquire = acquire};
+}
+
+auto BarrierBuilder::buildTransfer(const ImageBarrierPrecursor& ibp,
+                                   const LastImageUse& lastUse,
+                                   uint32_t srcFamily,
+                                   uint32_t dstFamily)
+    -> TransferBarriers<vk::ImageMemoryBarrier2> {
+  const auto release = vk::ImageMemoryBarrier2{.srcStageMask = lastUse.stage,
+                                               .srcAccessMask = lastUse.access,
+                                               .dstStageMask = vk::PipelineStageFlagBits2::eNone,
+                                               .dstAccessMask = vk::AccessFlagBits2::eNone,
+                                               .oldLayout = lastUse.layout,
+                                               .newLayout = ibp.layout,
+                                               .srcQueueFamilyIndex = srcFamily,
+                                               .dstQueueFamilyIndex = dstFamily,
+                                               .subresourceRange = vk::ImageSubresourceRange{
+                                                   .aspectMask = ibp.aspectFlags,
+                                                   .baseMipLevel = 0,
+                                                   .levelCount = 1,
+                                                   .baseArrayLayer = 0,
+                                                   .layerCount = 1,
+                                               }};
+  auto acquire = release;
+  acquire.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+  acquire.srcAccessMask = vk::AccessFlagBits2::eNone;
+  acquire.dstStageMask = ibp.stageFlags;
+  acquire.dstAccessMask = ibp.accessFlags;
+  return {.release = release, .acquire = acquire};
+}
+
 }
@@ -7,6 +7,14 @@
 
 namespace tr {
 
+/// The two halves of a queue family ownership transfer. The release is recorded on the old
+/// family's queue and the acquire on the new one's, both with the same families and layouts.
+template <typename T>
+struct TransferBarriers {
+  T release;
+  T acquire;
+};
+
 class BarrierBuilder {
 public:
   BarrierBuilder(const BarrierBuilder&) = default;
@@ -19,6 +27,15 @@ public:
   static auto build(const ImageBarrierPrecursor& ibp, std::optional<LastImageUse> lastUse)
       -> std::optional<vk::ImageMemoryBarrier2>;
 
+  static auto buildTransfer(const BufferBarrierPrecursor& bbp,
+                            const LastBufferUse& lastUse,
+                            uint32_t srcFamily,
+                            uint32_t dstFamily) -> TransferBarriers<vk::BufferMemoryBarrier2>;
+  static auto buildTransfer(const ImageBarrierPrecursor& ibp,
+                            const LastImageUse& lastUse,
+                            uint32_t srcFamily,
+                            uint32_t dstFamily) -> TransferBarriers<vk::ImageMemoryBarrier2>;
+
 private:
   BarrierBuilder() = default;
   ~BarrierBuilder() = default;
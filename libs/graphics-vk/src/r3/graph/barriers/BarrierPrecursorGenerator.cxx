@@ -2,7 +2,8 @@
 
 namespace tr {
 
-auto BarrierPrecursorGenerator::build(const std::vector<std::unique_ptr<IRenderPass>>& passes)
+auto BarrierPrecursorGenerator::build(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                                      const std::unordered_set<ImageAlias>& disabledImages)
     -> BarrierPrecursorPlan {
   BarrierPrecursorPlan result{};
 
@@ -12,6 +13,9 @@ auto BarrierPrecursorGenerator::build(const std::vector<std::unique_ptr<IRenderP
 
     // Image Reads
     for (const auto& read : info.imageReads) {
+      if (disabledImages.contains(read.alias)) {
+        continue;
+      }
       result.imagePrecursors[passId].push_back(ImageBarrierPrecursor{
           .alias = read.alias,
           .accessMode = AccessMode::Read,
@@ -15,7 +15,9 @@ public:
   auto operator=(const BarrierPrecursorGenerator&) -> BarrierPrecursorGenerator& = default;
   auto operator=(BarrierPrecursorGenerator&&) -> BarrierPrecursorGenerator& = delete;
 
-  auto build(const std::vector<std::unique_ptr<IRenderPass>>& passes) -> BarrierPrecursorPlan;
+  /// Reads of images in `disabledImages` are left out, the pass won't sample them.
+  auto build(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+             const std::unordered_set<ImageAlias>& disabledImages = {}) -> BarrierPrecursorPlan;
 };
 
 }
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "r3/ComponentIds.hpp"
+#include "r3/graph/ImageAlias.hpp"
+#include "r3/graph/ResourceAliases.hpp"
+
+namespace tr {
+
+/// The barriers recorded in a single pipelineBarrier2 before a pass. Each barrier is filled in
+/// apart from its image or buffer, the alias at the same index says which one that is.
+struct PassBarriers {
+  PassId passId;
+  std::vector<vk::ImageMemoryBarrier2> imageBarriers;
+  std::vector<ImageAlias> imageAliases;
+  std::vector<vk::BufferMemoryBarrier2> bufferBarriers;
+  std::vector<BufferAliasVariant> bufferAliases;
+  /// Indices into `imageBarriers` for the swapchain image, the only image that changes per run
+  std::vector<size_t> swapchainBarriers;
+
+  /// Recorded after the pass, releasing what it was the last to use on its queue family to the
+  /// family that uses it next
+  std::vector<vk::ImageMemoryBarrier2> releaseImageBarriers;
+  std::vector<ImageAlias> releaseImageAliases;
+  std::vector<vk::BufferMemoryBarrier2> releaseBufferBarriers;
+  std::vector<BufferAliasVariant> releaseBufferAliases;
+};
+
+/// A resource changing hands between queue families. The release is recorded after the last pass
+/// to use it on the old family, and the acquire before the first pass to use it on the new one,
+/// so the new family's queue also has to wait for the old one's.
+struct OwnershipTransfer {
+  std::variant<ImageAlias, BufferAliasVariant> resource;
+  /// Positions in the pass order
+  size_t releasePosition;
+  size_t acquirePosition;
+  uint32_t srcFamily;
+  uint32_t dstFamily;
+  /// The release happens in the run before the acquire's
+  bool fromPreviousRun;
+  /// What waits on the release
+  vk::PipelineStageFlags2 acquireStages;
+};
+
+/// Every pass's barriers in the order the passes run.
+struct BarrierSchedule {
+  /// The graph's first run, where a resource's first use waits on nothing
+  std::vector<PassBarriers> firstRun;
+  /// A frame's first run once some other frame has run. Global buffers are shared by every frame,
+  /// so their first use waits on their last use in the run before, whichever frame that was. The
+  /// frame's own resources haven't been used yet, so theirs waits on nothing.
+  std::vector<PassBarriers> frameFirstRun;
+  /// Every run of a frame after its first, where a resource's first use waits on its last use in
+  /// the run before. The swapchain image is the exception, it's a different image each run so is
+  /// always treated as a first use.
+  std::vector<PassBarriers> steadyState;
+  /// Every ownership transfer in the steady state, at most one per resource each time it moves to
+  /// another family. The other runs have the same ones, less those from the previous run that
+  /// they have nothing to take back from.
+  std::vector<OwnershipTransfer> transfers;
+};
+
+}
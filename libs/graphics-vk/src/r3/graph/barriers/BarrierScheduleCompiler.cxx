@@ -0,0 +1,314 @@
+#include "BarrierScheduleCompiler.hpp"
+#include "r3/graph/barriers/BarrierBuilder.hpp"
+#include "r3/graph/barriers/BarrierPrecursorGenerator.hpp"
+
+namespace tr {
+
+namespace {
+
+struct PassPrecursors {
+  PassId passId;
+  std::vector<ImageBarrierPrecursor> images;
+  std::vector<BufferBarrierPrecursor> buffers;
+};
+
+/// The queue family a resource was last used on, and by which pass
+struct Owner {
+  uint32_t family;
+  size_t position;
+  /// Used in the run before this one
+  bool previousRun{};
+};
+
+struct LastUses {
+  std::unordered_map<ImageAlias, LastImageUse> images;
+  std::unordered_map<BufferAliasVariant, LastBufferUse> buffers;
+  /// Last use of any image in each shared memory block
+  std::unordered_map<size_t, LastImageUse> blocks;
+  std::unordered_map<ImageAlias, Owner> imageOwners;
+  std::unordered_map<BufferAliasVariant, Owner> bufferOwners;
+};
+
+/// An ownership transfer found while scheduling a run, with the release still to be placed after
+/// the pass that owned the resource
+struct Handoff {
+  OwnershipTransfer transfer;
+  std::variant<vk::ImageMemoryBarrier2, vk::BufferMemoryBarrier2> release;
+};
+
+struct RunSchedule {
+  std::vector<PassBarriers> passes;
+  std::vector<Handoff> handoffs;
+};
+
+/// Folds a pass's uses of the same image into one. A pass can only have an image in one layout,
+/// if its uses disagree the write's layout wins.
+auto mergeImagePrecursors(PassId passId, const std::vector<ImageBarrierPrecursor>& precursors)
+    -> std::vector<ImageBarrierPrecursor> {
+  auto merged = std::vector<ImageBarrierPrecursor>{};
+  for (const auto& precursor : precursors) {
+    auto it = std::ranges::find(merged, precursor.alias, &ImageBarrierPrecursor::alias);
+    if (it == merged.end()) {
+      merged.push_back(precursor);
+      continue;
+    }
+    if (it->layout != precursor.layout) {
+      Log.warn("{} uses {} as both {} and {}",
+               passId,
+               precursor.alias,
+               vk::to_string(it->layout),
+               vk::to_string(precursor.layout));
+      if (precursor.accessMode == AccessMode::Write) {
+        it->layout = precursor.layout;
+      }
+    }
+    if (precursor.accessMode == AccessMode::Write) {
+      it->accessMode = AccessMode::Write;
+    }
+    it->accessFlags |= precursor.accessFlags;
+    it->stageFlags |= precursor.stageFlags;
+    it->aspectFlags |= precursor.aspectFlags;
+  }
+  return merged;
+}
+
+auto mergeBufferPrecursors(const std::vector<BufferBarrierPrecursor>& precursors)
+    -> std::vector<BufferBarrierPrecursor> {
+  auto merged = std::vector<BufferBarrierPrecursor>{};
+  for (const auto& precursor : precursors) {
+    auto it = std::ranges::find(merged, precursor.alias, &BufferBarrierPrecursor::alias);
+    if (it == merged.end()) {
+      merged.push_back(precursor);
+      continue;
+    }
+    if (precursor.accessMode == AccessMode::Write) {
+      it->accessMode = AccessMode::Write;
+    }
+    it->accessFlags |= precursor.accessFlags;
+    it->stageFlags |= precursor.stageFlags;
+  }
+  return merged;
+}
+
+/// Builds each pass's barriers in order, carrying `lastUses` from pass to pass. Leaves `lastUses`
+/// as the run ends. A resource whose contents are kept as it moves to a pass on another queue
+/// family gets an acquire in place of its barrier, and a handoff for the release. Buffers in
+/// `sharedBuffers` are created shared between families, so never need one.
+auto schedulePasses(const std::vector<PassPrecursors>& passes,
+                    const std::unordered_map<ImageAlias, size_t>& sharedMemory,
+                    const std::vector<uint32_t>& passFamilies,
+                    const std::unordered_set<BufferAliasVariant>& sharedBuffers,
+                    LastUses& lastUses) -> RunSchedule {
+  auto run = RunSchedule{};
+  run.passes.reserve(passes.size());
+  auto usedThisRun = std::unordered_set<ImageAlias>{};
+
+  for (size_t position = 0; position < passes.size(); ++position) {
+    const auto& pass = passes[position];
+    const auto family = passFamilies.empty() ? 0 : passFamilies[position];
+    auto& barriers = run.passes.emplace_back(PassBarriers{.passId = pass.passId});
+
+    for (const auto& precursor : pass.images) {
+      auto lastUse = lastUses.images.contains(precursor.alias)
+                         ? std::make_optional<LastImageUse>(lastUses.images.at(precursor.alias))
+                         : std::nullopt;
+
+      // Another image may have used the memory since, what was there is gone
+      const auto block = sharedMemory.find(precursor.alias);
+      if (block != sharedMemory.end() && usedThisRun.insert(precursor.alias).second) {
+        lastUse = lastUses.blocks.contains(block->second)
+                      ? std::make_optional<LastImageUse>(lastUses.blocks.at(block->second))
+                      : std::nullopt;
+        if (lastUse) {
+          lastUse->layout = vk::ImageLayout::eUndefined;
+        }
+      }
+
+      // Contents that are thrown away don't need to change hands
+      const auto owner = lastUses.imageOwners.find(precursor.alias);
+      if (lastUse && lastUse->layout != vk::ImageLayout::eUndefined &&
+          owner != lastUses.imageOwners.end() && owner->second.family != family) {
+        const auto transfer =
+            BarrierBuilder::buildTransfer(precursor, *lastUse, owner->second.family, family);
+        barriers.imageBarriers.push_back(transfer.acquire);
+        barriers.imageAliases.push_back(precursor.alias);
+        run.handoffs.push_back(Handoff{
+            .transfer = OwnershipTransfer{.resource = precursor.alias,
+                                          .releasePosition = owner->second.position,
+                                          .acquirePosition = position,
+                                          .srcFamily = owner->second.family,
+                                          .dstFamily = family,
+                                          .fromPreviousRun = owner->second.previousRun,
+                                          .acquireStages = precursor.stageFlags},
+            .release = transfer.release});
+      } else if (const auto imageBarrier = BarrierBuilder::build(precursor, lastUse)) {
+        if (precursor.alias == ImageAlias::SwapchainImage) {
+          barriers.swapchainBarriers.push_back(barriers.imageBarriers.size());
+        }
+        barriers.imageBarriers.push_back(*imageBarrier);
+        barriers.imageAliases.push_back(precursor.alias);
+      }
+      const auto newLastUse = LastImageUse{
+          .accessMode = precursor.accessMode,
+          .access = precursor.accessFlags,
+          .stage = precursor.stageFlags,
+          .layout = precursor.layout,
+      };
+      lastUses.images.insert_or_assign(precursor.alias, newLastUse);
+      lastUses.imageOwners.insert_or_assign(precursor.alias,
+                                            Owner{.family = family, .position = position});
+      if (block != sharedMemory.end()) {
+        lastUses.blocks.insert_or_assign(block->second, newLastUse);
+      }
+    }
+
+    for (const auto& precursor : pass.buffers) {
+      const auto lastUse =
+          lastUses.buffers.contains(precursor.alias)
+              ? std::make_optional<LastBufferUse>(lastUses.buffers.at(precursor.alias))
+              : std::nullopt;
+
+      const auto owner = lastUses.bufferOwners.find(precursor.alias);
+      if (lastUse && owner != lastUses.bufferOwners.end() && owner->second.family != family &&
+          !sharedBuffers.contains(precursor.alias)) {
+        const auto transfer =
+            BarrierBuilder::buildTransfer(precursor, *lastUse, owner->second.family, family);
+        barriers.bufferBarriers.push_back(transfer.acquire);
+        barriers.bufferAliases.push_back(precursor.alias);
+        run.handoffs.push_back(Handoff{
+            .transfer = OwnershipTransfer{.resource = precursor.alias,
+                                          .releasePosition = owner->second.position,
+                                          .acquirePosition = position,
+                                          .srcFamily = owner->second.family,
+                                          .dstFamily = family,
+                                          .fromPreviousRun = owner->second.previousRun,
+                                          .acquireStages = precursor.stageFlags},
+            .release = transfer.release});
+      } else if (const auto bufferBarrier = BarrierBuilder::build(precursor, lastUse)) {
+        barriers.bufferBarriers.push_back(*bufferBarrier);
+        barriers.bufferAliases.push_back(precursor.alias);
+      }
+      lastUses.buffers.insert_or_assign(precursor.alias,
+                                        LastBufferUse{
+                                            .passId = pass.passId,
+                                            .accessMask = precursor.accessFlags,
+                                            .stageMask = precursor.stageFlags,
+                                        });
+      lastUses.bufferOwners.insert_or_assign(precursor.alias,
+                                             Owner{.family = family, .position = position});
+    }
+  }
+
+  return run;
+}
+
+/// Where the next run starts, everything as this one left it apart from the swapchain image
+auto carryOver(LastUses& lastUses) -> void {
+  lastUses.images.erase(ImageAlias::SwapchainImage);
+  lastUses.imageOwners.erase(ImageAlias::SwapchainImage);
+  for (auto& owner : std::views::values(lastUses.imageOwners)) {
+    owner.previousRun = true;
+  }
+  for (auto& owner : std::views::values(lastUses.bufferOwners)) {
+    owner.previousRun = true;
+  }
+}
+
+/// The part of `lastUses` every frame shares. Global buffers are the same buffer whichever frame
+/// runs, so their history carries across frames, everything else is the frame's own.
+auto globalUses(const LastUses& lastUses) -> LastUses {
+  auto global = LastUses{};
+  for (const auto& [alias, lastUse] : lastUses.buffers) {
+    if (std::holds_alternative<GlobalBufferAlias>(alias)) {
+      global.buffers.emplace(alias, lastUse);
+      global.bufferOwners.emplace(alias, lastUses.bufferOwners.at(alias));
+    }
+  }
+  return global;
+}
+
+/// Records each release after the pass that owned the resource
+auto placeReleases(const std::vector<Handoff>& handoffs, std::vector<PassBarriers>& run) -> void {
+  for (const auto& handoff : handoffs) {
+    auto& barriers = run[handoff.transfer.releasePosition];
+    if (const auto* alias = std::get_if<ImageAlias>(&handoff.transfer.resource)) {
+      barriers.releaseImageBarriers.push_back(std::get<vk::ImageMemoryBarrier2>(handoff.release));
+      barriers.releaseImageAliases.push_back(*alias);
+    } else {
+      barriers.releaseBufferBarriers.push_back(
+          std::get<vk::BufferMemoryBarrier2>(handoff.release));
+      barriers.releaseBufferAliases.push_back(
+          std::get<BufferAliasVariant>(handoff.transfer.resource));
+    }
+  }
+}
+
+}
+
+auto BarrierScheduleCompiler::compile(const std::vector<std::unique_ptr<IRenderPass>>& passes)
+    -> BarrierSchedule {
+  auto passOrder = std::vector<size_t>(passes.size());
+  for (size_t i = 0; i < passOrder.size(); ++i) {
+    passOrder[i] = i;
+  }
+  return compile(passes, passOrder);
+}
+
+auto BarrierScheduleCompiler::compile(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                                      const std::vector<size_t>& passOrder,
+                                      const std::unordered_map<ImageAlias, size_t>& sharedMemory,
+                                      const std::vector<uint32_t>& passFamilies,
+                                      const std::unordered_set<BufferAliasVariant>& sharedBuffers,
+                                      const std::unordered_set<ImageAlias>& disabledImages)
+    -> BarrierSchedule {
+  auto barrierPrecursorGenerator = BarrierPrecursorGenerator{};
+  const auto plan = barrierPrecursorGenerator.build(passes, disabledImages);
+
+  auto precursors = std::vector<PassPrecursors>{};
+  precursors.reserve(passOrder.size());
+  for (const auto index : passOrder) {
+    const auto passId = passes[index]->getId();
+    auto& passPrecursors = precursors.emplace_back(PassPrecursors{.passId = passId});
+    if (const auto it = plan.imagePrecursors.find(passId); it != plan.imagePrecursors.end()) {
+      passPrecursors.images = mergeImagePrecursors(passId, it->second);
+    }
+    if (const auto it = plan.bufferPrecursors.find(passId); it != plan.bufferPrecursors.end()) {
+      passPrecursors.buffers = mergeBufferPrecursors(it->second);
+    }
+  }
+
+  auto lastUses = LastUses{};
+  auto firstRun = schedulePasses(precursors, sharedMemory, passFamilies, sharedBuffers, lastUses);
+
+  // Every run ends the same way, so whichever frame ran last the next one starts from here
+  carryOver(lastUses);
+  auto frameUses = globalUses(lastUses);
+  auto frameFirstRun =
+      schedulePasses(precursors, sharedMemory, passFamilies, sharedBuffers, frameUses);
+  auto steadyState =
+      schedulePasses(precursors, sharedMemory, passFamilies, sharedBuffers, lastUses);
+
+  auto schedule = BarrierSchedule{};
+  std::ranges::transform(steadyState.handoffs,
+                         std::back_inserter(schedule.transfers),
+                         &Handoff::transfer);
+
+  // A release for the next run's acquire goes in every run, since any of them can come before
+  // one that acquires. Those are the steady state's handoffs from the previous run, the rest are
+  // released within the run that acquires them.
+  const auto fromPreviousRun = [](const Handoff& h) { return h.transfer.fromPreviousRun; };
+  auto crossRun = std::vector<Handoff>{};
+  std::ranges::copy_if(steadyState.handoffs, std::back_inserter(crossRun), fromPreviousRun);
+  for (auto* run : {&firstRun, &frameFirstRun, &steadyState}) {
+    std::erase_if(run->handoffs, fromPreviousRun);
+    placeReleases(run->handoffs, run->passes);
+    placeReleases(crossRun, run->passes);
+  }
+
+  schedule.firstRun = std::move(firstRun.passes);
+  schedule.frameFirstRun = std::move(frameFirstRun.passes);
+  schedule.steadyState = std::move(steadyState.passes);
+  return schedule;
+}
+
+}
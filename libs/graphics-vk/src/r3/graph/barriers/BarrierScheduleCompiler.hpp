@@ -0,0 +1,41 @@
+#pragma once
+
+#include "r3/graph/barriers/BarrierSchedule.hpp"
+#include "r3/render-pass/IRenderPass.hpp"
+
+namespace tr {
+
+/// Works out every barrier the passes need from their graph info, once, so running the graph
+/// only has to fill in images and buffers. Uses of a resource within one pass are merged, so each
+/// resource gets at most one barrier per pass.
+class BarrierScheduleCompiler {
+public:
+  BarrierScheduleCompiler(const BarrierScheduleCompiler&) = default;
+  BarrierScheduleCompiler(BarrierScheduleCompiler&&) = delete;
+  auto operator=(const BarrierScheduleCompiler&) -> BarrierScheduleCompiler& = default;
+  auto operator=(BarrierScheduleCompiler&&) -> BarrierScheduleCompiler& = delete;
+
+  static auto compile(const std::vector<std::unique_ptr<IRenderPass>>& passes) -> BarrierSchedule;
+  /// Schedules only the passes in `passOrder`, indices into `passes`, in that order. Images in
+  /// `sharedMemory` share a memory block with the others mapped to the same block, so each run's
+  /// first use of one starts from undefined and waits on the block's last use.
+  /// `passFamilies` is the queue family each pass in `passOrder` runs on. Empty means they all
+  /// run on one, otherwise a resource moving between families is released and acquired once per
+  /// move, and listed in the schedule's transfers. That includes buffers that are only read, as
+  /// an exclusive buffer has to be owned by whichever family reads it. Buffers in `sharedBuffers`
+  /// are created shared between the families instead, so are left out. Reads of images in
+  /// `disabledImages` get no barriers, as FrameGraphCompiler left them out of the order too.
+  static auto compile(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                      const std::vector<size_t>& passOrder,
+                      const std::unordered_map<ImageAlias, size_t>& sharedMemory = {},
+                      const std::vector<uint32_t>& passFamilies = {},
+                      const std::unordered_set<BufferAliasVariant>& sharedBuffers = {},
+                      const std::unordered_set<ImageAlias>& disabledImages = {})
+      -> BarrierSchedule;
+
+private:
+  BarrierScheduleCompiler() = default;
+  ~BarrierScheduleCompiler() = default;
+};
+
+}
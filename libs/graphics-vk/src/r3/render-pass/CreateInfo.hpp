@@ -2,6 +2,7 @@
 
 #include "bk/Handle.hpp"
 #include "r3/ComponentIds.hpp"
+#include "r3/CullCompaction.hpp"
 #include "r3/graph/ImageAlias.hpp"
 #include "r3/graph/ResourceAliases.hpp"
 
@@ -14,6 +15,7 @@ enum class RenderPassType : uint8_t {
   Forward = 0,
   Composition,
   Culling,
+  DepthPyramid,
   ImGui,
   Count
 };
@@ -26,6 +28,8 @@ struct ForwardPassCreateInfo {
   ImageAlias colorImage;
   ImageAlias depthImage;
   std::vector<Handle<DSLayout>> dsLayoutHandles;
+  /// eLoad draws over what an earlier pass left in the attachments
+  vk::AttachmentLoadOp loadOp{vk::AttachmentLoadOp::eClear};
 };
 
 struct CullingPassCreateInfo {
@@ -33,6 +37,12 @@ struct CullingPassCreateInfo {
   BufferAlias geometryRegionBuffer;
   BufferAlias indirectCommandBuffer;
   BufferAlias indirectCommandCountBuffer;
+  CullPhase phase{CullPhase::Early};
+};
+
+struct DepthPyramidPassCreateInfo {
+  ImageAlias depthImage;
+  GlobalBufferAlias depthPyramid;
 };
 
 struct CompositionPassCreateInfo {
@@ -44,6 +54,7 @@ struct CompositionPassCreateInfo {
 
 using PassInfo = std::variant<ForwardPassCreateInfo,
                               CullingPassCreateInfo,
+                              DepthPyramidPassCreateInfo,
                               CompositionPassCreateInfo,
                               ImGuiPassCreateInfo>;
 
@@ -3,6 +3,7 @@
 #include "bk/Handle.hpp"
 #include "r3/ComponentIds.hpp"
 #include "r3/graph/IGraphInfoProvider.hpp"
+#include "vk/command-buffer/QueueType.hpp"
 
 namespace tr {
 
@@ -22,6 +23,12 @@ public:
   [[nodiscard]] virtual auto getId() const -> PassId = 0;
   virtual auto execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void = 0;
   virtual auto registerDispatchContext(Handle<IDispatchContext> handle) -> void = 0;
+
+  /// The queue the pass would like to run on. The frame graph falls back to the graphics queue
+  /// when there's no separate queue of this type.
+  [[nodiscard]] virtual auto getQueueType() const -> QueueType {
+    return QueueType::Graphics;
+  }
 };
 
 }
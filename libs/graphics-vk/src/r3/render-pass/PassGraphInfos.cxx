@@ -0,0 +1,338 @@
+#include "PassGraphInfos.hpp"
+
+namespace tr {
+
+auto mergeGraphInfo(PassGraphInfo& into, const PassGraphInfo& from) -> void {
+  into.bufferReads.insert(from.bufferReads.begin(), from.bufferReads.end());
+  into.bufferWrites.insert(from.bufferWrites.begin(), from.bufferWrites.end());
+  into.imageReads.insert(from.imageReads.begin(), from.imageReads.end());
+  into.imageWrites.insert(from.imageWrites.begin(), from.imageWrites.end());
+}
+
+auto cullingGraphInfo(CullPhase phase) -> PassGraphInfo {
+  const auto late = phase == CullPhase::Late;
+  auto passGraphInfo = PassGraphInfo{
+      .bufferWrites =
+          {
+              BufferUsageInfo{
+                  .alias = late ? BufferAlias::LateIndirectCommand : BufferAlias::IndirectCommand,
+                  .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                  .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+              },
+              BufferUsageInfo{
+                  .alias = late ? BufferAlias::LateIndirectCommandCount
+                                : BufferAlias::IndirectCommandCount,
+                  .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                  .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+              },
+              BufferUsageInfo{
+                  .alias = BufferAlias::VisibleObjects,
+                  .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                  .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+              },
+          },
+      .bufferReads = {BufferUsageInfo{
+                          .alias = BufferAlias::FrameData,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::ResourceTable,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::DrawBatches,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::DrawInstances,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::ObjectData,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::ObjectPositions,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::ObjectRotations,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::ObjectScales,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = BufferAlias::GeometryRegion,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::Index,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::Position,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::Normal,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::TexCoord,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::Color,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      },
+                      BufferUsageInfo{
+                          .alias = GlobalBufferAlias::ObjectVisibility,
+                          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                      }},
+  };
+
+  // Only the late phase tests against the pyramid, and it records what it found visible for the
+  // next frame's early phase
+  if (late) {
+    passGraphInfo.bufferReads.insert(BufferUsageInfo{
+        .alias = GlobalBufferAlias::DepthPyramid,
+        .accessFlags = vk::AccessFlagBits2::eShaderRead,
+        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+    });
+    passGraphInfo.bufferWrites.insert(BufferUsageInfo{
+        .alias = GlobalBufferAlias::ObjectVisibility,
+        .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+    });
+  }
+  return passGraphInfo;
+}
+
+auto forwardDrawGraphInfo(CullPhase phase) -> PassGraphInfo {
+  auto pgInfo = PassGraphInfo{};
+
+  pgInfo.imageWrites = {
+      ImageUsageInfo{
+          .alias = ImageAlias::GeometryColorImage,
+          .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+          .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+          .aspectFlags = vk::ImageAspectFlagBits::eColor,
+          .layout = vk::ImageLayout::eColorAttachmentOptimal,
+          .clearValue = {vk::ClearColorValue{std::array<float, 4>{0.392f, 0.584f, 0.929f, 1.0f}}},
+      },
+      ImageUsageInfo{.alias = ImageAlias::DepthImage,
+                     .accessFlags = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                     .stageFlags = vk::PipelineStageFlagBits2::eEarlyFragmentTests |
+                                   vk::PipelineStageFlagBits2::eLateFragmentTests,
+                     .aspectFlags = vk::ImageAspectFlagBits::eDepth,
+                     .layout = vk::ImageLayout::eDepthAttachmentOptimal,
+                     .clearValue = vk::ClearValue{
+                         .depthStencil = vk::ClearDepthStencilValue{.depth = 1.0f, .stencil = 0}}}};
+
+  const auto late = phase == CullPhase::Late;
+  pgInfo.bufferReads = {BufferUsageInfo{
+                            .alias = late ? BufferAlias::LateIndirectCommand
+                                          : BufferAlias::IndirectCommand,
+                            .accessFlags = vk::AccessFlagBits2::eIndirectCommandRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eDrawIndirect,
+                        },
+                        BufferUsageInfo{
+                            .alias = late ? BufferAlias::LateIndirectCommandCount
+                                          : BufferAlias::IndirectCommandCount,
+                            .accessFlags = vk::AccessFlagBits2::eIndirectCommandRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eDrawIndirect,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::FrameData,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::ResourceTable,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader |
+                                          vk::PipelineStageFlagBits2::eFragmentShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::VisibleObjects,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::ObjectData,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::ObjectPositions,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::ObjectRotations,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::ObjectScales,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = BufferAlias::GeometryRegion,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = GlobalBufferAlias::Index,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = GlobalBufferAlias::Position,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = GlobalBufferAlias::Normal,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = GlobalBufferAlias::TexCoord,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        },
+                        BufferUsageInfo{
+                            .alias = GlobalBufferAlias::Color,
+                            .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                            .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+                        }};
+  return pgInfo;
+}
+
+auto imGuiDrawGraphInfo() -> PassGraphInfo {
+  auto passGraphInfo = PassGraphInfo{};
+
+  passGraphInfo.imageWrites = {ImageUsageInfo{
+      .alias = ImageAlias::GuiColorImage,
+      .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+      .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+      .aspectFlags = vk::ImageAspectFlagBits::eColor,
+      .layout = vk::ImageLayout::eColorAttachmentOptimal,
+      .clearValue = {vk::ClearColorValue{std::array<float, 4>{0.392f, 0.584f, 0.929f, 1.0f}}},
+  }};
+
+  return passGraphInfo;
+}
+
+auto compositionGraphInfo() -> PassGraphInfo {
+  auto graphInfo = PassGraphInfo{};
+
+  graphInfo.imageReads = {ImageUsageInfo{.alias = ImageAlias::GeometryColorImage,
+                                         .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
+                                         .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
+                                         .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                                         .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                                         .clearValue = {}},
+                          ImageUsageInfo{.alias = ImageAlias::GuiColorImage,
+                                         .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
+                                         .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
+                                         .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                                         .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                                         .clearValue = {}}};
+
+  graphInfo.imageWrites = {ImageUsageInfo{
+      .alias = ImageAlias::SwapchainImage,
+      .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+      .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+      .aspectFlags = vk::ImageAspectFlagBits::eColor,
+      .layout = vk::ImageLayout::eColorAttachmentOptimal,
+      .clearValue = {vk::ClearColorValue{std::array<float, 4>{0.392f, 0.584f, 0.929f, 1.0f}}},
+  }};
+
+  return graphInfo;
+}
+
+auto depthPyramidGraphInfo(ImageAlias depthImage, GlobalBufferAlias depthPyramid) -> PassGraphInfo {
+  return PassGraphInfo{
+      .imageReads = {{
+          .alias = depthImage,
+          .accessFlags = vk::AccessFlagBits2::eTransferRead,
+          .stageFlags = vk::PipelineStageFlagBits2::eCopy,
+          .aspectFlags = vk::ImageAspectFlagBits::eDepth,
+          .layout = vk::ImageLayout::eTransferSrcOptimal,
+      }},
+      .bufferWrites = {{
+          .alias = depthPyramid,
+          .accessFlags = vk::AccessFlagBits2::eTransferWrite | vk::AccessFlagBits2::eShaderRead |
+                         vk::AccessFlagBits2::eShaderWrite,
+          .stageFlags = vk::PipelineStageFlagBits2::eCopy |
+                        vk::PipelineStageFlagBits2::eComputeShader,
+      }},
+  };
+}
+
+auto presentGraphInfo() -> PassGraphInfo {
+  return PassGraphInfo{.imageReads = {{
+                           .alias = ImageAlias::SwapchainImage,
+                           .accessFlags = vk::AccessFlagBits2::eNone,
+                           .stageFlags = vk::PipelineStageFlagBits2::eBottomOfPipe,
+                           .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                           .layout = vk::ImageLayout::ePresentSrcKHR,
+                       }}};
+}
+
+auto forwardLoadGraphInfo(ImageAlias colorImage, ImageAlias depthImage) -> PassGraphInfo {
+  return PassGraphInfo{
+      .imageReads = {
+          ImageUsageInfo{
+              .alias = colorImage,
+              .accessFlags = vk::AccessFlagBits2::eColorAttachmentRead,
+              .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+              .aspectFlags = vk::ImageAspectFlagBits::eColor,
+              .layout = vk::ImageLayout::eColorAttachmentOptimal,
+          },
+          ImageUsageInfo{
+              .alias = depthImage,
+              .accessFlags = vk::AccessFlagBits2::eDepthStencilAttachmentRead,
+              .stageFlags = vk::PipelineStageFlagBits2::eEarlyFragmentTests |
+                            vk::PipelineStageFlagBits2::eLateFragmentTests,
+              .aspectFlags = vk::ImageAspectFlagBits::eDepth,
+              .layout = vk::ImageLayout::eDepthAttachmentOptimal,
+          },
+      }};
+}
+
+auto imGuiTargetGraphInfo(ImageAlias colorImage) -> PassGraphInfo {
+  return PassGraphInfo{
+      .imageWrites = {
+          ImageUsageInfo{
+              .alias = colorImage,
+              .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+              .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+              .aspectFlags = vk::ImageAspectFlagBits::eColor,
+              .layout = vk::ImageLayout::eColorAttachmentOptimal,
+              .clearValue = vk::ClearValue{.color = {std::array<float, 4>{0.f, 0.f, 0.f, 1.f}}},
+          },
+      }};
+}
+
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "r3/CullCompaction.hpp"
+#include "r3/graph/PassGraphInfo.hpp"
+#include "r3/graph/ResourceAliases.hpp"
+
+namespace tr {
+
+/// What each of the renderer's passes and dispatch contexts reads and writes. Kept apart from the
+/// passes themselves, which need a device to create, so the frame graph can be compiled without
+/// one.
+
+/// Adds everything `from` uses to `into`, how a pass takes in its contexts' infos
+auto mergeGraphInfo(PassGraphInfo& into, const PassGraphInfo& from) -> void;
+
+auto cullingGraphInfo(CullPhase phase) -> PassGraphInfo;
+auto forwardDrawGraphInfo(CullPhase phase) -> PassGraphInfo;
+/// The reads of a forward pass that loads its attachments rather than clearing them
+auto forwardLoadGraphInfo(ImageAlias colorImage, ImageAlias depthImage) -> PassGraphInfo;
+auto depthPyramidGraphInfo(ImageAlias depthImage, GlobalBufferAlias depthPyramid) -> PassGraphInfo;
+/// The ImGui pass's own clear of its target, its context does the drawing
+auto imGuiTargetGraphInfo(ImageAlias colorImage) -> PassGraphInfo;
+auto imGuiDrawGraphInfo() -> PassGraphInfo;
+auto compositionGraphInfo() -> PassGraphInfo;
+auto presentGraphInfo() -> PassGraphInfo;
+
+}
@@ -4,6 +4,7 @@
 #include "r3/render-pass//passes/CullingPass.hpp"
 #include "r3/render-pass/PipelineFactory.hpp"
 #include "r3/render-pass/passes/CompositionPass.hpp"
+#include "r3/render-pass/passes/DepthPyramidPass.hpp"
 #include "r3/render-pass/passes/ForwardGraphicsPass.hpp"
 #include "r3/render-pass/passes/ImGuiPass.hpp"
 
@@ -11,6 +12,7 @@ namespace tr {
 
 RenderPassFactory::RenderPassFactory(std::shared_ptr<PipelineFactory> newPipelineFactory,
                                      std::shared_ptr<ImageManager> newImageManager,
+                                     std::shared_ptr<BufferSystem> newBufferSystem,
                                      std::shared_ptr<IFrameManager> newFrameManager,
                                      std::shared_ptr<ContextFactory> newDrawContextFactory,
                                      std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
@@ -23,6 +25,7 @@ RenderPassFactory::RenderPassFactory(std::shared_ptr<PipelineFactory> newPipelin
                                      std::shared_ptr<queue::Graphics> newGraphicsQueue)
     : pipelineFactory{std::move(newPipelineFactory)},
       imageManager{std::move(newImageManager)},
+      bufferSystem{std::move(newBufferSystem)},
       frameManager{std::move(newFrameManager)},
       drawContextFactory{std::move(newDrawContextFactory)},
       aliasRegistry{std::move(newAliasRegistry)},
@@ -47,6 +50,9 @@ auto RenderPassFactory::createRenderPass(RenderPassCreateInfo createInfo)
     if constexpr (std::is_same_v<T, CullingPassCreateInfo>) {
       return createCullingPass(createInfo.passId, arg);
     }
+    if constexpr (std::is_same_v<T, DepthPyramidPassCreateInfo>) {
+      return createDepthPyramidPass(createInfo.passId, arg);
+    }
     if constexpr (std::is_same_v<T, CompositionPassCreateInfo>) {
       return createCompositionPass(createInfo.passId, arg);
     }
@@ -85,10 +91,23 @@ auto RenderPassFactory::createForwardPass(PassId passId, const ForwardPassCreate
                                                passId);
 }
 
-auto RenderPassFactory::createCullingPass(PassId passId,
-                                          [[maybe_unused]] CullingPassCreateInfo createInfo)
+auto RenderPassFactory::createCullingPass(PassId passId, CullingPassCreateInfo createInfo)
+    -> std::unique_ptr<IRenderPass> {
+  return std::make_unique<CullingPass>(drawContextFactory,
+                                       pipelineFactory,
+                                       passId,
+                                       createInfo.phase);
+}
+
+auto RenderPassFactory::createDepthPyramidPass(PassId passId,
+                                               const DepthPyramidPassCreateInfo& createInfo)
     -> std::unique_ptr<IRenderPass> {
-  return std::make_unique<CullingPass>(drawContextFactory, pipelineFactory, passId);
+  return std::make_unique<DepthPyramidPass>(imageManager,
+                                            bufferSystem,
+                                            aliasRegistry,
+                                            pipelineFactory,
+                                            createInfo,
+                                            passId);
 }
 
 auto RenderPassFactory::createCompositionPass(PassId passId, CompositionPassCreateInfo createInfo)
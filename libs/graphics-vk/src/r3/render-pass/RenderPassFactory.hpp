@@ -10,6 +10,7 @@ class GraphicsPass;
 class ComputePass;
 class PipelineFactory;
 class ImageManager;
+class BufferSystem;
 class IFrameManager;
 class ManagedImage;
 class ContextFactory;
@@ -29,6 +30,7 @@ class RenderPassFactory {
 public:
   RenderPassFactory(std::shared_ptr<PipelineFactory> newPipelineFactory,
                     std::shared_ptr<ImageManager> newImageManager,
+                    std::shared_ptr<BufferSystem> newBufferSystem,
                     std::shared_ptr<IFrameManager> newFrameManager,
                     std::shared_ptr<ContextFactory> newDrawContextFactory,
                     std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
@@ -51,6 +53,7 @@ public:
 private:
   std::shared_ptr<PipelineFactory> pipelineFactory;
   std::shared_ptr<ImageManager> imageManager;
+  std::shared_ptr<BufferSystem> bufferSystem;
   std::shared_ptr<IFrameManager> frameManager;
   std::shared_ptr<ContextFactory> drawContextFactory;
   std::shared_ptr<ResourceAliasRegistry> aliasRegistry;
@@ -68,6 +71,8 @@ private:
       -> std::unique_ptr<IRenderPass>;
   auto createCullingPass(PassId passId, CullingPassCreateInfo createInfo)
       -> std::unique_ptr<IRenderPass>;
+  auto createDepthPyramidPass(PassId passId, const DepthPyramidPassCreateInfo& createInfo)
+      -> std::unique_ptr<IRenderPass>;
   auto createCompositionPass(PassId passId, CompositionPassCreateInfo createInfo)
       -> std::unique_ptr<IRenderPass>;
   auto createImGuiPass(PassId passId, ImGuiPassCreateInfo createInfo)
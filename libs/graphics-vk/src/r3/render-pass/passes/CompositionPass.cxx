@@ -4,6 +4,7 @@
 #include "r3/draw-context/ContextFactory.hpp"
 #include "r3/draw-context/IDispatchContext.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "r3/render-pass/PipelineCreateInfo.hpp"
 #include "r3/render-pass/PipelineFactory.hpp"
 #include "task/Frame.hpp"
@@ -113,16 +114,9 @@ auto CompositionPass::registerDispatchContext(Handle<IDispatchContext> handle) -
 
 [[nodiscard]] auto CompositionPass::getGraphInfo() const -> PassGraphInfo {
   auto graphInfo = PassGraphInfo{};
-
   for (const auto& handle : drawableContexts) {
-    const auto& dispatchContext = drawContextFactory->getDispatchContext(handle);
-    const auto contextInfo = dispatchContext->getGraphInfo();
-    graphInfo.bufferReads.insert(contextInfo.bufferReads.begin(), contextInfo.bufferReads.end());
-    graphInfo.bufferWrites.insert(contextInfo.bufferWrites.begin(), contextInfo.bufferWrites.end());
-    graphInfo.imageReads.insert(contextInfo.imageReads.begin(), contextInfo.imageReads.end());
-    graphInfo.imageWrites.insert(contextInfo.imageWrites.begin(), contextInfo.imageWrites.end());
+    mergeGraphInfo(graphInfo, drawContextFactory->getDispatchContext(handle)->getGraphInfo());
   }
-
   return graphInfo;
 }
 
@@ -2,16 +2,19 @@
 #include "bk/DebugPaths.hpp"
 #include "r3/draw-context/ContextFactory.hpp"
 #include "r3/draw-context/IDispatchContext.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "r3/render-pass/PipelineFactory.hpp"
 
 namespace tr {
 
 CullingPass::CullingPass(std::shared_ptr<ContextFactory> newContextFactory,
                          std::shared_ptr<PipelineFactory> newPipelineFactory,
-                         PassId newPassId)
+                         PassId newPassId,
+                         CullPhase newPhase)
     : contextFactory{std::move(newContextFactory)},
       pipelineFactory{std::move(newPipelineFactory)},
-      id{newPassId} {
+      id{newPassId},
+      phase{newPhase} {
 
   const auto pipelineLayoutInfo =
       PipelineLayoutInfo{.pushConstantInfoList = {PushConstantInfo{
@@ -54,20 +57,17 @@ auto CullingPass::registerDispatchContext(Handle<IDispatchContext> handle) -> vo
 
 auto CullingPass::getGraphInfo() const -> PassGraphInfo {
   auto passGraphInfo = PassGraphInfo{};
-
   for (const auto& handle : dispatchableContexts) {
-    const auto& dispatchContext = contextFactory->getDispatchContext(handle);
-    const auto contextInfo = dispatchContext->getGraphInfo();
-    passGraphInfo.bufferReads.insert(contextInfo.bufferReads.begin(),
-                                     contextInfo.bufferReads.end());
-    passGraphInfo.bufferWrites.insert(contextInfo.bufferWrites.begin(),
-                                      contextInfo.bufferWrites.end());
-    passGraphInfo.imageReads.insert(contextInfo.imageReads.begin(), contextInfo.imageReads.end());
-    passGraphInfo.imageWrites.insert(contextInfo.imageWrites.begin(),
-                                     contextInfo.imageWrites.end());
+    mergeGraphInfo(passGraphInfo, contextFactory->getDispatchContext(handle)->getGraphInfo());
   }
-
   return passGraphInfo;
 }
 
+/// Only dispatches, so the early phase can overlap the previous frame's graphics work on a compute
+/// queue. The late phase waits on this frame's draws and is waited on by the next, so there's
+/// nothing for it to overlap and it stays with them.
+auto CullingPass::getQueueType() const -> QueueType {
+  return phase == CullPhase::Early ? QueueType::Compute : QueueType::Graphics;
+}
+
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "r3/CullCompaction.hpp"
 #include "r3/render-pass/IRenderPass.hpp"
 
 namespace tr {
@@ -11,7 +12,8 @@ class CullingPass : public IRenderPass {
 public:
   explicit CullingPass(std::shared_ptr<ContextFactory> newContextFactory,
                        std::shared_ptr<PipelineFactory> newPipelineFactory,
-                       PassId newPassId);
+                       PassId newPassId,
+                       CullPhase newPhase);
   ~CullingPass() override = default;
 
   CullingPass(const CullingPass&) = delete;
@@ -23,12 +25,14 @@ public:
   auto execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void override;
   auto registerDispatchContext(Handle<IDispatchContext> handle) -> void override;
   [[nodiscard]] auto getGraphInfo() const -> PassGraphInfo override;
+  [[nodiscard]] auto getQueueType() const -> QueueType override;
 
 private:
   std::shared_ptr<ContextFactory> contextFactory;
   std::shared_ptr<PipelineFactory> pipelineFactory;
 
   PassId id;
+  CullPhase phase;
   std::vector<Handle<IDispatchContext>> dispatchableContexts;
 
   std::optional<vk::raii::Pipeline> pipeline;
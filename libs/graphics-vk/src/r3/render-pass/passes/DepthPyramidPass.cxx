@@ -0,0 +1,135 @@
+#include "DepthPyramidPass.hpp"
+#include "bk/DebugPaths.hpp"
+#include "buffers/BufferSystem.hpp"
+#include "img/ImageManager.hpp"
+#include "r3/HzbCulling.hpp"
+#include "r3/graph/PassGraphInfo.hpp"
+#include "r3/graph/ResourceAliasRegistry.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
+#include "r3/render-pass/PipelineCreateInfo.hpp"
+#include "r3/render-pass/PipelineFactory.hpp"
+#include "task/Frame.hpp"
+
+namespace tr {
+
+/// Texels per side of one depth_pyramid.comp workgroup
+constexpr uint32_t PyramidWorkgroupSize = 8;
+
+DepthPyramidPass::DepthPyramidPass(std::shared_ptr<ImageManager> newImageManager,
+                                   std::shared_ptr<BufferSystem> newBufferSystem,
+                                   std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
+                                   std::shared_ptr<PipelineFactory> newPipelineFactory,
+                                   const DepthPyramidPassCreateInfo& createInfo,
+                                   PassId newPassId)
+    : imageManager{std::move(newImageManager)},
+      bufferSystem{std::move(newBufferSystem)},
+      aliasRegistry{std::move(newAliasRegistry)},
+      pipelineFactory{std::move(newPipelineFactory)},
+      depthAlias{createInfo.depthImage},
+      pyramidAlias{createInfo.depthPyramid},
+      id{newPassId} {
+  Log.trace("Creating DepthPyramidPass");
+
+  const auto depthExtent =
+      imageManager->getImageMetadata(aliasRegistry->getHandle(depthAlias)).extent;
+  extent = glm::uvec2{depthExtent.width, depthExtent.height};
+  mipCount = hzbMipCount(extent);
+
+  const auto pipelineLayoutInfo =
+      PipelineLayoutInfo{.pushConstantInfoList = {PushConstantInfo{
+                             .stageFlags = vk::ShaderStageFlagBits::eCompute,
+                             .offset = 0,
+                             .size = sizeof(PushConstants),
+                         }}};
+
+  const auto shaderStageInfo =
+      ShaderStageInfo{.stage = vk::ShaderStageFlagBits::eCompute,
+                      .shaderFile = (getShaderRootPath() / "depth_pyramid.comp.spv").string(),
+                      .entryPoint = "main"};
+
+  const auto pipelineCreateInfo = PipelineCreateInfo{.id = id,
+                                                     .pipelineType = PipelineType::Compute,
+                                                     .pipelineLayoutInfo = pipelineLayoutInfo,
+                                                     .shaderStageInfo = {shaderStageInfo}};
+
+  std::tie(this->pipelineLayout, this->pipeline) =
+      pipelineFactory->createPipeline(pipelineCreateInfo);
+}
+
+auto DepthPyramidPass::getId() const -> PassId {
+  return id;
+}
+
+auto DepthPyramidPass::execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void {
+  const auto pyramidHandle = aliasRegistry->getHandle(pyramidAlias);
+  const auto pyramidBuffer = bufferSystem->getVkBuffer(pyramidHandle);
+  const auto pyramidAddress = bufferSystem->getBufferAddress(pyramidHandle);
+  if (!pyramidBuffer || !pyramidAddress) {
+    Log.warn("DepthPyramidPass could not find the depth pyramid buffer");
+    return;
+  }
+
+  // Mip 0 is the depth image as is, the frame graph has already moved it to transfer src
+  const auto& depthImage =
+      imageManager->getImage(frame->getLogicalImage(aliasRegistry->getHandle(depthAlias)));
+  const auto copyRegion = vk::BufferImageCopy{
+      .bufferOffset = 0,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = vk::ImageSubresourceLayers{.aspectMask = vk::ImageAspectFlagBits::eDepth,
+                                                     .mipLevel = 0,
+                                                     .baseArrayLayer = 0,
+                                                     .layerCount = 1},
+      .imageExtent = vk::Extent3D{.width = extent.x, .height = extent.y, .depth = 1},
+  };
+  cmdBuffer.copyImageToBuffer(depthImage.getImage(),
+                              vk::ImageLayout::eTransferSrcOptimal,
+                              **pyramidBuffer,
+                              copyRegion);
+
+  // Each mip reads the one before it
+  const auto waitForWrites = [&](vk::PipelineStageFlags2 stage, vk::AccessFlags2 access) {
+    const auto barrier = vk::BufferMemoryBarrier2{
+        .srcStageMask = stage,
+        .srcAccessMask = access,
+        .dstStageMask = vk::PipelineStageFlagBits2::eComputeShader,
+        .dstAccessMask = vk::AccessFlagBits2::eShaderRead,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = **pyramidBuffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE,
+    };
+    cmdBuffer.pipelineBarrier2(
+        vk::DependencyInfo{.bufferMemoryBarrierCount = 1, .pBufferMemoryBarriers = &barrier});
+  };
+  waitForWrites(vk::PipelineStageFlagBits2::eCopy, vk::AccessFlagBits2::eTransferWrite);
+
+  cmdBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline);
+  for (uint32_t level = 1; level < mipCount; ++level) {
+    if (level > 1) {
+      waitForWrites(vk::PipelineStageFlagBits2::eComputeShader, vk::AccessFlagBits2::eShaderWrite);
+    }
+    const auto pushConstants =
+        PushConstants{.pyramidAddress = *pyramidAddress, .extent = extent, .level = level};
+    cmdBuffer.pushConstants<PushConstants>(*pipelineLayout,
+                                           vk::ShaderStageFlagBits::eCompute,
+                                           0,
+                                           pushConstants);
+    const auto size = hzbMipExtent(extent, level);
+    cmdBuffer.dispatch((size.x + PyramidWorkgroupSize - 1) / PyramidWorkgroupSize,
+                       (size.y + PyramidWorkgroupSize - 1) / PyramidWorkgroupSize,
+                       1);
+  }
+}
+
+auto DepthPyramidPass::registerDispatchContext([[maybe_unused]] Handle<IDispatchContext> handle)
+    -> void {
+  // NOOP
+}
+
+auto DepthPyramidPass::getGraphInfo() const -> PassGraphInfo {
+  return depthPyramidGraphInfo(depthAlias, pyramidAlias);
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "r3/render-pass/IRenderPass.hpp"
+#include "r3/graph/ResourceAliases.hpp"
+#include "r3/render-pass/CreateInfo.hpp"
+
+namespace tr {
+
+class ImageManager;
+class BufferSystem;
+class ResourceAliasRegistry;
+class PipelineFactory;
+
+/// Builds the depth pyramid the next frame's culling tests objects against. Copies the depth
+/// image into mip 0 of the pyramid buffer, then reduces it a mip at a time, one dispatch per mip.
+/// See HzbCulling.hpp for the layout.
+class DepthPyramidPass : public IRenderPass {
+public:
+  DepthPyramidPass(std::shared_ptr<ImageManager> newImageManager,
+                   std::shared_ptr<BufferSystem> newBufferSystem,
+                   std::shared_ptr<ResourceAliasRegistry> newAliasRegistry,
+                   std::shared_ptr<PipelineFactory> newPipelineFactory,
+                   const DepthPyramidPassCreateInfo& createInfo,
+                   PassId newPassId);
+  ~DepthPyramidPass() override = default;
+
+  DepthPyramidPass(const DepthPyramidPass&) = delete;
+  DepthPyramidPass(DepthPyramidPass&&) = delete;
+  auto operator=(const DepthPyramidPass&) -> DepthPyramidPass& = delete;
+  auto operator=(DepthPyramidPass&&) -> DepthPyramidPass& = delete;
+
+  [[nodiscard]] auto getId() const -> PassId override;
+  auto execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void override;
+  auto registerDispatchContext(Handle<IDispatchContext> handle) -> void override;
+  [[nodiscard]] auto getGraphInfo() const -> PassGraphInfo override;
+
+private:
+  struct PushConstants {
+    uint64_t pyramidAddress;
+    glm::uvec2 extent;
+    uint32_t level;
+  };
+
+  std::shared_ptr<ImageManager> imageManager;
+  std::shared_ptr<BufferSystem> bufferSystem;
+  std::shared_ptr<ResourceAliasRegistry> aliasRegistry;
+  std::shared_ptr<PipelineFactory> pipelineFactory;
+  ImageAlias depthAlias;
+  GlobalBufferAlias pyramidAlias;
+  PassId id;
+
+  glm::uvec2 extent;
+  uint32_t mipCount;
+
+  std::optional<vk::raii::Pipeline> pipeline;
+  std::optional<vk::raii::PipelineLayout> pipelineLayout;
+};
+
+}
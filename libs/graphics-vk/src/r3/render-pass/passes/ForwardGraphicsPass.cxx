@@ -5,6 +5,7 @@
 #include "r3/graph/ImageUsageInfo.hpp"
 #include "r3/graph/PassGraphInfo.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "r3/render-pass/PipelineCreateInfo.hpp"
 #include "r3/render-pass/PipelineFactory.hpp"
 #include "task/Frame.hpp"
@@ -29,6 +30,7 @@ ForwardGraphicsPass::ForwardGraphicsPass(std::shared_ptr<ImageManager> newImageM
       layoutManager{std::move(newLayoutManager)},
       colorAlias{createInfo.colorImage},
       depthAlias{createInfo.depthImage},
+      loadOp{createInfo.loadOp},
       id{newPassId} {
   Log.trace("Creating ForwardGraphicsPass");
 
@@ -83,7 +85,7 @@ ForwardGraphicsPass::ForwardGraphicsPass(std::shared_ptr<ImageManager> newImageM
 
   colorAttachmentInfo = std::make_optional(vk::RenderingAttachmentInfo{
       .imageLayout = vk::ImageLayout::eColorAttachmentOptimal,
-      .loadOp = vk::AttachmentLoadOp::eClear,
+      .loadOp = loadOp,
       .storeOp = vk::AttachmentStoreOp::eStore,
       .clearValue =
           vk::ClearValue{
@@ -92,7 +94,7 @@ ForwardGraphicsPass::ForwardGraphicsPass(std::shared_ptr<ImageManager> newImageM
 
   depthAttachmentInfo = std::make_optional(vk::RenderingAttachmentInfo{
       .imageLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal,
-      .loadOp = vk::AttachmentLoadOp::eClear,
+      .loadOp = loadOp,
       .storeOp = vk::AttachmentStoreOp::eStore,
       .clearValue =
           vk::ClearValue{.depthStencil = vk::ClearDepthStencilValue{.depth = 1.f, .stencil = 0}},
@@ -125,6 +127,8 @@ auto ForwardGraphicsPass::execute(Frame* frame, vk::raii::CommandBuffer& cmdBuff
                           .dstAccessMask = vk::AccessFlagBits2::eNone,
                           .oldLayout = info.oldLayout,
                           .newLayout = info.newLayout,
+                          .srcQueueFamilyIndex = info.srcQueueFamily,
+                          .dstQueueFamilyIndex = info.dstQueueFamily,
                           .image = info.image,
                           .subresourceRange = info.subresourceRange});
     }
@@ -153,14 +157,13 @@ auto ForwardGraphicsPass::registerDispatchContext(Handle<IDispatchContext> handl
 
 [[nodiscard]] auto ForwardGraphicsPass::getGraphInfo() const -> PassGraphInfo {
   auto graphInfo = PassGraphInfo{};
-
   for (const auto& handle : drawableContexts) {
-    const auto& dispatchContext = drawContextFactory->getDispatchContext(handle);
-    const auto contextInfo = dispatchContext->getGraphInfo();
-    graphInfo.bufferReads.insert(contextInfo.bufferReads.begin(), contextInfo.bufferReads.end());
-    graphInfo.bufferWrites.insert(contextInfo.bufferWrites.begin(), contextInfo.bufferWrites.end());
-    graphInfo.imageReads.insert(contextInfo.imageReads.begin(), contextInfo.imageReads.end());
-    graphInfo.imageWrites.insert(contextInfo.imageWrites.begin(), contextInfo.imageWrites.end());
+    mergeGraphInfo(graphInfo, drawContextFactory->getDispatchContext(handle)->getGraphInfo());
+  }
+
+  // Loading the attachments reads what the passes before left in them
+  if (loadOp == vk::AttachmentLoadOp::eLoad) {
+    mergeGraphInfo(graphInfo, forwardLoadGraphInfo(colorAlias, depthAlias));
   }
 
   return graphInfo;
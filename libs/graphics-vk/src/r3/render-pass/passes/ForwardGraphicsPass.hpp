@@ -47,6 +47,7 @@ private:
   std::shared_ptr<DSLayoutManager> layoutManager;
   ImageAlias colorAlias;
   ImageAlias depthAlias;
+  vk::AttachmentLoadOp loadOp;
   PassId id;
 
   std::optional<vk::raii::Pipeline> pipeline;
@@ -5,6 +5,7 @@
 #include "r3/draw-context/ContextFactory.hpp"
 #include "r3/draw-context/IDispatchContext.hpp"
 #include "r3/graph/ResourceAliasRegistry.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 #include "task/Frame.hpp"
 #include "vk/core/Device.hpp"
 
@@ -124,26 +125,10 @@ auto ImGuiPass::registerDispatchContext(Handle<IDispatchContext> handle) -> void
 }
 
 [[nodiscard]] auto ImGuiPass::getGraphInfo() const -> PassGraphInfo {
-  auto graphInfo = PassGraphInfo{
-      .imageWrites = {
-          ImageUsageInfo{
-              .alias = colorAlias,
-              .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
-              .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
-              .aspectFlags = vk::ImageAspectFlagBits::eColor,
-              .layout = vk::ImageLayout::eColorAttachmentOptimal,
-              .clearValue = vk::ClearValue{.color = {std::array<float, 4>{0.f, 0.f, 0.f, 1.f}}},
-          },
-      }};
-
+  auto graphInfo = imGuiTargetGraphInfo(colorAlias);
   for (const auto& handle : drawableContexts) {
-    const auto& contextInfo = drawContextFactory->getDispatchContext(handle)->getGraphInfo();
-    graphInfo.bufferReads.insert(contextInfo.bufferReads.begin(), contextInfo.bufferReads.end());
-    graphInfo.bufferWrites.insert(contextInfo.bufferWrites.begin(), contextInfo.bufferWrites.end());
-    graphInfo.imageReads.insert(contextInfo.imageReads.begin(), contextInfo.imageReads.end());
-    graphInfo.imageWrites.insert(contextInfo.imageWrites.begin(), contextInfo.imageWrites.end());
+    mergeGraphInfo(graphInfo, drawContextFactory->getDispatchContext(handle)->getGraphInfo());
   }
-
   return graphInfo;
 }
 }
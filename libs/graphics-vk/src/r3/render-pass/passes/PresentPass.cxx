@@ -1,4 +1,5 @@
 #include "PresentPass.hpp"
+#include "r3/render-pass/PassGraphInfos.hpp"
 
 namespace tr {
 
@@ -20,13 +21,7 @@ auto PresentPass::registerDispatchContext([[maybe_unused]] Handle<IDispatchConte
 }
 
 [[nodiscard]] auto PresentPass::getGraphInfo() const -> PassGraphInfo {
-  return PassGraphInfo{.imageReads = {{
-                           .alias = ImageAlias::SwapchainImage,
-                           .accessFlags = vk::AccessFlagBits2::eNone,
-                           .stageFlags = vk::PipelineStageFlagBits2::eBottomOfPipe,
-                           .aspectFlags = vk::ImageAspectFlagBits::eColor,
-                           .layout = vk::ImageLayout::ePresentSrcKHR,
-                       }}};
+  return presentGraphInfo();
 }
 
 }
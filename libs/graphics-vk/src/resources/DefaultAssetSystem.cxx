@@ -54,30 +54,26 @@ auto DefaultAssetSystem::run() -> void {
     setCurrentThreadName("Assets");
     Log.trace("Started AssetSystemThread");
     // Create all subscriptions on the thread
-    eventQueue->subscribe<BeginResourceBatch>(
-        [this](const auto& batch) { eventBatches[batch->batchId] = std::vector<RequestVariant>{}; },
-        "test_group");
+    eventQueue->subscribe<BeginResourceBatch>([this](const auto& batch) {
+      eventBatches[batch->batchId] = std::vector<RequestVariant>{};
+    });
 
     eventQueue->subscribe<StaticModelRequest>(
-        [this](const auto& smRequest) { eventBatches[smRequest->batchId].push_back(smRequest); },
-        "test_group");
+        [this](const auto& smRequest) { eventBatches[smRequest->batchId].push_back(smRequest); });
     eventQueue->subscribe<StaticMeshRequest>(
-        [this](const auto& smRequest) { eventBatches[smRequest->batchId].push_back(smRequest); },
-        "test_group");
+        [this](const auto& smRequest) { eventBatches[smRequest->batchId].push_back(smRequest); });
 
     eventQueue->subscribe<DynamicModelRequest>(
-        [this](const auto& dmRequest) { eventBatches[dmRequest->batchId].push_back(dmRequest); },
-        "test_group");
+        [this](const auto& dmRequest) { eventBatches[dmRequest->batchId].push_back(dmRequest); });
 
     eventQueue->subscribe<EndResourceBatch>(
         [this](const std::shared_ptr<EndResourceBatch>& batch) {
           processBatchedResources(batch->batchId);
-        },
-        "test_group");
+        });
 
     while (!token.stop_requested()) {
+      eventQueue->waitForEvents(token);
       eventQueue->dispatchPending();
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
     Log.trace("AssetSystem thread shutting down");
   });
@@ -61,6 +61,11 @@ public:
   auto run() -> void override;
   auto requestStop() -> void override;
 
+  /// Splits a batch's requirements into sub-batches that each fit in the staging buffers.
+  static auto partition(BufferSizes stagingBufferSizes,
+                        const std::vector<StagingRequirements>& requirements)
+      -> std::vector<SubBatch>;
+
 private:
   std::shared_ptr<IEventQueue> eventQueue;
   std::shared_ptr<IAssetService> assetService;
@@ -89,10 +94,6 @@ private:
   auto extractRequirements(uint64_t batchId, const std::vector<RequestVariant>& requests)
       -> std::vector<StagingRequirements>;
 
-  static auto partition(BufferSizes stagingBufferSizes,
-                        const std::vector<StagingRequirements>& requirements)
-      -> std::vector<SubBatch>;
-
   auto prepareUpload(const SubBatch& subBatch) -> UploadSubBatch;
 
   auto processResults(const std::vector<SubBatchResult>& subBatchResults)
@@ -237,11 +237,12 @@ auto TransferSystem::recordImageUploads(const ImageCopyMap& imageCopies) -> void
                                        .dstImageLayout = vk::ImageLayout::eTransferDstOptimal,
                                        .regionCount = static_cast<uint32_t>(regions.size()),
                                        .pRegions = regions.data()});
+    // The layout transition belongs to the transfer, so the acquire has to use the same layouts
     vk::ImageMemoryBarrier2 releaseBarrier{
         .srcStageMask = vk::PipelineStageFlagBits2::eTransfer,
         .srcAccessMask = vk::AccessFlagBits2::eTransferWrite,
         .oldLayout = vk::ImageLayout::eTransferDstOptimal,
-        .newLayout = vk::ImageLayout::eTransferDstOptimal, // layout stays the same
+        .newLayout = vk::ImageLayout::eShaderReadOnlyOptimal,
         .srcQueueFamilyIndex = transferQueue->getFamily(),
         .dstQueueFamilyIndex = graphicsQueue->getFamily(),
         .image = dstImage.getImage(),
@@ -264,7 +265,9 @@ auto TransferSystem::recordImageUploads(const ImageCopyMap& imageCopies) -> void
                                 .levelCount = 1,
                                 .baseArrayLayer = regions.front().imageSubresource.baseArrayLayer,
                                 .layerCount = regions.front().imageSubresource.layerCount,
-                            }});
+                            },
+                            .srcQueueFamily = transferQueue->getFamily(),
+                            .dstQueueFamily = graphicsQueue->getFamily()});
   }
 }
 
@@ -39,6 +39,7 @@ auto GeometryAllocator::allocate(const GeometryData& data, TransferContext& tran
   }
 
   {
+    geometryRegion.bounds = computeBounds(*data.positionData);
     auto size = data.positionData->size();
     auto stagingRegion = transferContext.stagingAllocator->allocate(BufferRequest{.size = size});
     geometryRegion.positionRegion =
@@ -80,21 +81,22 @@ auto GeometryAllocator::allocate(const GeometryData& data, TransferContext& tran
     });
   }
 
-  const auto handle = regionGenerator.requestHandle();
-  regionTable.emplace(handle, geometryRegion);
+  const auto handle = regionTable.insert(geometryRegion);
   return {.regionHandle = handle, .bufferAllocations = uploadList};
 }
 
 auto GeometryAllocator::getRegionData(Handle<GeometryRegion> handle) const
     -> GpuGeometryRegionData {
-  assert(regionTable.contains(handle) && "No RegionTable entry for given handle");
   const auto& region = regionTable.at(handle);
 
   auto regionData = GpuGeometryRegionData{
       .indexCount = region.indexCount,
       .indexOffset = static_cast<uint32_t>(region.indexRegion.offset / sizeof(GpuIndexData)),
       .positionOffset =
-          static_cast<uint32_t>(region.positionRegion.offset / sizeof(GpuVertexPositionData))};
+          static_cast<uint32_t>(region.positionRegion.offset / sizeof(GpuVertexPositionData)),
+      .boundingSphere = region.bounds.sphere,
+      .boundsMin = region.bounds.min,
+      .boundsMax = region.bounds.max};
   if (region.texCoordRegion) {
     regionData.texCoordOffset = region.texCoordRegion->offset / sizeof(GpuVertexTexCoordData);
   }
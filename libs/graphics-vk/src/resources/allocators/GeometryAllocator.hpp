@@ -1,8 +1,9 @@
 #pragma once
 
 #include "bk/Handle.hpp"
-#include "bk/HandleGenerator.hpp"
+#include "bk/SlotMap.hpp"
 #include "mem/BufferRegion.hpp"
+#include "r3/FrustumCulling.hpp"
 #include "resources/TransferContext.hpp"
 
 namespace tr {
@@ -20,6 +21,7 @@ struct GeometryRegion {
   std::optional<BufferRegion> texCoordRegion;
   std::optional<BufferRegion> colorRegion;
   std::optional<BufferRegion> animationDataRegion;
+  GeometryBounds bounds;
 };
 
 struct BufferAllocation {
@@ -56,8 +58,7 @@ public:
 private:
   std::shared_ptr<GeometryBufferPack> geometryBufferPack;
 
-  HandleGenerator<GeometryRegion> regionGenerator{};
-  std::unordered_map<Handle<GeometryRegion>, GeometryRegion> regionTable;
+  SlotMap<GeometryRegion> regionTable;
 };
 
 }
@@ -4,6 +4,26 @@
 
 namespace tr {
 
+namespace {
+
+template <typename T>
+auto addMapping(std::vector<std::optional<T>>& mappings, size_t logicalId, T handle) -> void {
+  if (logicalId >= mappings.size()) {
+    mappings.resize(logicalId + 1);
+  }
+  assert(!mappings[logicalId].has_value() && "Attempted to register same logical handle twice");
+  mappings[logicalId] = handle;
+}
+
+template <typename T>
+auto getMapping(const std::vector<std::optional<T>>& mappings, size_t logicalId) -> T {
+  assert(logicalId < mappings.size() && mappings[logicalId].has_value() &&
+         "No handle registered for logical handle");
+  return *mappings[logicalId];
+}
+
+}
+
 Frame::Frame(const uint8_t newIndex,
              vk::raii::Fence&& newRenderFence,
              vk::raii::Semaphore&& newImageAvailableSemaphore,
@@ -42,26 +62,8 @@ auto Frame::getObjectCount() const -> uint32_t {
   return objectCount;
 }
 
-auto Frame::setLastImageUse(ImageAlias imageAlias, LastImageUse lastImageUse) -> void {
-  lastImageUses.insert_or_assign(imageAlias, lastImageUse);
-}
-
-auto Frame::getLastImageUse(ImageAlias imageAlias) const -> std::optional<LastImageUse> {
-  if (!lastImageUses.contains(imageAlias)) {
-    return std::nullopt;
-  }
-  return lastImageUses.at(imageAlias);
-}
-
-auto Frame::setLastBufferUse(BufferAliasVariant bufferAlias, LastBufferUse lastBufferUse) -> void {
-  lastBufferUses.insert_or_assign(bufferAlias, lastBufferUse);
-}
-
-auto Frame::getLastBufferUse(BufferAliasVariant bufferAlias) const -> std::optional<LastBufferUse> {
-  if (!lastBufferUses.contains(bufferAlias)) {
-    return std::nullopt;
-  }
-  return lastBufferUses.at(bufferAlias);
+auto Frame::getDrawCount() const -> uint32_t {
+  return drawCount;
 }
 
 auto Frame::setEditorState(std::optional<EditorState> newState) -> void {
@@ -82,9 +84,7 @@ auto Frame::getImageTransitionInfo() -> std::vector<ImageTransitionInfo> {
 
 auto Frame::addLogicalImage(LogicalHandle<ManagedImage> logicalHandle,
                             Handle<ManagedImage> imageHandle) -> void {
-  assert(!imageHandles.contains(logicalHandle) &&
-         "Attempted to register same logical handle twice");
-  imageHandles.emplace(logicalHandle, imageHandle);
+  addMapping(imageHandles, logicalHandle.id, imageHandle);
 }
 
 auto Frame::registerSwapchainLogicalHandle(LogicalHandle<ManagedImage> logicalHandle) -> void {
@@ -94,42 +94,38 @@ auto Frame::registerSwapchainLogicalHandle(LogicalHandle<ManagedImage> logicalHa
 
 auto Frame::addSwapchainImage(Handle<ManagedImage> handle, uint32_t index) -> void {
   Log.trace("Frame {} adding swapchain image, handle={}, index={}", this->index, handle.id, index);
-  swapchainImageHandles.emplace(index, handle);
+  if (index >= swapchainImageHandles.size()) {
+    swapchainImageHandles.resize(index + 1);
+  }
+  swapchainImageHandles[index] = handle;
 }
 
 auto Frame::getLogicalImage(LogicalHandle<ManagedImage> logicalHandle) const
     -> Handle<ManagedImage> {
   if (logicalHandle == swapchainLogicalHandle) {
-    return swapchainImageHandles.at(swapchainImageIndex);
+    return swapchainImageHandles[swapchainImageIndex];
   }
-  assert(imageHandles.contains(logicalHandle));
-  return imageHandles.at(logicalHandle);
+  return getMapping(imageHandles, logicalHandle.id);
 }
 
 auto Frame::addLogicalBuffer(LogicalHandle<ManagedBuffer> logicalHandle,
                              Handle<ManagedBuffer> bufferHandle) -> void {
-  assert(!bufferHandles.contains(logicalHandle) &&
-         "Attempted to register same logical handle twice");
-  bufferHandles.emplace(logicalHandle, bufferHandle);
+  addMapping(bufferHandles, logicalHandle.id, bufferHandle);
 }
 
 auto Frame::addLogicalShaderBinding(LogicalHandle<IShaderBinding> logicalHandle,
                                     Handle<IShaderBinding> handle) -> void {
-  assert(!shaderBindingHandles.contains(logicalHandle) &&
-         "Attempted to register same logical ShaderBinding twice");
-  shaderBindingHandles.emplace(logicalHandle, handle);
+  addMapping(shaderBindingHandles, logicalHandle.id, handle);
 }
 
 [[nodiscard]] auto Frame::getLogicalBuffer(LogicalHandle<ManagedBuffer> logicalHandle) const
     -> Handle<ManagedBuffer> {
-  assert(bufferHandles.contains(logicalHandle));
-  return bufferHandles.at(logicalHandle);
+  return getMapping(bufferHandles, logicalHandle.id);
 }
 
 [[nodiscard]] auto Frame::getLogicalShaderBinding(LogicalHandle<IShaderBinding> logicalHandle) const
     -> Handle<IShaderBinding> {
-  assert(shaderBindingHandles.contains(logicalHandle));
-  return shaderBindingHandles.at(logicalHandle);
+  return getMapping(shaderBindingHandles, logicalHandle.id);
 }
 
 auto Frame::setSwapchainImageIndex(const uint32_t index) -> void {
@@ -140,6 +136,10 @@ auto Frame::setObjectCount(uint32_t newObjectCount) -> void {
   objectCount = newObjectCount;
 }
 
+auto Frame::setDrawCount(uint32_t newDrawCount) -> void {
+  drawCount = newDrawCount;
+}
+
 auto Frame::transitionImage(const vk::raii::CommandBuffer& cmd,
                             const vk::Image& image,
                             const vk::ImageLayout currentLayout,
@@ -6,8 +6,6 @@
 #include "img/ManagedImage.hpp"
 #include "r3/graph/ImageAlias.hpp"
 #include "r3/graph/ResourceAliases.hpp"
-#include "r3/graph/barriers/LastBufferUse.hpp"
-#include "r3/graph/barriers/LastImageUse.hpp"
 #include "vk/ResourceManagerHandles.hpp"
 
 namespace tr {
@@ -61,6 +59,8 @@ public:
   [[nodiscard]] auto getDrawImageExtent() const -> vk::Extent2D;
 
   [[nodiscard]] auto getObjectCount() const -> uint32_t;
+  /// Number of instanced draw batches the objects were grouped into
+  [[nodiscard]] auto getDrawCount() const -> uint32_t;
 
   [[nodiscard]] auto getBufferHandle(BufferHandleType type) const -> BufferHandle;
 
@@ -98,12 +98,7 @@ public:
   auto setDrawImageExtent(vk::Extent2D extent) -> void;
 
   auto setObjectCount(uint32_t newObjectCount) -> void;
-
-  auto setLastImageUse(ImageAlias imageAlias, LastImageUse lastImageUse) -> void;
-  auto getLastImageUse(ImageAlias imageAlias) const -> std::optional<LastImageUse>;
-
-  auto setLastBufferUse(BufferAliasVariant bufferAlias, LastBufferUse lastBufferUse) -> void;
-  auto getLastBufferUse(BufferAliasVariant bufferAlias) const -> std::optional<LastBufferUse>;
+  auto setDrawCount(uint32_t newDrawCount) -> void;
 
   auto setEditorState(std::optional<EditorState> newState) -> void;
   auto getEditorState() const -> std::optional<EditorState>;
@@ -121,19 +116,18 @@ private:
   uint32_t swapchainImageIndex{};
   vk::Extent2D drawImageExtent{};
 
-  std::unordered_map<LogicalHandle<ManagedBuffer>, Handle<ManagedBuffer>> bufferHandles;
-  std::unordered_map<LogicalHandle<ManagedImage>, Handle<ManagedImage>> imageHandles;
-  std::unordered_map<LogicalHandle<IShaderBinding>, Handle<IShaderBinding>> shaderBindingHandles;
+  // Logical handle ids are handed out sequentially, so these are indexed by them directly.
+  std::vector<std::optional<Handle<ManagedBuffer>>> bufferHandles;
+  std::vector<std::optional<Handle<ManagedImage>>> imageHandles;
+  std::vector<std::optional<Handle<IShaderBinding>>> shaderBindingHandles;
 
   LogicalHandle<ManagedImage> swapchainLogicalHandle;
-  std::unordered_map<uint32_t, Handle<ManagedImage>> swapchainImageHandles;
-
-  std::unordered_map<ImageAlias, LastImageUse> lastImageUses;
-  std::unordered_map<BufferAliasVariant, LastBufferUse> lastBufferUses;
+  std::vector<Handle<ManagedImage>> swapchainImageHandles;
 
   std::vector<ImageTransitionInfo> imageTransitionInfo;
 
   uint32_t objectCount;
+  uint32_t drawCount{};
   std::optional<EditorState> editorState;
 
   static auto transitionImage(const vk::raii::CommandBuffer& cmd,
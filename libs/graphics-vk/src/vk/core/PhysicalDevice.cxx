@@ -146,6 +146,7 @@ auto PhysicalDevice::createDevice() -> std::unique_ptr<vk::raii::Device> {
   auto physicalVulkan12Features = vk12Features.get<vk::PhysicalDeviceVulkan12Features>();
   physicalVulkan12Features.drawIndirectCount = VK_TRUE;
   physicalVulkan12Features.bufferDeviceAddress = VK_TRUE;
+  physicalVulkan12Features.timelineSemaphore = VK_TRUE;
 
   vk::DeviceCreateInfo createInfo{
       .queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size()),
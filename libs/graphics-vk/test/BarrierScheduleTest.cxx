@@ -0,0 +1,514 @@
+#include "MockRenderPass.hpp"
+#include "r3/graph/barriers/BarrierScheduleCompiler.hpp"
+
+namespace tr {
+
+namespace {
+
+/// Culling -> Forward -> Composition -> Present, the way R3Renderer orders them
+auto makePasses() -> std::vector<std::unique_ptr<IRenderPass>> {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+
+  // Reads and writes IndirectCommandCount, reads ObjectData
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferWrites = {BufferUsageInfo{
+                        .alias = BufferAlias::IndirectCommandCount,
+                        .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                    }},
+                    .bufferReads = {BufferUsageInfo{
+                                        .alias = BufferAlias::IndirectCommandCount,
+                                        .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                                    },
+                                    BufferUsageInfo{
+                                        .alias = BufferAlias::ObjectData,
+                                        .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                                    }}}));
+
+  // Writes GeometryColorImage, reads IndirectCommandCount
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.imageWrites = {ImageUsageInfo{
+                        .alias = ImageAlias::GeometryColorImage,
+                        .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                    }},
+                    .bufferReads = {BufferUsageInfo{
+                        .alias = BufferAlias::IndirectCommandCount,
+                        .accessFlags = vk::AccessFlagBits2::eIndirectCommandRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eDrawIndirect,
+                    }}}));
+
+  // Reads GeometryColorImage, writes SwapchainImage
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Composition,
+      PassGraphInfo{.imageWrites = {ImageUsageInfo{
+                        .alias = ImageAlias::SwapchainImage,
+                        .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                    }},
+                    .imageReads = {ImageUsageInfo{
+                        .alias = ImageAlias::GeometryColorImage,
+                        .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                    }}}));
+
+  // Moves SwapchainImage to present
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Present,
+      PassGraphInfo{.imageReads = {ImageUsageInfo{
+                        .alias = ImageAlias::SwapchainImage,
+                        .accessFlags = vk::AccessFlagBits2::eNone,
+                        .stageFlags = vk::PipelineStageFlagBits2::eBottomOfPipe,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::ePresentSrcKHR,
+                    }}}));
+
+  return passes;
+}
+
+auto findBuffer(const PassBarriers& barriers, BufferAliasVariant alias)
+    -> std::optional<vk::BufferMemoryBarrier2> {
+  for (size_t i = 0; i < barriers.bufferAliases.size(); ++i) {
+    if (barriers.bufferAliases[i] == alias) {
+      return barriers.bufferBarriers[i];
+    }
+  }
+  return std::nullopt;
+}
+
+auto findImage(const PassBarriers& barriers, ImageAlias alias)
+    -> std::optional<vk::ImageMemoryBarrier2> {
+  for (size_t i = 0; i < barriers.imageAliases.size(); ++i) {
+    if (barriers.imageAliases[i] == alias) {
+      return barriers.imageBarriers[i];
+    }
+  }
+  return std::nullopt;
+}
+
+}
+
+TEST_CASE("BarrierScheduleCompiler schedules barriers in pass order", "[BarrierSchedule]") {
+  const auto passes = makePasses();
+  const auto schedule = BarrierScheduleCompiler::compile(passes);
+
+  REQUIRE(schedule.firstRun.size() == passes.size());
+  REQUIRE(schedule.steadyState.size() == passes.size());
+  for (size_t i = 0; i < passes.size(); ++i) {
+    CHECK(schedule.firstRun[i].passId == passes[i]->getId());
+    CHECK(schedule.steadyState[i].passId == passes[i]->getId());
+  }
+
+  SECTION("A pass's uses of one buffer are merged into one barrier") {
+    const auto& culling = schedule.firstRun[0];
+    CHECK(culling.bufferBarriers.size() == 2);
+    const auto indirectCount = findBuffer(culling, BufferAlias::IndirectCommandCount);
+    REQUIRE(indirectCount);
+    CHECK(indirectCount->dstAccessMask ==
+          (vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite));
+  }
+
+  SECTION("The first run waits on earlier passes in the run, or nothing") {
+    const auto& culling = schedule.firstRun[0];
+    const auto objectData = findBuffer(culling, BufferAlias::ObjectData);
+    REQUIRE(objectData);
+    CHECK(objectData->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+
+    const auto& forward = schedule.firstRun[1];
+    const auto indirectCount = findBuffer(forward, BufferAlias::IndirectCommandCount);
+    REQUIRE(indirectCount);
+    CHECK(indirectCount->srcStageMask == vk::PipelineStageFlagBits2::eComputeShader);
+    CHECK(indirectCount->dstStageMask == vk::PipelineStageFlagBits2::eDrawIndirect);
+
+    const auto color = findImage(forward, ImageAlias::GeometryColorImage);
+    REQUIRE(color);
+    CHECK(color->oldLayout == vk::ImageLayout::eUndefined);
+    CHECK(color->newLayout == vk::ImageLayout::eColorAttachmentOptimal);
+  }
+
+  SECTION("The steady state waits on the last use in the run before") {
+    const auto& culling = schedule.steadyState[0];
+    const auto indirectCount = findBuffer(culling, BufferAlias::IndirectCommandCount);
+    REQUIRE(indirectCount);
+    CHECK(indirectCount->srcStageMask == vk::PipelineStageFlagBits2::eDrawIndirect);
+    CHECK(indirectCount->srcAccessMask == vk::AccessFlagBits2::eIndirectCommandRead);
+
+    const auto color = findImage(schedule.steadyState[1], ImageAlias::GeometryColorImage);
+    REQUIRE(color);
+    CHECK(color->oldLayout == vk::ImageLayout::eShaderReadOnlyOptimal);
+  }
+
+  SECTION("A resource only one pass uses needs no barrier once it's settled") {
+    CHECK(findBuffer(schedule.firstRun[0], BufferAlias::ObjectData));
+    CHECK_FALSE(findBuffer(schedule.steadyState[0], BufferAlias::ObjectData));
+  }
+
+  SECTION("The swapchain image always starts undefined") {
+    const auto& composition = schedule.steadyState[2];
+    REQUIRE(composition.swapchainBarriers.size() == 1);
+    const auto& swapchain = composition.imageBarriers[composition.swapchainBarriers[0]];
+    CHECK(swapchain.oldLayout == vk::ImageLayout::eUndefined);
+    CHECK(swapchain.srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+
+    const auto& present = schedule.steadyState[3];
+    REQUIRE(present.swapchainBarriers.size() == 1);
+    CHECK(present.imageBarriers[present.swapchainBarriers[0]].oldLayout ==
+          vk::ImageLayout::eColorAttachmentOptimal);
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler leaves passes without resources empty", "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(PassId::ImGui, PassGraphInfo{}));
+
+  const auto schedule = BarrierScheduleCompiler::compile(passes);
+
+  REQUIRE(schedule.firstRun.size() == 1);
+  CHECK(schedule.firstRun[0].imageBarriers.empty());
+  CHECK(schedule.firstRun[0].bufferBarriers.empty());
+  CHECK(schedule.steadyState[0].imageBarriers.empty());
+  CHECK(schedule.steadyState[0].bufferBarriers.empty());
+}
+
+TEST_CASE("BarrierScheduleCompiler waits on the last image in shared memory",
+          "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.imageWrites = {ImageUsageInfo{
+                        .alias = ImageAlias::DepthImage,
+                        .accessFlags = vk::AccessFlagBits2::eDepthStencilAttachmentWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                        .aspectFlags = vk::ImageAspectFlagBits::eDepth,
+                        .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                    }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::DepthPyramid,
+      PassGraphInfo{.imageReads = {ImageUsageInfo{
+                        .alias = ImageAlias::DepthImage,
+                        .accessFlags = vk::AccessFlagBits2::eTransferRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eCopy,
+                        .aspectFlags = vk::ImageAspectFlagBits::eDepth,
+                        .layout = vk::ImageLayout::eTransferSrcOptimal,
+                    }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::ImGui,
+      PassGraphInfo{.imageWrites = {ImageUsageInfo{
+                        .alias = ImageAlias::GuiColorImage,
+                        .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                    }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Composition,
+      PassGraphInfo{.imageReads = {ImageUsageInfo{
+                        .alias = ImageAlias::GuiColorImage,
+                        .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                    }}}));
+
+  const auto sharedMemory = std::unordered_map<ImageAlias, size_t>{
+      {ImageAlias::DepthImage, 0},
+      {ImageAlias::GuiColorImage, 0},
+  };
+  const auto schedule = BarrierScheduleCompiler::compile(passes, {0, 1, 2, 3}, sharedMemory);
+
+  SECTION("The GUI image waits for depth to be done with the memory") {
+    const auto gui = findImage(schedule.firstRun[2], ImageAlias::GuiColorImage);
+    REQUIRE(gui);
+    CHECK(gui->oldLayout == vk::ImageLayout::eUndefined);
+    CHECK(gui->srcStageMask == vk::PipelineStageFlagBits2::eCopy);
+    CHECK(gui->srcAccessMask == vk::AccessFlagBits2::eTransferRead);
+  }
+
+  SECTION("Depth waits for the GUI image from the run before and starts over") {
+    const auto firstDepth = findImage(schedule.firstRun[0], ImageAlias::DepthImage);
+    REQUIRE(firstDepth);
+    CHECK(firstDepth->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+
+    const auto depth = findImage(schedule.steadyState[0], ImageAlias::DepthImage);
+    REQUIRE(depth);
+    CHECK(depth->oldLayout == vk::ImageLayout::eUndefined);
+    CHECK(depth->srcStageMask == vk::PipelineStageFlagBits2::eFragmentShader);
+  }
+
+  SECTION("Later uses in the same run keep their contents") {
+    const auto depth = findImage(schedule.steadyState[1], ImageAlias::DepthImage);
+    REQUIRE(depth);
+    CHECK(depth->oldLayout == vk::ImageLayout::eColorAttachmentOptimal);
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler transfers ownership once per queue family change",
+          "[BarrierSchedule]") {
+  const auto passes = makePasses();
+  // Culling on a compute family of its own
+  const auto schedule = BarrierScheduleCompiler::compile(passes, {0, 1, 2, 3}, {}, {1, 0, 0, 0});
+
+  SECTION("Forward acquires the count culling releases") {
+    const auto acquire = findBuffer(schedule.firstRun[1], BufferAlias::IndirectCommandCount);
+    REQUIRE(acquire);
+    CHECK(acquire->srcQueueFamilyIndex == 1);
+    CHECK(acquire->dstQueueFamilyIndex == 0);
+    CHECK(acquire->srcStageMask == vk::PipelineStageFlagBits2::eNone);
+    CHECK(acquire->dstStageMask == vk::PipelineStageFlagBits2::eDrawIndirect);
+
+    REQUIRE(schedule.firstRun[0].releaseBufferBarriers.size() == 1);
+    const auto& release = schedule.firstRun[0].releaseBufferBarriers[0];
+    CHECK(schedule.firstRun[0].releaseBufferAliases[0] ==
+          BufferAliasVariant{BufferAlias::IndirectCommandCount});
+    CHECK(release.srcQueueFamilyIndex == 1);
+    CHECK(release.dstQueueFamilyIndex == 0);
+    CHECK(release.srcStageMask == vk::PipelineStageFlagBits2::eComputeShader);
+    CHECK(release.dstStageMask == vk::PipelineStageFlagBits2::eNone);
+  }
+
+  SECTION("Culling takes the count back from the run before") {
+    // The first run has nothing to take back
+    const auto first = findBuffer(schedule.firstRun[0], BufferAlias::IndirectCommandCount);
+    REQUIRE(first);
+    CHECK(first->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+
+    const auto acquire = findBuffer(schedule.steadyState[0], BufferAlias::IndirectCommandCount);
+    REQUIRE(acquire);
+    CHECK(acquire->srcQueueFamilyIndex == 0);
+    CHECK(acquire->dstQueueFamilyIndex == 1);
+
+    // Either run can come before a steady state run, so both release it
+    CHECK(schedule.firstRun[1].releaseBufferBarriers.size() == 1);
+    CHECK(schedule.steadyState[1].releaseBufferBarriers.size() == 1);
+  }
+
+  SECTION("Each handoff is listed once") {
+    REQUIRE(schedule.transfers.size() == 2);
+    CHECK(schedule.transfers[0].releasePosition == 1);
+    CHECK(schedule.transfers[0].acquirePosition == 0);
+    CHECK(schedule.transfers[0].fromPreviousRun);
+    CHECK(schedule.transfers[1].releasePosition == 0);
+    CHECK(schedule.transfers[1].acquirePosition == 1);
+    CHECK(!schedule.transfers[1].fromPreviousRun);
+    CHECK(schedule.transfers[1].acquireStages == vk::PipelineStageFlagBits2::eDrawIndirect);
+
+    // Only culling uses the object data, and the images never leave graphics
+    for (const auto& pass : schedule.steadyState) {
+      CHECK(pass.releaseImageBarriers.empty());
+    }
+  }
+
+  SECTION("Passes on one family transfer nothing") {
+    const auto single = BarrierScheduleCompiler::compile(passes, {0, 1, 2, 3});
+    CHECK(single.transfers.empty());
+    for (const auto& pass : single.steadyState) {
+      CHECK(pass.releaseBufferBarriers.empty());
+      CHECK(pass.releaseImageBarriers.empty());
+    }
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler carries global buffers across frames", "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  // Reads last frame's pyramid and writes this frame's count
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferWrites = {BufferUsageInfo{
+                        .alias = BufferAlias::IndirectCommandCount,
+                        .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                    }},
+                    .bufferReads = {BufferUsageInfo{
+                        .alias = GlobalBufferAlias::DepthPyramid,
+                        .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                    }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::DepthPyramid,
+      PassGraphInfo{.bufferWrites = {BufferUsageInfo{
+          .alias = GlobalBufferAlias::DepthPyramid,
+          .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+      }}}));
+
+  const auto schedule = BarrierScheduleCompiler::compile(passes);
+
+  SECTION("Only the graph's first run has no pyramid to wait on") {
+    const auto first = findBuffer(schedule.firstRun[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(first);
+    CHECK(first->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+  }
+
+  SECTION("Another frame's first run waits on the pyramid the run before wrote") {
+    const auto pyramid = findBuffer(schedule.frameFirstRun[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(pyramid);
+    CHECK(pyramid->srcStageMask == vk::PipelineStageFlagBits2::eComputeShader);
+    CHECK(pyramid->srcAccessMask == vk::AccessFlagBits2::eShaderWrite);
+    CHECK(pyramid->dstAccessMask == vk::AccessFlagBits2::eShaderRead);
+
+    // Its own count hasn't been used by anything yet
+    const auto count = findBuffer(schedule.frameFirstRun[0], BufferAlias::IndirectCommandCount);
+    REQUIRE(count);
+    CHECK(count->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+  }
+
+  SECTION("The steady state waits on the pyramid the same way") {
+    const auto pyramid = findBuffer(schedule.steadyState[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(pyramid);
+    CHECK(pyramid->srcStageMask == vk::PipelineStageFlagBits2::eComputeShader);
+    CHECK(pyramid->srcAccessMask == vk::AccessFlagBits2::eShaderWrite);
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler hands global buffers over between frames",
+          "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferWrites = {BufferUsageInfo{
+                        .alias = BufferAlias::IndirectCommandCount,
+                        .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                    }},
+                    .bufferReads = {BufferUsageInfo{
+                        .alias = GlobalBufferAlias::DepthPyramid,
+                        .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+                    }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::DepthPyramid,
+      PassGraphInfo{.bufferWrites = {BufferUsageInfo{
+          .alias = GlobalBufferAlias::DepthPyramid,
+          .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+      }}}));
+
+  // Culling on a compute family of its own, the pyramid on graphics
+  const auto schedule = BarrierScheduleCompiler::compile(passes, {0, 1}, {}, {1, 0});
+
+  SECTION("The graph's first run has nothing to take back") {
+    const auto pyramid = findBuffer(schedule.firstRun[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(pyramid);
+    CHECK(pyramid->srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED);
+    CHECK(pyramid->srcStageMask == vk::PipelineStageFlagBits2::eTopOfPipe);
+  }
+
+  SECTION("A second frame's first run acquires the pyramid the first frame released") {
+    const auto acquire = findBuffer(schedule.frameFirstRun[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(acquire);
+    CHECK(acquire->srcQueueFamilyIndex == 0);
+    CHECK(acquire->dstQueueFamilyIndex == 1);
+
+    // The first frame's run released it, and so does every run after
+    for (const auto* run : {&schedule.firstRun, &schedule.frameFirstRun, &schedule.steadyState}) {
+      const auto& pyramidPass = (*run)[1];
+      REQUIRE(pyramidPass.releaseBufferAliases.size() == 1);
+      CHECK(pyramidPass.releaseBufferAliases[0] ==
+            BufferAliasVariant{GlobalBufferAlias::DepthPyramid});
+      CHECK(pyramidPass.releaseBufferBarriers[0].srcQueueFamilyIndex == 0);
+      CHECK(pyramidPass.releaseBufferBarriers[0].dstQueueFamilyIndex == 1);
+    }
+  }
+
+  SECTION("The steady state acquires the pyramid the same way") {
+    const auto acquire = findBuffer(schedule.steadyState[0], GlobalBufferAlias::DepthPyramid);
+    REQUIRE(acquire);
+    CHECK(acquire->srcQueueFamilyIndex == 0);
+    CHECK(acquire->dstQueueFamilyIndex == 1);
+
+    // The pyramid pass takes it back from culling within the run
+    REQUIRE(schedule.transfers.size() == 2);
+    CHECK(schedule.transfers[0].fromPreviousRun);
+    CHECK(!schedule.transfers[1].fromPreviousRun);
+    CHECK(schedule.transfers[1].srcFamily == 1);
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler transfers buffers that are only read", "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferReads = {BufferUsageInfo{
+          .alias = BufferAlias::ObjectData,
+          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+      }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.bufferReads = {BufferUsageInfo{
+          .alias = BufferAlias::ObjectData,
+          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+          .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+      }}}));
+
+  // Nothing writes the object data, but it isn't shared, so whichever family reads it owns it
+  const auto schedule = BarrierScheduleCompiler::compile(passes, {0, 1}, {}, {1, 0});
+
+  SECTION("Drawing acquires it from culling in every run") {
+    for (const auto* run : {&schedule.firstRun, &schedule.frameFirstRun, &schedule.steadyState}) {
+      const auto acquire = findBuffer((*run)[1], BufferAlias::ObjectData);
+      REQUIRE(acquire);
+      CHECK(acquire->srcQueueFamilyIndex == 1);
+      CHECK(acquire->dstQueueFamilyIndex == 0);
+
+      const auto& culling = (*run)[0];
+      REQUIRE(culling.releaseBufferAliases.size() == 1);
+      CHECK(culling.releaseBufferAliases[0] == BufferAliasVariant{BufferAlias::ObjectData});
+    }
+  }
+
+  SECTION("Culling takes it back from the previous run's drawing") {
+    const auto acquire = findBuffer(schedule.steadyState[0], BufferAlias::ObjectData);
+    REQUIRE(acquire);
+    CHECK(acquire->srcQueueFamilyIndex == 0);
+    CHECK(acquire->dstQueueFamilyIndex == 1);
+
+    REQUIRE(schedule.transfers.size() == 2);
+    CHECK(schedule.transfers[0].fromPreviousRun);
+    CHECK(!schedule.transfers[1].fromPreviousRun);
+  }
+}
+
+TEST_CASE("BarrierScheduleCompiler leaves buffers created shared out of transfers",
+          "[BarrierSchedule]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferReads = {BufferUsageInfo{
+          .alias = GlobalBufferAlias::Position,
+          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+          .stageFlags = vk::PipelineStageFlagBits2::eComputeShader,
+      }}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.bufferReads = {BufferUsageInfo{
+          .alias = GlobalBufferAlias::Position,
+          .accessFlags = vk::AccessFlagBits2::eShaderRead,
+          .stageFlags = vk::PipelineStageFlagBits2::eVertexShader,
+      }}}));
+
+  const auto schedule =
+      BarrierScheduleCompiler::compile(passes, {0, 1}, {}, {1, 0}, {GlobalBufferAlias::Position});
+
+  CHECK(schedule.transfers.empty());
+  for (const auto* run : {&schedule.firstRun, &schedule.frameFirstRun, &schedule.steadyState}) {
+    for (const auto& pass : *run) {
+      CHECK(pass.releaseBufferBarriers.empty());
+      for (const auto& barrier : pass.bufferBarriers) {
+        CHECK(barrier.srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED);
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,283 @@
+#include "r3/CullCompaction.hpp"
+
+namespace {
+
+/// Batches of the given sizes laid out the way DrawBatcher does, with the instances of each
+/// batch in order and the objects numbered by instance.
+struct Scene {
+  std::vector<tr::GpuDrawBatch> batches;
+  std::vector<tr::GpuDrawInstance> instances;
+  std::vector<tr::GpuIndirectCommand> commands;
+};
+
+auto makeScene(const std::vector<uint32_t>& batchSizes) -> Scene {
+  auto scene = Scene{};
+  for (uint32_t batchId = 0; batchId < batchSizes.size(); ++batchId) {
+    const auto firstInstance = static_cast<uint32_t>(scene.instances.size());
+    scene.batches.push_back(tr::GpuDrawBatch{.geometryRegionId = batchId,
+                                             .firstInstance = firstInstance,
+                                             .instanceCount = batchSizes[batchId]});
+    // Seeded the way FrameTables does, with culling counting the instances up from zero
+    scene.commands.push_back(tr::GpuIndirectCommand{.vertexCount = 3,
+                                                    .instanceCount = 0,
+                                                    .firstVertex = batchId,
+                                                    .firstInstance = firstInstance});
+    for (uint32_t i = 0; i < batchSizes[batchId]; ++i) {
+      scene.instances.push_back(
+          tr::GpuDrawInstance{.objectId = firstInstance + i, .batchId = batchId});
+    }
+  }
+  return scene;
+}
+
+struct Result {
+  std::vector<tr::GpuIndirectCommand> commands;
+  std::vector<uint32_t> visibleObjects;
+  uint32_t atomics;
+  uint32_t drawCount;
+};
+
+auto runCompaction(Scene scene, const std::vector<uint32_t>& visible) -> Result {
+  auto visibleObjects = std::vector<uint32_t>(scene.instances.size(), UINT32_MAX);
+  const auto atomics = tr::compactVisibleInstances(scene.instances,
+                                                   visible,
+                                                   scene.batches,
+                                                   scene.commands,
+                                                   visibleObjects);
+  const auto drawCount = tr::compactDrawCommands(scene.commands);
+  return Result{.commands = std::move(scene.commands),
+                .visibleObjects = std::move(visibleObjects),
+                .atomics = atomics,
+                .drawCount = drawCount};
+}
+
+/// Checks the packed commands draw exactly the visible instances, each batch's survivors
+/// packed from its firstInstance.
+auto checkCompacted(const Scene& scene, const std::vector<uint32_t>& visible, const Result& result)
+    -> void {
+  auto expectedDraws = 0U;
+  for (uint32_t batchId = 0; batchId < scene.batches.size(); ++batchId) {
+    const auto& batch = scene.batches[batchId];
+    auto expected = std::vector<uint32_t>{};
+    for (auto i = batch.firstInstance; i < batch.firstInstance + batch.instanceCount; ++i) {
+      if (visible[i] != 0) {
+        expected.push_back(scene.instances[i].objectId);
+      }
+    }
+    if (expected.empty()) {
+      continue;
+    }
+
+    REQUIRE(expectedDraws < result.drawCount);
+    const auto& command = result.commands[expectedDraws++];
+    CHECK(command.firstVertex == batchId);
+    CHECK(command.firstInstance == batch.firstInstance);
+    REQUIRE(command.instanceCount == expected.size());
+
+    // Runs from different workgroups land in whatever order their atomics did, so compare sets
+    auto drawn = std::vector<uint32_t>{
+        result.visibleObjects.begin() + command.firstInstance,
+        result.visibleObjects.begin() + command.firstInstance + command.instanceCount};
+    std::ranges::sort(drawn);
+    CHECK(drawn == expected);
+  }
+  CHECK(result.drawCount == expectedDraws);
+}
+
+/// Survivors every `stride` instances, starting at the first
+auto everyNth(size_t count, uint32_t stride) -> std::vector<uint32_t> {
+  auto visible = std::vector<uint32_t>(count, 0);
+  for (size_t i = 0; i < count; i += stride) {
+    visible[i] = 1;
+  }
+  return visible;
+}
+
+}
+
+TEST_CASE("inclusiveScan matches a sequential prefix sum", "[CullCompaction]") {
+  auto values = tr::LaneValues{};
+  for (uint32_t lane = 0; lane < tr::CullWorkgroupSize; ++lane) {
+    values[lane] = (lane * 7) % 5;
+  }
+  auto expected = values;
+  for (uint32_t lane = 1; lane < tr::CullWorkgroupSize; ++lane) {
+    expected[lane] += expected[lane - 1];
+  }
+
+  tr::inclusiveScan(values);
+  CHECK(values == expected);
+}
+
+TEST_CASE("segmentedInclusiveScan restarts at every head", "[CullCompaction]") {
+  auto values = tr::LaneValues{};
+  auto isHead = std::array<bool, tr::CullWorkgroupSize>{};
+  for (uint32_t lane = 0; lane < tr::CullWorkgroupSize; ++lane) {
+    values[lane] = lane % 3 == 0 ? 1 : 0;
+    // Segments of uneven lengths, including single lanes
+    isHead[lane] = lane == 0 || lane == 1 || lane == 2 || lane == 17 || lane == 40 || lane == 63;
+  }
+
+  auto expected = values;
+  auto expectedHeads = tr::LaneValues{};
+  for (uint32_t lane = 0; lane < tr::CullWorkgroupSize; ++lane) {
+    expectedHeads[lane] = isHead[lane] ? lane : expectedHeads[lane - 1];
+    if (!isHead[lane]) {
+      expected[lane] += expected[lane - 1];
+    }
+  }
+
+  auto heads = tr::LaneValues{};
+  tr::segmentedInclusiveScan(values, isHead, heads);
+  CHECK(values == expected);
+  CHECK(heads == expectedHeads);
+}
+
+TEST_CASE("Compaction with no survivors draws nothing", "[CullCompaction]") {
+  const auto scene = makeScene({10, 100, 1});
+  const auto visible = std::vector<uint32_t>(scene.instances.size(), 0);
+  const auto result = runCompaction(scene, visible);
+
+  CHECK(result.atomics == 0);
+  CHECK(result.drawCount == 0);
+  CHECK(std::ranges::all_of(result.visibleObjects, [](uint32_t v) { return v == UINT32_MAX; }));
+
+  SECTION("Nor with nothing to draw at all") {
+    const auto empty = runCompaction(makeScene({}), {});
+    CHECK(empty.atomics == 0);
+    CHECK(empty.drawCount == 0);
+  }
+}
+
+TEST_CASE("Compaction with every instance surviving draws every batch whole", "[CullCompaction]") {
+  const auto scene = makeScene({64, 1, 200, 30});
+  const auto visible = std::vector<uint32_t>(scene.instances.size(), 1);
+  const auto result = runCompaction(scene, visible);
+
+  checkCompacted(scene, visible, result);
+  CHECK(result.drawCount == scene.batches.size());
+  for (uint32_t i = 0; i < scene.instances.size(); ++i) {
+    CHECK(result.visibleObjects[i] == scene.instances[i].objectId);
+  }
+}
+
+TEST_CASE("Compaction handles instance counts that aren't a multiple of the workgroup",
+          "[CullCompaction]") {
+  for (const auto count : {1U, 63U, 65U, 127U, 1000U}) {
+    const auto scene = makeScene({count});
+    const auto visible = everyNth(count, 2);
+    const auto result = runCompaction(scene, visible);
+
+    checkCompacted(scene, visible, result);
+    // One batch with survivors in every workgroup, so one atomic per workgroup
+    CHECK(result.atomics == (count + tr::CullWorkgroupSize - 1) / tr::CullWorkgroupSize);
+  }
+}
+
+TEST_CASE("Compaction takes one atomic per batch run in a workgroup", "[CullCompaction]") {
+  // The first workgroup covers all of batches 0 to 2 and the start of batch 3, the second the
+  // rest of batch 3 and all of batch 4.
+  const auto scene = makeScene({5, 20, 9, 40, 30});
+  auto visible = std::vector<uint32_t>(scene.instances.size(), 1);
+
+  SECTION("Batches without survivors are dropped from the draw") {
+    // Nothing in batch 1 or batch 4 survives
+    std::fill_n(visible.begin() + 5, 20, 0);
+    std::fill_n(visible.begin() + 74, 30, 0);
+    const auto result = runCompaction(scene, visible);
+
+    checkCompacted(scene, visible, result);
+    CHECK(result.drawCount == 3);
+    // Batches 0, 2 and 3 in the first workgroup, batch 3 in the second
+    CHECK(result.atomics == 4);
+  }
+
+  SECTION("Scattered survivors") {
+    visible = everyNth(scene.instances.size(), 4);
+    const auto result = runCompaction(scene, visible);
+
+    checkCompacted(scene, visible, result);
+    CHECK(result.drawCount == 5);
+    CHECK(result.atomics == 6);
+  }
+}
+
+TEST_CASE("compactDrawCommands packs across workgroup sized chunks", "[CullCompaction]") {
+  constexpr uint32_t CommandCount = 200;
+  auto commands = std::vector<tr::GpuIndirectCommand>{};
+  auto expected = std::vector<tr::GpuIndirectCommand>{};
+  for (uint32_t i = 0; i < CommandCount; ++i) {
+    const auto command = tr::GpuIndirectCommand{.vertexCount = 3,
+                                                .instanceCount = i % 5 == 0 ? 0 : i,
+                                                .firstVertex = i,
+                                                .firstInstance = i};
+    commands.push_back(command);
+    if (command.instanceCount > 0) {
+      expected.push_back(command);
+    }
+  }
+
+  const auto packed = tr::compactDrawCommands(commands);
+  REQUIRE(packed == expected.size());
+  for (uint32_t i = 0; i < packed; ++i) {
+    CHECK(commands[i].firstVertex == expected[i].firstVertex);
+    CHECK(commands[i].instanceCount == expected[i].instanceCount);
+  }
+}
+
+TEST_CASE("Late survivors pack back from the end of their batch, clear of the early ones",
+          "[CullCompaction]") {
+  const auto scene = makeScene({5, 20, 9, 40, 30});
+  // Every third instance was visible last frame and drawn early, every other one the late phase
+  // finds visible. The two phases never share an instance.
+  const auto early = everyNth(scene.instances.size(), 3);
+  auto late = everyNth(scene.instances.size(), 2);
+  for (size_t i = 0; i < late.size(); ++i) {
+    late[i] = early[i] != 0 ? 0 : late[i];
+  }
+
+  auto visibleObjects = std::vector<uint32_t>(scene.instances.size(), UINT32_MAX);
+  auto earlyCommands = scene.commands;
+  auto lateCommands = scene.commands;
+  tr::compactVisibleInstances(
+      scene.instances, early, scene.batches, earlyCommands, visibleObjects);
+  tr::compactVisibleInstances(
+      scene.instances, late, scene.batches, lateCommands, visibleObjects, tr::CullPhase::Late);
+  const auto earlyDraws = tr::compactDrawCommands(earlyCommands);
+  const auto lateDraws =
+      tr::compactDrawCommands(lateCommands, tr::CullPhase::Late, scene.batches);
+
+  const auto drawnBy = [&](const std::vector<tr::GpuIndirectCommand>& commands, uint32_t count) {
+    auto drawn = std::vector<uint32_t>{};
+    for (uint32_t draw = 0; draw < count; ++draw) {
+      const auto& command = commands[draw];
+      const auto& batch = scene.batches[command.firstVertex];
+      // Each command only reads from its own batch's range
+      CHECK(command.firstInstance >= batch.firstInstance);
+      CHECK(command.firstInstance + command.instanceCount <=
+            batch.firstInstance + batch.instanceCount);
+      drawn.insert(drawn.end(),
+                   visibleObjects.begin() + command.firstInstance,
+                   visibleObjects.begin() + command.firstInstance + command.instanceCount);
+    }
+    std::ranges::sort(drawn);
+    return drawn;
+  };
+
+  const auto expectedOf = [&](const std::vector<uint32_t>& visible) {
+    auto expected = std::vector<uint32_t>{};
+    for (uint32_t i = 0; i < scene.instances.size(); ++i) {
+      if (visible[i] != 0) {
+        expected.push_back(scene.instances[i].objectId);
+      }
+    }
+    return expected;
+  };
+
+  // Had the late phase written over the early one's survivors, the early draws would come back
+  // with late objects in them
+  CHECK(earlyDraws == scene.batches.size());
+  CHECK(lateDraws == scene.batches.size());
+  CHECK(drawnBy(earlyCommands, earlyDraws) == expectedOf(early));
+  CHECK(drawnBy(lateCommands, lateDraws) == expectedOf(late));
+}
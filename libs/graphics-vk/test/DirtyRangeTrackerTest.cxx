@@ -0,0 +1,66 @@
+#include "r3/DirtyRangeTracker.hpp"
+
+using tr::ObjectRange;
+
+TEST_CASE("DirtyRangeTracker returns everything to a consumer that never synced",
+          "[DirtyRangeTracker]") {
+  tr::DirtyRangeTracker tracker;
+  const auto versions = std::vector<uint64_t>{1, 1, 1, 1};
+
+  const auto& ranges = tracker.collect(0, versions);
+  REQUIRE(ranges.size() == 1);
+  CHECK(ranges[0] == ObjectRange{.first = 0, .count = 4});
+}
+
+TEST_CASE("DirtyRangeTracker only returns objects newer than the synced tick",
+          "[DirtyRangeTracker]") {
+  tr::DirtyRangeTracker tracker{0};
+  const auto versions = std::vector<uint64_t>{1, 3, 3, 1, 2, 1, 4};
+
+  tracker.markSynced(0, 2);
+  const auto& ranges = tracker.collect(0, versions);
+  REQUIRE(ranges.size() == 2);
+  CHECK(ranges[0] == ObjectRange{.first = 1, .count = 2});
+  CHECK(ranges[1] == ObjectRange{.first = 6, .count = 1});
+
+  tracker.markSynced(0, 4);
+  CHECK(tracker.collect(0, versions).empty());
+}
+
+TEST_CASE("DirtyRangeTracker merges runs separated by small gaps", "[DirtyRangeTracker]") {
+  const auto versions = std::vector<uint64_t>{2, 1, 1, 2, 1, 1, 1, 1, 2};
+
+  SECTION("Gaps within the merge distance are absorbed") {
+    tr::DirtyRangeTracker tracker{2};
+    tracker.markSynced(0, 1);
+    const auto& ranges = tracker.collect(0, versions);
+    REQUIRE(ranges.size() == 2);
+    CHECK(ranges[0] == ObjectRange{.first = 0, .count = 4});
+    CHECK(ranges[1] == ObjectRange{.first = 8, .count = 1});
+  }
+
+  SECTION("A large enough gap merges everything") {
+    tr::DirtyRangeTracker tracker{4};
+    tracker.markSynced(0, 1);
+    const auto& ranges = tracker.collect(0, versions);
+    REQUIRE(ranges.size() == 1);
+    CHECK(ranges[0] == ObjectRange{.first = 0, .count = 9});
+  }
+}
+
+TEST_CASE("DirtyRangeTracker tracks consumers independently", "[DirtyRangeTracker]") {
+  tr::DirtyRangeTracker tracker{0};
+  const auto versions = std::vector<uint64_t>{1, 2, 3};
+
+  tracker.markSynced(0, 3);
+  tracker.markSynced(2, 1);
+
+  CHECK(tracker.collect(0, versions).empty());
+  CHECK(tracker.collect(1, versions).size() == 1);
+  CHECK(tracker.collect(1, versions)[0] == ObjectRange{.first = 0, .count = 3});
+  CHECK(tracker.collect(2, versions)[0] == ObjectRange{.first = 1, .count = 2});
+
+  tracker.invalidate(0);
+  CHECK(tracker.getSyncedTick(0) == 0);
+  CHECK(tracker.collect(0, versions)[0] == ObjectRange{.first = 0, .count = 3});
+}
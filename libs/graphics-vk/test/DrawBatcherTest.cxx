@@ -0,0 +1,86 @@
+#include "r3/DrawBatcher.hpp"
+
+namespace {
+
+/// Objects cycle through `meshCount` regions and `textureCount` textures, with each object's
+/// material in its own slot the way FrameTables lays them out.
+auto makeScene(uint32_t objectCount, uint32_t meshCount, uint32_t textureCount)
+    -> std::pair<std::vector<tr::GpuObjectData>, std::vector<tr::GpuMaterialData>> {
+  auto objects = std::vector<tr::GpuObjectData>{};
+  auto materials = std::vector<tr::GpuMaterialData>{};
+  for (uint32_t i = 0; i < objectCount; ++i) {
+    objects.push_back(tr::GpuObjectData{.geometryRegionId = i % meshCount, .materialId = i});
+    materials.push_back(tr::GpuMaterialData{.baseColor = glm::vec4{1.f},
+                                            .albedoTextureId = (i / 7) % textureCount});
+  }
+  return {objects, materials};
+}
+
+}
+
+TEST_CASE("DrawBatcher collapses objects sharing a mesh and material", "[DrawBatcher]") {
+  constexpr uint32_t ObjectCount = 10000;
+  constexpr uint32_t MeshCount = 3;
+  constexpr uint32_t TextureCount = 2;
+
+  const auto [objects, materials] = makeScene(ObjectCount, MeshCount, TextureCount);
+  auto batcher = tr::DrawBatcher{};
+  batcher.build(objects, materials);
+
+  const auto& batches = batcher.getBatches();
+  const auto& instances = batcher.getInstances();
+  CHECK(batches.size() == MeshCount * TextureCount);
+  REQUIRE(instances.size() == ObjectCount);
+
+  // Batches tile the instance list, and every instance in one draws the batch's mesh and material
+  auto nextInstance = 0U;
+  auto mismatches = 0;
+  for (uint32_t batchIndex = 0; batchIndex < batches.size(); ++batchIndex) {
+    const auto& batch = batches[batchIndex];
+    CHECK(batch.firstInstance == nextInstance);
+    CHECK(batch.instanceCount > 0);
+    const auto& first = objects[instances[batch.firstInstance].objectId];
+    const auto end = batch.firstInstance + batch.instanceCount;
+    for (auto instance = batch.firstInstance; instance < end; ++instance) {
+      CHECK(instances[instance].batchId == batchIndex);
+      const auto& object = objects[instances[instance].objectId];
+      if (object.geometryRegionId != batch.geometryRegionId ||
+          materials[object.materialId].albedoTextureId !=
+              materials[first.materialId].albedoTextureId) {
+        ++mismatches;
+      }
+    }
+    nextInstance += batch.instanceCount;
+  }
+  CHECK(mismatches == 0);
+  CHECK(nextInstance == ObjectCount);
+
+  // Every object is drawn exactly once
+  auto seen = std::vector<bool>(ObjectCount, false);
+  for (const auto& instance : instances) {
+    REQUIRE(instance.objectId < ObjectCount);
+    CHECK_FALSE(seen[instance.objectId]);
+    seen[instance.objectId] = true;
+  }
+}
+
+TEST_CASE("DrawBatcher keeps slot order within a batch", "[DrawBatcher]") {
+  const auto [objects, materials] = makeScene(20, 2, 1);
+  auto batcher = tr::DrawBatcher{};
+  batcher.build(objects, materials);
+
+  REQUIRE(batcher.getBatches().size() == 2);
+  const auto& instances = batcher.getInstances();
+  for (const auto& batch : batcher.getBatches()) {
+    const auto end = batch.firstInstance + batch.instanceCount;
+    for (auto instance = batch.firstInstance + 1; instance < end; ++instance) {
+      CHECK(instances[instance - 1].objectId < instances[instance].objectId);
+    }
+  }
+
+  SECTION("Rebuilding an empty scene clears the batches") {
+    batcher.build({}, {});
+    CHECK(batcher.getBatches().empty());
+    CHECK(batcher.getInstances().empty());
+  }
+}
@@ -0,0 +1,264 @@
+#include "MockRenderPass.hpp"
+#include "r3/graph/FrameGraphCompiler.hpp"
+#include "r3/graph/barriers/BarrierScheduleCompiler.hpp"
+
+namespace tr {
+
+namespace {
+
+auto imageRead(ImageAlias alias) -> ImageUsageInfo {
+  return ImageUsageInfo{.alias = alias,
+                        .accessFlags = vk::AccessFlagBits2::eShaderSampledRead,
+                        .stageFlags = vk::PipelineStageFlagBits2::eFragmentShader,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eShaderReadOnlyOptimal};
+}
+
+auto imageWrite(ImageAlias alias) -> ImageUsageInfo {
+  return ImageUsageInfo{.alias = alias,
+                        .accessFlags = vk::AccessFlagBits2::eColorAttachmentWrite,
+                        .stageFlags = vk::PipelineStageFlagBits2::eColorAttachmentOutput,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::eColorAttachmentOptimal};
+}
+
+auto bufferRead(BufferAliasVariant alias) -> BufferUsageInfo {
+  return BufferUsageInfo{.alias = alias,
+                         .accessFlags = vk::AccessFlagBits2::eShaderRead,
+                         .stageFlags = vk::PipelineStageFlagBits2::eComputeShader};
+}
+
+auto bufferWrite(BufferAliasVariant alias) -> BufferUsageInfo {
+  return BufferUsageInfo{.alias = alias,
+                         .accessFlags = vk::AccessFlagBits2::eShaderWrite,
+                         .stageFlags = vk::PipelineStageFlagBits2::eComputeShader};
+}
+
+auto passOrderOf(const std::vector<std::unique_ptr<IRenderPass>>& passes,
+                 const CompiledFrameGraph& compiled) -> std::vector<PassId> {
+  auto order = std::vector<PassId>{};
+  for (const auto index : compiled.passOrder) {
+    order.push_back(passes[index]->getId());
+  }
+  return order;
+}
+
+auto barrierCount(const std::vector<PassBarriers>& schedule) -> size_t {
+  auto count = size_t{0};
+  for (const auto& pass : schedule) {
+    count += pass.imageBarriers.size() + pass.bufferBarriers.size();
+  }
+  return count;
+}
+
+/// The passes R3Renderer adds, in the order it adds them
+auto makeRendererPasses(bool compositionReadsGui) -> std::vector<std::unique_ptr<IRenderPass>> {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferWrites = {bufferWrite(BufferAlias::IndirectCommand)},
+                    .bufferReads = {bufferRead(BufferAlias::ObjectData),
+                                    bufferRead(GlobalBufferAlias::ObjectVisibility)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::GeometryColorImage),
+                                    imageWrite(ImageAlias::DepthImage)},
+                    .bufferReads = {bufferRead(BufferAlias::IndirectCommand)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::DepthPyramid,
+      PassGraphInfo{.imageReads = {imageRead(ImageAlias::DepthImage)},
+                    .bufferWrites = {bufferWrite(GlobalBufferAlias::DepthPyramid)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::LateCulling,
+      PassGraphInfo{.bufferWrites = {bufferWrite(BufferAlias::LateIndirectCommand),
+                                     bufferWrite(GlobalBufferAlias::ObjectVisibility)},
+                    .bufferReads = {bufferRead(BufferAlias::ObjectData),
+                                    bufferRead(GlobalBufferAlias::DepthPyramid),
+                                    bufferRead(GlobalBufferAlias::ObjectVisibility)}}));
+  // Draws over what Forward left in the attachments
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::LateForward,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::GeometryColorImage),
+                                    imageWrite(ImageAlias::DepthImage)},
+                    .imageReads = {imageRead(ImageAlias::GeometryColorImage),
+                                   imageRead(ImageAlias::DepthImage)},
+                    .bufferReads = {bufferRead(BufferAlias::LateIndirectCommand)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::ImGui,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::GuiColorImage)}}));
+
+  auto compositionReads = std::unordered_set<ImageUsageInfo>{
+      imageRead(ImageAlias::GeometryColorImage),
+  };
+  if (compositionReadsGui) {
+    compositionReads.insert(imageRead(ImageAlias::GuiColorImage));
+  }
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Composition,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::SwapchainImage)},
+                    .imageReads = compositionReads}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Present,
+      PassGraphInfo{.imageReads = {ImageUsageInfo{
+                        .alias = ImageAlias::SwapchainImage,
+                        .accessFlags = vk::AccessFlagBits2::eNone,
+                        .stageFlags = vk::PipelineStageFlagBits2::eBottomOfPipe,
+                        .aspectFlags = vk::ImageAspectFlagBits::eColor,
+                        .layout = vk::ImageLayout::ePresentSrcKHR,
+                    }}}));
+  return passes;
+}
+
+}
+
+TEST_CASE("FrameGraphCompiler orders passes by their dependencies", "[FrameGraph]") {
+  const auto passes = makeRendererPasses(true);
+  const auto compiled = FrameGraphCompiler::compile(passes);
+
+  CHECK(compiled.culledPasses.empty());
+
+  // ImGui depends on nothing, so it fills the gap between culling and the draws waiting on it
+  CHECK(passOrderOf(passes, compiled) == std::vector<PassId>{PassId::Culling,
+                                                             PassId::ImGui,
+                                                             PassId::Forward,
+                                                             PassId::DepthPyramid,
+                                                             PassId::LateCulling,
+                                                             PassId::LateForward,
+                                                             PassId::Composition,
+                                                             PassId::Present});
+}
+
+TEST_CASE("FrameGraphCompiler finds where each transient image is used", "[FrameGraph]") {
+  const auto passes = makeRendererPasses(true);
+  const auto compiled = FrameGraphCompiler::compile(passes);
+
+  const auto lifetimeOf = [&](ImageAlias alias) {
+    const auto it = std::ranges::find(compiled.transientImages, alias, &ResourceLifetime::alias);
+    REQUIRE(it != compiled.transientImages.end());
+    return std::pair{it->firstUse, it->lastUse};
+  };
+
+  // Culling, ImGui, Forward, DepthPyramid, LateCulling, LateForward, Composition, Present. The
+  // late draws load what the early ones left, which doesn't carry anything between frames.
+  CHECK(compiled.transientImages.size() == 3);
+  CHECK(lifetimeOf(ImageAlias::GuiColorImage) == std::pair<size_t, size_t>{1, 6});
+  CHECK(lifetimeOf(ImageAlias::GeometryColorImage) == std::pair<size_t, size_t>{2, 6});
+  CHECK(lifetimeOf(ImageAlias::DepthImage) == std::pair<size_t, size_t>{2, 5});
+
+  SECTION("An image read before it's written carries over between frames") {
+    auto historyPasses = makeRendererPasses(true);
+    historyPasses.insert(historyPasses.begin(),
+                         std::make_unique<MockRenderPass>(
+                             PassId::PostProcessing,
+                             PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::SwapchainImage)},
+                                           .imageReads = {imageRead(ImageAlias::DepthImage)}}));
+    const auto history = FrameGraphCompiler::compile(historyPasses);
+    CHECK(std::ranges::find(history.transientImages,
+                            ImageAlias::DepthImage,
+                            &ResourceLifetime::alias) == history.transientImages.end());
+  }
+}
+
+TEST_CASE("FrameGraphCompiler keeps a pass whose writes the next frame reads", "[FrameGraph]") {
+  // Early culling reads the visibility the last frame's late culling wrote, and has to read it
+  // before this frame's late culling replaces it
+  const auto passes = makeRendererPasses(true);
+  const auto order = passOrderOf(passes, FrameGraphCompiler::compile(passes));
+
+  const auto culling = std::ranges::find(order, PassId::Culling);
+  const auto lateCulling = std::ranges::find(order, PassId::LateCulling);
+  REQUIRE(lateCulling != order.end());
+  CHECK(culling < lateCulling);
+}
+
+TEST_CASE("FrameGraphCompiler culls passes nothing reads", "[FrameGraph]") {
+  // Composition no longer samples the GUI image, so ImGui draws for nobody
+  const auto passes = makeRendererPasses(false);
+  const auto compiled = FrameGraphCompiler::compile(passes);
+
+  CHECK(compiled.culledPasses == std::vector<PassId>{PassId::ImGui});
+  CHECK(passOrderOf(passes, compiled) == std::vector<PassId>{PassId::Culling,
+                                                             PassId::Forward,
+                                                             PassId::DepthPyramid,
+                                                             PassId::LateCulling,
+                                                             PassId::LateForward,
+                                                             PassId::Composition,
+                                                             PassId::Present});
+
+  SECTION("A culled pass needs no barriers") {
+    const auto all = BarrierScheduleCompiler::compile(passes);
+    const auto live = BarrierScheduleCompiler::compile(passes, compiled.passOrder);
+    CHECK(live.firstRun.size() == passes.size() - 1);
+    // Its one barrier moves the GUI image out of undefined
+    CHECK(barrierCount(live.firstRun) == barrierCount(all.firstRun) - 1);
+  }
+}
+
+TEST_CASE("FrameGraphCompiler culls ImGui while the overlay is hidden", "[FrameGraph]") {
+  // Composition still declares the GUI read, but a hidden overlay disables the image
+  const auto passes = makeRendererPasses(true);
+  const auto disabled = std::unordered_set<ImageAlias>{ImageAlias::GuiColorImage};
+  const auto compiled = FrameGraphCompiler::compile(passes, disabled);
+
+  CHECK(compiled.culledPasses == std::vector<PassId>{PassId::ImGui});
+  CHECK(passOrderOf(passes, compiled) == std::vector<PassId>{PassId::Culling,
+                                                             PassId::Forward,
+                                                             PassId::DepthPyramid,
+                                                             PassId::LateCulling,
+                                                             PassId::LateForward,
+                                                             PassId::Composition,
+                                                             PassId::Present});
+  CHECK(FrameGraphCompiler::compile(passes).culledPasses.empty());
+
+  SECTION("Composition waits on nothing for the image it no longer reads") {
+    const auto withoutRead = makeRendererPasses(false);
+    const auto expected = BarrierScheduleCompiler::compile(
+        withoutRead, FrameGraphCompiler::compile(withoutRead).passOrder);
+    const auto hidden =
+        BarrierScheduleCompiler::compile(passes, compiled.passOrder, {}, {}, {}, disabled);
+    CHECK(barrierCount(hidden.firstRun) == barrierCount(expected.firstRun));
+    CHECK(barrierCount(hidden.steadyState) == barrierCount(expected.steadyState));
+  }
+}
+
+TEST_CASE("FrameGraphCompiler runs a write after the reads before it", "[FrameGraph]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  // Forward writes the color image, Composition reads it, then PostProcessing writes it again
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Forward,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::GeometryColorImage)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Composition,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::SwapchainImage)},
+                    .imageReads = {imageRead(ImageAlias::GeometryColorImage)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::PostProcessing,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::GeometryColorImage)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::ImGui,
+      PassGraphInfo{.imageWrites = {imageWrite(ImageAlias::SwapchainImage)},
+                    .imageReads = {imageRead(ImageAlias::GeometryColorImage)}}));
+
+  const auto compiled = FrameGraphCompiler::compile(passes);
+
+  CHECK(compiled.culledPasses.empty());
+  CHECK(passOrderOf(passes, compiled) == std::vector<PassId>{PassId::Forward,
+                                                             PassId::Composition,
+                                                             PassId::PostProcessing,
+                                                             PassId::ImGui});
+}
+
+TEST_CASE("FrameGraphCompiler leaves a graph without the swapchain whole", "[FrameGraph]") {
+  auto passes = std::vector<std::unique_ptr<IRenderPass>>{};
+  passes.push_back(std::make_unique<MockRenderPass>(
+      PassId::Culling,
+      PassGraphInfo{.bufferWrites = {bufferWrite(BufferAlias::IndirectCommand)}}));
+  passes.push_back(std::make_unique<MockRenderPass>(PassId::ImGui, PassGraphInfo{}));
+
+  const auto compiled = FrameGraphCompiler::compile(passes);
+
+  CHECK(compiled.culledPasses.empty());
+  CHECK(compiled.passOrder == std::vector<size_t>{0, 1});
+}
+
+}
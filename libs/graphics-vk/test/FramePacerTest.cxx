@@ -0,0 +1,100 @@
+#include "fx/LockFreeStateBuffer.hpp"
+#include "r3/FramePacer.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+auto publish(tr::IStateBuffer& buffer, uint64_t tag, tr::Timestamp t) -> void {
+  buffer.writeState(t, [tag](tr::SimState& state) {
+    state.clear();
+    state.tag = tag;
+  });
+}
+
+}
+
+TEST_CASE("FramePacer draws the newest tick in Latest mode", "[FramePacer]") {
+  auto buffer = std::make_shared<tr::LockFreeStateBuffer>();
+  auto pacer = tr::FramePacer{buffer, tr::FramePacing::Latest, milliseconds(0), milliseconds(20)};
+
+  const auto base = steady_clock::now();
+  publish(*buffer, 0, base);
+  publish(*buffer, 1, base + milliseconds(5));
+
+  auto paced = pacer.acquire();
+  REQUIRE(paced.has_value());
+  CHECK(paced->target == base + milliseconds(5));
+  CHECK(paced->states.previous().tag == 0);
+  CHECK(paced->states.next().tag == 1);
+  paced.reset();
+
+  SECTION("Redraws the newest tick if no new one lands in time") {
+    const auto waitStart = steady_clock::now();
+    auto stale = pacer.acquire();
+    REQUIRE(stale.has_value());
+    CHECK(stale->states.next().tag == 1);
+    CHECK(steady_clock::now() - waitStart >= milliseconds(20));
+  }
+
+  SECTION("Wakes as soon as the next tick is published") {
+    auto next = tr::FramePacer{buffer, tr::FramePacing::Latest, milliseconds(0), seconds(5)};
+    REQUIRE(next.acquire().has_value());
+    // Only publish once the first acquire has taken tick 1, so tick 2 is left for the second
+    std::thread producer([&]() {
+      std::this_thread::sleep_for(milliseconds(5));
+      publish(*buffer, 2, base + milliseconds(10));
+    });
+    const auto waitStart = steady_clock::now();
+    auto woken = next.acquire();
+    const auto waited = steady_clock::now() - waitStart;
+    producer.join();
+
+    REQUIRE(woken.has_value());
+    CHECK(woken->states.next().tag == 2);
+    CHECK(waited < seconds(5));
+  }
+}
+
+TEST_CASE("FramePacer draws behind now in Interpolate mode", "[FramePacer]") {
+  SECTION("Brackets now minus the lag") {
+    auto buffer = std::make_shared<tr::LockFreeStateBuffer>();
+    auto pacer =
+        tr::FramePacer{buffer, tr::FramePacing::Interpolate, milliseconds(50), milliseconds(20)};
+    const auto base = steady_clock::now();
+    publish(*buffer, 0, base - milliseconds(200));
+    publish(*buffer, 1, base + milliseconds(200));
+
+    auto paced = pacer.acquire();
+    REQUIRE(paced.has_value());
+    CHECK(paced->states.previous().tag == 0);
+    CHECK(paced->states.next().tag == 1);
+    CHECK(paced->target > base - milliseconds(200));
+    CHECK(paced->target <= steady_clock::now() - milliseconds(50));
+  }
+
+  SECTION("Waits for a tick past the target") {
+    auto buffer = std::make_shared<tr::LockFreeStateBuffer>();
+    auto pacer = tr::FramePacer{buffer, tr::FramePacing::Interpolate, milliseconds(0), seconds(5)};
+    publish(*buffer, 0, steady_clock::now() - milliseconds(100));
+
+    std::thread producer([&]() {
+      std::this_thread::sleep_for(milliseconds(5));
+      publish(*buffer, 1, steady_clock::now() + milliseconds(100));
+    });
+    auto paced = pacer.acquire();
+    producer.join();
+
+    REQUIRE(paced.has_value());
+    CHECK(paced->states.previous().tag == 0);
+    CHECK(paced->states.next().tag == 1);
+  }
+
+  SECTION("Gives up when the game thread stalls") {
+    auto buffer = std::make_shared<tr::LockFreeStateBuffer>();
+    auto pacer =
+        tr::FramePacer{buffer, tr::FramePacing::Interpolate, milliseconds(0), milliseconds(10)};
+    publish(*buffer, 0, steady_clock::now() - milliseconds(100));
+    CHECK_FALSE(pacer.acquire().has_value());
+  }
+}
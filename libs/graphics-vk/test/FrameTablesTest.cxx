@@ -0,0 +1,231 @@
+#include "r3/FrameTables.hpp"
+
+namespace {
+
+constexpr uint32_t ObjectCount = 8;
+
+auto makeState(uint64_t tick,
+               const std::vector<tr::Handle<tr::Geometry>>& geometries,
+               const std::vector<uint64_t>& versions) -> tr::SimState {
+  auto state = tr::SimState{};
+  state.tick = tick;
+  for (uint32_t i = 0; i < versions.size(); ++i) {
+    state.objectMetadata.push_back(
+        tr::GpuObjectData{.transformIndex = i, .rotationIndex = i, .scaleIndex = i});
+    // Odd objects are textured
+    state.stateHandles.push_back(
+        {.geometryHandle = geometries[i % geometries.size()],
+         .textureHandle = i % 2 == 1 ? std::make_optional(tr::Handle<tr::TextureTag>{i})
+                                     : std::nullopt});
+    state.entityIds.push_back(i);
+    state.objectVersions.push_back(versions[i]);
+  }
+  return state;
+}
+
+/// Stands in for the geometry allocator, every region gets distinct offsets
+auto regionFor(tr::Handle<tr::GeometryRegion> handle) -> tr::GpuGeometryRegionData {
+  const auto id = static_cast<uint32_t>(handle.id);
+  return tr::GpuGeometryRegionData{.indexCount = (id + 1) * 3,
+                                   .indexOffset = id * 1000,
+                                   .positionOffset = id * 500};
+}
+
+}
+
+TEST_CASE("FrameTables keeps object tables indexed by object slot", "[FrameTables]") {
+  auto mapper = std::make_shared<tr::GeometryHandleMapper>();
+  const auto geometry = mapper->toPublic(tr::Handle<tr::GeometryRegion>{3});
+  auto regionLookups = 0;
+  auto textureLookups = 0;
+  auto tables = tr::FrameTables{mapper,
+                                [&regionLookups](tr::Handle<tr::GeometryRegion> handle) {
+                                  ++regionLookups;
+                                  return regionFor(handle);
+                                },
+                                [&textureLookups](tr::Handle<tr::TextureTag> handle) {
+                                  ++textureLookups;
+                                  return static_cast<uint32_t>(handle.id + 100);
+                                }};
+
+  tables.update(makeState(1, {geometry}, std::vector<uint64_t>(ObjectCount, 1)));
+
+  REQUIRE(tables.getObjectData().size() == ObjectCount);
+  REQUIRE(tables.getMaterials().size() == ObjectCount);
+  CHECK(tables.getGeometryRegions().size() == 1);
+  CHECK(regionLookups == 1);
+  CHECK(textureLookups == ObjectCount / 2);
+  // Untextured objects share one batch, textured ones each have their own texture
+  CHECK(tables.getDrawBatches().size() == 1 + (ObjectCount / 2));
+  for (uint32_t i = 0; i < ObjectCount; ++i) {
+    CHECK(tables.getObjectData()[i].geometryRegionId == 0);
+    CHECK(tables.getObjectData()[i].materialId == i);
+    CHECK(tables.getMaterials()[i].albedoTextureId == (i % 2 == 1 ? i + 100 : 0));
+  }
+
+  SECTION("Only objects that changed are looked up again") {
+    const auto texturesBefore = textureLookups;
+    const auto batchesBefore = tables.getBatchGeneration();
+    auto versions = std::vector<uint64_t>(ObjectCount, 1);
+    versions[5] = 2;
+    tables.update(makeState(2, {geometry}, versions));
+    CHECK(regionLookups == 1);
+    CHECK(textureLookups == texturesBefore + 1);
+    // Same mesh and texture as before, so nothing to rebatch
+    CHECK(tables.getBatchGeneration() == batchesBefore);
+  }
+
+  SECTION("Removing an object shrinks the tables without touching the others") {
+    const auto texturesBefore = textureLookups;
+    tables.update(makeState(3, {geometry}, std::vector<uint64_t>(ObjectCount - 1, 1)));
+    CHECK(tables.getObjectData().size() == ObjectCount - 1);
+    CHECK(tables.getMaterials().size() == ObjectCount - 1);
+    CHECK(textureLookups == texturesBefore);
+    CHECK(tables.getDrawInstances().size() == ObjectCount - 1);
+  }
+}
+
+TEST_CASE("FrameTables shares one region entry per mesh", "[FrameTables]") {
+  constexpr uint32_t SceneSize = 1000;
+  constexpr uint32_t MeshCount = 3;
+
+  auto mapper = std::make_shared<tr::GeometryHandleMapper>();
+  auto meshes = std::vector<tr::Handle<tr::Geometry>>{};
+  for (uint32_t i = 0; i < MeshCount; ++i) {
+    meshes.push_back(mapper->toPublic(tr::Handle<tr::GeometryRegion>{10 + i}));
+  }
+  auto regionLookups = 0;
+  auto tables = tr::FrameTables{mapper,
+                                [&regionLookups](tr::Handle<tr::GeometryRegion> handle) {
+                                  ++regionLookups;
+                                  return regionFor(handle);
+                                },
+                                []([[maybe_unused]] tr::Handle<tr::TextureTag> handle) {
+                                  return 0U;
+                                }};
+
+  const auto state = makeState(1, meshes, std::vector<uint64_t>(SceneSize, 1));
+  tables.update(state);
+
+  CHECK(regionLookups == MeshCount);
+  CHECK(tables.getGeometryRegions().size() == MeshCount);
+  CHECK(tables.getRegionGeneration() == MeshCount);
+  for (const auto version : tables.getRegionVersions()) {
+    CHECK(version > 0);
+  }
+
+  // Every object resolves to exactly the region a per object lookup would have given it, which is
+  // all a draw reads from the region table.
+  const auto& regions = tables.getGeometryRegions();
+  auto mismatches = 0;
+  for (uint32_t i = 0; i < SceneSize; ++i) {
+    const auto expected = regionFor(*mapper->toInternal(state.stateHandles[i].geometryHandle));
+    const auto& actual = regions[tables.getObjectData()[i].geometryRegionId];
+    if (actual.indexCount != expected.indexCount || actual.indexOffset != expected.indexOffset ||
+        actual.positionOffset != expected.positionOffset) {
+      ++mismatches;
+    }
+  }
+  CHECK(mismatches == 0);
+
+  // Every object has the same texture, so there's a batch per mesh, each with a command ready for
+  // culling to add instances to
+  const auto& batches = tables.getDrawBatches();
+  const auto& commands = tables.getDrawCommands();
+  REQUIRE(batches.size() == MeshCount);
+  REQUIRE(commands.size() == MeshCount);
+  for (uint32_t i = 0; i < MeshCount; ++i) {
+    const auto& region = regions[batches[i].geometryRegionId];
+    CHECK(commands[i].vertexCount == region.indexCount);
+    CHECK(commands[i].firstVertex == region.indexOffset);
+    CHECK(commands[i].firstInstance == batches[i].firstInstance);
+    CHECK(commands[i].instanceCount == 0);
+  }
+
+  SECTION("A reused mapper entry is looked up again") {
+    const auto generationBefore = tables.getRegionGeneration();
+    mapper->erase(meshes[1]);
+    meshes[1] = mapper->toPublic(tr::Handle<tr::GeometryRegion>{42});
+    tables.update(makeState(2, meshes, std::vector<uint64_t>(SceneSize, 2)));
+
+    CHECK(tables.getGeometryRegions().size() == MeshCount);
+    CHECK(tables.getRegionGeneration() == generationBefore + 1);
+    const auto reusedIndex = tr::GeometryHandleMapper::indexOf(meshes[1]);
+    CHECK(tables.getGeometryRegions()[reusedIndex].indexOffset == 42 * 1000);
+
+    // The batch drawing it picks up the new region too
+    const auto batch = std::ranges::find_if(tables.getDrawBatches(), [&](const auto& candidate) {
+      return candidate.geometryRegionId == reusedIndex;
+    });
+    REQUIRE(batch != tables.getDrawBatches().end());
+    const auto command = tables.getDrawCommands()[batch - tables.getDrawBatches().begin()];
+    CHECK(command.firstVertex == 42 * 1000);
+  }
+
+  SECTION("A stale handle leaves its entry empty without disturbing the rest of the range") {
+    const auto stale = mapper->toPublic(tr::Handle<tr::GeometryRegion>{50});
+    mapper->erase(stale);
+    const auto lookupsBefore = regionLookups;
+    tables.update(makeState(3, {meshes[0], stale}, std::vector<uint64_t>(SceneSize, 3)));
+
+    CHECK(regionLookups == lookupsBefore);
+    const auto& objects = tables.getObjectData();
+    CHECK(objects[0].geometryRegionId == tr::GeometryHandleMapper::indexOf(meshes[0]));
+    CHECK(tables.getGeometryRegions()[objects[0].geometryRegionId].indexOffset == 10 * 1000);
+    CHECK(tables.getGeometryRegions()[objects[1].geometryRegionId].indexCount == 0);
+  }
+}
+
+TEST_CASE("FrameTables hands each frame in flight only the writes it's missing", "[FrameTables]") {
+  auto mapper = std::make_shared<tr::GeometryHandleMapper>();
+  const auto geometry = mapper->toPublic(tr::Handle<tr::GeometryRegion>{3});
+  auto tables = tr::FrameTables{mapper,
+                                regionFor,
+                                []([[maybe_unused]] tr::Handle<tr::TextureTag> handle) {
+                                  return 0U;
+                                }};
+
+  const auto writesTo = [](const std::vector<tr::TableWrite>& writes, tr::FrameTable table) {
+    return std::ranges::count(writes, table, &tr::TableWrite::table);
+  };
+
+  auto state = makeState(1, {geometry}, std::vector<uint64_t>(ObjectCount, 1));
+  state.positions.resize(ObjectCount);
+  state.rotations.resize(ObjectCount);
+  state.scales.resize(ObjectCount);
+  tables.update(state);
+
+  // Both frames start out empty, so each is given everything
+  for (const uint8_t frameIndex : {0, 1}) {
+    const auto& writes = tables.collectWrites(frameIndex, state, state.tick);
+    CHECK(writesTo(writes, tr::FrameTable::ObjectData) == 1);
+    CHECK(writesTo(writes, tr::FrameTable::Scales) == 1);
+    CHECK(writesTo(writes, tr::FrameTable::GeometryRegions) == 1);
+    CHECK(writesTo(writes, tr::FrameTable::DrawBatches) == 1);
+    const auto objects =
+        std::ranges::find(writes, tr::FrameTable::ObjectData, &tr::TableWrite::table);
+    CHECK(objects->size == sizeof(tr::GpuObjectData) * ObjectCount);
+  }
+
+  // Object 5 moves
+  auto versions = std::vector<uint64_t>(ObjectCount, 1);
+  versions[5] = 2;
+  state = makeState(2, {geometry}, versions);
+  state.positions.resize(ObjectCount);
+  state.rotations.resize(ObjectCount);
+  state.scales.resize(ObjectCount);
+  tables.update(state);
+
+  const auto& writes = tables.collectWrites(0, state, state.tick);
+  const auto positions =
+      std::ranges::find(writes, tr::FrameTable::Positions, &tr::TableWrite::table);
+  REQUIRE(positions != writes.end());
+  CHECK(positions->offset == sizeof(tr::GpuTransformData) * 5);
+  CHECK(positions->size == sizeof(tr::GpuTransformData));
+  CHECK(positions->data == state.positions.data() + 5);
+  CHECK(writesTo(writes, tr::FrameTable::GeometryRegions) == 0);
+  CHECK(writesTo(writes, tr::FrameTable::DrawBatches) == 0);
+  // Culling starts both phases' commands over every frame
+  CHECK(writesTo(writes, tr::FrameTable::DrawCommands) == 1);
+  CHECK(writesTo(writes, tr::FrameTable::LateDrawCount) == 1);
+}
@@ -0,0 +1,142 @@
+#include "r3/FrustumCulling.hpp"
+
+namespace {
+
+constexpr float Near = 0.1f;
+constexpr float Far = 100.f;
+
+/// Camera at the origin looking down -Z with a 90 degree field of view, so the side planes are
+/// at 45 degrees.
+auto makePlanes() -> tr::FrustumPlanes {
+  const auto projection = glm::perspective(glm::radians(90.f), 1.f, Near, Far);
+  const auto view =
+      glm::lookAt(glm::vec3{0.f}, glm::vec3{0.f, 0.f, -1.f}, glm::vec3{0.f, 1.f, 0.f});
+  return tr::extractFrustumPlanes(projection * view);
+}
+
+/// Region for a mesh spanning `min` to `max`
+auto makeRegion(const glm::vec3& min, const glm::vec3& max) -> tr::GpuGeometryRegionData {
+  const auto positions =
+      std::vector<tr::GpuVertexPositionData>{{.position = min}, {.position = max}};
+  const auto bounds = tr::computeBounds(positions);
+  return tr::GpuGeometryRegionData{.boundingSphere = bounds.sphere,
+                                   .boundsMin = bounds.min,
+                                   .boundsMax = bounds.max};
+}
+
+auto unitCube() -> tr::GpuGeometryRegionData {
+  return makeRegion(glm::vec3{-0.5f}, glm::vec3{0.5f});
+}
+
+const auto Identity = glm::quat{1.f, 0.f, 0.f, 0.f};
+
+auto isVisible(const tr::FrustumPlanes& planes,
+               const tr::GpuGeometryRegionData& region,
+               const glm::vec3& position,
+               const glm::quat& rotation = Identity,
+               const glm::vec3& scale = glm::vec3{1.f}) -> bool {
+  return tr::isObjectVisible(planes, region, position, rotation, scale);
+}
+
+}
+
+TEST_CASE("computeBounds encloses every vertex", "[FrustumCulling]") {
+  const auto positions = std::vector<tr::GpuVertexPositionData>{{.position = {-1.f, 0.f, 2.f}},
+                                                                {.position = {3.f, -2.f, 0.f}},
+                                                                {.position = {1.f, 2.f, 4.f}}};
+  const auto bounds = tr::computeBounds(positions);
+
+  CHECK(bounds.min.x == -1.f);
+  CHECK(bounds.min.y == -2.f);
+  CHECK(bounds.min.z == 0.f);
+  CHECK(bounds.max.x == 3.f);
+  CHECK(bounds.max.y == 2.f);
+  CHECK(bounds.max.z == 4.f);
+  for (const auto& vertex : positions) {
+    CHECK(glm::length(vertex.position - glm::vec3{bounds.sphere}) <= bounds.sphere.w);
+  }
+
+  CHECK(tr::computeBounds(std::span<const tr::GpuVertexPositionData>{}).sphere.w == 0.f);
+}
+
+TEST_CASE("extractFrustumPlanes gives normalized planes facing inwards", "[FrustumCulling]") {
+  const auto planes = makePlanes();
+
+  for (const auto& plane : planes) {
+    CHECK(std::abs(glm::length(glm::vec3{plane}) - 1.f) < 1e-5f);
+    // The middle of the frustum is in front of every plane
+    CHECK(glm::dot(glm::vec3{plane}, glm::vec3{0.f, 0.f, -50.f}) + plane.w > 0.f);
+  }
+
+  CHECK(tr::sphereInFrustum(planes, glm::vec3{0.f, 0.f, -10.f}, 0.f));
+  CHECK_FALSE(tr::sphereInFrustum(planes, glm::vec3{0.f, 0.f, -0.05f}, 0.f));
+  CHECK_FALSE(tr::sphereInFrustum(planes, glm::vec3{0.f, 0.f, -150.f}, 0.f));
+  CHECK_FALSE(tr::sphereInFrustum(planes, glm::vec3{0.f, 0.f, 10.f}, 0.f));
+  CHECK_FALSE(tr::sphereInFrustum(planes, glm::vec3{20.f, 0.f, -10.f}, 0.f));
+  CHECK_FALSE(tr::sphereInFrustum(planes, glm::vec3{0.f, -20.f, -10.f}, 0.f));
+}
+
+TEST_CASE("isObjectVisible keeps anything touching the frustum", "[FrustumCulling]") {
+  const auto planes = makePlanes();
+  const auto cube = unitCube();
+
+  CHECK(isVisible(planes, cube, glm::vec3{0.f, 0.f, -10.f}));
+  CHECK_FALSE(isVisible(planes, cube, glm::vec3{0.f, 0.f, 10.f}));
+  CHECK_FALSE(isVisible(planes, cube, glm::vec3{0.f, 0.f, -Far - 2.f}));
+
+  SECTION("Straddling a side plane") {
+    // The right plane passes through x = 10 at this depth
+    CHECK(isVisible(planes, cube, glm::vec3{10.4f, 0.f, -10.f}));
+    CHECK_FALSE(isVisible(planes, cube, glm::vec3{11.2f, 0.f, -10.f}));
+  }
+
+  SECTION("Scale grows the bounds") {
+    CHECK_FALSE(isVisible(planes, cube, glm::vec3{12.f, 0.f, -10.f}));
+    CHECK(isVisible(planes, cube, glm::vec3{12.f, 0.f, -10.f}, Identity, glm::vec3{5.f}));
+  }
+
+  SECTION("Bounds that aren't centered on the origin move with the object") {
+    const auto offset = makeRegion(glm::vec3{-20.5f, -0.5f, -0.5f}, glm::vec3{-19.5f, 0.5f, 0.5f});
+    CHECK(isVisible(planes, offset, glm::vec3{20.f, 0.f, -10.f}));
+    CHECK_FALSE(isVisible(planes, offset, glm::vec3{0.f, 0.f, -10.f}));
+  }
+}
+
+TEST_CASE("isObjectVisible uses the box to reject what the sphere lets through",
+          "[FrustumCulling]") {
+  const auto planes = makePlanes();
+  // A long thin rod along x. Its bounding sphere reaches down into the frustum from above, but the
+  // rod itself doesn't.
+  const auto rod = makeRegion(glm::vec3{-10.f, -0.1f, -0.1f}, glm::vec3{10.f, 0.1f, 0.1f});
+  const auto position = glm::vec3{0.f, 12.f, -5.f};
+
+  CHECK(tr::sphereInFrustum(planes, position, rod.boundingSphere.w));
+  CHECK_FALSE(isVisible(planes, rod, position));
+
+  SECTION("Stood upright the rod reaches into the frustum") {
+    const auto upright = glm::angleAxis(glm::radians(90.f), glm::vec3{0.f, 0.f, 1.f});
+    CHECK(isVisible(planes, rod, position, upright));
+  }
+}
+
+TEST_CASE("Frustum culling keeps about a field of view's share of a ring", "[FrustumCulling]") {
+  constexpr uint32_t ObjectCount = 1000;
+  constexpr float Radius = 50.f;
+
+  const auto planes = makePlanes();
+  const auto cube = unitCube();
+
+  auto visible = 0U;
+  for (uint32_t i = 0; i < ObjectCount; ++i) {
+    const auto angle = glm::radians(360.f * static_cast<float>(i) / ObjectCount);
+    const auto position = glm::vec3{Radius * std::sin(angle), 0.f, -Radius * std::cos(angle)};
+    if (isVisible(planes, cube, position)) {
+      ++visible;
+    }
+  }
+
+  // 90 of the ring's 360 degrees are in view, plus a sliver for each cube's size
+  const auto ratio = static_cast<float>(visible) / ObjectCount;
+  CHECK(ratio >= 0.25f);
+  CHECK(ratio <= 0.27f);
+}
@@ -0,0 +1,359 @@
+#include "r3/HzbCulling.hpp"
+
+namespace {
+
+constexpr auto Extent = glm::uvec2{160, 90};
+
+/// Camera at the origin looking down -Z
+auto makeViewProjection() -> glm::mat4 {
+  const auto projection = glm::perspective(glm::radians(90.f),
+                                           static_cast<float>(Extent.x) / Extent.y,
+                                           0.1f,
+                                           100.f);
+  const auto view =
+      glm::lookAt(glm::vec3{0.f}, glm::vec3{0.f, 0.f, -1.f}, glm::vec3{0.f, 1.f, 0.f});
+  return projection * view;
+}
+
+auto unitCube() -> tr::GpuGeometryRegionData {
+  return tr::GpuGeometryRegionData{.boundingSphere = glm::vec4{0.f, 0.f, 0.f, 0.87f},
+                                   .boundsMin = glm::vec3{-0.5f},
+                                   .boundsMax = glm::vec3{0.5f}};
+}
+
+/// A small software rasterizer to draw reference scenes with. Depth is cleared to 1 and tested
+/// with less, like the forward pass.
+class DepthBuffer {
+public:
+  explicit DepthBuffer(const glm::mat4& newViewProjection)
+      : viewProjection{newViewProjection}, depth(static_cast<size_t>(Extent.x) * Extent.y, 1.f) {
+  }
+
+  [[nodiscard]] auto getDepth() const -> const std::vector<float>& {
+    return depth;
+  }
+
+  /// Draws an axis aligned box into the depth buffer
+  auto drawBox(const glm::vec3& center, const glm::vec3& extents) -> void {
+    rasterizeBox(center, extents, true);
+  }
+
+  /// Whether any pixel of the box would pass the depth test, without drawing it
+  [[nodiscard]] auto isBoxVisible(const glm::vec3& center, const glm::vec3& extents) -> bool {
+    return rasterizeBox(center, extents, false);
+  }
+
+private:
+  glm::mat4 viewProjection;
+  std::vector<float> depth;
+
+  auto rasterizeBox(const glm::vec3& center, const glm::vec3& extents, bool write) -> bool {
+    auto corners = std::array<glm::vec3, 8>{};
+    for (uint32_t corner = 0; corner < 8; ++corner) {
+      const auto sign = glm::vec3{(corner & 1U) != 0 ? 1.f : -1.f,
+                                  (corner & 2U) != 0 ? 1.f : -1.f,
+                                  (corner & 4U) != 0 ? 1.f : -1.f};
+      const auto clip = viewProjection * glm::vec4{center + (sign * extents), 1.f};
+      // Reference scenes are kept in front of the near plane, so there's no clipping
+      REQUIRE(clip.w > 0.f);
+      corners[corner] = glm::vec3{(((clip.x / clip.w) * 0.5f) + 0.5f) * Extent.x,
+                                  (((clip.y / clip.w) * 0.5f) + 0.5f) * Extent.y,
+                                  clip.z / clip.w};
+    }
+
+    constexpr auto Faces = std::array<std::array<uint32_t, 4>, 6>{{{0, 1, 3, 2},
+                                                                   {4, 5, 7, 6},
+                                                                   {0, 1, 5, 4},
+                                                                   {2, 3, 7, 6},
+                                                                   {0, 2, 6, 4},
+                                                                   {1, 3, 7, 5}}};
+    auto passed = false;
+    for (const auto& face : Faces) {
+      passed |= rasterizeTriangle(corners[face[0]], corners[face[1]], corners[face[2]], write);
+      passed |= rasterizeTriangle(corners[face[0]], corners[face[2]], corners[face[3]], write);
+    }
+    return passed;
+  }
+
+  /// Samples at pixel centers, interpolating depth linearly in screen space
+  auto rasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, bool write)
+      -> bool {
+    const auto edge = [](const glm::vec3& from, const glm::vec3& to, float x, float y) {
+      return ((to.x - from.x) * (y - from.y)) - ((to.y - from.y) * (x - from.x));
+    };
+    const auto area = edge(a, b, c.x, c.y);
+    if (area == 0.f) {
+      return false;
+    }
+
+    const auto minX = std::max(0.f, std::floor(std::min({a.x, b.x, c.x})));
+    const auto minY = std::max(0.f, std::floor(std::min({a.y, b.y, c.y})));
+    const auto maxX = std::min(Extent.x - 1.f, std::ceil(std::max({a.x, b.x, c.x})));
+    const auto maxY = std::min(Extent.y - 1.f, std::ceil(std::max({a.y, b.y, c.y})));
+
+    auto passed = false;
+    for (auto y = minY; y <= maxY; ++y) {
+      for (auto x = minX; x <= maxX; ++x) {
+        const auto wa = edge(b, c, x + 0.5f, y + 0.5f) / area;
+        const auto wb = edge(c, a, x + 0.5f, y + 0.5f) / area;
+        const auto wc = edge(a, b, x + 0.5f, y + 0.5f) / area;
+        if (wa < 0.f || wb < 0.f || wc < 0.f) {
+          continue;
+        }
+        const auto z = (wa * a.z) + (wb * b.z) + (wc * c.z);
+        auto& stored = depth[(static_cast<size_t>(y) * Extent.x) + static_cast<size_t>(x)];
+        if (z < stored) {
+          passed = true;
+          if (write) {
+            stored = z;
+          }
+        }
+      }
+    }
+    return passed;
+  }
+};
+
+}
+
+TEST_CASE("Depth pyramid mips halve down to 1x1", "[HzbCulling]") {
+  CHECK(tr::hzbMipCount(glm::uvec2{1, 1}) == 1);
+  CHECK(tr::hzbMipCount(glm::uvec2{1920, 1080}) == 12);
+
+  const auto extent = glm::uvec2{5, 3};
+  REQUIRE(tr::hzbMipCount(extent) == 4);
+  const auto expected = std::array<std::array<uint32_t, 3>, 4>{{{5, 3, 0},
+                                                                {3, 2, 15},
+                                                                {2, 1, 21},
+                                                                {1, 1, 23}}};
+  for (uint32_t level = 0; level < expected.size(); ++level) {
+    const auto size = tr::hzbMipExtent(extent, level);
+    CHECK(size.x == expected[level][0]);
+    CHECK(size.y == expected[level][1]);
+    CHECK(tr::hzbMipOffset(extent, level) == expected[level][2]);
+  }
+  CHECK(tr::hzbTexelCount(extent) == 24);
+}
+
+TEST_CASE("Each pyramid texel holds the farthest depth it covers", "[HzbCulling]") {
+  const auto extent = glm::uvec2{13, 7};
+  auto depth = std::vector<float>(static_cast<size_t>(extent.x) * extent.y);
+  for (uint32_t i = 0; i < depth.size(); ++i) {
+    depth[i] = static_cast<float>((i * 37) % 101) / 100.f;
+  }
+  const auto pyramid = tr::buildDepthPyramid(depth, extent);
+
+  auto mismatches = 0;
+  for (uint32_t level = 0; level < tr::hzbMipCount(extent); ++level) {
+    const auto size = tr::hzbMipExtent(extent, level);
+    const auto offset = tr::hzbMipOffset(extent, level);
+    for (uint32_t y = 0; y < size.y; ++y) {
+      for (uint32_t x = 0; x < size.x; ++x) {
+        // Texel (x, y) covers the mip 0 texels from (x, y) << level up to the next texel's
+        auto farthest = 0.f;
+        const auto endY = std::min((y + 1) << level, extent.y);
+        const auto endX = std::min((x + 1) << level, extent.x);
+        for (auto sy = y << level; sy < endY; ++sy) {
+          for (auto sx = x << level; sx < endX; ++sx) {
+            farthest = std::max(farthest, depth[(sy * extent.x) + sx]);
+          }
+        }
+        if (pyramid[offset + (y * size.x) + x] != farthest) {
+          ++mismatches;
+        }
+      }
+    }
+  }
+  CHECK(mismatches == 0);
+}
+
+TEST_CASE("selectHzbLevel picks the finest mip covering the footprint in 2x2", "[HzbCulling]") {
+  const auto mipCount = tr::hzbMipCount(Extent);
+  const auto footprint = [](uint32_t minX, uint32_t minY, uint32_t maxX, uint32_t maxY) {
+    return tr::HzbFootprint{.min = glm::uvec2{minX, minY},
+                            .max = glm::uvec2{maxX, maxY},
+                            .nearestDepth = 0.5f};
+  };
+
+  CHECK(tr::selectHzbLevel(footprint(3, 3, 3, 3), mipCount) == 0);
+  CHECK(tr::selectHzbLevel(footprint(3, 3, 4, 4), mipCount) == 0);
+  CHECK(tr::selectHzbLevel(footprint(0, 0, 9, 0), mipCount) == 3);
+  CHECK(tr::selectHzbLevel(footprint(0, 0, 0, 40), mipCount) == 5);
+  // A footprint straddling a texel edge needs a coarser mip than its size alone suggests
+  CHECK(tr::selectHzbLevel(footprint(7, 0, 8, 0), mipCount) == 0);
+  CHECK(tr::selectHzbLevel(footprint(7, 0, 10, 0), mipCount) == 2);
+  // The whole screen fits in the 2x1 mip, one before the last
+  CHECK(tr::selectHzbLevel(footprint(0, 0, Extent.x - 1, Extent.y - 1), mipCount) ==
+        mipCount - 2);
+
+  auto tooWide = 0;
+  auto tooCoarse = 0;
+  for (uint32_t minX = 0; minX < 40; minX += 3) {
+    for (uint32_t width = 0; width < 60; width += 7) {
+      const auto fp = footprint(minX, 0, minX + width, 0);
+      const auto level = tr::selectHzbLevel(fp, mipCount);
+      if ((fp.max.x >> level) - (fp.min.x >> level) > 1) {
+        ++tooWide;
+      }
+      if (level > 0 && (fp.max.x >> (level - 1)) - (fp.min.x >> (level - 1)) <= 1) {
+        ++tooCoarse;
+      }
+    }
+  }
+  CHECK(tooWide == 0);
+  CHECK(tooCoarse == 0);
+}
+
+TEST_CASE("projectBox finds a box's footprint and nearest depth", "[HzbCulling]") {
+  const auto viewProjection = makeViewProjection();
+
+  const auto footprint =
+      tr::projectBox(viewProjection, glm::vec3{0.f, 0.f, -10.f}, glm::vec3{1.3f}, Extent);
+  REQUIRE(footprint.has_value());
+  // Centered on screen
+  CHECK(footprint->min.x + footprint->max.x == Extent.x - 1);
+  CHECK(footprint->min.y + footprint->max.y == Extent.y - 1);
+  CHECK(footprint->min.x < footprint->max.x);
+
+  const auto front = viewProjection * glm::vec4{0.f, 0.f, -8.7f, 1.f};
+  CHECK(std::abs(footprint->nearestDepth - (front.z / front.w)) < 1e-6f);
+
+  SECTION("Boxes reaching past the near plane can't be tested") {
+    CHECK_FALSE(tr::projectBox(viewProjection, glm::vec3{0.f}, glm::vec3{1.f}, Extent));
+    CHECK_FALSE(tr::projectBox(viewProjection, glm::vec3{0.f, 0.f, 5.f}, glm::vec3{1.f}, Extent));
+  }
+
+  SECTION("Footprints are clamped to the screen") {
+    const auto offscreen =
+        tr::projectBox(viewProjection, glm::vec3{40.f, 0.f, -10.f}, glm::vec3{1.f}, Extent);
+    REQUIRE(offscreen.has_value());
+    CHECK(offscreen->max.x == Extent.x - 1);
+  }
+}
+
+TEST_CASE("HZB culling against a rasterized scene never hides a visible object",
+          "[HzbCulling]") {
+  const auto viewProjection = makeViewProjection();
+  const auto cube = unitCube();
+  const auto identity = glm::quat{1.f, 0.f, 0.f, 0.f};
+
+  // A wall across the middle of the view, and the floor behind it
+  auto scene = DepthBuffer{viewProjection};
+  scene.drawBox(glm::vec3{0.f, 0.f, -10.f}, glm::vec3{6.f, 4.f, 0.5f});
+  scene.drawBox(glm::vec3{0.f, -6.f, -40.f}, glm::vec3{40.f, 0.5f, 35.f});
+  const auto pyramid = tr::buildDepthPyramid(scene.getDepth(), Extent);
+
+  const auto isOccluded = [&](const glm::vec3& position, float scale = 1.f) {
+    return tr::isObjectOccluded(pyramid,
+                                Extent,
+                                viewProjection,
+                                cube,
+                                position,
+                                identity,
+                                glm::vec3{scale});
+  };
+
+  CHECK(isOccluded(glm::vec3{0.f, 0.f, -20.f}));
+  CHECK(isOccluded(glm::vec3{0.f, 0.f, -30.f}, 3.f));
+  CHECK_FALSE(isOccluded(glm::vec3{0.f, 0.f, -5.f}));
+  CHECK_FALSE(isOccluded(glm::vec3{20.f, 0.f, -20.f}));
+  // Under the floor is hidden too, though nothing was drawn directly in front of it
+  CHECK(isOccluded(glm::vec3{10.f, -10.f, -30.f}));
+  // Reaching past the near plane is never culled
+  CHECK_FALSE(isOccluded(glm::vec3{0.f, 0.f, 0.f}));
+
+  // A grid of cubes sweeping across the wall's edges and down through the floor, each checked
+  // against drawing it into the scene
+  auto falselyHidden = 0;
+  auto hidden = 0;
+  auto hiddenCulled = 0;
+  for (auto x = -24.f; x <= 24.f; x += 1.5f) {
+    for (auto y = -12.f; y <= 12.f; y += 1.5f) {
+      const auto position = glm::vec3{x, y, -20.f};
+      const auto visible = scene.isBoxVisible(position, glm::vec3{0.5f});
+      const auto occluded = isOccluded(position);
+      if (visible && occluded) {
+        ++falselyHidden;
+      }
+      if (!visible) {
+        ++hidden;
+        hiddenCulled += occluded ? 1 : 0;
+      }
+    }
+  }
+  CHECK(falselyHidden == 0);
+  REQUIRE(hidden > 0);
+  // Conservative, but not so much that it stops culling
+  CHECK(static_cast<float>(hiddenCulled) / static_cast<float>(hidden) > 0.9f);
+}
+
+TEST_CASE("Two phase culling draws an object the frame it comes out from behind another",
+          "[HzbCulling]") {
+  const auto viewProjection = makeViewProjection();
+  const auto cube = unitCube();
+  const auto identity = glm::quat{1.f, 0.f, 0.f, 0.f};
+
+  // A wall, and a cube behind it. Both stay in the frustum throughout.
+  const auto wallScale = glm::vec3{12.f, 8.f, 1.f};
+  const auto cubePosition = glm::vec3{0.f, 0.f, -20.f};
+  auto wallPosition = glm::vec3{0.f, 0.f, -10.f};
+  auto wasVisible = std::array<bool, 2>{};
+  auto pyramid = std::vector<float>{};
+
+  struct Drawn {
+    bool wall;
+    bool cube;
+  };
+
+  const auto renderFrame = [&] {
+    const auto positions = std::array{wallPosition, cubePosition};
+    const auto scales = std::array{wallScale, glm::vec3{1.f}};
+    auto drawn = std::array<bool, 2>{};
+
+    auto depth = DepthBuffer{viewProjection};
+    for (size_t object = 0; object < positions.size(); ++object) {
+      if (tr::isDrawnEarly(true, wasVisible[object])) {
+        depth.drawBox(positions[object], scales[object] * 0.5f);
+        drawn[object] = true;
+      }
+    }
+    pyramid = tr::buildDepthPyramid(depth.getDepth(), Extent);
+
+    for (size_t object = 0; object < positions.size(); ++object) {
+      const auto visible = !tr::isObjectOccluded(
+          pyramid, Extent, viewProjection, cube, positions[object], identity, scales[object]);
+      drawn[object] = drawn[object] || tr::isDrawnLate(wasVisible[object], visible);
+      wasVisible[object] = visible;
+    }
+    return Drawn{.wall = drawn[0], .cube = drawn[1]};
+  };
+
+  // Nothing was visible before the first frame, so the late phase draws it all against an empty
+  // pyramid
+  const auto first = renderFrame();
+  CHECK(first.wall);
+  CHECK(first.cube);
+
+  // The second frame draws the cube early as it was visible, then finds it behind the wall
+  const auto second = renderFrame();
+  CHECK(second.wall);
+  CHECK(second.cube);
+  CHECK_FALSE(wasVisible[1]);
+
+  const auto third = renderFrame();
+  CHECK(third.wall);
+  CHECK_FALSE(third.cube);
+
+  // The wall slides aside. Last frame's pyramid still has it in front of the cube, so testing
+  // against that would leave the cube out of this frame.
+  CHECK(tr::isObjectOccluded(
+      pyramid, Extent, viewProjection, cube, cubePosition, identity, glm::vec3{1.f}));
+  wallPosition = glm::vec3{12.f, 0.f, -10.f};
+  const auto uncovered = renderFrame();
+  CHECK(uncovered.wall);
+  CHECK(uncovered.cube);
+
+  // From then on it's drawn early
+  CHECK(wasVisible[1]);
+  CHECK(tr::isDrawnEarly(true, wasVisible[1]));
+}
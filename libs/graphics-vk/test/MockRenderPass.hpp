@@ -5,8 +5,10 @@ namespace tr {
 struct MockRenderPass : public IRenderPass {
   PassId id;
   PassGraphInfo info;
+  QueueType queueType;
 
-  MockRenderPass(PassId pid, tr::PassGraphInfo pinfo) : id(pid), info(std::move(pinfo)) {
+  MockRenderPass(PassId pid, tr::PassGraphInfo pinfo, QueueType pqueueType = QueueType::Graphics)
+      : id(pid), info(std::move(pinfo)), queueType(pqueueType) {
   }
 
   auto getId() const -> PassId override {
@@ -17,6 +19,10 @@ struct MockRenderPass : public IRenderPass {
     return info;
   }
 
+  auto getQueueType() const -> QueueType override {
+    return queueType;
+  }
+
   auto execute(Frame* frame, vk::raii::CommandBuffer& cmdBuffer) -> void override {};
   auto registerDispatchContext(Handle<IDispatchContext> handle) -> void override {};
 };
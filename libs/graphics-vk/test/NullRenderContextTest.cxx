@@ -0,0 +1,164 @@
+#include "api/gw/EditorStateBuffer.hpp"
+#include "fx/LockFreeStateBuffer.hpp"
+#include "headless/NullDevice.hpp"
+#include "headless/NullGeometryStore.hpp"
+#include "headless/NullRenderContext.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr uint32_t ObjectCount = 16;
+
+constexpr size_t ObjectBytes = sizeof(tr::GpuObjectData) + sizeof(tr::GpuMaterialData) +
+                               sizeof(tr::GpuTransformData) + sizeof(tr::GpuRotationData) +
+                               sizeof(tr::GpuScaleData);
+/// Every object shares one mesh and material, so they all land in one batch, with one draw command
+/// for each culling phase
+constexpr size_t FrameBytes =
+    sizeof(tr::GpuFrameData) + (2 * (sizeof(tr::GpuIndirectCommand) + sizeof(tr::GpuDrawCount)));
+constexpr size_t BatchBytes =
+    sizeof(tr::GpuDrawBatch) + (ObjectCount * sizeof(tr::GpuDrawInstance));
+
+auto makeGeometry(size_t indexCount, size_t vertexCount) -> tr::GeometryData {
+  return tr::GeometryData{
+      .indexData =
+          std::make_shared<std::vector<std::byte>>(indexCount * sizeof(tr::GpuIndexData)),
+      .positionData = std::make_shared<std::vector<std::byte>>(
+          vertexCount * sizeof(tr::GpuVertexPositionData)),
+  };
+}
+
+/// Publishes a state where every object was added at tick 1, apart from `changed`, which last
+/// changed at `tick`.
+auto publish(tr::IStateBuffer& buffer,
+             tr::Timestamp base,
+             uint64_t tick,
+             tr::Handle<tr::Geometry> geometry,
+             std::optional<uint32_t> changed = std::nullopt) -> void {
+  buffer.writeState(base + milliseconds(tick), [&](tr::SimState& state) {
+    state.clear();
+    state.tick = tick;
+    for (uint32_t i = 0; i < ObjectCount; ++i) {
+      state.objectMetadata.push_back(
+          tr::GpuObjectData{.transformIndex = i, .rotationIndex = i, .scaleIndex = i});
+      state.positions.push_back({.position = glm::vec3{static_cast<float>(tick)}});
+      state.rotations.push_back({.rotation = glm::quat{1.f, 0.f, 0.f, 0.f}});
+      state.scales.push_back({.scale = glm::vec3{1.f}});
+      state.stateHandles.push_back({.geometryHandle = geometry});
+      state.entityIds.push_back(i);
+      state.objectVersions.push_back(changed == i ? tick : 1);
+    }
+  });
+}
+
+}
+
+TEST_CASE("NullGeometryStore packs regions end to end", "[headless]") {
+  auto store = tr::NullGeometryStore{};
+  const auto first = store.allocate(makeGeometry(6, 4));
+  const auto second = store.allocate(makeGeometry(36, 24));
+
+  const auto firstRegion = store.getRegionData(first);
+  CHECK(firstRegion.indexCount == 6);
+  CHECK(firstRegion.indexOffset == 0);
+  CHECK(firstRegion.positionOffset == 0);
+  CHECK(firstRegion.colorOffset == tr::INVALID_OFFSET);
+
+  const auto secondRegion = store.getRegionData(second);
+  CHECK(secondRegion.indexCount == 36);
+  CHECK(secondRegion.indexOffset == 6);
+  CHECK(secondRegion.positionOffset == 4);
+}
+
+TEST_CASE("NullRenderContext only records the writes each frame in flight needs", "[headless]") {
+  auto stateBuffer = std::make_shared<tr::LockFreeStateBuffer>();
+  auto mapper = std::make_shared<tr::GeometryHandleMapper>();
+  auto store = std::make_shared<tr::NullGeometryStore>();
+  auto device = std::make_shared<tr::NullDevice>();
+  auto context = tr::NullRenderContext{tr::RenderContextConfig{.framesInFlight = 2,
+                                                               .framePacing =
+                                                                   tr::FramePacing::Latest},
+                                       stateBuffer,
+                                       std::make_shared<tr::EditorStateBuffer>(),
+                                       mapper,
+                                       store,
+                                       device};
+  const auto geometry = mapper->toPublic(store->allocate(makeGeometry(6, 4)));
+  const auto base = steady_clock::now();
+
+  // Both frames in flight start out empty, so each writes every object, the one shared geometry
+  // region, the draw batches and its resource table once
+  publish(*stateBuffer, base, 1, geometry);
+  publish(*stateBuffer, base, 2, geometry);
+  context.renderNextFrame();
+  publish(*stateBuffer, base, 3, geometry, 5);
+  context.renderNextFrame();
+
+  auto counters = device->getCounters();
+  CHECK(counters.submits == 2);
+  CHECK(counters.drawnObjects == 2 * ObjectCount);
+  CHECK(counters.bufferWrites == 2 * (6 + 5 + 1 + 2));
+  CHECK(counters.bufferBytes == 2 * (FrameBytes + sizeof(tr::GpuResourceTable) +
+                                     (ObjectCount * ObjectBytes) +
+                                     sizeof(tr::GpuGeometryRegionData) + BatchBytes));
+
+  // The first frame is back up and only object 5 changed since it was last written. It only moved,
+  // so the batches and resource table stay as they were
+  publish(*stateBuffer, base, 4, geometry, 5);
+  context.renderNextFrame();
+
+  const auto before = counters;
+  counters = device->getCounters();
+  CHECK(counters.submits == 3);
+  CHECK(counters.bufferWrites - before.bufferWrites == 5 + 5);
+  CHECK(counters.bufferBytes - before.bufferBytes == FrameBytes + ObjectBytes);
+}
+
+TEST_CASE("NullRenderContext runs the renderer's frame graph each frame", "[headless]") {
+  // There's no overlay headless, so the ImGui pass is culled and the other seven run
+  constexpr uint64_t PassCount = 7;
+
+  auto steadyBarriers = std::vector<uint64_t>{};
+  for (const auto asyncCompute : {false, true}) {
+    auto stateBuffer = std::make_shared<tr::LockFreeStateBuffer>();
+    auto mapper = std::make_shared<tr::GeometryHandleMapper>();
+    auto store = std::make_shared<tr::NullGeometryStore>();
+    auto device = std::make_shared<tr::NullDevice>();
+    auto context = tr::NullRenderContext{tr::RenderContextConfig{.framesInFlight = 2,
+                                                                 .framePacing =
+                                                                     tr::FramePacing::Latest,
+                                                                 .asyncCompute = asyncCompute},
+                                         stateBuffer,
+                                         std::make_shared<tr::EditorStateBuffer>(),
+                                         mapper,
+                                         store,
+                                         device};
+    const auto geometry = mapper->toPublic(store->allocate(makeGeometry(6, 4)));
+    const auto base = steady_clock::now();
+    publish(*stateBuffer, base, 1, geometry);
+    const auto renderFrame = [&](uint64_t tick) {
+      publish(*stateBuffer, base, tick, geometry);
+      context.renderNextFrame();
+      return device->getCounters();
+    };
+
+    const auto first = renderFrame(2);
+    CHECK(first.recordedPasses == PassCount);
+    CHECK(first.barriers > 0);
+    // With async compute the early culling pass is submitted to a queue of its own
+    CHECK(first.queueSubmits == (asyncCompute ? 2 : 1));
+
+    // Both frames in flight have had their first run, so every run from here is the same
+    const auto second = renderFrame(3);
+    const auto third = renderFrame(4);
+    const auto fourth = renderFrame(5);
+    CHECK(fourth.recordedPasses == 4 * PassCount);
+    CHECK(fourth.queueSubmits == 4 * first.queueSubmits);
+    CHECK(fourth.barriers - third.barriers == third.barriers - second.barriers);
+    steadyBarriers.push_back(fourth.barriers - third.barriers);
+  }
+
+  // Handing what culling writes over to the graphics queue and back takes barriers of its own
+  CHECK(steadyBarriers[1] > steadyBarriers[0]);
+}
@@ -0,0 +1,145 @@
+#include "r3/ComponentIds.hpp"
+#include "r3/graph/PassRecorder.hpp"
+
+namespace tr {
+
+namespace {
+
+struct MockCommandBuffer {
+  PassId passId{};
+  std::thread::id threadId;
+};
+
+/// Records passes the way OrderedFrameGraph does, each into its own slot, but without Vulkan. The
+/// earliest passes take the longest, so the workers finish in roughly the reverse of graph order.
+class MockCommandRecorder {
+public:
+  explicit MockCommandRecorder(std::vector<PassId> newPasses) : passes{std::move(newPasses)} {
+  }
+
+  auto record(PassRecorder& recorder) -> std::vector<MockCommandBuffer> {
+    auto submitted = std::vector<MockCommandBuffer>(passes.size());
+    recorder.record(passes.size(), [&](size_t position) {
+      std::this_thread::sleep_for(std::chrono::microseconds{(passes.size() - position) * 200});
+      submitted[position] =
+          MockCommandBuffer{.passId = passes[position], .threadId = std::this_thread::get_id()};
+      std::lock_guard lock(mutex);
+      finishOrder.push_back(position);
+    });
+    return submitted;
+  }
+
+  [[nodiscard]] auto getFinishOrder() const -> const std::vector<size_t>& {
+    return finishOrder;
+  }
+
+private:
+  std::vector<PassId> passes;
+  std::mutex mutex;
+  std::vector<size_t> finishOrder;
+};
+
+const auto GraphOrder = std::vector<PassId>{PassId::Culling,
+                                            PassId::ImGui,
+                                            PassId::Forward,
+                                            PassId::DepthPyramid,
+                                            PassId::Composition,
+                                            PassId::Present};
+
+auto passIdsOf(const std::vector<MockCommandBuffer>& buffers) -> std::vector<PassId> {
+  auto passIds = std::vector<PassId>{};
+  for (const auto& buffer : buffers) {
+    passIds.push_back(buffer.passId);
+  }
+  return passIds;
+}
+
+}
+
+TEST_CASE("PassRecorder submits passes in graph order", "[PassRecorder]") {
+  auto recorder = PassRecorder{RenderContextConfig{.recordingThreads = 3}};
+
+  const auto& threadIds = recorder.getThreadIds();
+  REQUIRE(threadIds.size() == 3);
+  CHECK(std::ranges::find(threadIds, std::this_thread::get_id()) == threadIds.end());
+  CHECK(std::set<std::thread::id>{threadIds.begin(), threadIds.end()}.size() == 3);
+
+  for (size_t run = 0; run < 20; ++run) {
+    auto commandRecorder = MockCommandRecorder{GraphOrder};
+    const auto submitted = commandRecorder.record(recorder);
+
+    REQUIRE(passIdsOf(submitted) == GraphOrder);
+    CHECK(commandRecorder.getFinishOrder().size() == GraphOrder.size());
+    // Each pass always goes to the same thread, so its command buffers come from that thread's
+    // pools every time
+    for (size_t position = 0; position < submitted.size(); ++position) {
+      CHECK(submitted[position].threadId == recorder.getThreadId(position));
+    }
+  }
+}
+
+TEST_CASE("PassRecorder records on the calling thread without workers", "[PassRecorder]") {
+  auto recorder = PassRecorder{RenderContextConfig{}};
+
+  CHECK(recorder.getThreadIds() == std::vector<std::thread::id>{std::this_thread::get_id()});
+
+  auto commandRecorder = MockCommandRecorder{GraphOrder};
+  const auto submitted = commandRecorder.record(recorder);
+
+  CHECK(passIdsOf(submitted) == GraphOrder);
+  CHECK(commandRecorder.getFinishOrder() == std::vector<size_t>{0, 1, 2, 3, 4, 5});
+  for (const auto& buffer : submitted) {
+    CHECK(buffer.threadId == std::this_thread::get_id());
+  }
+}
+
+TEST_CASE("PassRecorder passes on a pass's exception once every pass is done", "[PassRecorder]") {
+  auto recorder = PassRecorder{RenderContextConfig{.recordingThreads = 2}};
+
+  auto recorded = std::atomic<size_t>{0};
+  CHECK_THROWS_AS(recorder.record(4,
+                                  [&](size_t position) {
+                                    if (position == 1) {
+                                      throw std::runtime_error("Failed to record");
+                                    }
+                                    ++recorded;
+                                  }),
+                  std::runtime_error);
+  CHECK(recorded == 3);
+
+  SECTION("The workers are still there for the next frame") {
+    auto commandRecorder = MockCommandRecorder{GraphOrder};
+    CHECK(passIdsOf(commandRecorder.record(recorder)) == GraphOrder);
+  }
+}
+
+TEST_CASE("PassRecorder passes see what the caller resolved before recording",
+          "[PassRecorder]") {
+  auto recorder = PassRecorder{RenderContextConfig{.recordingThreads = 3}};
+
+  // Stands in for the swapchain image and buffer addresses OrderedFrameGraph resolves on the
+  // calling thread each frame, which every pass then reads at once
+  auto swapchainImage = uint64_t{};
+  auto addresses = std::unordered_map<PassId, uint64_t>{};
+
+  for (uint64_t run = 1; run <= 20; ++run) {
+    swapchainImage = run % 3;
+    for (size_t position = 0; position < GraphOrder.size(); ++position) {
+      addresses.insert_or_assign(GraphOrder[position], (run << 8U) | position);
+    }
+
+    auto seen = std::vector<std::pair<uint64_t, uint64_t>>(GraphOrder.size());
+    recorder.record(GraphOrder.size(), [&](size_t position) {
+      for (size_t lookup = 0; lookup < 100; ++lookup) {
+        seen[position] = {swapchainImage, addresses.at(GraphOrder[position])};
+      }
+    });
+
+    for (size_t position = 0; position < GraphOrder.size(); ++position) {
+      CHECK(seen[position].first == run % 3);
+      CHECK(seen[position].second == ((run << 8U) | position));
+    }
+  }
+}
+
+}
@@ -0,0 +1,120 @@
+#include "r3/graph/QueuePlanner.hpp"
+
+namespace tr {
+
+namespace {
+
+auto bufferTransfer(BufferAlias alias,
+                    size_t releasePosition,
+                    size_t acquirePosition,
+                    bool fromPreviousRun,
+                    vk::PipelineStageFlags2 acquireStages) -> OwnershipTransfer {
+  return OwnershipTransfer{.resource = BufferAliasVariant{alias},
+                           .releasePosition = releasePosition,
+                           .acquirePosition = acquirePosition,
+                           .srcFamily = 0,
+                           .dstFamily = 1,
+                           .fromPreviousRun = fromPreviousRun,
+                           .acquireStages = acquireStages};
+}
+
+auto rangeOf(const QueueSubmission& submission) -> std::pair<size_t, size_t> {
+  return {submission.firstPosition, submission.endPosition};
+}
+
+}
+
+TEST_CASE("QueuePlanner submits passes on one queue together", "[QueuePlanner]") {
+  const auto submissions = QueuePlanner::plan(
+      std::vector<QueueType>(4, QueueType::Graphics), std::vector<OwnershipTransfer>{});
+
+  REQUIRE(submissions.size() == 1);
+  CHECK(submissions[0].queueType == QueueType::Graphics);
+  CHECK(rangeOf(submissions[0]) == std::pair<size_t, size_t>{0, 4});
+  CHECK(submissions[0].waits.empty());
+}
+
+TEST_CASE("QueuePlanner overlaps culling with the frame before", "[QueuePlanner]") {
+  // Culling, ImGui, Forward, DepthPyramid, Composition, Present, with culling on compute
+  const auto passQueues = std::vector<QueueType>{QueueType::Compute,
+                                                 QueueType::Graphics,
+                                                 QueueType::Graphics,
+                                                 QueueType::Graphics,
+                                                 QueueType::Graphics,
+                                                 QueueType::Graphics};
+  const auto transfers = std::vector<OwnershipTransfer>{
+      // Culling takes back what this frame's last run drew from, and the pyramid the last frame
+      // built
+      bufferTransfer(BufferAlias::IndirectCommand,
+                     2,
+                     0,
+                     true,
+                     vk::PipelineStageFlagBits2::eComputeShader),
+      bufferTransfer(BufferAlias::IndirectCommandCount,
+                     2,
+                     0,
+                     true,
+                     vk::PipelineStageFlagBits2::eComputeShader),
+      OwnershipTransfer{.resource = BufferAliasVariant{GlobalBufferAlias::DepthPyramid},
+                        .releasePosition = 3,
+                        .acquirePosition = 0,
+                        .srcFamily = 0,
+                        .dstFamily = 1,
+                        .fromPreviousRun = true,
+                        .acquireStages = vk::PipelineStageFlagBits2::eComputeShader},
+      // Forward draws from what culling wrote
+      bufferTransfer(BufferAlias::IndirectCommand,
+                     0,
+                     2,
+                     false,
+                     vk::PipelineStageFlagBits2::eDrawIndirect),
+      bufferTransfer(BufferAlias::IndirectCommandCount,
+                     0,
+                     2,
+                     false,
+                     vk::PipelineStageFlagBits2::eDrawIndirect),
+  };
+
+  const auto submissions = QueuePlanner::plan(passQueues, transfers);
+
+  // Graphics is split after the depth pyramid, the frame's fence already covers what culling takes
+  // back from its own last run
+  REQUIRE(submissions.size() == 3);
+  CHECK(submissions[0].queueType == QueueType::Compute);
+  CHECK(rangeOf(submissions[0]) == std::pair<size_t, size_t>{0, 1});
+  CHECK(rangeOf(submissions[1]) == std::pair<size_t, size_t>{1, 4});
+  CHECK(rangeOf(submissions[2]) == std::pair<size_t, size_t>{4, 6});
+
+  SECTION("Culling only waits on the last frame's graphics up to the depth pyramid") {
+    REQUIRE(submissions[0].waits.size() == 1);
+    CHECK(submissions[0].waits[0].submission == 1);
+    CHECK(submissions[0].waits[0].previousRun);
+    CHECK(submissions[0].waits[0].stages == vk::PipelineStageFlagBits2::eComputeShader);
+  }
+
+  SECTION("Forward waits on this frame's culling once for both buffers") {
+    REQUIRE(submissions[1].waits.size() == 1);
+    CHECK(submissions[1].waits[0].submission == 0);
+    CHECK(!submissions[1].waits[0].previousRun);
+    CHECK(submissions[1].waits[0].stages == vk::PipelineStageFlagBits2::eDrawIndirect);
+  }
+
+  SECTION("The last submission is already after everything") {
+    CHECK(submissions[2].waits.empty());
+  }
+}
+
+TEST_CASE("QueuePlanner makes the last submission wait on the rest", "[QueuePlanner]") {
+  // Nothing passes between the queues, but the frame isn't done until both are
+  const auto submissions =
+      QueuePlanner::plan(std::vector<QueueType>{QueueType::Graphics, QueueType::Compute},
+                         std::vector<OwnershipTransfer>{});
+
+  REQUIRE(submissions.size() == 2);
+  REQUIRE(submissions[1].waits.size() == 1);
+  CHECK(submissions[1].waits[0].submission == 0);
+  CHECK(!submissions[1].waits[0].previousRun);
+  CHECK(submissions[1].waits[0].stages == vk::PipelineStageFlagBits2::eAllCommands);
+}
+
+}
@@ -0,0 +1,126 @@
+#include "r3/ResourceTableCache.hpp"
+
+namespace {
+
+constexpr uint8_t FramesInFlight = 2;
+
+/// Stands in for BufferSystem, counting lookups. Each buffer's address is its handle plus
+/// `base`, so moving `base` is a resize of every buffer.
+struct MockAddressProvider {
+  uint64_t base = 0x1000;
+  uint32_t lookups = 0;
+
+  auto operator()(tr::Handle<tr::ManagedBuffer> handle) -> std::optional<uint64_t> {
+    ++lookups;
+    return base + handle.id;
+  }
+};
+
+/// Each frame in flight has its own per frame buffers and shares the geometry buffers
+auto buffersFor(uint8_t frameIndex) -> tr::ResourceTableBuffers {
+  const auto perFrame = [frameIndex](size_t id) {
+    return tr::Handle<tr::ManagedBuffer>{.id = (frameIndex * 100U) + id};
+  };
+  const auto shared = [](size_t id) { return tr::Handle<tr::ManagedBuffer>{.id = 1000 + id}; };
+  return tr::ResourceTableBuffers{.objectData = perFrame(0),
+                                  .objectPositions = perFrame(1),
+                                  .objectRotations = perFrame(2),
+                                  .objectScales = perFrame(3),
+                                  .geometryRegion = perFrame(4),
+                                  .index = shared(0),
+                                  .position = shared(1),
+                                  .color = shared(2),
+                                  .texCoord = shared(3),
+                                  .normal = shared(4),
+                                  .animation = shared(5),
+                                  .materials = perFrame(5),
+                                  .indirectCommand = perFrame(6),
+                                  .indirectCount = perFrame(7),
+                                  .drawBatches = perFrame(8),
+                                  .drawInstances = perFrame(9),
+                                  .visibleObjects = perFrame(10),
+                                  .depthPyramid = shared(6),
+                                  .lateIndirectCommand = perFrame(11),
+                                  .lateIndirectCount = perFrame(12),
+                                  .objectVisibility = shared(7)};
+}
+
+/// Fields in GpuResourceTable, all of them addresses
+constexpr uint32_t AddressCount = sizeof(tr::GpuResourceTable) / sizeof(uint64_t);
+
+/// Renders `frames` frames the way R3Renderer does, returning how many tables were rebuilt
+auto renderFrames(tr::ResourceTableCache& cache,
+                  uint32_t frames,
+                  uint64_t addressGeneration,
+                  std::vector<tr::GpuResourceTable>* uploads = nullptr) -> uint32_t {
+  auto rebuilds = 0U;
+  for (uint32_t frame = 0; frame < frames; ++frame) {
+    const auto frameIndex = static_cast<uint8_t>(frame % FramesInFlight);
+    if (cache.isStale(frameIndex, addressGeneration)) {
+      const auto table = cache.rebuild(frameIndex, addressGeneration, buffersFor(frameIndex));
+      if (uploads != nullptr) {
+        uploads->push_back(table);
+      }
+      ++rebuilds;
+    }
+  }
+  return rebuilds;
+}
+
+}
+
+TEST_CASE("ResourceTableCache builds each frame's table once and reuses it", "[ResourceTable]") {
+  auto provider = std::make_shared<MockAddressProvider>();
+  auto cache = tr::ResourceTableCache{
+      [provider](tr::Handle<tr::ManagedBuffer> handle) { return (*provider)(handle); }};
+
+  auto uploads = std::vector<tr::GpuResourceTable>{};
+  CHECK(renderFrames(cache, 100, 0, &uploads) == FramesInFlight);
+  CHECK(provider->lookups == FramesInFlight * AddressCount);
+
+  // Each frame in flight's table points at its own buffers
+  REQUIRE(uploads.size() == FramesInFlight);
+  CHECK(uploads[0].objectDataBufferAddress == 0x1000);
+  CHECK(uploads[1].objectDataBufferAddress == 0x1000 + 100);
+  CHECK(uploads[0].indexBufferAddress == uploads[1].indexBufferAddress);
+  CHECK(uploads[1].depthPyramidAddress == 0x1000 + 1006);
+}
+
+TEST_CASE("ResourceTableCache rebuilds every frame's table when the generation moves on",
+          "[ResourceTable]") {
+  auto provider = std::make_shared<MockAddressProvider>();
+  auto cache = tr::ResourceTableCache{
+      [provider](tr::Handle<tr::ManagedBuffer> handle) { return (*provider)(handle); }};
+  renderFrames(cache, 10, 0);
+  const auto lookups = provider->lookups;
+
+  // A resize took over, so every frame in flight picks up the new addresses, once
+  provider->base = 0x8000;
+  auto uploads = std::vector<tr::GpuResourceTable>{};
+  CHECK(renderFrames(cache, 10, 7, &uploads) == FramesInFlight);
+  CHECK(provider->lookups - lookups == FramesInFlight * AddressCount);
+  for (const auto& table : uploads) {
+    CHECK(table.indexBufferAddress == 0x8000 + 1000);
+  }
+
+  SECTION("An older generation doesn't count as a change") {
+    CHECK_FALSE(cache.isStale(0, 3));
+    CHECK_FALSE(cache.isStale(1, 7));
+    CHECK(cache.isStale(1, 8));
+  }
+}
+
+TEST_CASE("ResourceTableCache leaves buffers without an address as 0", "[ResourceTable]") {
+  auto cache = tr::ResourceTableCache{
+      []([[maybe_unused]] tr::Handle<tr::ManagedBuffer> handle) -> std::optional<uint64_t> {
+        return std::nullopt;
+      }};
+
+  CHECK(cache.isStale(3, 0));
+  const auto table = cache.rebuild(3, 0, buffersFor(3));
+  CHECK(table.objectDataBufferAddress == 0);
+  CHECK(table.depthPyramidAddress == 0);
+  CHECK_FALSE(cache.isStale(3, 0));
+  // Frames before it still have nothing built
+  CHECK(cache.isStale(0, 0));
+}
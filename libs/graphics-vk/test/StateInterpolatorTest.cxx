@@ -0,0 +1,118 @@
+#include "r3/StateInterpolator.hpp"
+
+using namespace std::chrono;
+
+namespace {
+
+auto addObject(tr::SimState& state,
+               uint32_t entityId,
+               glm::vec3 position,
+               glm::quat rotation,
+               glm::vec3 scale) -> void {
+  const auto index = static_cast<uint32_t>(state.objectMetadata.size());
+  state.objectMetadata.push_back(
+      tr::GpuObjectData{.transformIndex = index, .rotationIndex = index, .scaleIndex = index});
+  state.positions.push_back({.position = position});
+  state.rotations.push_back({.rotation = rotation});
+  state.scales.push_back({.scale = scale});
+  state.stateHandles.push_back({.geometryHandle = tr::Handle<tr::Geometry>{entityId}});
+  state.entityIds.push_back(entityId);
+}
+
+constexpr auto Epsilon = 1e-5f;
+
+auto near(glm::vec3 a, glm::vec3 b) -> bool {
+  return glm::all(glm::lessThan(glm::abs(a - b), glm::vec3{Epsilon}));
+}
+
+}
+
+TEST_CASE("StateInterpolator computes alpha from timestamps", "[StateInterpolator]") {
+  const auto base = steady_clock::now();
+
+  CHECK(tr::StateInterpolator::computeAlpha(base, base + milliseconds(10), base) == 0.f);
+  CHECK(tr::StateInterpolator::computeAlpha(base, base + milliseconds(10), base + milliseconds(5)) ==
+        0.5f);
+  CHECK(tr::StateInterpolator::computeAlpha(base, base + milliseconds(10), base + seconds(1)) ==
+        1.f);
+  CHECK(tr::StateInterpolator::computeAlpha(base, base, base) == 1.f);
+}
+
+TEST_CASE("StateInterpolator blends matching objects", "[StateInterpolator]") {
+  const auto base = steady_clock::now();
+  const auto identity = glm::identity<glm::quat>();
+  const auto quarterTurn = glm::angleAxis(glm::radians(90.f), glm::vec3{0.f, 1.f, 0.f});
+
+  auto previous = tr::SimState{};
+  previous.timeStamp = base;
+  addObject(previous, 1, {0.f, 0.f, 0.f}, identity, {1.f, 1.f, 1.f});
+  addObject(previous, 2, {10.f, 0.f, 0.f}, identity, {2.f, 2.f, 2.f});
+
+  auto next = tr::SimState{};
+  next.timeStamp = base + milliseconds(10);
+  addObject(next, 1, {4.f, 0.f, 0.f}, quarterTurn, {3.f, 3.f, 3.f});
+  addObject(next, 2, {10.f, 8.f, 0.f}, identity, {2.f, 2.f, 2.f});
+
+  auto interpolator = tr::StateInterpolator{};
+  auto out = tr::SimState{};
+  interpolator.interpolate(previous, next, base + microseconds(2500), out);
+
+  REQUIRE(out.positions.size() == 2);
+  CHECK(near(out.positions[0].position, {1.f, 0.f, 0.f}));
+  CHECK(near(out.positions[1].position, {10.f, 2.f, 0.f}));
+  CHECK(near(out.scales[0].scale, {1.5f, 1.5f, 1.5f}));
+
+  const auto expected = glm::normalize(glm::lerp(identity, quarterTurn, 0.25f));
+  CHECK(glm::abs(glm::dot(out.rotations[0].rotation, expected)) > 1.f - Epsilon);
+  CHECK(glm::abs(glm::length(out.rotations[0].rotation) - 1.f) < Epsilon);
+}
+
+TEST_CASE("StateInterpolator takes the short way around", "[StateInterpolator]") {
+  const auto base = steady_clock::now();
+  const auto rotation = glm::angleAxis(glm::radians(10.f), glm::vec3{0.f, 0.f, 1.f});
+
+  auto previous = tr::SimState{};
+  previous.timeStamp = base;
+  addObject(previous, 1, {}, rotation, {1.f, 1.f, 1.f});
+
+  // Same orientation, opposite hemisphere
+  auto next = tr::SimState{};
+  next.timeStamp = base + milliseconds(10);
+  addObject(next, 1, {}, -rotation, {1.f, 1.f, 1.f});
+
+  auto interpolator = tr::StateInterpolator{};
+  auto out = tr::SimState{};
+  interpolator.interpolate(previous, next, base + milliseconds(5), out);
+
+  REQUIRE(out.rotations.size() == 1);
+  CHECK(glm::abs(glm::dot(out.rotations[0].rotation, rotation)) > 1.f - Epsilon);
+}
+
+TEST_CASE("StateInterpolator matches objects by entity id", "[StateInterpolator]") {
+  const auto base = steady_clock::now();
+  const auto identity = glm::identity<glm::quat>();
+
+  auto previous = tr::SimState{};
+  previous.timeStamp = base;
+  addObject(previous, 7, {0.f, 0.f, 0.f}, identity, {1.f, 1.f, 1.f});
+  addObject(previous, 3, {100.f, 0.f, 0.f}, identity, {1.f, 1.f, 1.f});
+  addObject(previous, 5, {-50.f, 0.f, 0.f}, identity, {1.f, 1.f, 1.f});
+
+  // 5 was destroyed, 9 was spawned, and 3 and 7 swapped places in the arrays.
+  auto next = tr::SimState{};
+  next.timeStamp = base + milliseconds(10);
+  addObject(next, 3, {200.f, 0.f, 0.f}, identity, {1.f, 1.f, 1.f});
+  addObject(next, 9, {0.f, 42.f, 0.f}, identity, {1.f, 1.f, 1.f});
+  addObject(next, 7, {0.f, 0.f, 10.f}, identity, {1.f, 1.f, 1.f});
+
+  auto interpolator = tr::StateInterpolator{};
+  auto out = tr::SimState{};
+  interpolator.interpolate(previous, next, base + milliseconds(5), out);
+
+  REQUIRE(out.entityIds == next.entityIds);
+  REQUIRE(out.positions.size() == 3);
+  CHECK(near(out.positions[0].position, {150.f, 0.f, 0.f}));
+  CHECK(near(out.positions[1].position, {0.f, 42.f, 0.f}));
+  CHECK(near(out.positions[2].position, {0.f, 0.f, 5.f}));
+  CHECK(out.stateHandles[1].geometryHandle.id == 9);
+}
@@ -0,0 +1,110 @@
+#include "r3/graph/TransientMemoryPlanner.hpp"
+
+namespace tr {
+
+namespace {
+
+constexpr uint64_t MiB = 1024 * 1024;
+constexpr uint32_t AnyMemory = 0xFF;
+
+auto resource(ImageAlias alias, uint64_t size, size_t firstUse, size_t lastUse)
+    -> TransientResource {
+  return TransientResource{.alias = alias,
+                           .size = size,
+                           .alignment = 256,
+                           .memoryTypeBits = AnyMemory,
+                           .firstUse = firstUse,
+                           .lastUse = lastUse};
+}
+
+auto placementOf(const TransientMemoryPlan& plan, ImageAlias alias) -> TransientPlacement {
+  const auto it = std::ranges::find(plan.placements, alias, &TransientPlacement::alias);
+  REQUIRE(it != plan.placements.end());
+  return *it;
+}
+
+}
+
+TEST_CASE("TransientMemoryPlanner shares memory between images used at different times",
+          "[TransientMemory]") {
+  // Forward's depth is done with before the GUI is drawn
+  const auto plan = TransientMemoryPlanner::plan({
+      resource(ImageAlias::GeometryColorImage, 64 * MiB, 1, 4),
+      resource(ImageAlias::DepthImage, 32 * MiB, 1, 2),
+      resource(ImageAlias::GuiColorImage, 64 * MiB, 3, 4),
+  });
+
+  CHECK(plan.blocks.size() == 2);
+  CHECK(placementOf(plan, ImageAlias::DepthImage).block ==
+        placementOf(plan, ImageAlias::GuiColorImage).block);
+  CHECK(placementOf(plan, ImageAlias::GeometryColorImage).block !=
+        placementOf(plan, ImageAlias::GuiColorImage).block);
+
+  CHECK(plan.unaliasedBytes == 160 * MiB);
+  CHECK(plan.aliasedBytes == 128 * MiB);
+  CHECK(plan.savedBytes() == 32 * MiB);
+}
+
+TEST_CASE("TransientMemoryPlanner keeps images in use at the same time apart",
+          "[TransientMemory]") {
+  const auto plan = TransientMemoryPlanner::plan({
+      resource(ImageAlias::GeometryColorImage, 64 * MiB, 0, 2),
+      resource(ImageAlias::DepthImage, 32 * MiB, 2, 3),
+      resource(ImageAlias::GuiColorImage, 16 * MiB, 1, 1),
+  });
+
+  // The color image overlaps both of the others, so it gets a block to itself
+  const auto color = placementOf(plan, ImageAlias::GeometryColorImage);
+  const auto depth = placementOf(plan, ImageAlias::DepthImage);
+  const auto gui = placementOf(plan, ImageAlias::GuiColorImage);
+  CHECK(color.block != depth.block);
+  // The GUI image is gone before depth arrives, so they can share
+  CHECK(gui.block == depth.block);
+  CHECK(gui.offset == depth.offset);
+  CHECK(plan.savedBytes() == 16 * MiB);
+}
+
+TEST_CASE("TransientMemoryPlanner places images side by side in a block", "[TransientMemory]") {
+  // Depth is done before the two color images, which are alive together and fit side by side
+  // in its space
+  const auto plan = TransientMemoryPlanner::plan({
+      resource(ImageAlias::DepthImage, 64 * MiB, 0, 1),
+      resource(ImageAlias::GeometryColorImage, 32 * MiB, 2, 3),
+      resource(ImageAlias::GuiColorImage, 32 * MiB, 2, 3),
+  });
+
+  REQUIRE(plan.blocks.size() == 1);
+  CHECK(plan.blocks[0].size == 64 * MiB);
+  CHECK(placementOf(plan, ImageAlias::GeometryColorImage).offset == 0);
+  CHECK(placementOf(plan, ImageAlias::GuiColorImage).offset == 32 * MiB);
+  CHECK(plan.savedBytes() == 64 * MiB);
+}
+
+TEST_CASE("TransientMemoryPlanner respects alignment and memory types", "[TransientMemory]") {
+  SECTION("Offsets are aligned") {
+    auto color = resource(ImageAlias::GeometryColorImage, 5000, 0, 0);
+    auto depth = resource(ImageAlias::DepthImage, 3000, 1, 1);
+    auto gui = resource(ImageAlias::GuiColorImage, 1000, 1, 1);
+    gui.alignment = 4096;
+    const auto plan = TransientMemoryPlanner::plan({color, depth, gui});
+
+    // The GUI image goes after depth, rounded up to its alignment
+    REQUIRE(plan.blocks.size() == 1);
+    CHECK(placementOf(plan, ImageAlias::GuiColorImage).offset == 4096);
+    CHECK(plan.blocks[0].size == 4096 + 1000);
+    CHECK(plan.blocks[0].alignment == 4096);
+  }
+
+  SECTION("Images without a memory type in common never share") {
+    auto depth = resource(ImageAlias::DepthImage, 32 * MiB, 0, 1);
+    auto gui = resource(ImageAlias::GuiColorImage, 32 * MiB, 2, 3);
+    depth.memoryTypeBits = 0b01;
+    gui.memoryTypeBits = 0b10;
+    const auto plan = TransientMemoryPlanner::plan({depth, gui});
+
+    CHECK(plan.blocks.size() == 2);
+    CHECK(plan.savedBytes() == 0);
+  }
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "api/action/Actions.hpp"
+
+namespace tr {
+
+inline constexpr size_t ActionTypeCount = static_cast<size_t>(ActionType::Cancel) + 1;
+
+/// Everything the action layer saw between two game ticks, coalesced so input costs the same per
+/// tick however many raw events arrived.
+struct ActionFrame {
+  /// Counts up by one per frame taken, so a consumer can tell if it missed one
+  uint64_t sequence{};
+  /// Range actions summed over the tick, e.g. total mouse movement
+  std::array<float, ActionTypeCount> ranges{};
+  /// State actions that were down at the end of the tick
+  std::bitset<ActionTypeCount> held;
+  /// State actions that went down or up during the tick. Both are set if one was tapped and
+  /// released within a single tick.
+  std::bitset<ActionTypeCount> pressed;
+  std::bitset<ActionTypeCount> released;
+
+  [[nodiscard]] auto range(ActionType action) const -> float {
+    return ranges[static_cast<size_t>(action)];
+  }
+
+  [[nodiscard]] auto isHeld(ActionType action) const -> bool {
+    return held.test(static_cast<size_t>(action));
+  }
+
+  [[nodiscard]] auto wasPressed(ActionType action) const -> bool {
+    return pressed.test(static_cast<size_t>(action));
+  }
+
+  [[nodiscard]] auto wasReleased(ActionType action) const -> bool {
+    return released.test(static_cast<size_t>(action));
+  }
+};
+
+}
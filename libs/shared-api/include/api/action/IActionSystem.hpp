@@ -2,6 +2,7 @@
 
 #include "api/action/Sources.hpp"
 #include "api/action/Actions.hpp"
+#include "api/action/ActionFrame.hpp"
 
 namespace tr {
 
@@ -16,6 +17,9 @@ public:
   auto operator=(IActionSystem&&) -> IActionSystem& = delete;
 
   virtual void mapSource(Source source, tr::StateType sType, tr::ActionType aType) = 0;
+
+  /// Returns the input accumulated since the previous call. Meant to be called once per game tick.
+  virtual auto takeActionFrame() -> ActionFrame = 0;
 };
 
 }
@@ -4,6 +4,28 @@
 
 namespace tr {
 
+/// Interned channel name, see `IEventQueue::internChannel`
+struct ChannelId {
+  uint32_t id;
+  constexpr auto operator==(const ChannelId&) const -> bool = default;
+};
+
+inline constexpr auto DefaultChannel = ChannelId{.id = 0};
+
+using EventTypeId = uint32_t;
+
+inline auto nextEventTypeId() -> EventTypeId {
+  static std::atomic<EventTypeId> next;
+  return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Small dense id per event type, so routing an event doesn't have to hash a type_index.
+template <typename T>
+auto eventTypeId() -> EventTypeId {
+  static const auto id = nextEventTypeId();
+  return id;
+}
+
 class IEventQueue {
 public:
   IEventQueue() = default;
@@ -14,33 +36,61 @@ public:
   auto operator=(const IEventQueue&) -> IEventQueue& = default;
   auto operator=(IEventQueue&&) -> IEventQueue& = delete;
 
+  /// Returns the same id every time it's called with the same name. "default" is DefaultChannel.
+  virtual auto internChannel(std::string_view name) -> ChannelId = 0;
+
+  /// Memory event payloads are allocated from. Must be safe to use from any thread.
+  virtual auto getPayloadResource() -> std::pmr::memory_resource* = 0;
+
   // Type-erased emit
-  virtual void emitErased(std::type_index type,
-                          std::shared_ptr<void> payload,
-                          const std::string& channel) = 0;
+  virtual void emitErased(EventTypeId type, std::shared_ptr<void> payload, ChannelId channel) = 0;
 
   // Type-erased subscribe
-  virtual void subscribeErased(std::type_index type,
-                               std::function<void(std::shared_ptr<void>)> listener,
-                               const std::string& channel) = 0;
+  virtual void subscribeErased(EventTypeId type,
+                               std::function<void(const std::shared_ptr<void>&)> listener,
+                               ChannelId channel) = 0;
 
   // Dispatch queued events on current thread
   virtual void dispatchPending() = 0;
 
+  /// Blocks until something is queued for the calling thread or `token` is stopped. The default
+  /// implementation can't tell, so it waits a millisecond and lets the caller check again.
+  virtual void waitForEvents(std::stop_token token) {
+    if (!token.stop_requested()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
   // Convenience templated API
   template <typename T>
-  void emit(T event, const std::string& channel = "default") {
-    emitErased(typeid(T), std::make_shared<T>(std::move(event)), channel);
+  void emit(T event, ChannelId channel = DefaultChannel) {
+    // One pooled allocation holds both the event and its control block
+    auto payload = std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{getPayloadResource()},
+                                           std::move(event));
+    emitErased(eventTypeId<T>(), std::move(payload), channel);
+  }
+
+  template <typename T>
+  void emit(T event, std::string_view channel) {
+    emit(std::move(event), internChannel(channel));
   }
 
   template <typename T>
   void subscribe(std::function<void(const std::shared_ptr<T>&)> listener,
-                 const std::string& channel = "default") {
+                 ChannelId channel = DefaultChannel) {
     subscribeErased(
-        typeid(T),
-        [listener](std::shared_ptr<void> ptr) { listener(std::static_pointer_cast<T>(ptr)); },
+        eventTypeId<T>(),
+        [listener = std::move(listener)](const std::shared_ptr<void>& ptr) {
+          listener(std::static_pointer_cast<T>(ptr));
+        },
         channel);
   }
+
+  template <typename T>
+  void subscribe(std::function<void(const std::shared_ptr<T>&)> listener,
+                 std::string_view channel) {
+    subscribe(std::move(listener), internChannel(channel));
+  }
 };
 
 }
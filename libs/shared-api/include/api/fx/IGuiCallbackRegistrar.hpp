@@ -22,5 +22,10 @@ public:
 
   virtual auto setReadyCallback(std::function<void(void)> newReadyFn) -> void = 0;
   virtual auto ready() -> void = 0;
+
+  /// Whether the overlay is drawn at all. Set from the application's thread and read by the
+  /// renderer, which stops running the ImGui pass while it's hidden.
+  virtual auto setVisible(bool visible) -> void = 0;
+  [[nodiscard]] virtual auto isVisible() const -> bool = 0;
 };
 }
@@ -6,6 +6,61 @@ namespace tr {
 
 using Timestamp = std::chrono::steady_clock::time_point;
 
+/// How many states a buffer has published so far, and the timestamp of the newest one.
+struct PublishedState {
+  uint64_t count{};
+  Timestamp latest{};
+};
+
+/// Read-only view of the two SimStates that bracket a requested time. Implementations may point
+/// this directly at their own storage, in which case the states are guaranteed not to be
+/// overwritten until the view is destroyed. Hold onto it only as long as the frame needs it.
+class StateReadView {
+public:
+  StateReadView(const SimState* newPrevious,
+                const SimState* newNext,
+                std::function<void()> newRelease = nullptr)
+      : previousState{newPrevious}, nextState{newNext}, release{std::move(newRelease)} {
+  }
+  ~StateReadView() {
+    if (release) {
+      release();
+    }
+  }
+
+  StateReadView(const StateReadView&) = delete;
+  StateReadView(StateReadView&& other) noexcept
+      : previousState{std::exchange(other.previousState, nullptr)},
+        nextState{std::exchange(other.nextState, nullptr)},
+        release{std::exchange(other.release, nullptr)} {
+  }
+  auto operator=(const StateReadView&) -> StateReadView& = delete;
+  auto operator=(StateReadView&& other) noexcept -> StateReadView& {
+    if (this != &other) {
+      if (release) {
+        release();
+      }
+      previousState = std::exchange(other.previousState, nullptr);
+      nextState = std::exchange(other.nextState, nullptr);
+      release = std::exchange(other.release, nullptr);
+    }
+    return *this;
+  }
+
+  [[nodiscard]] auto previous() const -> const SimState& {
+    return *previousState;
+  }
+
+  [[nodiscard]] auto next() const -> const SimState& {
+    return *nextState;
+  }
+
+private:
+  const SimState* previousState;
+  const SimState* nextState;
+  std::function<void()> release;
+};
+
 class IStateBuffer {
 public:
   IStateBuffer() = default;
@@ -18,6 +73,44 @@ public:
 
   virtual auto getStates(Timestamp t) -> std::optional<std::pair<SimState, SimState>> = 0;
   virtual auto pushState(const SimState& newState, Timestamp t) -> void = 0;
+
+  /// Lets the producer build a state in place rather than handing over a finished one. `writer`
+  /// receives whatever SimState the buffer is about to publish, which may still hold an older
+  /// state's contents, and is expected to clear it and fill it in. The default implementation
+  /// builds into a temporary and pushes a copy.
+  virtual auto writeState(Timestamp t, const std::function<void(SimState&)>& writer) -> void {
+    auto state = SimState{};
+    writer(state);
+    pushState(state, t);
+  }
+
+  /// The default implementation can't tell when something is published, so it reports every call
+  /// as the newest state being stamped now.
+  [[nodiscard]] virtual auto getPublishedState() const -> PublishedState {
+    return PublishedState{.count = 0, .latest = std::chrono::steady_clock::now()};
+  }
+
+  /// Blocks until more than `seenCount` states have been published or `deadline` passes, then
+  /// returns what's been published by then. The default implementation just waits a millisecond,
+  /// which is what readers had to do before buffers could signal them.
+  virtual auto waitForPublish([[maybe_unused]] uint64_t seenCount, Timestamp deadline)
+      -> PublishedState {
+    std::this_thread::sleep_until(
+        std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+    return getPublishedState();
+  }
+
+  /// Zero-copy variant of getStates. The default implementation falls back to getStates and lets
+  /// the returned view own the copies, so only buffers that can hand out views into their own
+  /// storage need to override it.
+  virtual auto readStates(Timestamp t) -> std::optional<StateReadView> {
+    auto states = getStates(t);
+    if (!states) {
+      return std::nullopt;
+    }
+    auto owned = std::make_shared<const std::pair<SimState, SimState>>(std::move(*states));
+    return StateReadView{&owned->first, &owned->second, [owned] {}};
+  }
 };
 
 }
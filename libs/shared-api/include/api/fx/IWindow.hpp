@@ -15,6 +15,8 @@ public:
   auto operator=(IWindow&&) -> IWindow& = delete;
 
   virtual void pollEvents() = 0;
+  /// Like pollEvents, but sleeps until the OS has an event for the window or `timeout` passes.
+  virtual void waitEvents(std::chrono::milliseconds timeout) = 0;
   virtual void setVulkanVersion(std::string_view version) = 0;
   virtual auto createVulkanSurface(const vk::Instance& instance, VkSurfaceKHR* outSurface) const
       -> void = 0;
@@ -10,6 +10,15 @@ struct GpuFrameData {
   glm::vec4 cameraPosition;
   float time;
   uint32_t maxObjects;
+  uint32_t batchCount;
+  /// Left, right, bottom, top, near, far as (inward normal, distance)
+  std::array<glm::vec4, 6> frustumPlanes;
+  /// What this frame draws with, for the late culling phase's test against the depth pyramid
+  /// built from the early phase's draws
+  glm::mat4 viewProjection;
+  glm::uvec2 hzbExtent;
+  /// 0 turns occlusion culling off, leaving the late phase to draw everything in the frustum
+  uint32_t hzbMipCount;
 };
 
 struct GpuResourceTable {
@@ -27,6 +36,13 @@ struct GpuResourceTable {
   uint64_t materialBufferAddress{};
   uint64_t indirectCommandAddress{};
   uint64_t indirectCountAddress{};
+  uint64_t drawBatchAddress{};
+  uint64_t drawInstanceAddress{};
+  uint64_t visibleObjectAddress{};
+  uint64_t depthPyramidAddress{};
+  uint64_t lateIndirectCommandAddress{};
+  uint64_t lateIndirectCountAddress{};
+  uint64_t objectVisibilityAddress{};
 };
 
 /// ObjectData Buffer
@@ -61,6 +77,11 @@ struct GpuGeometryRegionData {
   uint32_t colorOffset = INVALID_OFFSET;
   uint32_t texCoordOffset = INVALID_OFFSET;
   uint32_t normalOffset = INVALID_OFFSET;
+
+  /// Mesh space bounds, for culling. xyz is the sphere's center, w its radius.
+  glm::vec4 boundingSphere{0.f};
+  glm::vec3 boundsMin{0.f};
+  glm::vec3 boundsMax{0.f};
 };
 
 // Typical Index Data each index 'indexes' into the GpuVertex*Data buffer
@@ -88,6 +109,35 @@ struct GpuAnimationData {
   glm::mat4 jointMatrices;
 };
 
+/// One indirect draw's worth of objects sharing a geometry region and material. Instances
+/// firstInstance to firstInstance + instanceCount - 1 index the instance buffers.
+struct GpuDrawBatch {
+  uint32_t geometryRegionId;
+  uint32_t firstInstance;
+  uint32_t instanceCount;
+};
+
+/// An object that might be drawn, and the batch it would be drawn in
+struct GpuDrawInstance {
+  uint32_t objectId;
+  uint32_t batchId;
+};
+
+/// Same layout as VkDrawIndirectCommand
+struct GpuIndirectCommand {
+  uint32_t vertexCount;
+  uint32_t instanceCount;
+  uint32_t firstVertex;
+  uint32_t firstInstance;
+};
+
+/// Count buffer for the indirect draw. Culling uses finishedWorkgroups to find the last
+/// workgroup, which packs the commands and writes count.
+struct GpuDrawCount {
+  uint32_t count;
+  uint32_t finishedWorkgroups;
+};
+
 struct GpuMaterialData {
   glm::vec4 baseColor;
   uint32_t albedoTextureId;
@@ -16,6 +16,7 @@ struct StateHandles {
 struct SimState {
   Timestamp timeStamp{};                     // 8
   uint64_t tag{};                            // 8
+  uint64_t tick{};                           // 8, 0 means never written
   std::vector<GpuObjectData> objectMetadata; // 28
   std::vector<GpuTransformData> positions;   // 20
   std::vector<GpuRotationData> rotations;    // 20
@@ -24,6 +25,15 @@ struct SimState {
   // Parallel vector to GpuObjectData.
   std::vector<StateHandles> stateHandles; // 8
 
+  // Parallel vector to GpuObjectData. Stable per-entity key so objects can be matched up across
+  // states even when entities are added or removed between them.
+  std::vector<uint32_t> entityIds; // 4
+
+  // Parallel vector to GpuObjectData. The tick each object last changed, including being added or
+  // moved to a different index. Comparing these against a tick a consumer has already seen gives
+  // that consumer the delta it needs, no matter how many states it skipped in between.
+  std::vector<uint64_t> objectVersions; // 8
+
   glm::mat4 view;
   glm::mat4 projection;
 
@@ -34,6 +44,8 @@ struct SimState {
     rotations.reserve(initialCapacity);
     scales.reserve(initialCapacity);
     stateHandles.reserve(initialCapacity);
+    entityIds.reserve(initialCapacity);
+    objectVersions.reserve(initialCapacity);
   }
 
   auto ensureCapacity(size_t needed) {
@@ -43,15 +55,30 @@ struct SimState {
       rotations.reserve(needed);
       scales.reserve(needed);
       stateHandles.reserve(needed);
+      entityIds.reserve(needed);
+      objectVersions.reserve(needed);
     }
   }
 
+  /// Heap bytes currently reserved by the vectors, used to spot per-tick reallocation.
+  [[nodiscard]] auto capacityBytes() const -> size_t {
+    return (objectMetadata.capacity() * sizeof(GpuObjectData)) +
+           (positions.capacity() * sizeof(GpuTransformData)) +
+           (rotations.capacity() * sizeof(GpuRotationData)) +
+           (scales.capacity() * sizeof(GpuScaleData)) +
+           (stateHandles.capacity() * sizeof(StateHandles)) +
+           (entityIds.capacity() * sizeof(uint32_t)) +
+           (objectVersions.capacity() * sizeof(uint64_t));
+  }
+
   auto clear() {
     objectMetadata.clear();
     positions.clear();
     rotations.clear();
     scales.clear();
     stateHandles.clear();
+    entityIds.clear();
+    objectVersions.clear();
   }
 };
 
@@ -43,7 +43,7 @@ auto DebugMeshManager::update() -> void {
   //   }
   // };
 
-  // taskQueue->enqueue(task, onComplete);
+  // jobSystem->enqueue(task, onComplete);
 }
 
 auto DebugMeshManager::getRenderableMeshes() const -> std::vector<MeshData> {